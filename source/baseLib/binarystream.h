@@ -155,6 +155,11 @@ namespace baseLib
 		{
 		}
 
+		// read-only view of external memory, the memory needs to stay valid for the lifetime of the stream
+		BinaryStream(uint8_t* _buffer, const size_t _size) : StreamBuffer(_buffer, _size)
+		{
+		}
+
 		template<typename T> explicit BinaryStream(const std::vector<T>& _data)
 		{
 			Base::write(reinterpret_cast<const uint8_t*>(_data.data()), _data.size() * sizeof(T));
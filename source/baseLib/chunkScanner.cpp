@@ -0,0 +1,82 @@
+#include "chunkScanner.h"
+
+#include <cstring>
+
+namespace baseLib
+{
+	size_t ChunkScanner::find(const std::string_view& _pattern, const size_t _offset/* = 0*/) const
+	{
+		const auto len = _pattern.size();
+
+		if(!len || len > m_size || _offset > m_size - len)
+			return npos;
+
+		const auto first = static_cast<uint8_t>(_pattern.front());
+
+		const uint8_t* pos = m_data + _offset;
+		const uint8_t* last = m_data + m_size - len;	// last position at which the pattern can start
+
+		while(pos <= last)
+		{
+			pos = static_cast<const uint8_t*>(memchr(pos, first, static_cast<size_t>(last - pos) + 1));
+
+			if(!pos)
+				return npos;
+
+			if(len == 1 || memcmp(pos + 1, _pattern.data() + 1, len - 1) == 0)
+				return static_cast<size_t>(pos - m_data);
+
+			++pos;
+		}
+
+		return npos;
+	}
+
+	bool ChunkScanner::find(uint32_t& _offset, const std::string_view& _pattern) const
+	{
+		const auto pos = find(_pattern, _offset);
+
+		if(pos == npos)
+			return false;
+
+		_offset = static_cast<uint32_t>(pos);
+		return true;
+	}
+
+	size_t ChunkScanner::count(const std::string_view& _pattern, size_t _offset/* = 0*/) const
+	{
+		size_t result = 0;
+
+		while((_offset = find(_pattern, _offset)) != npos)
+		{
+			++result;
+			_offset += _pattern.size();
+		}
+
+		return result;
+	}
+
+	bool ChunkScanner::readBE32(uint32_t& _result, const size_t _offset) const
+	{
+		if(_offset > m_size || m_size - _offset < 4)
+			return false;
+
+		const auto* p = m_data + _offset;
+
+		_result =
+			(static_cast<uint32_t>(p[0]) << 24) |
+			(static_cast<uint32_t>(p[1]) << 16) |
+			(static_cast<uint32_t>(p[2]) << 8) |
+			(static_cast<uint32_t>(p[3]));
+
+		return true;
+	}
+
+	ByteSpan ChunkScanner::span(const size_t _offset, const size_t _size) const
+	{
+		if(_offset > m_size || m_size - _offset < _size)
+			return {};
+
+		return {m_data + _offset, _size};
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace baseLib
+{
+	// Non-owning view into a byte buffer
+	struct ByteSpan
+	{
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+
+		const uint8_t* begin() const { return data; }
+		const uint8_t* end() const { return data + size; }
+
+		bool empty() const { return size == 0; }
+
+		uint8_t operator[](const size_t _index) const { return data[_index]; }
+
+		std::vector<uint8_t> toVector() const { return {begin(), end()}; }
+	};
+
+	// Locates chunk identifiers (usually four character codes) in binary data without copying it. The search for the
+	// first character uses memchr, which is vectorized by all common C runtimes, the remaining characters are compared only
+	// at candidate positions
+	class ChunkScanner
+	{
+	public:
+		static constexpr size_t npos = ~static_cast<size_t>(0);
+
+		ChunkScanner(const uint8_t* _data, const size_t _size) : m_data(_data), m_size(_size) {}
+		explicit ChunkScanner(const std::vector<uint8_t>& _data) : ChunkScanner(_data.data(), _data.size()) {}
+
+		size_t find(const std::string_view& _pattern, size_t _offset = 0) const;
+		bool find(uint32_t& _offset, const std::string_view& _pattern) const;
+
+		size_t count(const std::string_view& _pattern, size_t _offset = 0) const;
+
+		bool readBE32(uint32_t& _result, size_t _offset) const;
+
+		// returns an empty span if the requested range is not entirely inside of the buffer
+		ByteSpan span(size_t _offset, size_t _size) const;
+
+		const uint8_t* data() const { return m_data; }
+		size_t size() const { return m_size; }
+
+	private:
+		const uint8_t* const m_data;
+		const size_t m_size;
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <condition_variable>
 #include <cstdint>
@@ -20,6 +21,19 @@ namespace baseLib
 			--m_count;
 		}
 
+		// returns false if the semaphore has not been notified within the given time
+		template<typename Rep, typename Period>
+		bool waitFor(const std::chrono::duration<Rep, Period>& _duration)
+		{
+			std::unique_lock uLock(m_mutex);
+
+			if(!m_cv.wait_for(uLock, _duration, [&]{ return m_count > 0; }))
+				return false;
+
+			--m_count;
+			return true;
+		}
+
 		void notify()
 		{
 			{
@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "baseLib/commandline.h"
+
+#include "bridgeLib/tcpConnection.h"
+
+#include "networkLib/exception.h"
+#include "networkLib/logging.h"
+#include "networkLib/reactor.h"
+#include "networkLib/tcpClient.h"
+#include "networkLib/tcpServer.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr uint32_t g_defaultPort = 56399;
+	constexpr uint32_t g_channelCount = 2;
+	constexpr auto g_timeout = std::chrono::seconds(30);
+
+	std::atomic<uint64_t> g_serverMidiCount{0};
+
+	// Server side connections count midi messages and echo audio blocks, client side connections count the audio replies
+	class BenchConnection : public bridgeLib::TcpConnection
+	{
+	public:
+		BenchConnection(std::unique_ptr<networkLib::TcpStream>&& _stream, std::shared_ptr<networkLib::Reactor> _reactor, const bool _isServer)
+			: TcpConnection(std::move(_stream), std::move(_reactor))
+			, m_isServer(_isServer)
+		{
+			for(size_t i=0; i<g_channelCount; ++i)
+			{
+				m_audio[i].resize(16384);
+				m_audioPtrs[i] = m_audio[i].data();
+			}
+
+			start();
+		}
+
+		~BenchConnection() override
+		{
+			shutdown();
+		}
+
+		void handleMidi(const synthLib::SMidiEvent&) override
+		{
+			g_serverMidiCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void handleAudio(baseLib::BinaryStream& _in) override
+		{
+			const auto numSamples = TcpConnection::handleAudio(m_audioPtrs.data(), _in);
+
+			if(m_isServer)
+			{
+				sendAudio(m_audioPtrs.data(), g_channelCount, numSamples);
+				return;
+			}
+
+			{
+				std::scoped_lock lock(m_mutex);
+				++m_audioCount;
+			}
+			m_cv.notify_one();
+		}
+
+		void handleException(const networkLib::NetException&) override
+		{
+			{
+				std::scoped_lock lock(m_mutex);
+				m_closed = true;
+			}
+			m_cv.notify_one();
+		}
+
+		bool waitForAudio(const uint64_t _count)
+		{
+			std::unique_lock lock(m_mutex);
+			return m_cv.wait_for(lock, g_timeout, [&]
+			{
+				return m_closed || m_audioCount >= _count;
+			}) && !m_closed;
+		}
+
+		void sendAudioBlock(const uint32_t _blockSize)
+		{
+			sendAudio(m_audioPtrs.data(), g_channelCount, _blockSize);
+		}
+
+	private:
+		const bool m_isServer;
+
+		std::array<std::vector<float>, g_channelCount> m_audio;
+		std::array<float*, g_channelCount> m_audioPtrs{};
+
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		uint64_t m_audioCount = 0;
+		bool m_closed = false;
+	};
+
+	void printUsage()
+	{
+		std::cout << "Measures the throughput of the DSP bridge network layer over loopback" << std::endl << std::endl;
+
+		std::cout << "Usage:" << std::endl;
+		std::cout << "  bridgeBenchmark [options]" << std::endl << std::endl;
+
+		std::cout << "Options:" << std::endl;
+		std::cout << "  -clients <n>              number of client connections, default 4" << std::endl;
+		std::cout << "  -messages <n>             midi messages sent per client, default 200000" << std::endl;
+		std::cout << "  -payload <bytes>          sysex size of each midi message, default 0" << std::endl;
+		std::cout << "  -blocks <n>               audio blocks sent per client, each one waits for the reply, default 20000" << std::endl;
+		std::cout << "  -blocksize <n>            samples per channel of each audio block, default 64" << std::endl;
+		std::cout << "  -workers <n>              reactor worker threads of the server, default 0 = one per CPU core" << std::endl;
+		std::cout << "  -port <n>                 TCP port, default " << g_defaultPort << std::endl;
+	}
+
+	void printRate(const char* _name, const uint64_t _count, const uint64_t _bytes, const double _seconds)
+	{
+		std::cout << std::fixed << std::setprecision(0) << _name << ": " << _count << " messages in " << std::setprecision(3) << _seconds << "s, "
+			<< std::setprecision(0) << (static_cast<double>(_count) / _seconds) << " messages/s, "
+			<< std::setprecision(1) << (static_cast<double>(_bytes) / _seconds / (1024.0 * 1024.0)) << " MiB/s" << std::endl;
+	}
+}
+
+int main(const int _argc, char* _argv[])
+{
+	const baseLib::CommandLine commandLine(_argc, _argv);
+
+	if(commandLine.contains("help") || commandLine.contains("h"))
+	{
+		printUsage();
+		return 0;
+	}
+
+	const auto clientCount = static_cast<uint32_t>(std::max(1, commandLine.getInt("clients", 4)));
+	const auto messageCount = static_cast<uint64_t>(std::max(0, commandLine.getInt("messages", 200000)));
+	const auto payload = static_cast<size_t>(std::max(0, commandLine.getInt("payload", 0)));
+	const auto blockCount = static_cast<uint64_t>(std::max(0, commandLine.getInt("blocks", 20000)));
+	const auto blockSize = static_cast<uint32_t>(std::clamp(commandLine.getInt("blocksize", 64), 1, 16384));
+	const auto workerCount = static_cast<uint32_t>(std::max(0, commandLine.getInt("workers", 0)));
+	const auto port = commandLine.getInt("port", static_cast<int>(g_defaultPort));
+
+	networkLib::setLogFunc([](networkLib::LogLevel _level, const char*, int, const std::string& _message)
+	{
+		if(_level >= networkLib::LogLevel::Warning)
+			std::cout << _message << std::endl;
+	});
+
+	// server
+
+	const auto serverReactor = std::make_shared<networkLib::Reactor>(workerCount);
+
+	std::mutex mutexServer;
+	std::list<std::unique_ptr<BenchConnection>> serverConnections;
+
+	networkLib::TcpServer server([&](std::unique_ptr<networkLib::TcpStream> _stream)
+	{
+		auto c = std::make_unique<BenchConnection>(std::move(_stream), serverReactor, true);
+		std::scoped_lock lock(mutexServer);
+		serverConnections.emplace_back(std::move(c));
+	}, port);
+
+	// clients, they use their own reactor to behave like a separate process
+
+	const auto clientReactor = std::make_shared<networkLib::Reactor>(networkLib::Reactor::SharedWorkerCount);
+
+	std::mutex mutexClients;
+	std::condition_variable cvClients;
+	std::vector<std::unique_ptr<networkLib::TcpStream>> clientStreams;
+	std::vector<std::unique_ptr<networkLib::TcpClient>> tcpClients;
+
+	for(uint32_t i=0; i<clientCount; ++i)
+	{
+		tcpClients.emplace_back(std::make_unique<networkLib::TcpClient>("127.0.0.1", port, [&](std::unique_ptr<networkLib::TcpStream> _stream)
+		{
+			{
+				std::scoped_lock lock(mutexClients);
+				clientStreams.emplace_back(std::move(_stream));
+			}
+			cvClients.notify_one();
+		}));
+	}
+
+	{
+		std::unique_lock lock(mutexClients);
+		if(!cvClients.wait_for(lock, g_timeout, [&] { return clientStreams.size() == clientCount; }))
+		{
+			std::cout << "Failed to connect to port " << port << std::endl;
+			return -1;
+		}
+	}
+
+	std::vector<std::unique_ptr<BenchConnection>> clients;
+	for (auto& stream : clientStreams)
+		clients.emplace_back(std::make_unique<BenchConnection>(std::move(stream), clientReactor, false));
+
+	std::cout << clientCount << " clients connected, server uses " << serverReactor->getWorkerCount() << " worker threads" << std::endl;
+
+	int result = 0;
+
+	// test 1: one-way throughput of small messages
+
+	if(messageCount)
+	{
+		synthLib::SMidiEvent ev(synthLib::MidiEventSource::Host, synthLib::M_CONTROLCHANGE, 1, 64);
+		if(payload)
+			ev.sysex.resize(payload, 0x7f);
+
+		g_serverMidiCount = 0;
+
+		const auto start = Clock::now();
+
+		std::vector<std::thread> threads;
+		for (auto& c : clients)
+		{
+			threads.emplace_back([&c, &ev, messageCount]
+			{
+				for(uint64_t i=0; i<messageCount; ++i)
+					c->send(ev);
+			});
+		}
+
+		for (auto& t : threads)
+			t.join();
+
+		const auto expected = messageCount * clientCount;
+
+		while(g_serverMidiCount < expected && Clock::now() - start < g_timeout)
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+		const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		if(g_serverMidiCount < expected)
+		{
+			std::cout << "Midi: timeout, received " << g_serverMidiCount << " of " << expected << " messages" << std::endl;
+			result = -1;
+		}
+		else
+		{
+			const auto bytesPerMessage = bridgeLib::g_commandHeaderSize + 3 + 4 + ev.sysex.size() + 4 + 1;
+			printRate("Midi", expected, expected * bytesPerMessage, seconds);
+		}
+	}
+
+	// test 2: audio round trips, every client waits for the reply before sending the next block, as the bridge client does
+
+	if(blockCount)
+	{
+		std::vector<double> maxRoundTrip(clients.size(), 0.0);
+		std::atomic<bool> failed{false};
+
+		const auto start = Clock::now();
+
+		std::vector<std::thread> threads;
+		for(size_t i=0; i<clients.size(); ++i)
+		{
+			threads.emplace_back([&, i]
+			{
+				auto& c = *clients[i];
+
+				for(uint64_t b=0; b<blockCount; ++b)
+				{
+					const auto t = Clock::now();
+
+					c.sendAudioBlock(blockSize);
+
+					if(!c.waitForAudio(b + 1))
+					{
+						failed = true;
+						return;
+					}
+
+					maxRoundTrip[i] = std::max(maxRoundTrip[i], std::chrono::duration<double, std::micro>(Clock::now() - t).count());
+				}
+			});
+		}
+
+		for (auto& t : threads)
+			t.join();
+
+		const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		if(failed)
+		{
+			std::cout << "Audio: round trip failed" << std::endl;
+			result = -1;
+		}
+		else
+		{
+			const auto count = blockCount * clientCount * 2;
+			const auto bytesPerMessage = bridgeLib::g_commandHeaderSize + 1 + 4 + g_channelCount * (4 + blockSize * sizeof(float));
+
+			printRate("Audio", count, count * bytesPerMessage, seconds);
+
+			std::cout << std::fixed << std::setprecision(1) << "Audio: round trip avg " << (seconds * 1e6 / static_cast<double>(blockCount)) << " us, max "
+				<< *std::max_element(maxRoundTrip.begin(), maxRoundTrip.end()) << " us" << std::endl;
+		}
+	}
+
+	clients.clear();
+	tcpClients.clear();
+
+	{
+		std::scoped_lock lock(mutexServer);
+		serverConnections.clear();
+	}
+
+	return result;
+}
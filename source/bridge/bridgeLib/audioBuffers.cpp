@@ -1,7 +1,58 @@
 #include "audioBuffers.h"
 
+#include <algorithm>
+#include <cstring>	// memcpy
+
 namespace bridgeLib
 {
+	void AudioBuffers::Ring::write(const float* _data, const uint32_t _count)
+	{
+		assert(size() + _count <= BufferSize);
+
+		const auto w = m_writePos.load(std::memory_order_relaxed);
+		const auto offset = w & Mask;
+		const auto first = std::min(_count, BufferSize - offset);
+
+		memcpy(&m_data[offset], _data, first * sizeof(float));
+		memcpy(&m_data[0], _data + first, (_count - first) * sizeof(float));
+
+		m_writePos.store(w + _count, std::memory_order_release);
+	}
+
+	void AudioBuffers::Ring::writeSilence(const uint32_t _count)
+	{
+		assert(size() + _count <= BufferSize);
+
+		const auto w = m_writePos.load(std::memory_order_relaxed);
+		const auto offset = w & Mask;
+		const auto first = std::min(_count, BufferSize - offset);
+
+		std::fill_n(&m_data[offset], first, 0.0f);
+		std::fill_n(&m_data[0], _count - first, 0.0f);
+
+		m_writePos.store(w + _count, std::memory_order_release);
+	}
+
+	void AudioBuffers::Ring::read(float* _data, const uint32_t _count)
+	{
+		assert(size() >= _count);
+
+		const auto r = m_readPos.load(std::memory_order_relaxed);
+		const auto offset = r & Mask;
+		const auto first = std::min(_count, BufferSize - offset);
+
+		memcpy(_data, &m_data[offset], first * sizeof(float));
+		memcpy(_data + first, &m_data[0], (_count - first) * sizeof(float));
+
+		m_readPos.store(r + _count, std::memory_order_release);
+	}
+
+	void AudioBuffers::Ring::skip(const uint32_t _count)
+	{
+		assert(size() >= _count);
+		m_readPos.store(m_readPos.load(std::memory_order_relaxed) + _count, std::memory_order_release);
+	}
+
 	AudioBuffers::AudioBuffers() = default;
 
 	void AudioBuffers::writeInput(const synthLib::TAudioInputs& _inputs, const uint32_t _size)
@@ -10,20 +61,17 @@ namespace bridgeLib
 
 		for(size_t c=0; c<_inputs.size(); ++c)
 		{
-			auto& in = _inputs[c];
-
-			if(!in)
-				continue;
-
-			for(uint32_t i=0; i<_size; ++i)
-				m_inputBuffers[c].push_back(in[i]);
+			// unconnected inputs are filled with silence to keep all channels in sync
+			if(const auto& in = _inputs[c])
+				m_inputBuffers[c].write(in, _size);
+			else
+				m_inputBuffers[c].writeSilence(_size);
 		}
 	}
 
 	void AudioBuffers::readInput(const uint32_t _channel, std::vector<float>& _data, const uint32_t _numSamples)
 	{
-		for(uint32_t i=0; i<_numSamples; ++i)
-			_data[i] = m_inputBuffers[_channel].pop_front();
+		m_inputBuffers[_channel].read(_data.data(), _numSamples);
 	}
 
 	void AudioBuffers::readOutput(const synthLib::TAudioOutputs& _outputs, const uint32_t _size)
@@ -38,33 +86,41 @@ namespace bridgeLib
 			if(!out)
 				continue;
 
-			for(uint32_t i=0; i<_size; ++i)
-				out[i] = m_outputBuffers[c].pop_front();
+			// channels that the device does not output are not transmitted
+			auto& buf = m_outputBuffers[c];
+			const auto count = std::min(_size, buf.size());
+
+			buf.read(out, count);
+			std::fill_n(out + count, _size - count, 0.0f);
 		}
 	}
 
 	void AudioBuffers::writeOutput(const uint32_t _channel, const std::vector<float>& _data, const uint32_t _numSamples)
 	{
-		for(uint32_t i=0; i<_numSamples; ++i)
-			m_outputBuffers[_channel].push_back(_data[i]);
+		m_outputBuffers[_channel].write(_data.data(), _numSamples);
 	}
 
 	void AudioBuffers::setLatency(const uint32_t _newLatency, const uint32_t _numSamplesToKeep)
 	{
-		while(_newLatency > m_latency)
+		if(_newLatency > m_latency)
 		{
+			const auto count = _newLatency - m_latency;
+
 			for (auto& in : m_inputBuffers)
-				in.push_back(0.0f);
-			++m_latency;
-			++m_inputSize;
-		}
+				in.writeSilence(count);
 
-		while(_newLatency < m_latency && m_inputBuffers.front().size() > _numSamplesToKeep)
+			m_latency += count;
+			m_inputSize += count;
+		}
+		else if(_newLatency < m_latency && m_inputBuffers.front().size() > _numSamplesToKeep)
 		{
+			const auto count = std::min(m_latency - _newLatency, m_inputBuffers.front().size() - _numSamplesToKeep);
+
 			for (auto& in : m_inputBuffers)
-				in.pop_front();
-			--m_latency;
-			--m_inputSize;
+				in.skip(count);
+
+			m_latency -= count;
+			m_inputSize -= count;
 		}
 	}
 }
@@ -1,7 +1,9 @@
 #pragma once
 
-#include "baseLib/binarystream.h"
-#include "dsp56kEmu/ringbuffer.h"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <vector>
 
 #include "synthLib/audioTypes.h"
 
@@ -12,8 +14,25 @@ namespace bridgeLib
 	public:
 		static constexpr uint32_t BufferSize = 16384;
 
-		using RingBufferIn = dsp56k::RingBuffer<float, BufferSize, false, true>;
-		using RingBufferOut = dsp56k::RingBuffer<float, BufferSize, false, true>;
+		// single producer, single consumer ring of samples. Blocks are copied in at most two pieces instead of sample by sample
+		class Ring
+		{
+		public:
+			uint32_t size() const { return m_writePos.load(std::memory_order_acquire) - m_readPos.load(std::memory_order_acquire); }
+
+			void write(const float* _data, uint32_t _count);
+			void writeSilence(uint32_t _count);
+			void read(float* _data, uint32_t _count);
+			void skip(uint32_t _count);
+
+		private:
+			static constexpr uint32_t Mask = BufferSize - 1;
+			static_assert((BufferSize & Mask) == 0, "buffer size needs to be a power of two");
+
+			std::array<float, BufferSize> m_data{};
+			std::atomic<uint32_t> m_writePos{0};
+			std::atomic<uint32_t> m_readPos{0};
+		};
 
 		AudioBuffers();
 
@@ -40,11 +59,11 @@ namespace bridgeLib
 		void setLatency(uint32_t _newLatency, uint32_t _numSamplesToKeep);
 
 	private:
-		std::array<RingBufferIn, std::tuple_size_v<synthLib::TAudioInputs>> m_inputBuffers;
-		std::array<RingBufferOut, std::tuple_size_v<synthLib::TAudioOutputs>> m_outputBuffers;
+		std::array<Ring, std::tuple_size_v<synthLib::TAudioInputs>> m_inputBuffers;
+		std::array<Ring, std::tuple_size_v<synthLib::TAudioOutputs>> m_outputBuffers;
 
 		uint32_t m_inputSize = 0;
-		uint32_t m_outputSize = 0;
+		std::atomic<uint32_t> m_outputSize{0};	// written by the receiver, read by the audio thread
 		uint32_t m_latency = 0;
 	};
 }
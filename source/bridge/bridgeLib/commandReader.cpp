@@ -1,5 +1,8 @@
 #include "commandReader.h"
 
+#include <array>
+#include <cstring>	// memcpy
+
 #include "command.h"
 #include "dsp56300/source/dsp56kEmu/logging.h"
 #include "networkLib/stream.h"
@@ -12,23 +15,26 @@ namespace bridgeLib
 
 	void CommandReader::read(networkLib::Stream& _stream)
 	{
-		// read command (4 bytes)
-		char temp[5]{0,0,0,0,0};
+		// read command (4 bytes) and size (4 bytes)
+		std::array<uint8_t, g_commandHeaderSize> header;
+		_stream.read(header.data(), g_commandHeaderSize);
 
-		_stream.read(temp, 4);
+		char temp[5]{0,0,0,0,0};
+		memcpy(temp, header.data(), 4);
 		const auto command = static_cast<Command>(cmd(temp));
 
-		// read size (4 bytes)
 		uint32_t size;
-		_stream.read(&size, sizeof(size));
+		memcpy(&size, header.data() + 4, sizeof(size));
 
-		// read data (n bytes)
-		m_stream.getVector().resize(size);
-		_stream.read(m_stream.getVector().data(), size);
+		// read data (n bytes). The vector keeps its capacity, it only grows if a larger command arrives
+		auto& buffer = m_stream.getVector();
+		if(buffer.size() < size)
+			buffer.resize(size);
+		_stream.read(buffer.data(), size);
 
 //		LOG("Recv cmd " << commandToString(command) << ", len " << size);
-		m_stream.setReadPos(0);
-		handleCommand(command, m_stream);
+		baseLib::BinaryStream in(buffer.data(), size);
+		handleCommand(command, in);
 	}
 
 	void CommandReader::read(baseLib::BinaryStream& _in)
@@ -36,10 +42,7 @@ namespace bridgeLib
 		// read command (4 bytes)
 		char temp[5]{0,0,0,0,0};
 
-		_in.read(temp[0]);
-		_in.read(temp[1]);
-		_in.read(temp[2]);
-		_in.read(temp[3]);
+		_in.read(temp, 4);
 
 		const auto command = cmd(temp);
 
@@ -47,11 +50,39 @@ namespace bridgeLib
 		const uint32_t size = _in.read<uint32_t>();
 
 		// read data (n bytes)
-		m_stream.getVector().resize(size);
-		for(size_t i=0; i<size; ++i)
-			m_stream.getVector()[i] = _in.read<uint8_t>();
+		auto& buffer = m_stream.getVector();
+		if(buffer.size() < size)
+			buffer.resize(size);
+		_in.read(buffer.data(), size);
+
+		baseLib::BinaryStream in(buffer.data(), size);
+		handleCommand(static_cast<Command>(command), in);
+	}
+
+	size_t CommandReader::read(uint8_t* _data, const size_t _size)
+	{
+		size_t offset = 0;
+
+		while(_size - offset >= g_commandHeaderSize)
+		{
+			auto* header = _data + offset;
+
+			// size (4 bytes) follows the command (4 bytes)
+			uint32_t size;
+			memcpy(&size, header + 4, sizeof(size));
+
+			if(_size - offset - g_commandHeaderSize < size)
+				break;
+
+			char temp[5]{0,0,0,0,0};
+			memcpy(temp, header, 4);
+
+			baseLib::BinaryStream in(header + g_commandHeaderSize, size);
+			handleCommand(static_cast<Command>(cmd(temp)), in);
+
+			offset += g_commandHeaderSize + size;
+		}
 
-		m_stream.setReadPos(0);
-		handleCommand(static_cast<Command>(command), m_stream);
+		return offset;
 	}
 }
@@ -22,6 +22,10 @@ namespace bridgeLib
 		void read(networkLib::Stream& _stream);
 		void read(baseLib::BinaryStream& _in);
 
+		// handles all complete commands in the buffer and returns the number of bytes consumed. Commands are
+		// parsed in place, the stream passed to handleCommand() refers to the given buffer
+		size_t read(uint8_t* _data, size_t _size);
+
 		virtual void handleCommand(Command _command, baseLib::BinaryStream& _in)
 		{
 			m_commandCallback(_command, _in);
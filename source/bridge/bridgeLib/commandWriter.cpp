@@ -1,8 +1,13 @@
 #include "commandWriter.h"
 
 #include <array>
+#include <cstring>	// memcpy
+#include <iterator>	// std::size
+
+#include "sharedMemoryTransport.h"
 
 #include "networkLib/stream.h"
+#include "networkLib/tcpSession.h"
 
 namespace bridgeLib
 {
@@ -25,18 +30,12 @@ namespace bridgeLib
 
 	void CommandWriter::write(networkLib::Stream& _stream, const bool _flush)
 	{
-		// send command (4 bytes)
-		std::array<char,5> buf;
-		commandToBuffer(buf, m_command);
-		_stream.write(buf.data(), 4);
-
-		// send size (4 bytes)
-		const auto size = m_stream.getWritePos();
-		_stream.write(&size, sizeof(size));
+		const auto header = buildHeader();
+		_stream.write(header.data(), g_commandHeaderSize);
 
 		// send data (size bytes)
-		const auto* data = m_stream.getVector().data();
-		_stream.write(data, size);
+		const auto size = m_stream.getWritePos();
+		_stream.write(m_stream.getVector().data(), size);
 
 		if(_flush)
 			_stream.flush();
@@ -44,21 +43,52 @@ namespace bridgeLib
 
 	void CommandWriter::write(baseLib::BinaryStream& _out)
 	{
-		// send command (4 bytes)
+		const auto header = buildHeader();
+		_out.write(header.data(), g_commandHeaderSize);
+
+		const auto size = m_stream.getWritePos();
+		_out.write(m_stream.getVector().data(), size);
+	}
+
+	bool CommandWriter::write(networkLib::TcpSession& _session)
+	{
+		const auto header = buildHeader();
+
+		const networkLib::TcpSession::SendBuffer buffers[] =
+		{
+			{header.data(), g_commandHeaderSize},
+			{m_stream.getVector().data(), m_stream.getWritePos()}
+		};
+
+		return _session.send(buffers, std::size(buffers));
+	}
+
+	bool CommandWriter::write(SharedMemoryTransport& _transport)
+	{
+		const auto header = buildHeader();
+
+		const SharedMemoryRing::Buffer buffers[] =
+		{
+			{header.data(), g_commandHeaderSize},
+			{m_stream.getVector().data(), m_stream.getWritePos()}
+		};
+
+		return _transport.send(buffers, std::size(buffers));
+	}
+
+	std::array<uint8_t, g_commandHeaderSize> CommandWriter::buildHeader() const
+	{
+		std::array<uint8_t, g_commandHeaderSize> header;
+
+		// command (4 bytes)
 		std::array<char,5> buf;
 		commandToBuffer(buf, m_command);
-		_out.write(buf[0]);
-		_out.write(buf[1]);
-		_out.write(buf[2]);
-		_out.write(buf[3]);
+		memcpy(header.data(), buf.data(), 4);
 
-		// send size (4 bytes)
+		// size (4 bytes)
 		const auto size = m_stream.getWritePos();
-		_out.write(size);
+		memcpy(header.data() + 4, &size, sizeof(size));
 
-		// send data (size bytes)
-		const auto* data = m_stream.getVector().data();
-		for(uint32_t i=0; i<size; ++i)
-			_out.write(m_stream.getVector()[i]);
+		return header;
 	}
 }
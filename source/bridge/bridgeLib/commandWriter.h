@@ -7,10 +7,13 @@
 namespace networkLib
 {
 	class Stream;
+	class TcpSession;
 }
 
 namespace bridgeLib
 {
+	class SharedMemoryTransport;
+
 	class CommandWriter
 	{
 	public:
@@ -23,7 +26,16 @@ namespace bridgeLib
 		void write(networkLib::Stream& _stream, bool _flush = true);
 		void write(baseLib::BinaryStream& _out);
 
+		// header and payload are sent with one gather write
+		bool write(networkLib::TcpSession& _session);
+		bool write(SharedMemoryTransport& _transport);
+
+		Command getCommand() const { return m_command; }
+		size_t getSize() const { return g_commandHeaderSize + m_stream.getWritePos(); }
+
 	private:
+		std::array<uint8_t, g_commandHeaderSize> buildHeader() const;
+
 		baseLib::BinaryStream m_stream;
 		Command m_command = Command::Invalid;
 	};
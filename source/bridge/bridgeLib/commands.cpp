@@ -42,6 +42,7 @@ namespace bridgeLib
 		_s.write(protocolVersion);
 		_s.write(portUdp);
 		_s.write(portTcp);
+		_s.write<uint8_t>(sharedMemory ? 1 : 0);
 		return _s;
 	}
 
@@ -50,6 +51,7 @@ namespace bridgeLib
 		_s.read(protocolVersion);
 		_s.read(portUdp);
 		_s.read(portTcp);
+		sharedMemory = _s.read<uint8_t>() != 0;
 		return _s;
 	}
 
@@ -60,6 +62,8 @@ namespace bridgeLib
 		_s.write(pluginVersion);
 		_s.write(plugin4CC);
 		_s.write(sessionId);
+		_s.write(sharedMemoryName);
+		_s.write(sharedMemoryKey);
 		return _s;
 	}
 
@@ -70,6 +74,8 @@ namespace bridgeLib
 		_s.read(pluginVersion);
 		plugin4CC = _s.readString();
 		_s.read(sessionId);
+		sharedMemoryName = _s.readString();
+		_s.read(sharedMemoryKey);
 		return _s;
 	}
 
@@ -44,6 +44,9 @@ namespace bridgeLib
 		SetDspClockPercent = cmd("DspC")
 	};
 
+	// every command is sent as 4CC (4 bytes) + payload size (4 bytes) + payload
+	static constexpr uint32_t g_commandHeaderSize = 8;
+
 	std::string commandToString(Command _command);
 	void commandToBuffer(std::array<char,5>& _buffer, Command _command);
 
@@ -61,6 +64,7 @@ namespace bridgeLib
 		uint32_t protocolVersion;
 		uint32_t portUdp;
 		uint32_t portTcp;
+		bool sharedMemory = false;	// server confirms that it uses the shared memory offered by the client
 
 		baseLib::BinaryStream& write(baseLib::BinaryStream& _s) const override;
 		baseLib::BinaryStream& read(baseLib::BinaryStream& _s) override;
@@ -73,6 +77,8 @@ namespace bridgeLib
 		uint32_t pluginVersion = 0;
 		std::string plugin4CC;
 		SessionId sessionId = 0;
+		std::string sharedMemoryName;	// offered by a client that supports local transport, empty otherwise
+		uint64_t sharedMemoryKey = 0;
 
 		PluginDesc()
 		{
@@ -0,0 +1,173 @@
+#include "sharedMemory.h"
+
+#include <cstring>	// strerror
+
+#include "networkLib/logging.h"
+
+#ifdef _WIN32
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <cerrno>
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace bridgeLib
+{
+	namespace
+	{
+		std::string getSystemName(const std::string& _name)
+		{
+#ifdef _WIN32
+			return "Local\\" + _name;
+#else
+			return '/' + _name;
+#endif
+		}
+	}
+
+	SharedMemory::~SharedMemory()
+	{
+		close();
+	}
+
+	bool SharedMemory::create(const std::string& _name, const size_t _size)
+	{
+		return map(_name, _size, true);
+	}
+
+	bool SharedMemory::open(const std::string& _name, const size_t _size)
+	{
+		return map(_name, _size, false);
+	}
+
+	void SharedMemory::unlink()
+	{
+#ifndef _WIN32
+		if(!m_linked)
+			return;
+		m_linked = false;
+		::shm_unlink(getSystemName(m_name).c_str());
+#endif
+	}
+
+	void SharedMemory::close()
+	{
+		if(m_created)
+			unlink();
+
+#ifdef _WIN32
+		if(m_data)
+			UnmapViewOfFile(m_data);
+		if(m_handle)
+			CloseHandle(m_handle);
+		m_handle = nullptr;
+#else
+		if(m_data)
+			::munmap(m_data, m_size);
+#endif
+		m_data = nullptr;
+		m_size = 0;
+		m_created = false;
+	}
+
+	bool SharedMemory::map(const std::string& _name, const size_t _size, const bool _create)
+	{
+		close();
+
+		const auto name = getSystemName(_name);
+
+#ifdef _WIN32
+		const auto size = static_cast<uint64_t>(_size);
+
+		HANDLE handle;
+
+		if(_create)
+		{
+			handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xffffffff), name.c_str());
+
+			if(handle && GetLastError() == ERROR_ALREADY_EXISTS)
+			{
+				CloseHandle(handle);
+				handle = nullptr;
+			}
+		}
+		else
+		{
+			handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+		}
+
+		if(!handle)
+		{
+			LOGNET(networkLib::LogLevel::Warning, "Failed to " << (_create ? "create" : "open") << " shared memory " << name << ", error " << GetLastError());
+			return false;
+		}
+
+		auto* data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, _size);
+
+		if(!data)
+		{
+			LOGNET(networkLib::LogLevel::Warning, "Failed to map shared memory " << name << ", error " << GetLastError());
+			CloseHandle(handle);
+			return false;
+		}
+
+		m_handle = handle;
+		m_data = static_cast<uint8_t*>(data);
+#else
+		const int fd = _create
+			? ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR)
+			: ::shm_open(name.c_str(), O_RDWR, 0);
+
+		if(fd < 0)
+		{
+			LOGNET(networkLib::LogLevel::Warning, "Failed to " << (_create ? "create" : "open") << " shared memory " << name << ", error " << errno << ": " << strerror(errno));
+			return false;
+		}
+
+		if(_create && ::ftruncate(fd, static_cast<off_t>(_size)) != 0)
+		{
+			LOGNET(networkLib::LogLevel::Warning, "Failed to resize shared memory " << name << ", error " << errno << ": " << strerror(errno));
+			::close(fd);
+			::shm_unlink(name.c_str());
+			return false;
+		}
+
+		if(!_create)
+		{
+			// the creator might be malicious or might have failed to resize it, do not map beyond the end of the object
+			struct stat st{};
+			if(::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < _size)
+			{
+				LOGNET(networkLib::LogLevel::Warning, "Shared memory " << name << " is smaller than expected");
+				::close(fd);
+				return false;
+			}
+		}
+
+		auto* data = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		// the mapping stays valid after the descriptor has been closed
+		::close(fd);
+
+		if(data == MAP_FAILED)
+		{
+			LOGNET(networkLib::LogLevel::Warning, "Failed to map shared memory " << name << ", error " << errno << ": " << strerror(errno));
+			if(_create)
+				::shm_unlink(name.c_str());
+			return false;
+		}
+
+		m_data = static_cast<uint8_t*>(data);
+		m_linked = true;
+#endif
+		m_name = _name;
+		m_size = _size;
+		m_created = _create;
+
+		return true;
+	}
+}
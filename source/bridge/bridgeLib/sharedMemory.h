@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bridgeLib
+{
+	// Named shared memory segment that can be mapped by several processes on the same host
+	class SharedMemory
+	{
+	public:
+		SharedMemory() = default;
+		~SharedMemory();
+
+		SharedMemory(const SharedMemory&) = delete;
+		SharedMemory(SharedMemory&&) = delete;
+		SharedMemory& operator = (const SharedMemory&) = delete;
+		SharedMemory& operator = (SharedMemory&&) = delete;
+
+		// creates a new segment, fails if a segment with that name exists already. The memory is zero initialized
+		bool create(const std::string& _name, size_t _size);
+
+		// maps an existing segment that has been created by another process
+		bool open(const std::string& _name, size_t _size);
+
+		// removes the name of the segment, both the creator and a process that opened it may do this. Processes that have
+		// mapped it can continue to use it. No-op on Windows, the segment is destroyed once the last process closes it
+		void unlink();
+
+		void close();
+
+		bool isValid() const { return m_data != nullptr; }
+
+		uint8_t* getData() const { return m_data; }
+		size_t getSize() const { return m_size; }
+		const std::string& getName() const { return m_name; }
+
+	private:
+		bool map(const std::string& _name, size_t _size, bool _create);
+
+		std::string m_name;
+		uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+		bool m_created = false;
+
+#ifdef _WIN32
+		void* m_handle = nullptr;
+#else
+		bool m_linked = false;
+#endif
+	};
+}
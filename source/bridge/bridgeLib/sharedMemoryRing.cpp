@@ -0,0 +1,279 @@
+#include "sharedMemoryRing.h"
+
+#include <cassert>
+#include <chrono>
+#include <climits>
+#include <cstring>	// memcpy
+
+#include "networkLib/logging.h"
+
+#ifdef _WIN32
+#	define NOMINMAX
+#	include <Windows.h>
+#elif defined(__linux__)
+#	include <linux/futex.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#	include <ctime>
+#endif
+
+namespace bridgeLib
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+#if defined(__linux__)
+		uint32_t* futexAddress(const std::atomic<uint32_t>& _value)
+		{
+			static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+			return reinterpret_cast<uint32_t*>(const_cast<std::atomic<uint32_t>*>(&_value));
+		}
+
+		// not FUTEX_PRIVATE_FLAG, the word is shared with another process
+		void futexWait(const std::atomic<uint32_t>& _value, const uint32_t _expected, const Clock::duration _timeout)
+		{
+			const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(_timeout).count();
+
+			timespec ts{};
+			ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+			ts.tv_nsec = static_cast<long>(ns % 1000000000);
+
+			::syscall(SYS_futex, futexAddress(_value), FUTEX_WAIT, _expected, &ts, nullptr, 0);
+		}
+
+		void futexWake(const std::atomic<uint32_t>& _value)
+		{
+			::syscall(SYS_futex, futexAddress(_value), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+		}
+#endif
+
+#ifdef _WIN32
+		HANDLE createEvent(const std::string& _name, const bool _create)
+		{
+			const auto name = "Local\\" + _name;
+
+			// auto reset, a signal that is not consumed yet is not lost
+			const auto handle = _create
+				? CreateEventA(nullptr, FALSE, FALSE, name.c_str())
+				: OpenEventA(SYNCHRONIZE | EVENT_MODIFY_STATE, FALSE, name.c_str());
+
+			if(!handle)
+				LOGNET(networkLib::LogLevel::Warning, "Failed to " << (_create ? "create" : "open") << " event " << name << ", error " << GetLastError());
+
+			return handle;
+		}
+#endif
+	}
+
+	SharedMemoryRing::~SharedMemoryRing()
+	{
+#ifdef _WIN32
+		if(m_eventData)
+			CloseHandle(m_eventData);
+		if(m_eventSpace)
+			CloseHandle(m_eventSpace);
+#endif
+	}
+
+	bool SharedMemoryRing::init(Header* _header, uint8_t* _data, const uint32_t _capacity, [[maybe_unused]] const std::string& _name, [[maybe_unused]] const bool _create)
+	{
+		assert((_capacity & (_capacity - 1)) == 0 && _capacity >= RecordAlignment * 2);
+
+#ifdef _WIN32
+		m_eventData = createEvent(_name + "_d", _create);
+		m_eventSpace = createEvent(_name + "_s", _create);
+
+		if(!m_eventData || !m_eventSpace)
+			return false;
+#endif
+		m_header = _header;
+		m_data = _data;
+		m_capacity = _capacity;
+
+		return true;
+	}
+
+	bool SharedMemoryRing::write(const Buffer* _buffers, const size_t _count, const uint32_t _timeoutMs)
+	{
+		if(!m_header || isClosed())
+			return false;
+
+		size_t total = 0;
+		for(size_t i=0; i<_count; ++i)
+			total += _buffers[i].size;
+
+		if(total > getMaxMessageSize())
+			return false;
+
+		const auto recordSize = getRecordSize(static_cast<uint32_t>(total));
+
+		auto w = m_header->writePos.load(std::memory_order_relaxed);
+
+		const auto offset = w & (m_capacity - 1);
+		const auto toEnd = m_capacity - offset;
+
+		// a message that does not fit before the end of the ring starts at the beginning, the rest is skipped
+		const auto needed = recordSize <= toEnd ? recordSize : toEnd + recordSize;
+
+		const auto deadline = Clock::now() + std::chrono::milliseconds(_timeoutMs);
+
+		while(true)
+		{
+			const auto r = m_header->readPos.load(std::memory_order_acquire);
+
+			if(m_capacity - (w - r) >= needed)
+				break;
+
+			if(!wait(Side::Writer, m_header->readPos, r, deadline - Clock::now()))
+				return false;
+		}
+
+		if(recordSize > toEnd)
+		{
+			memcpy(m_data + offset, &WrapMarker, sizeof(WrapMarker));
+			w += toEnd;
+		}
+
+		auto* dst = m_data + (w & (m_capacity - 1));
+
+		const auto size = static_cast<uint32_t>(total);
+		memcpy(dst, &size, sizeof(size));
+		dst += RecordHeaderSize;
+
+		for(size_t i=0; i<_count; ++i)
+		{
+			memcpy(dst, _buffers[i].data, _buffers[i].size);
+			dst += _buffers[i].size;
+		}
+
+		m_header->writePos.store(w + recordSize);
+
+		notify(Side::Reader);
+
+		return true;
+	}
+
+	uint8_t* SharedMemoryRing::peek(uint32_t& _size, const uint32_t _timeoutMs)
+	{
+		if(!m_header)
+			return nullptr;
+
+		auto r = m_header->readPos.load(std::memory_order_relaxed);
+
+		const auto deadline = Clock::now() + std::chrono::milliseconds(_timeoutMs);
+
+		while(true)
+		{
+			const auto w = m_header->writePos.load(std::memory_order_acquire);
+
+			if(w != r)
+			{
+				const auto offset = r & (m_capacity - 1);
+
+				uint32_t size;
+				memcpy(&size, m_data + offset, sizeof(size));
+
+				if(size == WrapMarker)
+				{
+					r += m_capacity - offset;
+					m_header->readPos.store(r);
+					notify(Side::Writer);
+					continue;
+				}
+
+				// the other process is not trusted, never hand out memory outside of the ring
+				const auto recordSize = getRecordSize(size);
+
+				if(size > getMaxMessageSize() || recordSize > w - r || recordSize > m_capacity - offset)
+				{
+					LOGNET(networkLib::LogLevel::Error, "Invalid message of size " << size << " in shared memory ring, closing");
+					close();
+					return nullptr;
+				}
+
+				m_peekSize = size;
+				_size = size;
+				return m_data + offset + RecordHeaderSize;
+			}
+
+			if(!wait(Side::Reader, m_header->writePos, w, deadline - Clock::now()))
+				return nullptr;
+		}
+	}
+
+	void SharedMemoryRing::pop()
+	{
+		const auto r = m_header->readPos.load(std::memory_order_relaxed);
+		m_header->readPos.store(r + getRecordSize(m_peekSize));
+		m_peekSize = 0;
+
+		notify(Side::Writer);
+	}
+
+	void SharedMemoryRing::close()
+	{
+		if(!m_header)
+			return;
+
+		m_header->closed = 1;
+
+#if defined(__linux__)
+		futexWake(m_header->writePos);
+		futexWake(m_header->readPos);
+#elif defined(_WIN32)
+		SetEvent(m_eventData);
+		SetEvent(m_eventSpace);
+#endif
+	}
+
+	bool SharedMemoryRing::isClosed() const
+	{
+		return m_header && m_header->closed != 0;
+	}
+
+	bool SharedMemoryRing::wait(const Side _side, const std::atomic<uint32_t>& _value, const uint32_t _expected, const Clock::duration _timeout) const
+	{
+		auto& waiting = _side == Side::Reader ? m_header->readerWaiting : m_header->writerWaiting;
+
+		const auto deadline = Clock::now() + _timeout;
+
+		while(true)
+		{
+			// announce that we are about to sleep before checking the value for the last time. The other side changes
+			// the value before it checks the flag, one of both sides sees the change of the other
+			waiting = 1;
+
+			if(_value != _expected)
+				return true;
+
+			if(isClosed())
+				return false;
+
+			const auto now = Clock::now();
+			if(now >= deadline)
+				return false;
+
+#if defined(__linux__)
+			futexWait(_value, _expected, deadline - now);
+#elif defined(_WIN32)
+			const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+			WaitForSingleObject(_side == Side::Reader ? m_eventData : m_eventSpace, static_cast<DWORD>(ms));
+#endif
+		}
+	}
+
+	void SharedMemoryRing::notify(const Side _side) const
+	{
+		auto& waiting = _side == Side::Reader ? m_header->readerWaiting : m_header->writerWaiting;
+
+		if(!waiting.exchange(0))
+			return;
+
+#if defined(__linux__)
+		futexWake(_side == Side::Reader ? m_header->writePos : m_header->readPos);
+#elif defined(_WIN32)
+		SetEvent(_side == Side::Reader ? m_eventData : m_eventSpace);
+#endif
+	}
+}
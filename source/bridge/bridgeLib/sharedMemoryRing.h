@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bridgeLib
+{
+	// Single producer, single consumer message ring that lives in shared memory. Every message is stored contiguously,
+	// the consumer can parse it in place. A consumer waiting for data and a producer waiting for space sleep on a futex
+	// on Linux and on a named event on Windows, they do not spin
+	class SharedMemoryRing
+	{
+	public:
+		// shared state, placed in the shared memory segment. A zero initialized header is an empty ring
+		struct Header
+		{
+			alignas(64) std::atomic<uint32_t> writePos;
+			std::atomic<uint32_t> readerWaiting;
+			std::atomic<uint32_t> closed;
+			alignas(64) std::atomic<uint32_t> readPos;
+			std::atomic<uint32_t> writerWaiting;
+		};
+
+		static_assert(std::atomic<uint32_t>::is_always_lock_free, "atomics in shared memory need to be lock free");
+
+		struct Buffer
+		{
+			const void* data;
+			size_t size;
+		};
+
+		SharedMemoryRing() = default;
+		~SharedMemoryRing();
+
+		SharedMemoryRing(const SharedMemoryRing&) = delete;
+		SharedMemoryRing(SharedMemoryRing&&) = delete;
+		SharedMemoryRing& operator = (const SharedMemoryRing&) = delete;
+		SharedMemoryRing& operator = (SharedMemoryRing&&) = delete;
+
+		// _capacity needs to be a power of two. _name is used to create (or open if _create is false) the events on Windows
+		bool init(Header* _header, uint8_t* _data, uint32_t _capacity, const std::string& _name, bool _create);
+
+		uint32_t getMaxMessageSize() const { return m_capacity / 2 - RecordHeaderSize; }
+
+		// producer. Writes all buffers as one message, waits up to _timeoutMs for space. Returns false on timeout, if
+		// the message is too large or if the ring has been closed
+		bool write(const Buffer* _buffers, size_t _count, uint32_t _timeoutMs);
+
+		// consumer. Returns the next message or nullptr if none arrived within _timeoutMs. The message stays valid
+		// until pop() is called
+		uint8_t* peek(uint32_t& _size, uint32_t _timeoutMs);
+		void pop();
+
+		// wakes up both sides, all calls fail afterwards
+		void close();
+		bool isClosed() const;
+
+	private:
+		static constexpr uint32_t RecordHeaderSize = sizeof(uint32_t);
+		static constexpr uint32_t RecordAlignment = 8;
+		static constexpr uint32_t WrapMarker = 0xffffffff;
+
+		static uint32_t getRecordSize(const uint32_t _size)
+		{
+			return (RecordHeaderSize + _size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+		}
+
+		enum class Side
+		{
+			Reader,
+			Writer
+		};
+
+		// waits until _value is no longer _expected. Returns false on timeout or if the ring has been closed
+		bool wait(Side _side, const std::atomic<uint32_t>& _value, uint32_t _expected, std::chrono::steady_clock::duration _timeout) const;
+		void notify(Side _side) const;
+
+		Header* m_header = nullptr;
+		uint8_t* m_data = nullptr;
+		uint32_t m_capacity = 0;
+
+		uint32_t m_peekSize = 0;	// consumer only
+
+#ifdef _WIN32
+		void* m_eventData = nullptr;	// signaled when the writer added a message
+		void* m_eventSpace = nullptr;	// signaled when the reader removed a message
+#endif
+	};
+}
@@ -0,0 +1,175 @@
+#include "sharedMemoryTransport.h"
+
+#include <atomic>
+#include <new>
+#include <random>
+
+#include "commandReader.h"
+
+#include "networkLib/logging.h"
+
+#ifdef _WIN32
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <unistd.h>
+#endif
+
+namespace bridgeLib
+{
+	namespace
+	{
+		constexpr uint32_t g_magic = 0x4d485347;	// GSHM
+		constexpr uint32_t g_version = 1;
+
+		// large enough for an audio block of the maximum size with all channels
+		constexpr uint32_t g_ringCapacity = 4 * 1024 * 1024;
+
+		uint32_t getProcessId()
+		{
+#ifdef _WIN32
+			return static_cast<uint32_t>(GetCurrentProcessId());
+#else
+			return static_cast<uint32_t>(getpid());
+#endif
+		}
+	}
+
+	struct alignas(64) SharedMemoryTransport::Header
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t key;
+		uint32_t ringCapacity;
+
+		SharedMemoryRing::Header clientToServer;
+		SharedMemoryRing::Header serverToClient;
+	};
+
+	SharedMemoryTransport::~SharedMemoryTransport()
+	{
+		close();
+	}
+
+	bool SharedMemoryTransport::isSupported()
+	{
+#if defined(__linux__) || defined(_WIN32)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	std::unique_ptr<SharedMemoryTransport> SharedMemoryTransport::create()
+	{
+		if(!isSupported())
+			return {};
+
+		static std::atomic<uint32_t> g_counter{0};
+
+		std::random_device rd;
+		const auto key = (static_cast<uint64_t>(rd()) << 32) | rd();
+
+		const auto name = "gmbridge_" + std::to_string(getProcessId()) + '_' + std::to_string(++g_counter);
+
+		std::unique_ptr<SharedMemoryTransport> t(new SharedMemoryTransport());
+
+		if(!t->m_memory.create(name, sizeof(Header) + g_ringCapacity * 2))
+			return {};
+
+		auto* header = new (t->m_memory.getData()) Header{};
+
+		header->version = g_version;
+		header->key = key;
+		header->ringCapacity = g_ringCapacity;
+		header->magic = g_magic;
+
+		t->m_key = key;
+
+		if(!t->init(true))
+			return {};
+
+		return t;
+	}
+
+	std::unique_ptr<SharedMemoryTransport> SharedMemoryTransport::open(const std::string& _name, const uint64_t _key)
+	{
+		if(!isSupported() || _name.empty())
+			return {};
+
+		std::unique_ptr<SharedMemoryTransport> t(new SharedMemoryTransport());
+
+		if(!t->m_memory.open(_name, sizeof(Header) + g_ringCapacity * 2))
+			return {};
+
+		const auto* header = reinterpret_cast<const Header*>(t->m_memory.getData());
+
+		if(header->magic != g_magic || header->version != g_version || header->ringCapacity != g_ringCapacity || header->key != _key)
+		{
+			LOGNET(networkLib::LogLevel::Warning, "Shared memory " << _name << " does not belong to this connection");
+			return {};
+		}
+
+		t->m_key = _key;
+
+		if(!t->init(false))
+			return {};
+
+		// both sides have mapped the segment now, its name is not needed anymore. The client unlinks it, too, but
+		// this way, the name does not stay in /dev/shm if the client crashes
+		t->unlink();
+
+		return t;
+	}
+
+	bool SharedMemoryTransport::send(const SharedMemoryRing::Buffer* _buffers, const size_t _count)
+	{
+		return m_send.write(_buffers, _count, SendTimeoutMs);
+	}
+
+	bool SharedMemoryTransport::receive(CommandReader& _reader, const uint32_t _timeoutMs)
+	{
+		bool received = false;
+
+		uint32_t size;
+
+		while(auto* data = m_receive.peek(size, received ? 0 : _timeoutMs))
+		{
+			// a message contains exactly one command, it is parsed in place
+			_reader.read(data, size);
+			m_receive.pop();
+			received = true;
+		}
+
+		return received;
+	}
+
+	void SharedMemoryTransport::close()
+	{
+		m_send.close();
+		m_receive.close();
+
+		// every teardown path closes the transport, the segment must not outlive the connection
+		unlink();
+	}
+
+	bool SharedMemoryTransport::init(const bool _create)
+	{
+		auto* header = reinterpret_cast<Header*>(m_memory.getData());
+
+		auto* dataClientToServer = m_memory.getData() + sizeof(Header);
+		auto* dataServerToClient = dataClientToServer + g_ringCapacity;
+
+		const auto& name = m_memory.getName();
+
+		// the client creates the segment and writes to the first ring, the server opens it and writes to the second one
+		if(_create)
+		{
+			return m_send.init(&header->clientToServer, dataClientToServer, g_ringCapacity, name + "_cs", true)
+				&& m_receive.init(&header->serverToClient, dataServerToClient, g_ringCapacity, name + "_sc", true);
+		}
+
+		return m_send.init(&header->serverToClient, dataServerToClient, g_ringCapacity, name + "_sc", false)
+			&& m_receive.init(&header->clientToServer, dataClientToServer, g_ringCapacity, name + "_cs", false);
+	}
+}
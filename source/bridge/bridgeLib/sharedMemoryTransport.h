@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "sharedMemory.h"
+#include "sharedMemoryRing.h"
+
+namespace bridgeLib
+{
+	class CommandReader;
+
+	// Local transport for client and server on the same host. Commands are exchanged via two shared memory rings
+	// in the same format as via TCP. The client creates the segment and sends its name and key in the PluginDesc,
+	// the server opens it and confirms via ServerInfo. Sockets are used for everything else
+	class SharedMemoryTransport
+	{
+	public:
+		static constexpr uint32_t SendTimeoutMs = 1000;
+
+		~SharedMemoryTransport();
+
+		SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+		SharedMemoryTransport(SharedMemoryTransport&&) = delete;
+		SharedMemoryTransport& operator = (const SharedMemoryTransport&) = delete;
+		SharedMemoryTransport& operator = (SharedMemoryTransport&&) = delete;
+
+		static bool isSupported();
+
+		// client, returns nullptr if not supported on this platform or if creation failed
+		static std::unique_ptr<SharedMemoryTransport> create();
+
+		// server, returns nullptr if the segment does not exist on this host or if the key does not match
+		static std::unique_ptr<SharedMemoryTransport> open(const std::string& _name, uint64_t _key);
+
+		const std::string& getName() const { return m_memory.getName(); }
+		uint64_t getKey() const { return m_key; }
+
+		// called once both sides have mapped the segment and by close(), the segment cannot be opened anymore afterwards
+		void unlink() { m_memory.unlink(); }
+
+		uint32_t getMaxMessageSize() const { return m_send.getMaxMessageSize(); }
+
+		bool send(const SharedMemoryRing::Buffer* _buffers, size_t _count);
+
+		// passes all received commands to the reader, waits up to _timeoutMs for the first one. Returns false if no command has been received
+		bool receive(CommandReader& _reader, uint32_t _timeoutMs);
+
+		void close();
+		bool isClosed() const { return m_receive.isClosed(); }
+
+	private:
+		struct Header;
+
+		SharedMemoryTransport() = default;
+
+		bool init(bool _create);
+
+		SharedMemory m_memory;
+		SharedMemoryRing m_send;
+		SharedMemoryRing m_receive;
+		uint64_t m_key = 0;
+	};
+}
@@ -1,18 +1,22 @@
 #include "tcpConnection.h"
 
 #include "audioBuffers.h"
+#include "sharedMemoryTransport.h"
+
 #include "networkLib/exception.h"
 #include "networkLib/logging.h"
+#include "networkLib/reactor.h"
 
 #include "synthLib/midiTypes.h"
 
 namespace bridgeLib
 {
-	TcpConnection::TcpConnection(std::unique_ptr<networkLib::TcpStream>&& _stream) : CommandReader(nullptr), m_stream(std::move(_stream))
+	TcpConnection::TcpConnection(std::unique_ptr<networkLib::TcpStream>&& _stream, std::shared_ptr<networkLib::Reactor> _reactor)
+		: CommandReader(nullptr)
+		, m_reactor(_reactor ? std::move(_reactor) : networkLib::Reactor::getShared())
+		, m_session(m_reactor->createSession(std::move(_stream)))
 	{
 		m_audioTransferBuffer.reserve(16384);
-
-		start();
 	}
 
 	TcpConnection::~TcpConnection()
@@ -43,35 +47,48 @@ namespace bridgeLib
 		}
 	}
 
-	void TcpConnection::threadFunc()
+	size_t TcpConnection::onReceive(uint8_t* _data, const size_t _size)
 	{
-		try
-		{
-			NetworkThread::threadFunc();
-		}
-		catch (const networkLib::NetException& e)
-		{
-			m_stream->close();
-			LOGNET(networkLib::LogLevel::Warning, "Network Exception, code " << e.type() << ": " << e.what());
-			handleException(e);
-		}
+		return read(_data, _size);
 	}
 
-	void TcpConnection::threadLoopFunc()
+	void TcpConnection::onClosed(const networkLib::NetException& _e)
 	{
-		read(*m_stream);
+		LOGNET(networkLib::LogLevel::Warning, "Network Exception, code " << _e.type() << ": " << _e.what());
+		handleException(_e);
+	}
+
+	void TcpConnection::write()
+	{
+		if(!m_session)
+			return;
+
+		// commands that do not fit into the ring are rare (large sysex), they take the TCP path
+		if(m_sharedMemoryActive && isSharedMemoryCommand(m_writer.getCommand()) && m_writer.getSize() <= m_sharedMemory->getMaxMessageSize())
+		{
+			if(!m_writer.write(*m_sharedMemory))
+			{
+				LOGNET(networkLib::LogLevel::Error, "Failed to send via shared memory, closing connection");
+				close();
+			}
+			return;
+		}
+
+		m_writer.write(*m_session);
 	}
 
 	void TcpConnection::send(const Command _command, const CommandStruct& _data)
 	{
+		std::scoped_lock lock(m_mutexWrite);
 		m_writer.build(_command, _data);
-		m_writer.write(*m_stream);
+		write();
 	}
 
 	void TcpConnection::send(Command _command)
 	{
+		std::scoped_lock lock(m_mutexWrite);
 		m_writer.build(_command);
-		m_writer.write(*m_stream);
+		write();
 	}
 
 	void TcpConnection::handleMidi(baseLib::BinaryStream& _in)
@@ -88,6 +105,8 @@ namespace bridgeLib
 
 	void TcpConnection::sendAudio(const float* const* _data, const uint32_t _numChannels, const uint32_t _numSamplesPerChannel)
 	{
+		std::scoped_lock lock(m_mutexWrite);
+
 		auto& s = m_writer.build(Command::Audio);
 		s.write(static_cast<uint8_t>(_numChannels));
 		s.write(_numSamplesPerChannel);
@@ -105,11 +124,13 @@ namespace bridgeLib
 				s.write(0);
 			}
 		}
-		send();
+		write();
 	}
 
 	void TcpConnection::sendAudio(AudioBuffers& _buffers, const uint32_t _numChannels, uint32_t _numSamplesPerChannel)
 	{
+		std::scoped_lock lock(m_mutexWrite);
+
 		auto& s = m_writer.build(Command::Audio);
 		s.write(static_cast<uint8_t>(_numChannels));
 		s.write(_numSamplesPerChannel);
@@ -126,7 +147,7 @@ namespace bridgeLib
 
 		_buffers.onInputRead(_numSamplesPerChannel);
 
-		send();
+		write();
 	}
 
 	uint32_t TcpConnection::handleAudio(float* const* _output, baseLib::BinaryStream& _in)
@@ -192,6 +213,7 @@ namespace bridgeLib
 	{
 		if(!isValid())
 			return false;
+		std::scoped_lock lock(m_mutexWrite);
 		auto& bs = m_writer.build(Command::Midi);
 		bs.write(_ev.a);
 		bs.write(_ev.b);
@@ -199,20 +221,68 @@ namespace bridgeLib
 		bs.write(_ev.sysex);
 		bs.write(_ev.offset);
 		bs.write<uint8_t>(static_cast<uint8_t>(_ev.source));
-		send();
+		write();
 		return true;
 	}
 
+	void TcpConnection::start()
+	{
+		if(m_session)
+			m_session->start(*this);
+	}
+
 	void TcpConnection::close() const
 	{
-		if(m_stream)
-			m_stream->close();
+		if(m_session)
+			m_session->close();
+	}
+
+	void TcpConnection::closeWhenSent() const
+	{
+		if(m_session)
+			m_session->closeWhenSent();
+	}
+
+	void TcpConnection::setSharedMemory(std::unique_ptr<SharedMemoryTransport> _transport)
+	{
+		std::scoped_lock lock(m_mutexWrite);
+		m_sharedMemoryActive = false;
+		m_sharedMemory = std::move(_transport);
+	}
+
+	void TcpConnection::setSharedMemoryActive(const bool _active)
+	{
+		std::scoped_lock lock(m_mutexWrite);
+
+		if(_active && m_sharedMemory)
+		{
+			m_sharedMemoryActive = true;
+			return;
+		}
+
+		assert(!m_sharedMemoryActive && "an active transport may be in use by another thread");
+		m_sharedMemory.reset();
+	}
+
+	bool TcpConnection::receiveSharedMemory(const uint32_t _timeoutMs)
+	{
+		if(!m_sharedMemoryActive)
+			return false;
+		return m_sharedMemory->receive(*this, _timeoutMs);
 	}
 
 	void TcpConnection::shutdown()
 	{
-		close();
-		stop();
-		m_stream.reset();
+		// wakes up threads that wait for shared memory, the transport itself is destroyed with the connection
+		if(m_sharedMemory)
+			m_sharedMemory->close();
+
+		if(!m_session)
+			return;
+
+		// waits for a handler that might currently run on a reactor worker thread
+		m_session->detach();
+		m_session->close();
+		m_session.reset();
 	}
 }
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "commandReader.h"
 #include "commandWriter.h"
 
-#include "networkLib/networkThread.h"
+#include "networkLib/tcpSession.h"
 #include "networkLib/tcpStream.h"
 #include "synthLib/deviceTypes.h"
 
@@ -17,29 +20,28 @@ namespace synthLib
 namespace networkLib
 {
 	class NetException;
+	class Reactor;
 }
 
 namespace bridgeLib
 {
 	class AudioBuffers;
+	class SharedMemoryTransport;
 
-	class TcpConnection : CommandReader, protected networkLib::NetworkThread
+	// Commands are received via a networkLib::Reactor and handled on one of its worker threads. If no reactor
+	// is specified, the process wide shared reactor is used.
+	// If a shared memory transport is active, audio and midi are exchanged via shared memory instead, received
+	// commands are handled on the thread that calls receiveSharedMemory()
+	class TcpConnection : CommandReader, networkLib::TcpSession::Handler
 	{
 	public:
-		TcpConnection(std::unique_ptr<networkLib::TcpStream>&& _stream);
+		TcpConnection(std::unique_ptr<networkLib::TcpStream>&& _stream, std::shared_ptr<networkLib::Reactor> _reactor = {});
 		~TcpConnection() override;
 
-		bool isValid() const { return m_stream && m_stream->isValid(); }
+		bool isValid() const { return m_session && m_session->isValid(); }
 
 		void handleCommand(bridgeLib::Command _command, baseLib::BinaryStream& _in) override;
-		void threadFunc() override;
-		void threadLoopFunc() override;
 
-		auto& writer() { return m_writer; }
-		void send()
-		{
-			m_writer.write(*m_stream);
-		}
 		void send(Command _command, const CommandStruct& _data);
 		void send(Command _command);
 
@@ -91,13 +93,45 @@ namespace bridgeLib
 		}
 
 		virtual void handleException(const networkLib::NetException& _e) = 0;
+
+		// starts receiving commands, to be called by the derived class once it is fully constructed
+		void start();
 		void close() const;
+		void closeWhenSent() const;	// lets an error message reach the peer before the connection is closed
 		void shutdown();
 
+		// SHARED MEMORY
+		void setSharedMemory(std::unique_ptr<SharedMemoryTransport> _transport);
+		SharedMemoryTransport* getSharedMemory() const { return m_sharedMemory.get(); }
+
+		// once active, audio and midi are sent via shared memory. Deactivating releases the transport, it cannot be activated again
+		void setSharedMemoryActive(bool _active);
+		bool isSharedMemoryActive() const { return m_sharedMemoryActive; }
+
+		// handles commands that arrived via shared memory, waits up to _timeoutMs for the first one. Returns false if nothing arrived
+		bool receiveSharedMemory(uint32_t _timeoutMs);
+
+		static bool isSharedMemoryCommand(const Command _command)
+		{
+			return _command == Command::Audio || _command == Command::Midi;
+		}
+
 	private:
-		std::unique_ptr<networkLib::TcpStream> m_stream;
+		size_t onReceive(uint8_t* _data, size_t _size) override;
+		void onClosed(const networkLib::NetException& _e) override;
+
+		// sends the command that has been built with m_writer, m_mutexWrite needs to be locked
+		void write();
+
+		std::shared_ptr<networkLib::Reactor> m_reactor;
+		std::shared_ptr<networkLib::TcpSession> m_session;
+
+		std::mutex m_mutexWrite;
 		CommandWriter m_writer;
 
+		std::unique_ptr<SharedMemoryTransport> m_sharedMemory;
+		std::atomic<bool> m_sharedMemoryActive{false};
+
 		synthLib::SMidiEvent m_midiEvent;	// preallocated for receiver
 
 		std::vector<float> m_audioTransferBuffer;
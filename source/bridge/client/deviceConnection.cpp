@@ -1,6 +1,7 @@
 #include "deviceConnection.h"
 
 #include "remoteDevice.h"
+#include "bridgeLib/sharedMemoryTransport.h"
 #include "dsp56kEmu/logging.h"
 #include "networkLib/logging.h"
 
@@ -12,8 +13,21 @@ namespace bridgeClient
 	{
 		m_handleReplyFunc = [](bridgeLib::Command, baseLib::BinaryStream&){};
 
+		// offer a shared memory transport. It can only be opened by a server that runs on the same host
+		setSharedMemory(bridgeLib::SharedMemoryTransport::create());
+
+		start();
+
+		auto pluginDesc = m_device.getPluginDesc();
+
+		if(const auto* sharedMemory = getSharedMemory())
+		{
+			pluginDesc.sharedMemoryName = sharedMemory->getName();
+			pluginDesc.sharedMemoryKey = sharedMemory->getKey();
+		}
+
 		// send plugin description and device creation parameters, this will cause the server to either boot the device or ask for the rom if it doesn't have it yet
-		send(bridgeLib::Command::PluginInfo, m_device.getPluginDesc());
+		send(bridgeLib::Command::PluginInfo, pluginDesc);
 
 		// do not send rom data now but only if the server asks for it
 		sendDeviceCreateParams(false);
@@ -37,6 +51,22 @@ namespace bridgeClient
 		}
 	}
 
+	void DeviceConnection::handleData(const bridgeLib::ServerInfo& _info)
+	{
+		// answer to our plugin description, the server either uses the shared memory or it does not
+		auto* sharedMemory = getSharedMemory();
+
+		if(!sharedMemory || isSharedMemoryActive())
+			return;
+
+		sharedMemory->unlink();
+
+		if(_info.sharedMemory)
+			LOGNET(networkLib::LogLevel::Info, "Server runs on the same host, using shared memory transport for audio and midi");
+
+		setSharedMemoryActive(_info.sharedMemory);
+	}
+
 	void DeviceConnection::handleData(const bridgeLib::DeviceDesc& _desc)
 	{
 		m_deviceDesc = _desc;
@@ -67,6 +97,9 @@ namespace bridgeClient
 	{
 		m_audioBuffers.writeInput(_inputs, _size);
 
+		if(isSharedMemoryActive())
+			return processAudioSharedMemory(_outputs, _size, _latency);
+
 		std::unique_lock lock(m_cvWaitMutex);
 
 		const auto haveEnoughOutput = m_audioBuffers.getOutputSize() >= _size;
@@ -105,6 +138,34 @@ namespace bridgeClient
 		return true;
 	}
 
+	bool DeviceConnection::processAudioSharedMemory(const synthLib::TAudioOutputs& _outputs, const uint32_t _size, const uint32_t _latency)
+	{
+		// replies are received on the audio thread itself, there is no lock and no thread switch involved
+		receiveSharedMemory(0);
+
+		const auto haveEnoughOutput = m_audioBuffers.getOutputSize() >= _size;
+
+		m_audioBuffers.setLatency(_latency, haveEnoughOutput ? 0 : _size);
+
+		const auto sendSize = m_audioBuffers.getInputSize();
+
+		if(sendSize > 0)
+			sendAudio(m_audioBuffers, m_device.getChannelCountIn(), sendSize);
+
+		while(m_audioBuffers.getOutputSize() < _size)
+		{
+			if(!receiveSharedMemory(g_replyTimeoutSecs * 1000))
+			{
+				LOG("Receive timeout, closing connection");
+				close();
+				return false;
+			}
+		}
+
+		m_audioBuffers.readOutput(_outputs, _size);
+		return true;
+	}
+
 	void DeviceConnection::handleAudio(baseLib::BinaryStream& _in)
 	{
 		{
@@ -117,11 +178,13 @@ namespace bridgeClient
 
 	void DeviceConnection::handleMidi(const synthLib::SMidiEvent& _e)
 	{
+		std::scoped_lock lock(m_midiOutMutex);
 		m_midiOut.push_back(_e);
 	}
 
 	void DeviceConnection::readMidiOut(std::vector<synthLib::SMidiEvent>& _midiOut)
 	{
+		std::scoped_lock lock(m_midiOutMutex);
 		_midiOut.insert(_midiOut.end(), m_midiOut.begin(), m_midiOut.end());
 		m_midiOut.clear();
 	}
@@ -21,6 +21,7 @@ namespace bridgeClient
 
 		void handleCommand(bridgeLib::Command _command, baseLib::BinaryStream& _in) override;
 
+		void handleData(const bridgeLib::ServerInfo& _info) override;
 		void handleData(const bridgeLib::DeviceDesc& _desc) override;
 		void handleDeviceInfo(baseLib::BinaryStream& _in) override;
 
@@ -47,6 +48,8 @@ namespace bridgeClient
 		void setDspClockPercent(uint32_t _percent);
 
 	private:
+		bool processAudioSharedMemory(const synthLib::TAudioOutputs& _outputs, uint32_t _size, uint32_t _latency);
+
 		bool sendAwaitReply(const std::function<void()>& _send, const std::function<void(baseLib::BinaryStream&)>& _reply, bridgeLib::Command _replyCommand);
 
 		RemoteDevice& m_device;
@@ -57,6 +60,7 @@ namespace bridgeClient
 		std::mutex m_cvWaitMutex;
 		std::condition_variable m_cvWait;
 
+		std::mutex m_midiOutMutex;
 		std::vector<synthLib::SMidiEvent> m_midiOut;
 
 		bridgeLib::AudioBuffers m_audioBuffers;
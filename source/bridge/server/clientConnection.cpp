@@ -2,14 +2,16 @@
 
 #include "server.h"
 #include "bridgeLib/error.h"
+#include "bridgeLib/sharedMemoryTransport.h"
 #include "networkLib/logging.h"
 
 namespace bridgeServer
 {
 	static constexpr uint32_t g_audioBufferSize = 16384;
+	static constexpr uint32_t g_sharedMemoryPollMs = 100;
 
 	ClientConnection::ClientConnection(Server& _server, std::unique_ptr<networkLib::TcpStream>&& _stream, std::string _name)
-		: TcpConnection(std::move(_stream))
+		: TcpConnection(std::move(_stream), _server.getReactor())
 		, m_server(_server)
 		, m_name(std::move(_name))
 	{
@@ -31,16 +33,22 @@ namespace bridgeServer
 		m_midiOut.reserve(4096);
 
 		getDeviceState().state.reserve(8 * 1024 * 1024);
+
+		start();
 	}
 
 	ClientConnection::~ClientConnection()
 	{
+		closeSharedMemory();
 		shutdown();
 		destroyDevice();
+
+		m_server.getThreadPlacement().release(m_threadPlacementSlot);
 	}
 
 	void ClientConnection::handleMidi(const synthLib::SMidiEvent& _e)
 	{
+		std::scoped_lock lock(m_mutexMidiIn);
 		m_midiIn.push_back(_e);
 	}
 
@@ -49,6 +57,16 @@ namespace bridgeServer
 		m_pluginDesc = _desc;
 		LOGNET(networkLib::LogLevel::Info, "Client " << m_name << " identified as plugin " << _desc.pluginName << ", version " << _desc.pluginVersion);
 		m_name = m_pluginDesc.pluginName + '-' + m_name;
+
+		if(!m_threadPlacementSlot.isValid())
+		{
+			m_threadPlacementSlot = m_server.getThreadPlacement().acquire();
+
+			if(m_threadPlacementSlot.isValid())
+				LOGNET(networkLib::LogLevel::Info, m_name << ": Placing device threads on NUMA node " << m_threadPlacementSlot.node << ", " << m_threadPlacementSlot.cpus.size() << " CPUs");
+		}
+
+		openSharedMemory();
 		createDevice();
 	}
 
@@ -107,6 +125,8 @@ namespace bridgeServer
 
 	void ClientConnection::handleAudio(baseLib::BinaryStream& _in)
 	{
+		std::scoped_lock lockDevice(m_mutexDevice);
+
 		if(!m_device)
 		{
 			errorClose(bridgeLib::ErrorCode::UnexpectedCommand, "Audio data without valid device");
@@ -115,6 +135,8 @@ namespace bridgeServer
 
 		const auto numSamples = TcpConnection::handleAudio(const_cast<float* const*>(m_audioInputs.data()), _in);
 
+		std::scoped_lock lock(m_mutexMidiIn);
+
 		m_device->process(m_audioInputs, m_audioOutputs, numSamples, m_midiIn, m_midiOut);
 
 		for (const auto& midiOut : m_midiOut)
@@ -129,10 +151,13 @@ namespace bridgeServer
 
 	void ClientConnection::sendDeviceState(const synthLib::StateType _type)
 	{
+		// same order as in handleDeviceState, which locks the state first and the device in the handler
+		std::scoped_lock lock(m_mutexDeviceState);
+		std::scoped_lock lockDevice(m_mutexDevice);
+
 		if(!m_device)
 			return;
 
-		std::scoped_lock lock(m_mutexDeviceState);
 		auto& state = getDeviceState();
 		state.type = _type;
 
@@ -142,12 +167,26 @@ namespace bridgeServer
 		send(bridgeLib::Command::DeviceState, state);
 	}
 
-	void ClientConnection::handleRequestDeviceState(bridgeLib::RequestDeviceState& _requestDeviceState)
+	void ClientConnection::logMetrics()
 	{
+		std::scoped_lock lock(m_mutexDevice);
+
 		if(!m_device)
-		{
-			errorClose(bridgeLib::ErrorCode::UnexpectedCommand, "Device state request without valid device");
 			return;
+
+		LOGNET(networkLib::LogLevel::Info, m_name << ": " << m_device->getMetrics().getSnapshot().toString());
+	}
+
+	void ClientConnection::handleRequestDeviceState(bridgeLib::RequestDeviceState& _requestDeviceState)
+	{
+		{
+			std::scoped_lock lock(m_mutexDevice);
+
+			if(!m_device)
+			{
+				errorClose(bridgeLib::ErrorCode::UnexpectedCommand, "Device state request without valid device");
+				return;
+			}
 		}
 
 		sendDeviceState(_requestDeviceState.type);
@@ -155,6 +194,8 @@ namespace bridgeServer
 
 	void ClientConnection::handleDeviceState(bridgeLib::DeviceState& _in)
 	{
+		std::scoped_lock lock(m_mutexDevice);
+
 		if(!m_device)
 		{
 			errorClose(bridgeLib::ErrorCode::UnexpectedCommand, "Device state without valid device");
@@ -173,12 +214,13 @@ namespace bridgeServer
 
 	void ClientConnection::handleException(const networkLib::NetException& _e)
 	{
-		exit(true);
 		m_server.onClientException(*this, _e);
 	}
 
 	void ClientConnection::handleData(const bridgeLib::SetSamplerate& _params)
 	{
+		std::scoped_lock lock(m_mutexDevice);
+
 		if(!m_device)
 		{
 			errorClose(bridgeLib::ErrorCode::UnexpectedCommand, "Set samplerate request without valid device");
@@ -191,6 +233,8 @@ namespace bridgeServer
 
 	void ClientConnection::handleData(const bridgeLib::SetDspClockPercent& _params)
 	{
+		std::scoped_lock lock(m_mutexDevice);
+
 		if(!m_device)
 		{
 			errorClose(bridgeLib::ErrorCode::UnexpectedCommand, "Set DSP clock request without valid device");
@@ -203,6 +247,8 @@ namespace bridgeServer
 
 	void ClientConnection::handleData(const bridgeLib::SetUnknownCustomData& _params)
 	{
+		std::scoped_lock lock(m_mutexDevice);
+
 		if(!m_device)
 		{
 			errorClose(bridgeLib::ErrorCode::UnexpectedCommand, "Set custom data request without valid device");
@@ -239,7 +285,13 @@ namespace bridgeServer
 		if(m_pluginDesc.pluginVersion == 0 || m_deviceCreateParams.romData.empty())
 			return;
 
-		m_device = m_server.getPlugins().createDevice(m_deviceCreateParams, m_pluginDesc);
+		std::scoped_lock lock(m_mutexDevice);
+
+		{
+			// all threads that the device creates inherit the placement, memory is allocated on the node of the device
+			const synthLib::ThreadPlacement::ScopedSlot placement(m_threadPlacementSlot);
+			m_device = m_server.getPlugins().createDevice(m_deviceCreateParams, m_pluginDesc);
+		}
 
 		if(!m_device)
 		{
@@ -265,16 +317,68 @@ namespace bridgeServer
 
 	void ClientConnection::destroyDevice()
 	{
+		if(isValid())
+			sendDeviceState(synthLib::StateTypeGlobal);
+
+		std::scoped_lock lock(m_mutexDevice);
+
 		if(!m_device)
 			return;
 
-		if(isValid())
-		sendDeviceState(synthLib::StateTypeGlobal);
-
 		m_server.getPlugins().destroyDevice(m_pluginDesc, m_device);
 		m_device = nullptr;
 	}
 
+	void ClientConnection::openSharedMemory()
+	{
+		if(m_pluginDesc.sharedMemoryName.empty() || getSharedMemory())
+			return;
+
+		// only succeeds if the client runs on the same host
+		setSharedMemory(bridgeLib::SharedMemoryTransport::open(m_pluginDesc.sharedMemoryName, m_pluginDesc.sharedMemoryKey));
+		setSharedMemoryActive(getSharedMemory() != nullptr);
+
+		bridgeLib::ServerInfo si;
+		si.protocolVersion = bridgeLib::g_protocolVersion;
+		si.portTcp = bridgeLib::g_tcpServerPort;
+		si.portUdp = bridgeLib::g_udpServerPort;
+		si.sharedMemory = isSharedMemoryActive();
+
+		send(bridgeLib::Command::ServerInfo, si);
+
+		if(!si.sharedMemory)
+			return;
+
+		LOGNET(networkLib::LogLevel::Info, m_name << ": Client runs on the same host, using shared memory transport for audio and midi");
+
+		m_sharedMemoryThread.reset(new std::thread([this]
+		{
+			sharedMemoryThreadFunc();
+		}));
+	}
+
+	void ClientConnection::closeSharedMemory()
+	{
+		if(!m_sharedMemoryThread)
+			return;
+
+		m_sharedMemoryExit = true;
+		getSharedMemory()->close();
+
+		m_sharedMemoryThread->join();
+		m_sharedMemoryThread.reset();
+	}
+
+	void ClientConnection::sharedMemoryThreadFunc()
+	{
+		// this thread processes the audio of the device, keep it close to the device threads
+		if(m_threadPlacementSlot.isValid())
+			synthLib::ThreadPlacement::setCurrentThreadCpus(m_threadPlacementSlot.cpus);
+
+		while(!m_sharedMemoryExit && !getSharedMemory()->isClosed())
+			receiveSharedMemory(g_sharedMemoryPollMs);
+	}
+
 	void ClientConnection::errorClose(const bridgeLib::ErrorCode _code, const std::string& _err)
 	{
 		LOGNET(networkLib::LogLevel::Error, m_name + ": " + _err);
@@ -284,7 +388,8 @@ namespace bridgeServer
 		err.msg = _err;
 
 		send(bridgeLib::Command::Error, err);
-		std::this_thread::sleep_for(std::chrono::seconds(1));
-		close();
+
+		// do not block the reactor worker, the session is closed as soon as the error has been sent
+		closeWhenSent();
 	}
 }
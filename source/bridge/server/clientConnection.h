@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <mutex>
+#include <thread>
 
 #include "bridgeLib/tcpConnection.h"
-#include "networkLib/networkThread.h"
 #include "networkLib/tcpStream.h"
 #include "synthLib/device.h"
+#include "synthLib/threadPlacement.h"
 
 namespace bridgeServer
 {
@@ -26,6 +28,7 @@ namespace bridgeServer
 
 		void handleAudio(baseLib::BinaryStream& _in) override;
 		void sendDeviceState(synthLib::StateType _type);
+		void logMetrics();
 		void handleRequestDeviceState(bridgeLib::RequestDeviceState& _requestDeviceState) override;
 		void handleDeviceState(bridgeLib::DeviceState& _in) override;
 		void handleDeviceState(baseLib::BinaryStream& _in) override;
@@ -34,10 +37,14 @@ namespace bridgeServer
 		const auto& getPluginDesc() const { return m_pluginDesc; }
 
 	private:
-		void sendDeviceInfo();
+		void sendDeviceInfo();	// m_mutexDevice has to be locked
 		void createDevice();
 		void destroyDevice();
 
+		void openSharedMemory();
+		void closeSharedMemory();
+		void sharedMemoryThreadFunc();
+
 		void errorClose(bridgeLib::ErrorCode _code, const std::string& _err);
 
 		Server& m_server;
@@ -46,18 +53,26 @@ namespace bridgeServer
 		bridgeLib::PluginDesc m_pluginDesc;
 		synthLib::DeviceCreateParams m_deviceCreateParams;
 
+		// Audio is processed by the shared memory thread while control commands are handled by reactor workers. Every
+		// access to the device, including replacing it, has to lock this mutex
+		std::mutex m_mutexDevice;
 		synthLib::Device* m_device = nullptr;
+		synthLib::ThreadPlacement::Slot m_threadPlacementSlot;
 
 		synthLib::TAudioInputs m_audioInputs;
 		synthLib::TAudioOutputs m_audioOutputs;
 
 		std::array<std::vector<float>, std::tuple_size_v<synthLib::TAudioInputs>> m_audioInputBuffers;
 		std::array<std::vector<float>, std::tuple_size_v<synthLib::TAudioOutputs>> m_audioOutputBuffers;
+		std::mutex m_mutexMidiIn;	// midi may arrive via TCP and via shared memory
 		std::vector<synthLib::SMidiEvent> m_midiIn;
 		std::vector<synthLib::SMidiEvent> m_midiOut;
 
 		bool m_romRequested = false;
 
 		std::mutex m_mutexDeviceState;
+
+		std::unique_ptr<std::thread> m_sharedMemoryThread;
+		std::atomic<bool> m_sharedMemoryExit{false};
 	};
 }
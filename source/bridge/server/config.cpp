@@ -12,6 +12,10 @@ namespace bridgeServer
 		: portTcp(bridgeLib::g_tcpServerPort)
 		, portUdp(bridgeLib::g_udpServerPort)
 		, deviceStateRefreshMinutes(3)
+		, metricsLogMinutes(5)
+		, networkWorkerThreads(0)
+		, threadPlacement("off")
+		, threadPlacementCores(2)
 		, pluginsPath(getDefaultDataPath() + "plugins/")
 		, romsPath(getDefaultDataPath() + "roms/")
 	{
@@ -29,6 +33,10 @@ namespace bridgeServer
 		portTcp = config.getInt("tcpPort", static_cast<int>(portTcp));
 		portUdp = config.getInt("tcpPort", static_cast<int>(portUdp));
 		deviceStateRefreshMinutes = config.getInt("deviceStateRefreshMinutes", static_cast<int>(deviceStateRefreshMinutes));
+		metricsLogMinutes = config.getInt("metricsLogMinutes", static_cast<int>(metricsLogMinutes));
+		networkWorkerThreads = config.getInt("networkWorkerThreads", static_cast<int>(networkWorkerThreads));
+		threadPlacement = config.get("threadPlacement", threadPlacement);
+		threadPlacementCores = config.getInt("threadPlacementCores", static_cast<int>(threadPlacementCores));
 		pluginsPath = config.get("pluginsPath", pluginsPath);
 		romsPath = config.get("romsPath", romsPath);
 
@@ -12,6 +12,10 @@ namespace bridgeServer
 		uint32_t portTcp;
 		uint32_t portUdp;
 		uint32_t deviceStateRefreshMinutes;
+		uint32_t metricsLogMinutes;		// 0 = disabled
+		uint32_t networkWorkerThreads;	// 0 = one per hardware thread
+		std::string threadPlacement;	// off, node or cores, see synthLib::ThreadPlacement
+		uint32_t threadPlacementCores;	// physical cores per device if thread placement is "cores"
 		std::string pluginsPath;
 		std::string romsPath;
 
@@ -11,10 +11,15 @@ namespace bridgeServer
 		: m_config(_argc, _argv)
 		, m_plugins(m_config)
 		, m_romPool(m_config)
+		, m_threadPlacement(synthLib::ThreadPlacement::parseMode(m_config.threadPlacement), m_config.threadPlacementCores)
+		, m_reactor(std::make_shared<networkLib::Reactor>(m_config.networkWorkerThreads))
 		, m_tcpServer([this](std::unique_ptr<networkLib::TcpStream> _stream){onClientConnected(std::move(_stream));}
 		, bridgeLib::g_tcpServerPort)
 		, m_lastDeviceStateUpdate(std::chrono::system_clock::now())
+		, m_lastMetricsLog(std::chrono::system_clock::now())
 	{
+		if(m_threadPlacement.getMode() != synthLib::ThreadPlacement::Mode::Off)
+			LOGNET(networkLib::LogLevel::Info, "Thread placement mode " << synthLib::ThreadPlacement::toString(m_threadPlacement.getMode()) << ", " << synthLib::ThreadPlacement::getNodeCount() << " NUMA nodes");
 	}
 
 	Server::~Server()
@@ -33,6 +38,7 @@ namespace bridgeServer
 
 			cleanupClients();
 			doPeriodicDeviceStateUpdate();
+			doPeriodicMetricsLog();
 		}
 	}
 
@@ -110,4 +116,24 @@ namespace bridgeServer
 		for (const auto& c : m_clients)
 			c->sendDeviceState(synthLib::StateTypeGlobal);
 	}
+
+	void Server::doPeriodicMetricsLog()
+	{
+		if(!m_config.metricsLogMinutes)
+			return;
+
+		std::scoped_lock lock(m_mutexClients);
+
+		const auto now = std::chrono::system_clock::now();
+
+		const auto diff = std::chrono::duration_cast<std::chrono::minutes>(now - m_lastMetricsLog);
+
+		if(diff.count() < static_cast<int>(m_config.metricsLogMinutes))
+			return;
+
+		m_lastMetricsLog = now;
+
+		for (const auto& c : m_clients)
+			c->logMetrics();
+	}
 }
@@ -9,7 +9,9 @@
 #include "import.h"
 #include "romPool.h"
 #include "udpServer.h"
+#include "networkLib/reactor.h"
 #include "networkLib/tcpServer.h"
+#include "synthLib/threadPlacement.h"
 
 namespace bridgeServer
 {
@@ -27,18 +29,24 @@ namespace bridgeServer
 		void exit(bool _exit);
 
 		auto& getPlugins() { return m_plugins; }
+		const auto& getReactor() const { return m_reactor; }
 		auto& getRomPool() { return m_romPool; }
+		auto& getThreadPlacement() { return m_threadPlacement; }
 
 		bridgeLib::DeviceState getCachedDeviceState(const bridgeLib::SessionId& _id);
 
 	private:
 		void cleanupClients();
 		void doPeriodicDeviceStateUpdate();
+		void doPeriodicMetricsLog();
 
 		Config m_config;
 
 		Import m_plugins;
 		RomPool m_romPool;
+		synthLib::ThreadPlacement m_threadPlacement;
+
+		std::shared_ptr<networkLib::Reactor> m_reactor;
 
 		UdpServer m_udpServer;
 		networkLib::TcpServer m_tcpServer;
@@ -52,5 +60,6 @@ namespace bridgeServer
 		std::mutex m_cvWaitMutex;
 		std::condition_variable m_cvWait;
 		std::chrono::system_clock::time_point m_lastDeviceStateUpdate;
+		std::chrono::system_clock::time_point m_lastMetricsLog;
 	};
 }
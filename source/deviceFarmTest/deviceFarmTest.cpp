@@ -0,0 +1,209 @@
+#include <array>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "synthLib/deviceFarm.h"
+
+// Checks that every member of a device farm receives the audio of its own part only, see synthLib::DeviceFarm
+
+namespace
+{
+	constexpr uint8_t g_partCount = 16;
+	constexpr uint32_t g_pairCount = 2;
+	constexpr size_t g_blockSize = 64;
+
+	// Multitimbral device with two stereo output pairs. Every part that holds a note outputs a constant level of
+	// part + 1 on the pair that it is routed to. All parts are routed to the first pair until they are routed elsewhere
+	class TestDevice : public synthLib::Device
+	{
+	public:
+		TestDevice(const synthLib::DeviceCreateParams& _params, const bool _canRoute) : Device(_params), m_canRoute(_canRoute)
+		{
+		}
+
+		float getSamplerate() const override { return 44100.0f; }
+		bool isValid() const override { return true; }
+
+#if SYNTHLIB_DEMO_MODE == 0
+		bool getState(std::vector<uint8_t>&, synthLib::StateType) override { return false; }
+		bool setState(const std::vector<uint8_t>&, synthLib::StateType) override { return false; }
+#endif
+
+		uint32_t getChannelCountIn() override { return 0; }
+		uint32_t getChannelCountOut() override { return g_pairCount * 2; }
+
+		bool setDspClockPercent(uint32_t) override { return false; }
+		uint32_t getDspClockPercent() const override { return 100; }
+		uint64_t getDspClockHz() const override { return 0; }
+
+		bool setPartOutput(const uint8_t _part, const uint32_t _outputPair) override
+		{
+			if(!m_canRoute || _part >= g_partCount || _outputPair >= g_pairCount)
+				return false;
+			m_partOutputs[_part] = _outputPair;
+			return true;
+		}
+
+	protected:
+		void readMidiOut(std::vector<synthLib::SMidiEvent>&) override {}
+
+		void processAudio(const synthLib::TAudioInputs&, const synthLib::TAudioOutputs& _outputs, const size_t _samples) override
+		{
+			for(uint32_t pair=0; pair<g_pairCount; ++pair)
+			{
+				float level = 0.0f;
+
+				for(uint8_t p=0; p<g_partCount; ++p)
+				{
+					if(m_notes[p] && m_partOutputs[p] == pair)
+						level += static_cast<float>(p + 1);
+				}
+
+				for(uint32_t c=pair*2; c<pair*2+2; ++c)
+				{
+					for(size_t i=0; i<_samples; ++i)
+						_outputs[c][i] = level;
+				}
+			}
+		}
+
+		bool sendMidi(const synthLib::SMidiEvent& _ev, std::vector<synthLib::SMidiEvent>&) override
+		{
+			const auto status = _ev.a & 0xf0;
+			const auto part = _ev.a & 0x0f;
+
+			if(status == synthLib::M_NOTEON)
+				m_notes[part] = _ev.c > 0;
+			else if(status == synthLib::M_NOTEOFF || (status == synthLib::M_CONTROLCHANGE && _ev.b == synthLib::MC_ALLNOTESOFF))
+				m_notes[part] = false;
+			return true;
+		}
+
+	private:
+		const bool m_canRoute;
+		std::array<uint32_t, g_partCount> m_partOutputs{};
+		std::array<bool, g_partCount> m_notes{};
+	};
+
+	struct Member
+	{
+		Member(const std::string& _farmId, const uint8_t _part, const bool _canRoute)
+			: device(synthLib::DeviceCreateParams(), _farmId, _part, [_canRoute]() -> synthLib::Device*
+			{
+				return new TestDevice(synthLib::DeviceCreateParams(), _canRoute);
+			})
+		{
+			for(size_t c=0; c<buffers.size(); ++c)
+			{
+				buffers[c].resize(g_blockSize);
+				outputs[c] = buffers[c].data();
+			}
+		}
+
+		// every member plays a note on channel 1, the farm moves it to the channel of the part of the member
+		void process(const bool _noteOn)
+		{
+			synthLib::TAudioInputs inputs{};
+
+			std::vector<synthLib::SMidiEvent> midiIn;
+			std::vector<synthLib::SMidiEvent> midiOut;
+
+			if(_noteOn != noteOn)
+			{
+				midiIn.emplace_back(synthLib::MidiEventSource::Host, _noteOn ? synthLib::M_NOTEON : synthLib::M_NOTEOFF, 60, 100);
+				noteOn = _noteOn;
+			}
+
+			device.process(inputs, outputs, g_blockSize, midiIn, midiOut);
+		}
+
+		float getLevel() const
+		{
+			return buffers[0][g_blockSize - 1];
+		}
+
+		synthLib::FarmDevice device;
+		std::array<std::vector<float>, 2> buffers;
+		synthLib::TAudioOutputs outputs{};
+		bool noteOn = false;
+	};
+
+	// the block that contains a note on is produced by the member that runs first, the others follow one block later
+	void processAll(const std::vector<Member*>& _members, const bool _noteOn)
+	{
+		for(uint32_t i=0; i<2; ++i)
+		{
+			for (auto* m : _members)
+				m->process(_noteOn);
+		}
+	}
+
+	bool check(const char* _name, const Member& _member, const float _expected)
+	{
+		const auto level = _member.getLevel();
+
+		if(level == _expected)
+			return true;
+
+		std::cout << _name << ": member of part " << static_cast<int>(_member.device.getPart() + 1) << " received level " << level << ", expected " << _expected << std::endl;
+		return false;
+	}
+
+	// two members on a device that routes parts, each one receives its own part only
+	bool testTwoMembers()
+	{
+		Member a("twoMembers", 0, true);
+		Member b("twoMembers", 5, true);
+
+		processAll({&a, &b}, true);
+
+		if(!check("Two members", a, 1.0f) || !check("Two members", b, 6.0f))
+			return false;
+
+		processAll({&a, &b}, false);
+
+		return check("Two members, notes released", a, 0.0f) && check("Two members, notes released", b, 0.0f);
+	}
+
+	// A member that attaches when all pairs are taken is silenced and does not play, once a pair is released it gets it.
+	// Notes that the member that left still holds are stopped
+	bool testNoPairLeft()
+	{
+		Member a("noPairLeft", 0, true);
+		auto b = std::make_unique<Member>("noPairLeft", 1, true);
+		Member c("noPairLeft", 2, true);
+
+		processAll({&a, b.get(), &c}, true);
+
+		if(!check("No pair left", a, 1.0f) || !check("No pair left", *b, 2.0f) || !check("No pair left", c, 0.0f))
+			return false;
+
+		b.reset();
+
+		processAll({&a, &c}, false);
+		processAll({&a, &c}, true);
+
+		return check("Pair released", a, 1.0f) && check("Pair released", c, 3.0f);
+	}
+
+	// a device that cannot route parts plays all of them on its first pair, only the first member receives it
+	bool testNoRouting()
+	{
+		Member a("noRouting", 0, false);
+		Member b("noRouting", 1, false);
+
+		processAll({&a, &b}, true);
+
+		return check("No routing", a, 1.0f) && check("No routing", b, 0.0f);
+	}
+}
+
+int main()
+{
+	if(!testTwoMembers() || !testNoPairLeft() || !testNoRouting())
+		return -1;
+
+	std::cout << "All members received their own parts only" << std::endl;
+	return 0;
+}
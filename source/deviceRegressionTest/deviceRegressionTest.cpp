@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include "baseLib/commandline.h"
+#include "baseLib/filesystem.h"
+
+#include "renderConsoleLib/deviceFactory.h"
+#include "renderConsoleLib/regressionScenario.h"
+
+#include "synthLib/device.h"
+#include "synthLib/deviceException.h"
+#include "synthLib/midiFile.h"
+#include "synthLib/scenario.h"
+#include "synthLib/scenarioRunner.h"
+
+using namespace renderConsoleLib;
+
+namespace
+{
+	// returned if no device has been tested because no ROM was found, ctest reports the test as skipped
+	constexpr int g_resultSkipped = 77;
+
+	constexpr DeviceType g_devices[] = {DeviceType::MicroQ, DeviceType::Xt, DeviceType::N2x};
+
+	enum class Result
+	{
+		Ok,
+		Created,
+		Skipped,
+		Failed
+	};
+
+	void printUsage()
+	{
+		std::cout << "Renders a scripted midi sequence with the microQ, XT and N2x and compares the audio against golden files" << std::endl << std::endl;
+
+		std::cout << "Usage:" << std::endl;
+		std::cout << "  deviceRegressionTest -folder <dir> [-microq <rom>] [-xt <rom>] [-n2x <rom>] [options]" << std::endl << std::endl;
+
+		std::cout << "The ROM of a device is either given on the command line or is read from <dir>/<device>.bin. Devices without" << std::endl;
+		std::cout << "a ROM are skipped. Golden files are stored as <dir>/<device>.golden" << std::endl << std::endl;
+
+		std::cout << "Options:" << std::endl;
+		std::cout << "  -folder <dir>             folder with ROMs and golden files, default is the current directory" << std::endl;
+		std::cout << "  -create                   writes new golden files instead of comparing against them" << std::endl;
+		std::cout << "  -midi <file.mid>          plays a midi file after booting instead of the built-in sequence" << std::endl;
+		std::cout << "  -tail <seconds>           time played after the end of the midi file, default 2" << std::endl;
+		std::cout << "  -hashBlockSize <n>        samples per audio hash, the resolution of reported divergences, default 256" << std::endl;
+	}
+
+	std::string getRomFile(const baseLib::CommandLine& _cmd, const std::string& _folder, const DeviceType _type)
+	{
+		const auto name = DeviceFactory::getName(_type);
+
+		if(_cmd.contains(name))
+			return _cmd.get(name);
+
+		const auto file = _folder + name + ".bin";
+
+		return baseLib::filesystem::getFileSize(file) ? file : std::string();
+	}
+
+	std::string getGoldenFile(const baseLib::CommandLine& _cmd, const std::string& _folder, const DeviceType _type)
+	{
+		std::string name = DeviceFactory::getName(_type);
+
+		const auto midiFile = _cmd.get("midi");
+
+		if(!midiFile.empty())
+			name += '_' + baseLib::filesystem::stripExtension(baseLib::filesystem::getFilenameWithoutPath(midiFile));
+
+		return _folder + name + ".golden";
+	}
+
+	bool createScenario(synthLib::Scenario& _scenario, const baseLib::CommandLine& _cmd, const DeviceType _type)
+	{
+		const auto midiFile = _cmd.get("midi");
+
+		if(midiFile.empty())
+		{
+			RegressionScenario::create(_scenario, _type);
+			return true;
+		}
+
+		synthLib::MidiFile midi;
+
+		if(!midi.loadFromFile(midiFile))
+		{
+			std::cout << "Failed to load midi file " << midiFile << std::endl;
+			return false;
+		}
+
+		_scenario.addPhase("boot", RegressionScenario::getBootSeconds(_type));
+		_scenario.addMidiFile("midi", midi, _cmd.getFloat("tail", 2.0f));
+		return true;
+	}
+
+	void printDivergence(const synthLib::ScenarioResult& _result, const synthLib::ScenarioResult::Divergence& _d)
+	{
+		const auto pos = _result.getPhaseStart(_d.phase) + _d.samplePos;
+
+		std::cout << "  FAILED, " << _d.reason << std::endl;
+		std::cout << "  First divergence at sample " << pos << " (" << std::fixed << std::setprecision(3) << static_cast<double>(pos) / static_cast<double>(_result.samplerate) << "s)";
+
+		if(_d.phase < _result.phases.size())
+			std::cout << ", sample " << _d.samplePos << " of phase '" << _result.phases[_d.phase].name << "'";
+
+		std::cout << ", resolution " << _result.hashBlockSize << " samples" << std::endl;
+	}
+
+	Result runDevice(const baseLib::CommandLine& _cmd, const std::string& _folder, const DeviceType _type)
+	{
+		const auto romFile = getRomFile(_cmd, _folder, _type);
+
+		std::cout << DeviceFactory::getName(_type) << std::endl;
+
+		if(romFile.empty())
+		{
+			std::cout << "  Skipped, no ROM found" << std::endl;
+			return Result::Skipped;
+		}
+
+		const auto goldenFile = getGoldenFile(_cmd, _folder, _type);
+		const auto create = _cmd.contains("create");
+
+		synthLib::ScenarioResult golden;
+
+		if(!create && !golden.load(goldenFile))
+		{
+			std::cout << "  FAILED, unable to load golden file " << goldenFile << ", use -create to create it" << std::endl;
+			return Result::Failed;
+		}
+
+		synthLib::Scenario scenario;
+
+		if(!createScenario(scenario, _cmd, _type))
+			return Result::Failed;
+
+		const auto hashBlockSize = static_cast<uint32_t>(_cmd.getInt("hashBlockSize", 256));
+
+		synthLib::ScenarioResult result;
+
+		try
+		{
+			const auto device = DeviceFactory::create(_type, romFile);
+
+			// front panel updates do not affect audio, skip them to save time
+			device->setHeadless(true);
+
+			synthLib::ScenarioRunner runner(*device, 0.0f, 64, hashBlockSize);
+
+			result = runner.run(scenario);
+		}
+		catch(const synthLib::DeviceException& e)
+		{
+			std::cout << "  FAILED, " << e.what() << std::endl;
+			return Result::Failed;
+		}
+
+		std::cout << "  Rendered " << std::fixed << std::setprecision(2) << static_cast<double>(result.getSampleCount()) / static_cast<double>(result.samplerate)
+			<< "s of audio in " << result.getRenderSeconds() << "s" << std::endl;
+
+		if(create)
+		{
+			if(!result.save(goldenFile))
+			{
+				std::cout << "  FAILED, unable to write golden file " << goldenFile << std::endl;
+				return Result::Failed;
+			}
+
+			std::cout << "  Created golden file " << goldenFile << std::endl;
+			return Result::Created;
+		}
+
+		const auto d = result.compare(golden);
+
+		if(d.diverged)
+		{
+			printDivergence(result, d);
+			return Result::Failed;
+		}
+
+		std::cout << "  OK" << std::endl;
+		return Result::Ok;
+	}
+}
+
+int main(const int _argc, char* _argv[])
+{
+	const baseLib::CommandLine commandLine(_argc, _argv);
+
+	if(commandLine.contains("help") || commandLine.contains("h"))
+	{
+		printUsage();
+		return 0;
+	}
+
+	auto folder = commandLine.get("folder");
+	folder = baseLib::filesystem::validatePath(folder.empty() ? baseLib::filesystem::getCurrentDirectory() : folder);
+
+	const auto supported = DeviceFactory::getSupportedTypes();
+
+	uint32_t tested = 0;
+	uint32_t failed = 0;
+
+	for (const auto type : g_devices)
+	{
+		if(std::find(supported.begin(), supported.end(), type) == supported.end())
+			continue;
+
+		switch (runDevice(commandLine, folder, type))
+		{
+		case Result::Ok:
+		case Result::Created:	++tested;				break;
+		case Result::Failed:	++tested; ++failed;		break;
+		case Result::Skipped:							break;
+		}
+	}
+
+	if(!tested)
+	{
+		std::cout << "No device has been tested, no ROMs found in " << folder << std::endl;
+		return g_resultSkipped;
+	}
+
+	std::cout << "Tested " << tested << " device(s), " << failed << " failure(s)" << std::endl;
+
+	return failed ? -1 : 0;
+}
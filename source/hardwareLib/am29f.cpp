@@ -1,5 +1,6 @@
 #include "am29f.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "mc68k/logging.h"
@@ -114,15 +115,14 @@ namespace hwLib
 				}
 
 				MCLOG("Erasing Sector at " << MCHEX(_addr) << ", size " << MCHEX(1024 * sectorSizekB));
-				for(size_t i = _addr; i< _addr + sectorSizekB * 1024; ++i)
-					m_buffer[i] = 0xff;
+				std::fill_n(m_buffer + _addr, sectorSizekB * 1024, static_cast<uint8_t>(0xff));
 			}
 			break;
 		case CommandType::Program:
 			{
 				if(_addr >= m_size)
 					return;
-				MCLOG("Programming word at " << MCHEX(_addr) << ", value " << MCHEXN(_data, 4));
+//				MCLOG("Programming word at " << MCHEX(_addr) << ", value " << MCHEXN(_data, 4));
 				const auto old = mc68k::Mc68k::readW(m_buffer, _addr);
 				// "A bit cannot be programmed from a 0 back to a 1"
 				const auto v = _data & old;
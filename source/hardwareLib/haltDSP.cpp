@@ -2,6 +2,8 @@
 
 #include "dsp56kEmu/dsp.h"
 
+#include "synthLib/deviceMetrics.h"
+
 namespace hwLib
 {
 	HaltDSP::HaltDSP(dsp56k::DSP& _dsp)
@@ -67,6 +69,8 @@ namespace hwLib
 
 		m_halting = true;
 
+		const synthLib::ScopedMetricTimer timer(m_metrics, synthLib::MetricType::DspWaitForUc);
+
 		// halt and wait for resume or a wakeup call
 		m_blockSem.wait();
 
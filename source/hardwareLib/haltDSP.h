@@ -6,6 +6,11 @@
 
 #include "baseLib/semaphore.h"
 
+namespace synthLib
+{
+	class DeviceMetrics;
+}
+
 namespace dsp56k
 {
 	class DSP;
@@ -28,6 +33,8 @@ namespace hwLib
 
 		void wakeUp(std::function<void()>&& _func);
 
+		void setMetrics(synthLib::DeviceMetrics* _metrics) { m_metrics = _metrics; }
+
 	private:
 		void onInterrupt();
 
@@ -49,6 +56,8 @@ namespace hwLib
 		std::unordered_map<uint32_t, std::function<void()>> m_wakeUps;
 
 		bool m_halting = false;
+
+		synthLib::DeviceMetrics* m_metrics = nullptr;
 	};
 
 	class ScopedResumeDSP
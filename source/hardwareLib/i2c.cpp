@@ -111,7 +111,7 @@ namespace hwLib
 
 	void I2c::onByteWritten()
 	{
-		LOG("Got byte " << HEXN(byte(), 2));
+//		LOG("Got byte " << HEXN(byte(), 2));
 	}
 
 	void I2c::sdaFlip(const bool _sda)
@@ -131,7 +131,7 @@ namespace hwLib
 		{
 			if(m_nextBit >= Bit0 && m_nextBit <= Bit7)
 			{
-				LOG("next bit " << static_cast<int>(m_nextBit) << " = " << m_sda);
+//				LOG("next bit " << static_cast<int>(m_nextBit) << " = " << m_sda);
 
 				if(m_nextBit == Bit7)
 					m_byte = 0;
@@ -149,7 +149,7 @@ namespace hwLib
 			}
 			else if(m_nextBit == BitAck)
 			{
-				LOG("ACK by master=" << m_sda);
+//				LOG("ACK by master=" << m_sda);
 				m_nextBit = 7;
 			}
 		}
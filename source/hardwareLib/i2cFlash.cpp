@@ -1,5 +1,6 @@
 #include "i2cFlash.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "baseLib/filesystem.h"
@@ -19,17 +20,21 @@ namespace hwLib
 			return false;
 
 		std::copy(_data.begin(), _data.end(), m_data.begin());
+		m_pageCount = 0;
 		return true;
 	}
 
 	void I2cFlash::onStartCondition()
 	{
+		// a repeated start ends a write transaction, too
+		commitPage();
 		m_state = State::ReadDeviceSelect;
 		I2c::onStartCondition();
 	}
 
 	void I2cFlash::onStopCondition()
 	{
+		commitPage();
 		I2c::onStopCondition();
 	}
 
@@ -87,7 +92,7 @@ namespace hwLib
 		assert((m_deviceSelect & DeviceSelectMask::Rw) == DeviceSelectValues::Read);
 		const auto res = m_data[m_address];
 
-		LOG("I2C op read from " << HEXN(m_address,4) << ", res " << HEXN(res,2));
+//		LOG("I2C op read from " << HEXN(m_address,4) << ", res " << HEXN(res,2));
 		++m_address;
 		if(m_address >= m_data.size())
 			m_address = static_cast<uint32_t>(m_data.size()) - 1;
@@ -99,9 +104,13 @@ namespace hwLib
 		assert((m_deviceSelect & DeviceSelectMask::Area) == DeviceSelectValues::AreaMemory);
 		assert((m_deviceSelect & DeviceSelectMask::Rw) == DeviceSelectValues::Write);
 
-		m_data[m_address] = _byte;
+		if(!m_pageCount)
+			m_pageAddress = m_address;
 
-		LOG("I2C op write to " << HEXN(m_address,4) << ", val " << HEXN(_byte,2));
+		m_page[m_address & (PageSize-1)] = _byte;
+		++m_pageCount;
+
+//		LOG("I2C op write to " << HEXN(m_address,4) << ", val " << HEXN(_byte,2));
 		advanceAddress();
 	}
 
@@ -109,4 +118,32 @@ namespace hwLib
 	{
 		m_address = (m_address & 0xFF80) | ((m_address + 1) & 0x7F);
 	}
+
+	void I2cFlash::commitPage()
+	{
+		if(!m_pageCount)
+			return;
+
+		const auto pageStart = m_data.begin() + (m_pageAddress & ~(PageSize-1));
+
+		if(m_pageCount >= PageSize)
+		{
+			// the address rolled over within the page, every byte of it has been written
+			std::copy(m_page.begin(), m_page.end(), pageStart);
+		}
+		else
+		{
+			// the written range might wrap around to the beginning of the page
+			const auto first = m_pageAddress & (PageSize-1);
+			const auto countA = std::min(m_pageCount, PageSize - first);
+			const auto countB = m_pageCount - countA;
+
+			std::copy_n(m_page.begin() + first, countA, pageStart + first);
+			std::copy_n(m_page.begin(), countB, pageStart);
+		}
+
+//		LOG("I2C page write to " << HEXN(m_pageAddress,4) << ", " << m_pageCount << " bytes");
+
+		m_pageCount = 0;
+	}
 }
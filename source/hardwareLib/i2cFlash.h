@@ -14,6 +14,7 @@ namespace hwLib
 	{
 	public:
 		static constexpr uint32_t Size = 0x10000;
+		static constexpr uint32_t PageSize = 128;
 		using Data = std::array<uint8_t, Size>;
 
 		I2cFlash()
@@ -31,6 +32,9 @@ namespace hwLib
 
 		const auto& getAddress() const { return m_address; }
 
+		// bytes of a write transaction that has not ended yet are not included
+		const Data& getData() const { return m_data; }
+
 	protected:
 		void onStartCondition() override;
 		void onStopCondition() override;
@@ -64,11 +68,18 @@ namespace hwLib
 
 		void writeByte(uint8_t _byte);
 		void advanceAddress();
+		void commitPage();
 
 		State m_state = State::ReadDeviceSelect;
 		uint8_t m_deviceSelect = 0;
 		uint32_t m_address = 0;
 
+		// Like the real chip, bytes of a write transaction are collected in a page buffer and are copied to memory
+		// at once when the transaction ends
+		std::array<uint8_t, PageSize> m_page{};
+		uint32_t m_pageAddress = 0;		// address of the first byte of the transaction
+		uint32_t m_pageCount = 0;		// number of bytes written in the transaction, might exceed the page size
+
 		Data m_data;
 	};
 }
@@ -0,0 +1,43 @@
+#include "i2cTrace.h"
+
+#include "baseLib/filesystem.h"
+
+namespace hwLib
+{
+	// one byte per event: bits 2-3 = type, bit 1 = sda, bit 0 = scl
+
+	bool I2cTrace::saveAs(const std::string& _filename) const
+	{
+		std::vector<uint8_t> data;
+		data.reserve(m_events.size());
+
+		for (const auto& e : m_events)
+			data.push_back(static_cast<uint8_t>((static_cast<uint8_t>(e.type) << 2) | (e.sda ? 2 : 0) | (e.scl ? 1 : 0)));
+
+		return baseLib::filesystem::writeFile(_filename, data);
+	}
+
+	bool I2cTrace::load(const std::string& _filename)
+	{
+		std::vector<uint8_t> data;
+
+		if(!baseLib::filesystem::readFile(data, _filename))
+			return false;
+
+		std::vector<Event> events;
+		events.reserve(data.size());
+
+		for (const auto d : data)
+		{
+			const auto type = d >> 2;
+
+			if(type > static_cast<uint8_t>(Type::SdaDirection))
+				return false;
+
+			events.push_back({static_cast<Type>(type), (d & 2) != 0, (d & 1) != 0});
+		}
+
+		m_events.swap(events);
+		return true;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace hwLib
+{
+	// Records the pin accesses of an i2c bus master to be able to replay them on a slave later, for example to test a
+	// slave implementation with the access pattern of a real firmware
+	class I2cTrace
+	{
+	public:
+		enum class Type : uint8_t
+		{
+			Write,			// masterWrite(sda, scl)
+			Read,			// masterRead(scl)
+			SdaDirection,	// setSdaWrite(sda)
+		};
+
+		struct Event
+		{
+			Type type;
+			bool sda;
+			bool scl;
+		};
+
+		static constexpr int8_t NoResult = -1;
+
+		void setEnabled(const bool _enabled) { m_enabled = _enabled; }
+		bool isEnabled() const { return m_enabled; }
+
+		void addWrite(const bool _sda, const bool _scl)	{ add({Type::Write, _sda, _scl}); }
+		void addRead(const bool _scl)					{ add({Type::Read, false, _scl}); }
+		void addSdaDirection(const bool _write)			{ add({Type::SdaDirection, _write, false}); }
+
+		void clear() { m_events.clear(); }
+
+		const auto& getEvents() const { return m_events; }
+
+		bool saveAs(const std::string& _filename) const;
+		bool load(const std::string& _filename);
+
+		// Replays all events. For every event, the value that the slave returns is written to _results, NoResult if
+		// the slave did not return anything
+		template<typename TSlave> void replay(TSlave& _slave, std::vector<int8_t>& _results) const
+		{
+			_results.resize(m_events.size());
+
+			for(size_t i=0; i<m_events.size(); ++i)
+			{
+				const auto& e = m_events[i];
+
+				std::optional<bool> res;
+
+				switch (e.type)
+				{
+				case Type::Write:			_slave.masterWrite(e.sda, e.scl);	break;
+				case Type::Read:			res = _slave.masterRead(e.scl);		break;
+				case Type::SdaDirection:	res = _slave.setSdaWrite(e.sda);	break;
+				}
+
+				_results[i] = res ? static_cast<int8_t>(*res) : NoResult;
+			}
+		}
+
+	private:
+		void add(const Event& _event)
+		{
+			if(m_enabled)
+				m_events.push_back(_event);
+		}
+
+		std::vector<Event> m_events;
+		bool m_enabled = false;
+	};
+}
@@ -133,34 +133,29 @@ namespace hwLib
 				{
 //					LOG("LCD write data to DDRAM addr " << m_dramAddr << ", data=" << static_cast<int>(g) << ", char=" << static_cast<char>(g));
 
-					const auto old = m_dramData;
-
 					if(m_dramAddr >= 20 && m_dramAddr < 0x40)
 					{
-						for(size_t i=1; i<=20; ++i)
-							m_dramData[i-1] = m_dramData[i];
-						m_dramData[19] = static_cast<char>(g);
+						for(size_t i=1; i<20; ++i)
+							writeDdRam(i-1, m_dramData[i], changed);
+						writeDdRam(19, static_cast<char>(g), changed);
 					}
 					else if(m_dramAddr > 0x53)
 					{
-						for(size_t i=21; i<=40; ++i)
-							m_dramData[i-1] = m_dramData[i];
+						for(size_t i=21; i<40; ++i)
+							writeDdRam(i-1, m_dramData[i], changed);
 
-						m_dramData[39] = static_cast<char>(g);
+						writeDdRam(39, static_cast<char>(g), changed);
 					}
 					else
 					{
 						if(m_dramAddr < 20)
-							m_dramData[m_dramAddr] = static_cast<char>(g);
+							writeDdRam(m_dramAddr, static_cast<char>(g), changed);
 						else
-							m_dramData[m_dramAddr - 0x40 + 20] = static_cast<char>(g);
+							writeDdRam(m_dramAddr - 0x40 + 20, static_cast<char>(g), changed);
 					}
 
 					if(m_dramAddr != 20 && m_dramAddr != 0x54)
 						m_dramAddr += m_addrIncrement;
-
-					if(m_dramData != old)
-						changed = true;
 				}
 			}
 		}
@@ -193,15 +188,24 @@ namespace hwLib
 			}
 		}
 
-		if(changed && m_changeCallback)
-			m_changeCallback();
+		if(changed && m_trackChanges.load(std::memory_order_relaxed))
+			m_version.fetch_add(1, std::memory_order_release);
 
-		if(cgRamChanged && m_cgRamChangeCallback)
-			m_cgRamChangeCallback();
+		if(cgRamChanged && m_trackChanges.load(std::memory_order_relaxed))
+			m_cgRamVersion.fetch_add(1, std::memory_order_release);
 
 		return result;
 	}
 
+	void LCD::writeDdRam(const size_t _index, const char _c, bool& _changed)
+	{
+		// compare per character instead of copying and comparing the whole display after every write
+		if(m_dramData[_index] == _c)
+			return;
+		m_dramData[_index] = _c;
+		_changed = true;
+	}
+
 	bool LCD::getCgData(std::array<uint8_t, 8>& _data, uint32_t _charIndex) const
 	{
 		const auto idx = _charIndex * 8;
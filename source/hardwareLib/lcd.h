@@ -1,8 +1,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstdint>
-#include <functional>
 #include <optional>
 
 namespace hwLib
@@ -13,8 +13,6 @@ namespace hwLib
 	class LCD
 	{
 	public:
-		using ChangeCallback = std::function<void()>;
-
 		LCD();
 		std::optional<uint8_t> exec(bool registerSelect, bool read, uint8_t g);
 
@@ -22,16 +20,17 @@ namespace hwLib
 		const auto& getCgRam() const { return m_cgramData; }
 		bool getCgData(std::array<uint8_t, 8>& _data, uint32_t _charIndex) const;
 
-		void setChangeCallback(const ChangeCallback& _callback)
-		{
-			m_changeCallback = _callback;
-		}
+		// Change counters of the display content and of the custom characters. The UC thread increments them, consumers
+		// poll them when they repaint and read the content only if a counter differs from the value they have seen last
+		uint32_t getVersion() const { return m_version.load(std::memory_order_acquire); }
+		uint32_t getCgRamVersion() const { return m_cgRamVersion.load(std::memory_order_acquire); }
+
+		// if disabled, change counters are no longer updated, for example if there is nothing that displays the content
+		void setTrackChanges(const bool _trackChanges) { m_trackChanges = _trackChanges; }
 
-		void setCgRamChangeCallback(const ChangeCallback& _callback)
-		{
-			m_cgRamChangeCallback = _callback;
-		}
 	private:
+		void writeDdRam(size_t _index, char _c, bool& _changed);
+
 		enum class CursorShiftMode
 		{
 			CursorLeft,
@@ -85,7 +84,8 @@ namespace hwLib
 		std::array<char, 40> m_dramData{};
 		uint32_t m_lastOpState = 0;
 
-		ChangeCallback m_changeCallback;
-		ChangeCallback m_cgRamChangeCallback;
+		std::atomic<uint32_t> m_version{0};
+		std::atomic<uint32_t> m_cgRamVersion{0};
+		std::atomic<bool> m_trackChanges{true};	// set by the plugin thread, read by the UC thread
 	};
 }
@@ -0,0 +1,213 @@
+#include "ucExecutor.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+
+#include "dsp56kEmu/threadtools.h"
+
+#include "synthLib/threadPlacement.h"
+
+namespace hwLib
+{
+	void UcExecutor::Task::wakeUpUc()
+	{
+		if(m_executor)
+			m_executor->wakeUp(*this);
+	}
+
+	void UcExecutor::Task::startUc(std::shared_ptr<UcExecutor> _executor)
+	{
+		assert(!m_executor);
+		m_executor = _executor ? std::move(_executor) : getShared();
+		m_executor->add(*this);
+	}
+
+	void UcExecutor::Task::stopUc(const std::function<void()>& _pump)
+	{
+		if(!m_executor)
+			return;
+		// the executor is kept, the DSP might still call wakeUpUc() which is a no-op now
+		m_executor->remove(*this, _pump);
+	}
+
+	UcExecutor::UcExecutor(uint32_t _threadCount, const int32_t _node)
+	{
+		const auto nodeCpus = _node >= 0 ? synthLib::ThreadPlacement::getNodeCpus(static_cast<uint32_t>(_node)) : synthLib::ThreadPlacement::CpuList();
+
+		if(!_threadCount)
+			_threadCount = nodeCpus.empty() ? std::max(1u, std::thread::hardware_concurrency()) : static_cast<uint32_t>(nodeCpus.size());
+
+		m_threads.reserve(_threadCount);
+
+		for(uint32_t i=0; i<_threadCount; ++i)
+		{
+			m_threads.emplace_back([this, nodeCpus]
+			{
+				// the creating thread might be limited to a few cores of the node only, our threads serve all devices of the node
+				if(!nodeCpus.empty())
+					synthLib::ThreadPlacement::setCurrentThreadCpus(nodeCpus);
+
+				dsp56k::ThreadTools::setCurrentThreadPriority(dsp56k::ThreadPriority::Highest);
+				dsp56k::ThreadTools::setCurrentThreadName("MC68331");
+				threadFunc();
+			});
+		}
+	}
+
+	UcExecutor::~UcExecutor()
+	{
+		{
+			std::scoped_lock lock(m_mutex);
+			assert(m_entries.empty() && "all tasks need to be stopped before the executor is destroyed");
+			m_exit = true;
+		}
+		m_cv.notify_all();
+
+		for (auto& t : m_threads)
+			t.join();
+		m_threads.clear();
+	}
+
+	std::shared_ptr<UcExecutor> UcExecutor::getShared()
+	{
+		static std::mutex mutex;
+		static std::map<int32_t, std::weak_ptr<UcExecutor>> instances;	// per NUMA node
+
+		const auto node = synthLib::ThreadPlacement::getCurrentThreadNode();
+
+		std::scoped_lock lock(mutex);
+
+		auto& instance = instances[node];
+
+		auto executor = instance.lock();
+
+		if(!executor)
+		{
+			executor = std::make_shared<UcExecutor>(0, node);
+			instance = executor;
+		}
+
+		return executor;
+	}
+
+	void UcExecutor::add(Task& _task)
+	{
+		{
+			std::scoped_lock lock(m_mutex);
+			m_entries.insert({&_task, Entry()});
+			m_queue.push_back(&_task);
+		}
+		m_cv.notify_one();
+	}
+
+	void UcExecutor::remove(Task& _task, const std::function<void()>& _pump)
+	{
+		std::unique_lock lock(m_mutex);
+
+		const auto it = m_entries.find(&_task);
+		if(it == m_entries.end())
+			return;
+
+		auto& entry = it->second;
+		entry.removing = true;
+
+		while(entry.state == State::Running || entry.state == State::RunningWakeUp)
+		{
+			lock.unlock();
+			_pump();
+			lock.lock();
+		}
+
+		if(entry.state == State::Queued)
+			m_queue.erase(std::find(m_queue.begin(), m_queue.end(), &_task));
+
+		m_entries.erase(it);
+	}
+
+	void UcExecutor::wakeUp(Task& _task)
+	{
+		{
+			std::scoped_lock lock(m_mutex);
+
+			const auto it = m_entries.find(&_task);
+			if(it == m_entries.end())
+				return;
+
+			auto& entry = it->second;
+
+			switch (entry.state)
+			{
+			case State::Suspended:
+				if(entry.removing)
+					return;
+				entry.state = State::Queued;
+				entry.resumed = true;
+				m_queue.push_back(&_task);
+				break;
+			case State::Running:
+				entry.state = State::RunningWakeUp;
+				return;
+			case State::Queued:
+			case State::RunningWakeUp:
+				return;
+			}
+		}
+		m_cv.notify_one();
+	}
+
+	void UcExecutor::threadFunc()
+	{
+		std::unique_lock lock(m_mutex);
+
+		while(true)
+		{
+			m_cv.wait(lock, [this]
+			{
+				return m_exit || !m_queue.empty();
+			});
+
+			if(m_exit)
+				return;
+
+			auto* task = m_queue.front();
+			m_queue.pop_front();
+
+			auto& entry = m_entries.find(task)->second;
+			entry.state = State::Running;
+
+			const auto resumed = entry.resumed;
+			const auto suspendTime = entry.suspendTime;
+			entry.resumed = false;
+
+			lock.unlock();
+
+			if(resumed)
+				task->onUcResumed(Clock::now() - suspendTime);
+
+			const auto ready = task->runUcQuantum();
+
+			const auto now = ready ? Clock::time_point() : Clock::now();
+
+			lock.lock();
+
+			// the entry cannot be removed while it is running
+			if(entry.removing)
+			{
+				entry.state = State::Suspended;
+				continue;
+			}
+
+			if(ready || entry.state == State::RunningWakeUp)
+			{
+				// round robin, other microcontrollers that are waiting get their quantum first
+				entry.state = State::Queued;
+				m_queue.push_back(task);
+				continue;
+			}
+
+			entry.state = State::Suspended;
+			entry.suspendTime = now;
+		}
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace hwLib
+{
+	// Runs the microcontrollers of many device instances on a shared pool of threads, one per CPU core, instead of one
+	// thread per instance. Microcontrollers are time-sliced: each one executes a quantum of instructions, then the next
+	// one is scheduled. A microcontroller that has used up the cycles of all ESAI frames that the DSP produced so far is
+	// suspended until the DSP produces more frames, it does not occupy a thread while waiting
+	class UcExecutor
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		class Task
+		{
+		public:
+			using Clock = UcExecutor::Clock;
+
+			virtual ~Task() = default;
+
+			// executes a quantum of instructions. Returns false if the microcontroller has to wait for the DSP, it is
+			// then suspended until wakeUpUc() is called
+			virtual bool runUcQuantum() = 0;
+
+			// called before the quantum is executed if the task has been suspended before
+			virtual void onUcResumed([[maybe_unused]] Clock::duration _suspendedTime) {}
+
+			// starts running runUcQuantum() on the given executor, the process wide shared one is used if none is specified.
+			// Needs to be called before the DSP calls wakeUpUc() for the first time
+			void startUc(std::shared_ptr<UcExecutor> _executor = {});
+
+			// stops running the microcontroller. A quantum that is currently executed might wait for the DSP, _pump is
+			// called repeatedly until that quantum has finished
+			void stopUc(const std::function<void()>& _pump);
+
+		protected:
+			// to be called by the DSP thread once it produced new ESAI frames. Thread-safe, cheap if the task is not suspended
+			void wakeUpUc();
+
+		private:
+			std::shared_ptr<UcExecutor> m_executor;
+		};
+
+		// _node: NUMA node that the threads are limited to, -1 = no limit. Thread count 0 = one thread per CPU of that node
+		explicit UcExecutor(uint32_t _threadCount = 0, int32_t _node = -1);
+		~UcExecutor();
+
+		UcExecutor(const UcExecutor&) = delete;
+		UcExecutor(UcExecutor&&) = delete;
+		UcExecutor& operator = (const UcExecutor&) = delete;
+		UcExecutor& operator = (UcExecutor&&) = delete;
+
+		uint32_t getThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+
+		// process wide executor, created on first use and destroyed when the last user releases it. If the calling thread
+		// is limited to one NUMA node by synthLib::ThreadPlacement, an executor for that node is returned
+		static std::shared_ptr<UcExecutor> getShared();
+
+	private:
+		enum class State
+		{
+			Suspended,
+			Queued,
+			Running,
+			RunningWakeUp	// woken up while running, will be queued again even if it wants to be suspended
+		};
+
+		struct Entry
+		{
+			State state = State::Queued;
+			bool removing = false;
+			bool resumed = false;
+			Clock::time_point suspendTime;
+		};
+
+		void add(Task& _task);
+		void remove(Task& _task, const std::function<void()>& _pump);
+		void wakeUp(Task& _task);
+
+		void threadFunc();
+
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		std::deque<Task*> m_queue;
+		std::unordered_map<Task*, Entry> m_entries;
+		bool m_exit = false;
+
+		std::vector<std::thread> m_threads;
+	};
+}
@@ -3,8 +3,8 @@
 #include "defaultskin.h"
 #include "listitem.h"
 #include "patchmanager.h"
+#include "previewcache.h"
 #include "savepatchdesc.h"
-#include "search.h"
 #include "treeitem.h"
 
 #include "../pluginEditor.h"
@@ -15,8 +15,19 @@
 
 namespace jucePluginEditorLib::patchManager
 {
-	ListModel::ListModel(PatchManager& _pm): m_patchManager(_pm)
+	namespace
 	{
+		constexpr size_t g_pageSize = 4096;
+	}
+
+	ListModel::ListModel(PatchManager& _pm): m_patchManager(_pm), m_generation(std::make_shared<std::atomic<uint32_t>>(0))
+	{
+	}
+
+	ListModel::~ListModel()
+	{
+		// drop all results that are still in flight
+		++*m_generation;
 	}
 
 	void ListModel::setContent(const pluginLib::patchDB::SearchHandle& _handle)
@@ -41,9 +52,13 @@ namespace jucePluginEditorLib::patchManager
 
 	void ListModel::clear()
 	{
+		++*m_generation;
+		m_updating = false;
+		m_selectionToRestore.clear();
+
 		m_search.reset();
+		m_entries.reset();
 		m_patches.clear();
-		m_filteredPatches.clear();
 		onModelChanged();
 		getPatchManager().setListStatus(0, 0);
 	}
@@ -55,21 +70,81 @@ namespace jucePluginEditorLib::patchManager
 
 	void ListModel::setContent(const std::shared_ptr<pluginLib::patchDB::Search>& _search)
 	{
-		const std::set<Patch> selectedPatches = getSelectedPatches();
-
 		m_search = _search;
 
-		m_patches.clear();
+		updatePatches(true);
+	}
+
+	void ListModel::updatePatches(const bool _resultsChanged)
+	{
+		if(!m_search)
+			return;
+
+		// the list is replaced page by page, remember the selection of the list as it was before the first update
+		if(!m_updating)
 		{
-			std::shared_lock lock(_search->resultsMutex);
-			m_patches.insert(m_patches.end(), _search->results.begin(), _search->results.end());
+			m_selectionToRestore = getSelectedPatches();
+			m_updating = true;
 		}
 
-		sortPatches();
-		filterPatches();
+		if(_resultsChanged)
+			m_entries.reset();
+
+		const auto generation = ++*m_generation;
+
+		getPatchManager().runOnListWorker([this, &db = getPatchManager(), generation, currentGeneration = m_generation, search = m_search, entries = m_entries, filter = m_filter]
+		{
+			// do not touch this list model here, it may be gone already. It is only accessed on the ui thread if the generation still matches
+			const auto e = entries ? entries : pluginLib::patchDB::PatchList::createEntries(*search);
+
+			bool first = true;
+
+			pluginLib::patchDB::PatchList::filter(*e, filter, g_pageSize, [&](Patches&& _page, const bool _last)
+			{
+				if(*currentGeneration != generation)
+					return false;
+
+				db.runOnUiThread([this, generation, currentGeneration, e, page = std::move(_page), first, _last]() mutable
+				{
+					if(*currentGeneration == generation)
+						onPage(e, std::move(page), first, _last);
+				});
+
+				first = false;
+				return true;
+			});
+		});
+	}
+
+	void ListModel::onPage(const pluginLib::patchDB::PatchList::EntriesPtr& _entries, Patches&& _page, const bool _first, const bool _last)
+	{
+		m_ignoreSelectedRowsChanged = true;
+
+		if(_first)
+		{
+			m_entries = _entries;
+			m_patches = std::move(_page);
+
+			// row indices do not match the selected patches anymore
+			deselectAll();
+		}
+		else
+		{
+			m_patches.insert(m_patches.end(), std::make_move_iterator(_page.begin()), std::make_move_iterator(_page.end()));
+		}
 
 		onModelChanged();
 
+		m_ignoreSelectedRowsChanged = false;
+
+		if(!_last)
+			return;
+
+		m_updating = false;
+
+		const auto selectedPatches = std::move(m_selectionToRestore);
+		m_selectionToRestore.clear();
+
 		setSelectedPatches(selectedPatches);
 
 		redraw();
@@ -266,14 +341,34 @@ namespace jucePluginEditorLib::patchManager
 				}
 			}
 		}
+		auto& previewCache = m_patchManager.getPreviewCache();
+
+		if(previewCache.isAvailable())
+		{
+			menu.addSeparator();
+
+			if(selectedPatches.size() == 1)
+			{
+				menu.addItem("Play preview", [&previewCache, patch = *selectedPatches.begin()]
+				{
+					previewCache.play(patch);
+				});
+			}
+
+			menu.addItem("Render previews for all patches", [this, &previewCache]
+			{
+				previewCache.prefetch(getPatches());
+			});
+		}
+
 		menu.addSeparator();
-		menu.addItem("Hide duplicates (by hash)", true, m_hideDuplicatesByHash, [this]
+		menu.addItem("Hide duplicates (by hash)", true, m_filter.hideDuplicatesByHash, [this]
 		{
-			setFilter(m_filter, !m_hideDuplicatesByHash, m_hideDuplicatesByName);
+			setFilter(m_filter.text, !m_filter.hideDuplicatesByHash, m_filter.hideDuplicatesByName);
 		});
-		menu.addItem("Hide duplicates (by name)", true, m_hideDuplicatesByName, [this]
+		menu.addItem("Hide duplicates (by name)", true, m_filter.hideDuplicatesByName, [this]
 		{
-			setFilter(m_filter, m_hideDuplicatesByHash, !m_hideDuplicatesByName);
+			setFilter(m_filter.text, m_filter.hideDuplicatesByHash, !m_filter.hideDuplicatesByName);
 		});
 
 		menu.addSeparator();
@@ -506,51 +601,24 @@ namespace jucePluginEditorLib::patchManager
 
 	void ListModel::setFilter(const std::string& _filter)
 	{
-		setFilter(_filter, m_hideDuplicatesByHash, m_hideDuplicatesByName);
+		setFilter(_filter, m_filter.hideDuplicatesByHash, m_filter.hideDuplicatesByName);
 	}
 
 	void ListModel::setFilter(const std::string& _filter, const bool _hideDuplicatesByHash, const bool _hideDuplicatesByName)
 	{
-		if (m_filter == _filter && _hideDuplicatesByHash == m_hideDuplicatesByHash && m_hideDuplicatesByName == _hideDuplicatesByName)
-			return;
-
-		const auto selected = getSelectedPatches();
-
-		m_filter = _filter;
-		m_hideDuplicatesByHash = _hideDuplicatesByHash;
-		m_hideDuplicatesByName = _hideDuplicatesByName;
-
-		filterPatches();
-		onModelChanged();
+		const pluginLib::patchDB::PatchList::Filter filter{_filter, _hideDuplicatesByHash, _hideDuplicatesByName};
 
-		setSelectedPatches(selected);
+		if (m_filter == filter)
+			return;
 
-		redraw();
+		m_filter = filter;
 
-		getPatchManager().setListStatus(static_cast<uint32_t>(selected.size()), static_cast<uint32_t>(getPatches().size()));
+		updatePatches(false);
 	}
 
-	void ListModel::sortPatches(Patches& _patches, pluginLib::patchDB::SourceType _sourceType)
+	void ListModel::sortPatches(Patches& _patches, const pluginLib::patchDB::SourceType _sourceType)
 	{
-		std::sort(_patches.begin(), _patches.end(), [_sourceType](const Patch& _a, const Patch& _b)
-		{
-			const auto sourceType = _sourceType;
-
-			if(sourceType == pluginLib::patchDB::SourceType::Folder)
-			{
-				const auto aSource = _a->source.lock();
-				const auto bSource = _b->source.lock();
-				if (*aSource != *bSource)
-					return *aSource < *bSource;
-			}
-			else if (sourceType == pluginLib::patchDB::SourceType::File || sourceType == pluginLib::patchDB::SourceType::Rom || sourceType == pluginLib::patchDB::SourceType::LocalStorage)
-			{
-				if (_a->program != _b->program)
-					return _a->program < _b->program;
-			}
-
-			return _a->getName().compare(_b->getName()) < 0;
-		});
+		pluginLib::patchDB::PatchList::sort(_patches, _sourceType);
 	}
 
 	void ListModel::listBoxItemClicked(const int _row, const juce::MouseEvent& _mouseEvent)
@@ -597,7 +665,7 @@ namespace jucePluginEditorLib::patchManager
 
 	bool ListModel::hasFilters() const
 	{
-		return hasTagFilters() || !m_filter.empty();
+		return hasTagFilters() || !m_filter.text.empty();
 	}
 
 	pluginLib::patchDB::SearchHandle ListModel::getSearchHandle() const
@@ -607,59 +675,6 @@ namespace jucePluginEditorLib::patchManager
 		return m_search->handle;
 	}
 
-	void ListModel::sortPatches()
-	{
-		// Note: If this list is no longer sorted by calling this function, be sure to modify the second caller in state.cpp, too, as it is used to track the selected entry across multiple parts
-		sortPatches(m_patches);
-	}
-
-	void ListModel::sortPatches(Patches& _patches) const
-	{
-		sortPatches(_patches, getSourceType());
-	}
-
-	void ListModel::filterPatches()
-	{
-		if (m_filter.empty() && !m_hideDuplicatesByHash && !m_hideDuplicatesByName)
-		{
-			m_filteredPatches.clear();
-			return;
-		}
-
-		m_filteredPatches.reserve(m_patches.size());
-		m_filteredPatches.clear();
-
-		std::set<pluginLib::patchDB::PatchHash> knownHashes;
-		std::set<std::string> knownNames;
-
-		for (const auto& patch : m_patches)
-		{
-			if(m_hideDuplicatesByHash)
-			{
-				if(knownHashes.find(patch->hash) != knownHashes.end())
-					continue;
-				knownHashes.insert(patch->hash);
-			}
-
-			if(m_hideDuplicatesByName)
-			{
-				if(knownNames.find(patch->getName()) != knownNames.end())
-					continue;
-				knownNames.insert(patch->getName());
-			}
-
-			if (m_filter.empty() || match(patch))
-				m_filteredPatches.emplace_back(patch);
-		}
-	}
-
-	bool ListModel::match(const Patch& _patch) const
-	{
-		const auto name = _patch->getName();
-		const auto t = Search::lowercase(name);
-		return t.find(m_filter) != std::string::npos;
-	}
-
 	bool ListModel::isInterestedInDragSource(const SourceDetails& dragSourceDetails)
 	{
 		auto ds = getPatchManager().getSelectedDataSourceTreeItem();
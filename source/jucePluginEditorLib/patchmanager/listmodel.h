@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
+
 #include "editable.h"
 
 #include "jucePluginLib/patchdb/patchdbtypes.h"
+#include "jucePluginLib/patchdb/patchlist.h"
 
 #include "juce_gui_basics/juce_gui_basics.h"
 
@@ -29,6 +32,7 @@ namespace jucePluginEditorLib::patchManager
 		using Patches = std::vector<Patch>;
 
 		explicit ListModel(PatchManager& _pm);
+		~ListModel() override;
 
 		void setContent(const pluginLib::patchDB::SearchHandle& _handle);
 		void setContent(pluginLib::patchDB::SearchRequest&& _request);
@@ -46,9 +50,7 @@ namespace jucePluginEditorLib::patchManager
 
 		const Patches& getPatches() const
 		{
-			if (m_filter.empty() && !m_hideDuplicatesByHash && !m_hideDuplicatesByName)
-				return m_patches;
-			return m_filteredPatches;
+			return m_patches;
 		}
 
 		Patch getPatch(const size_t _index) const
@@ -81,6 +83,7 @@ namespace jucePluginEditorLib::patchManager
 			return m_patchManager;
 		}
 
+		// Note: state.cpp uses this to track the selected entry across multiple parts, it needs to sort in the same way as the list does
 		static void sortPatches(Patches& _patches, pluginLib::patchDB::SourceType _sourceType);
 		void listBoxItemClicked(int _row, const juce::MouseEvent&) override;
 		void backgroundClicked(const juce::MouseEvent&) override;
@@ -139,10 +142,8 @@ namespace jucePluginEditorLib::patchManager
 		void filesDropped(const juce::StringArray& files, int x, int y) override;
 
 	private:
-		void sortPatches();
-		void sortPatches(Patches& _patches) const;
-		void filterPatches();
-		bool match(const Patch& _patch) const;
+		void updatePatches(bool _resultsChanged);
+		void onPage(const pluginLib::patchDB::PatchList::EntriesPtr& _entries, Patches&& _page, bool _first, bool _last);
 		void setContent(const std::shared_ptr<pluginLib::patchDB::Search>& _search);
 		bool exportPresets(bool _selectedOnly, const FileType& _fileType) const;
 		bool onClicked(const juce::MouseEvent&);
@@ -152,10 +153,14 @@ namespace jucePluginEditorLib::patchManager
 
 		std::shared_ptr<pluginLib::patchDB::Search> m_search;
 		Patches m_patches;
-		Patches m_filteredPatches;
-		std::string m_filter;
-		bool m_hideDuplicatesByHash = false;
-		bool m_hideDuplicatesByName = false;
+		pluginLib::patchDB::PatchList::EntriesPtr m_entries;
+		pluginLib::patchDB::PatchList::Filter m_filter;
+
+		// sorting and filtering runs on the list worker and increments the generation for every update. Results of
+		// outdated updates are dropped, both on the worker and when they arrive on the ui thread
+		std::shared_ptr<std::atomic<uint32_t>> m_generation;
+		bool m_updating = false;
+		std::set<Patch> m_selectionToRestore;
 		pluginLib::patchDB::SearchHandle m_searchHandle = pluginLib::patchDB::g_invalidSearchHandle;
 		bool m_ignoreSelectedRowsChanged = false;
 	};
@@ -6,6 +6,7 @@
 #include "info.h"
 #include "list.h"
 #include "listmodel.h"
+#include "previewcache.h"
 #include "searchlist.h"
 #include "searchtree.h"
 #include "status.h"
@@ -157,6 +158,8 @@ namespace jucePluginEditorLib::patchManager
 		else
 			PatchManager::resized();
 
+		m_previewCache.reset(new PreviewCache(*this, _editor.getProcessor(), juce::File(_editor.getProcessor().getPatchManagerDataFolder(false)).getChildFile("previews")));
+
 		startTimer(200);
 	}
 
@@ -164,6 +167,8 @@ namespace jucePluginEditorLib::patchManager
 	{
 		stopTimer();
 
+		m_previewCache.reset();
+
 		delete m_status;
 		delete m_info;
 		delete m_searchList;
@@ -183,6 +188,7 @@ namespace jucePluginEditorLib::patchManager
 	void PatchManager::timerCallback()
 	{
 		uiProcess();
+		m_previewCache->uiProcess();
 	}
 
 	void PatchManager::processDirty(const pluginLib::patchDB::Dirty& _dirty) const
@@ -756,10 +762,39 @@ namespace jucePluginEditorLib::patchManager
 	{
 		std::vector<pluginLib::patchDB::PatchPtr> patches;
 
-		for (const auto& file : _files)
+		// reading and parsing is done in parallel, patches are created in file order afterwards
+		std::vector<pluginLib::patchDB::DataList> fileResults;
+		fileResults.resize(_files.size());
+
+		auto load = [&](const size_t _index)
 		{
-			pluginLib::patchDB::DataList results;
-			if(!loadFile(results, file) || results.empty())
+			if(!loadFile(fileResults[_index], _files[_index]))
+				fileResults[_index].clear();
+		};
+
+		if(_files.size() > 1)
+		{
+			const auto threadCount = static_cast<uint32_t>(std::min(_files.size(), static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()))));
+
+			pluginLib::patchDB::JobQueue queue("FileLoader", true, dsp56k::ThreadPriority::Normal, threadCount);
+			pluginLib::patchDB::JobGroup group(queue);
+
+			for(size_t i=0; i<_files.size(); ++i)
+				group.add([&load, i] { load(i); });
+
+			group.wait();
+		}
+		else if(!_files.empty())
+		{
+			load(0);
+		}
+
+		for(size_t f=0; f<_files.size(); ++f)
+		{
+			const auto& file = _files[f];
+			auto& results = fileResults[f];
+
+			if(results.empty())
 				continue;
 
 			const auto defaultName = results.size() == 1 ? baseLib::filesystem::stripExtension(baseLib::filesystem::getFilenameWithoutPath(file)) : "";
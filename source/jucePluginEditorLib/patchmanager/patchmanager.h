@@ -30,6 +30,7 @@ namespace jucePluginEditorLib::patchManager
 	class SearchList;
 	class Info;
 	class ListModel;
+	class PreviewCache;
 	class Tree;
 
 	class PatchManager : public juce::Component, public pluginLib::patchDB::DB, juce::Timer, public juce::ChangeListener
@@ -128,6 +129,11 @@ namespace jucePluginEditorLib::patchManager
 
 		virtual bool activatePatch(const std::string& _filename, uint32_t _part);
 
+		// creates the sysex messages that load a patch into the single mode edit buffer of a freshly booted device, used to render previews
+		virtual bool createPreviewSysex(pluginLib::patchDB::DataList& _result, const pluginLib::patchDB::PatchPtr& _patch) const { return false; }
+
+		PreviewCache& getPreviewCache() const { return *m_previewCache; }
+
 		std::vector<pluginLib::patchDB::PatchPtr> loadPatchesFromFiles(const juce::StringArray& _files);
 		std::vector<pluginLib::patchDB::PatchPtr> loadPatchesFromFiles(const std::vector<std::string>& _files);
 
@@ -182,5 +188,7 @@ namespace jucePluginEditorLib::patchManager
 
 		LayoutType m_layout = LayoutType::List;
 		bool m_firstTimeGridLayout = true;
+
+		std::unique_ptr<PreviewCache> m_previewCache;
 	};
 }
@@ -0,0 +1,454 @@
+#include "previewcache.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "patchmanager.h"
+
+#include "baseLib/binarystream.h"
+
+#include "jucePluginLib/processor.h"
+
+#include "synthLib/device.h"
+#include "synthLib/deviceException.h"
+#include "synthLib/midiTypes.h"
+#include "synthLib/offlineRenderer.h"
+
+namespace jucePluginEditorLib::patchManager
+{
+	namespace
+	{
+		constexpr uint8_t g_previewNote = 60;
+		constexpr uint8_t g_previewVelocity = 100;
+
+		constexpr double g_warmupSeconds = 1.0;			// once per device, gives the firmware time to boot
+		constexpr double g_sysexIntervalSeconds = 0.02;
+		constexpr double g_settleSeconds = 0.25;		// time between sending the patch and the note on
+		constexpr double g_noteSeconds = 1.5;
+		constexpr double g_lengthSeconds = 2.5;
+
+		constexpr size_t g_maxCachedPreviews = 32;
+
+		constexpr char g_chunkPreview[] = "PvAu";
+		constexpr uint32_t g_chunkPreviewVersion = 1;
+
+		uint64_t toSamples(const double _seconds, const float _samplerate)
+		{
+			return static_cast<uint64_t>(_seconds * static_cast<double>(_samplerate));
+		}
+	}
+
+	struct PreviewCache::Worker
+	{
+		std::unique_ptr<synthLib::Device> device;
+		std::unique_ptr<synthLib::OfflineRenderer> renderer;
+	};
+
+	PreviewCache::PreviewCache(PatchManager& _patchManager, pluginLib::Processor& _processor, const juce::File& _dir, uint32_t _threadCount)
+	: m_patchManager(_patchManager)
+	, m_processor(_processor)
+	, m_dir(_dir)
+	, m_jobs("PatchPreview", true, dsp56k::ThreadPriority::Lowest, _threadCount ? _threadCount : std::max(1u, std::thread::hardware_concurrency() >> 2))
+	{
+		try
+		{
+			m_createDevice = _processor.createDeviceFactory();
+		}
+		catch(const synthLib::DeviceException&)
+		{
+			m_deviceFailed = true;
+		}
+	}
+
+	PreviewCache::~PreviewCache()
+	{
+		m_cancel = true;
+		m_jobs.destroy();
+		m_idleWorkers.clear();
+	}
+
+	bool PreviewCache::request(const pluginLib::patchDB::PatchPtr& _patch, const Callback& _callback)
+	{
+		if(!_patch)
+			return false;
+
+		const auto& hash = _patch->hash;
+
+		if(const auto cached = getCached(hash))
+		{
+			if(_callback)
+				_callback(cached);
+			return true;
+		}
+
+		Job job{hash, {}};
+
+		const auto canRender = !m_deviceFailed && m_patchManager.createPreviewSysex(job.sysex, _patch) && !job.sysex.empty();
+
+		if(!canRender && !getFile(hash).existsAsFile())
+			return false;
+
+		if(_callback)
+		{
+			std::scoped_lock lock(m_mutexUi);
+			m_callbacks[hash].push_back(_callback);
+		}
+
+		{
+			std::scoped_lock lock(m_mutexCache);
+			if(!m_inProgress.insert(hash).second)
+				return true;
+		}
+
+		m_jobs.add([this, j = std::move(job)]
+		{
+			process(j);
+		});
+
+		return true;
+	}
+
+	void PreviewCache::prefetch(const std::vector<pluginLib::patchDB::PatchPtr>& _patches)
+	{
+		for (const auto& patch : _patches)
+		{
+			if(m_deviceFailed)
+				break;
+			request(patch);
+		}
+	}
+
+	bool PreviewCache::play(const pluginLib::patchDB::PatchPtr& _patch)
+	{
+		auto& player = m_processor.getPreviewPlayer();
+
+		player.stop();
+
+		return request(_patch, [&player](const pluginLib::PreviewAudioPtr& _audio)
+		{
+			player.play(_audio);
+		});
+	}
+
+	void PreviewCache::stop() const
+	{
+		m_processor.getPreviewPlayer().stop();
+	}
+
+	pluginLib::PreviewAudioPtr PreviewCache::getCached(const pluginLib::patchDB::PatchHash& _hash)
+	{
+		std::scoped_lock lock(m_mutexCache);
+
+		const auto it = m_cache.find(_hash);
+
+		if(it == m_cache.end())
+			return {};
+
+		m_cacheOrder.remove(_hash);
+		m_cacheOrder.push_back(_hash);
+
+		return it->second;
+	}
+
+	void PreviewCache::uiProcess()
+	{
+		std::vector<std::pair<pluginLib::patchDB::PatchHash, pluginLib::PreviewAudioPtr>> finished;
+
+		{
+			std::scoped_lock lock(m_mutexUi);
+
+			if(m_finished.empty())
+				return;
+
+			std::swap(finished, m_finished);
+		}
+
+		for (const auto& [hash, audio] : finished)
+		{
+			std::vector<Callback> callbacks;
+
+			{
+				std::scoped_lock lock(m_mutexUi);
+
+				const auto it = m_callbacks.find(hash);
+				if(it == m_callbacks.end())
+					continue;
+
+				callbacks = std::move(it->second);
+				m_callbacks.erase(it);
+			}
+
+			// a preview that failed to render is not reported, there is nothing to play
+			if(!audio)
+				continue;
+
+			for (const auto& callback : callbacks)
+				callback(audio);
+		}
+	}
+
+	size_t PreviewCache::getPendingCount() const
+	{
+		std::scoped_lock lock(m_mutexCache);
+		return m_inProgress.size();
+	}
+
+	void PreviewCache::process(const Job& _job)
+	{
+		if(m_cancel)
+			return;
+
+		pluginLib::PreviewAudioPtr result;
+
+		const auto file = getFile(_job.hash);
+
+		auto audio = std::make_shared<pluginLib::PreviewAudio>();
+
+		if(load(*audio, file))
+		{
+			result = std::move(audio);
+		}
+		else if(!_job.sysex.empty())
+		{
+			if(auto worker = acquireWorker())
+			{
+				result = render(*worker, _job);
+				releaseWorker(std::move(worker));
+
+				if(result)
+					save(*result, file);
+			}
+		}
+
+		onFinished(_job.hash, result);
+	}
+
+	pluginLib::PreviewAudioPtr PreviewCache::render(Worker& _worker, const Job& _job) const
+	{
+		auto& renderer = *_worker.renderer;
+
+		const auto samplerate = renderer.getSamplerate();
+		const auto channelCount = renderer.getChannelCount();
+
+		if(!channelCount)
+			return {};
+
+		// silence anything that might still be sounding from the previous preview
+		auto pos = renderer.getPosition();
+
+		renderer.addEvent(pos, synthLib::SMidiEvent(synthLib::MidiEventSource::Host, synthLib::M_CONTROLCHANGE, synthLib::MC_ALLSOUNDOFF, 0));
+
+		for (const auto& sysex : _job.sysex)
+		{
+			pos += toSamples(g_sysexIntervalSeconds, samplerate);
+
+			synthLib::SMidiEvent ev(synthLib::MidiEventSource::Host);
+			ev.sysex = sysex;
+			renderer.addEvent(pos, ev);
+		}
+
+		pos += toSamples(g_settleSeconds, samplerate);
+
+		renderer.skip(pos - renderer.getPosition());
+
+		renderer.addEvent(pos, synthLib::SMidiEvent(synthLib::MidiEventSource::Host, synthLib::M_NOTEON, g_previewNote, g_previewVelocity));
+		renderer.addEvent(pos + toSamples(g_noteSeconds, samplerate), synthLib::SMidiEvent(synthLib::MidiEventSource::Host, synthLib::M_NOTEOFF, g_previewNote, 0));
+
+		auto audio = std::make_shared<pluginLib::PreviewAudio>();
+
+		audio->samplerate = samplerate;
+
+		const auto frameCount = toSamples(g_lengthSeconds, samplerate);
+
+		audio->data.reserve(frameCount << 1);
+
+		renderer.render(frameCount, [&](const synthLib::OfflineRenderer::TChannels& _channels, const uint32_t _size)
+		{
+			const auto& l = _channels[0];
+			const auto& r = _channels[channelCount > 1 ? 1 : 0];
+
+			for(uint32_t i=0; i<_size; ++i)
+			{
+				audio->data.push_back(l[i]);
+				audio->data.push_back(r[i]);
+			}
+		});
+
+		return audio;
+	}
+
+	std::unique_ptr<PreviewCache::Worker> PreviewCache::acquireWorker()
+	{
+		{
+			std::scoped_lock lock(m_mutexWorkers);
+
+			if(!m_idleWorkers.empty())
+			{
+				auto w = std::move(m_idleWorkers.back());
+				m_idleWorkers.pop_back();
+				return w;
+			}
+		}
+
+		if(m_deviceFailed)
+			return {};
+
+		auto w = std::make_unique<Worker>();
+
+		try
+		{
+			w->device.reset(m_createDevice());
+		}
+		catch(const synthLib::DeviceException&)
+		{
+		}
+
+		if(!w->device || !w->device->isValid())
+		{
+			m_deviceFailed = true;
+			return {};
+		}
+
+		w->renderer = std::make_unique<synthLib::OfflineRenderer>(*w->device, 0.0f);
+		w->renderer->skip(toSamples(g_warmupSeconds, w->renderer->getSamplerate()));
+
+		return w;
+	}
+
+	void PreviewCache::releaseWorker(std::unique_ptr<Worker> _worker)
+	{
+		std::scoped_lock lock(m_mutexWorkers);
+		m_idleWorkers.emplace_back(std::move(_worker));
+	}
+
+	juce::File PreviewCache::getFile(const pluginLib::patchDB::PatchHash& _hash) const
+	{
+		return m_dir.getChildFile(juce::String::toHexString(_hash.data(), static_cast<int>(_hash.size()), 0) + ".preview");
+	}
+
+	bool PreviewCache::load(pluginLib::PreviewAudio& _audio, const juce::File& _file) const
+	{
+		if(!_file.existsAsFile())
+			return false;
+
+		juce::MemoryBlock fileData;
+
+		if(!_file.loadFileAsData(fileData))
+			return false;
+
+		try
+		{
+			std::vector<uint8_t> data(static_cast<const uint8_t*>(fileData.getData()), static_cast<const uint8_t*>(fileData.getData()) + fileData.getSize());
+
+			baseLib::BinaryStream inStream(data);
+
+			auto s = inStream.tryReadChunk(g_chunkPreview, g_chunkPreviewVersion);
+
+			if(!s)
+				return false;
+
+			const auto samplerate = s.read<float>();
+			const auto frameCount = s.read<uint32_t>();
+
+			std::vector<uint8_t> compressed;
+			s.read(compressed);
+
+			juce::MemoryInputStream compressedStream(compressed.data(), compressed.size(), false);
+			juce::GZIPDecompressorInputStream gzip(compressedStream);
+
+			juce::MemoryBlock pcm;
+			gzip.readIntoMemoryBlock(pcm);
+
+			const auto sampleCount = static_cast<size_t>(frameCount) << 1;
+
+			if(pcm.getSize() != sampleCount * sizeof(int16_t) || samplerate <= 0.0f)
+				return false;
+
+			const auto* src = static_cast<const int16_t*>(pcm.getData());
+
+			_audio.samplerate = samplerate;
+			_audio.data.resize(sampleCount);
+
+			// samples are stored as deltas per channel, which compresses a lot better
+			int16_t last[2]{0,0};
+
+			for(size_t i=0; i<sampleCount; ++i)
+			{
+				auto& l = last[i&1];
+				l = static_cast<int16_t>(l + src[i]);
+				_audio.data[i] = static_cast<float>(l) * (1.0f / 32767.0f);
+			}
+
+			return true;
+		}
+		catch(std::range_error&)
+		{
+			return false;
+		}
+	}
+
+	bool PreviewCache::save(const pluginLib::PreviewAudio& _audio, const juce::File& _file) const
+	{
+		if(!m_dir.createDirectory())
+			return false;
+
+		std::vector<int16_t> pcm;
+		pcm.resize(_audio.data.size());
+
+		int16_t last[2]{0,0};
+
+		for(size_t i=0; i<pcm.size(); ++i)
+		{
+			const auto v = static_cast<int16_t>(std::clamp(_audio.data[i], -1.0f, 1.0f) * 32767.0f);
+			auto& l = last[i&1];
+			pcm[i] = static_cast<int16_t>(v - l);
+			l = v;
+		}
+
+		juce::MemoryOutputStream compressedStream;
+		{
+			juce::GZIPCompressorOutputStream gzip(compressedStream, 9);
+			gzip.write(pcm.data(), pcm.size() * sizeof(int16_t));
+		}
+
+		const auto* compressedData = static_cast<const uint8_t*>(compressedStream.getData());
+
+		baseLib::BinaryStream outStream;
+		{
+			baseLib::ChunkWriter cw(outStream, g_chunkPreview, g_chunkPreviewVersion);
+
+			outStream.write(_audio.samplerate);
+			outStream.write(static_cast<uint32_t>(_audio.getFrameCount()));
+			outStream.write(std::vector<uint8_t>(compressedData, compressedData + compressedStream.getDataSize()));
+		}
+
+		std::vector<uint8_t> buffer;
+		outStream.toVector(buffer);
+
+		return _file.replaceWithData(buffer.data(), buffer.size());
+	}
+
+	void PreviewCache::onFinished(const pluginLib::patchDB::PatchHash& _hash, const pluginLib::PreviewAudioPtr& _audio)
+	{
+		{
+			std::scoped_lock lock(m_mutexCache);
+
+			m_inProgress.erase(_hash);
+
+			if(_audio)
+			{
+				if(m_cache.insert({_hash, _audio}).second)
+					m_cacheOrder.push_back(_hash);
+
+				while(m_cache.size() > g_maxCachedPreviews)
+				{
+					m_cache.erase(m_cacheOrder.front());
+					m_cacheOrder.pop_front();
+				}
+			}
+		}
+
+		std::scoped_lock lock(m_mutexUi);
+		m_finished.emplace_back(_hash, _audio);
+	}
+}
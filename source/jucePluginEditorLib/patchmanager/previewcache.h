@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "jucePluginLib/previewPlayer.h"
+#include "jucePluginLib/patchdb/jobqueue.h"
+#include "jucePluginLib/patchdb/patch.h"
+
+#include "juce_core/juce_core.h"
+
+namespace synthLib
+{
+	class Device;
+	class OfflineRenderer;
+}
+
+namespace pluginLib
+{
+	class Processor;
+}
+
+namespace jucePluginEditorLib::patchManager
+{
+	class PatchManager;
+
+	// Renders short audio previews of patches on offscreen device instances, independent of the device used by the plugin.
+	// Previews are cached in memory and compressed on disk, keyed by patch hash
+	class PreviewCache
+	{
+	public:
+		using Callback = std::function<void(const pluginLib::PreviewAudioPtr&)>;
+
+		PreviewCache(PatchManager& _patchManager, pluginLib::Processor& _processor, const juce::File& _dir, uint32_t _threadCount = 0);
+		~PreviewCache();
+
+		PreviewCache(PreviewCache&&) = delete;
+		PreviewCache(const PreviewCache&) = delete;
+		PreviewCache& operator = (PreviewCache&&) = delete;
+		PreviewCache& operator = (const PreviewCache&) = delete;
+
+		// the callback is invoked on the UI thread once the preview is available. Returns false if the patch cannot be previewed
+		bool request(const pluginLib::patchDB::PatchPtr& _patch, const Callback& _callback = {});
+
+		// renders previews that are not cached yet in the background
+		void prefetch(const std::vector<pluginLib::patchDB::PatchPtr>& _patches);
+
+		bool play(const pluginLib::patchDB::PatchPtr& _patch);
+		void stop() const;
+
+		pluginLib::PreviewAudioPtr getCached(const pluginLib::patchDB::PatchHash& _hash);
+
+		void uiProcess();
+
+		size_t getPendingCount() const;
+		bool isAvailable() const { return !m_deviceFailed; }
+
+	private:
+		struct Worker;
+
+		struct Job
+		{
+			pluginLib::patchDB::PatchHash hash;
+			pluginLib::patchDB::DataList sysex;
+		};
+
+		void process(const Job& _job);
+		pluginLib::PreviewAudioPtr render(Worker& _worker, const Job& _job) const;
+
+		std::unique_ptr<Worker> acquireWorker();
+		void releaseWorker(std::unique_ptr<Worker> _worker);
+
+		juce::File getFile(const pluginLib::patchDB::PatchHash& _hash) const;
+		bool load(pluginLib::PreviewAudio& _audio, const juce::File& _file) const;
+		bool save(const pluginLib::PreviewAudio& _audio, const juce::File& _file) const;
+
+		void onFinished(const pluginLib::patchDB::PatchHash& _hash, const pluginLib::PreviewAudioPtr& _audio);
+
+		PatchManager& m_patchManager;
+		pluginLib::Processor& m_processor;
+		const juce::File m_dir;
+
+		// resolved on the UI thread at construction, the workers create their devices with it
+		std::function<synthLib::Device*()> m_createDevice;
+
+		// cache
+		mutable std::mutex m_mutexCache;
+		std::map<pluginLib::patchDB::PatchHash, pluginLib::PreviewAudioPtr> m_cache;
+		std::list<pluginLib::patchDB::PatchHash> m_cacheOrder;	// least recently used first
+		std::set<pluginLib::patchDB::PatchHash> m_inProgress;
+
+		// ui
+		std::mutex m_mutexUi;
+		std::map<pluginLib::patchDB::PatchHash, std::vector<Callback>> m_callbacks;
+		std::vector<std::pair<pluginLib::patchDB::PatchHash, pluginLib::PreviewAudioPtr>> m_finished;
+
+		// rendering
+		std::mutex m_mutexWorkers;
+		std::vector<std::unique_ptr<Worker>> m_idleWorkers;
+		std::atomic<bool> m_deviceFailed = false;
+		std::atomic<bool> m_cancel = false;
+
+		pluginLib::patchDB::JobQueue m_jobs;
+	};
+}
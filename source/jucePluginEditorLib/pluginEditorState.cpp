@@ -11,6 +11,7 @@
 
 #include "dsp56kEmu/logging.h"
 
+#include "synthLib/deviceMetrics.h"
 #include "synthLib/os.h"
 
 namespace jucePluginEditorLib
@@ -313,6 +314,20 @@ void PluginEditorState::openMenu(const juce::MouseEvent* _event)
 	latencyMenu.addItem("2", true, latency == 2, [this, adjustLatency] { adjustLatency(2); });
 	latencyMenu.addItem("4", true, latency == 4, [this, adjustLatency] { adjustLatency(4); });
 	latencyMenu.addItem("8", true, latency == 8, [this, adjustLatency] { adjustLatency(8); });
+	latencyMenu.addSeparator();
+	latencyMenu.addItem("Automatic (raise if CPU load is high)", true, m_processor.getLatencyAutotune(), [this]
+	{
+		const auto enable = !m_processor.getLatencyAutotune();
+
+		m_processor.setLatencyAutotune(enable);
+
+		if(!enable)
+			return;
+
+		juce::NativeMessageBox::showMessageBox(juce::AlertWindow::WarningIcon, "Warning",
+			"The selected number of blocks is used as minimum and the latency is raised automatically if the CPU cannot keep up.\n"
+			"Most hosts cannot handle if a plugin changes its latency while being in use, timing might be off until the project is reopened.");
+	});
 
 	auto servers = m_remoteServerList.getEntries();
 
@@ -352,9 +367,55 @@ void PluginEditorState::openMenu(const juce::MouseEvent* _event)
 	menu.addSubMenu("GUI Scale", scaleMenu);
 	menu.addSubMenu("Latency (blocks)", latencyMenu);
 
+	{
+		juce::PopupMenu idleMenu;
+
+		const auto idleSleep = m_processor.getIdleSleepSeconds();
+
+		idleMenu.addItem("Off (default)", true, idleSleep <= 0.0f, [this] { m_processor.setIdleSleepSeconds(0.0f); });
+
+		for (const auto seconds : {1.0f, 5.0f, 30.0f})
+		{
+			idleMenu.addItem("After " + std::to_string(static_cast<int>(seconds)) + "s of silence", true, idleSleep == seconds, [this, seconds]
+			{
+				m_processor.setIdleSleepSeconds(seconds);
+			});
+		}
+
+		menu.addSubMenu("Sleep when idle", idleMenu);
+	}
+
+	menu.addItem("Show Performance Statistics...", [this]
+	{
+		synthLib::MetricsSnapshot metrics;
+
+		if(!m_processor.getDeviceMetrics(metrics))
+			return;
+
+		juce::NativeMessageBox::showMessageBoxAsync(juce::AlertWindow::InfoIcon, "Performance Statistics", metrics.toString());
+	});
+
 	if (m_processor.getConfig().getBoolValue("supportDspBridge", false))
 		menu.addSubMenu("Device Type", deviceTypeMenu);
 
+	{
+		const auto isFarm = m_processor.getDeviceType() == pluginLib::DeviceType::Farm;
+
+		juce::PopupMenu farmMenu;
+		farmMenu.addItem("Off (own device, default)", true, !isFarm, [this] { m_processor.setDeviceType(pluginLib::DeviceType::Local); });
+		farmMenu.addSeparator();
+
+		for(uint8_t p=0; p<m_processor.getController().getPartCount(); ++p)
+		{
+			farmMenu.addItem("Part " + std::to_string(p + 1) + " (MIDI channel " + std::to_string(p + 1) + ")", true, isFarm && m_processor.getFarmPart() == p, [this, p]
+			{
+				m_processor.setFarmDevice(p);
+			});
+		}
+
+		menu.addSubMenu("Share Device with other Instances", farmMenu);
+	}
+
 	menu.addSeparator();
 
 	auto& regions = m_processor.getController().getParameterDescriptions().getRegions();
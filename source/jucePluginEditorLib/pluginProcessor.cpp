@@ -47,6 +47,14 @@ namespace jucePluginEditorLib
 		return true;
 	}
 
+	void Processor::setLatencyAutotune(const bool _enabled)
+	{
+		pluginLib::Processor::setLatencyAutotune(_enabled);
+
+		getConfig().setValue("latencyAutotune", _enabled);
+		getConfig().saveIfNeeded();
+	}
+
 	bool Processor::hasEditor() const
 	{
 		return true; // (change this to false if you choose to not supply an editor)
@@ -16,6 +16,7 @@ namespace jucePluginEditorLib
 		juce::PropertiesFile& getConfig() { return m_config; }
 
 		bool setLatencyBlocks(uint32_t _blocks) override;
+		void setLatencyAutotune(bool _enabled) override;
 
 		bool hasEditor() const override;
 		juce::AudioProcessorEditor* createEditor() override;
@@ -1,5 +1,86 @@
 #include "bypassBuffer.h"
 
+#include <algorithm>
+#include <cstring>	// memcpy
+
 namespace pluginLib
 {
+	namespace
+	{
+		constexpr uint32_t g_mask = BypassBuffer::BufferSize - 1;
+		static_assert((BypassBuffer::BufferSize & g_mask) == 0, "buffer size needs to be a power of two");
+	}
+
+	void BypassBuffer::write(const float* _data, const uint32_t _channel, const uint32_t _samples, const uint32_t _latency)
+	{
+		if(_channel >= m_channels.size())
+		{
+			const auto oldSize = m_channels.size();
+
+			m_channels.resize(_channel + 1);
+
+			// a new channel starts with silence at the requested latency, there is nothing to fade from
+			for(auto i=oldSize; i<m_channels.size(); ++i)
+			{
+				m_channels[i].buffer.resize(BufferSize, 0.0f);
+				m_channels[i].latency = std::min(_latency, BufferSize - std::min(_samples, BufferSize));
+			}
+		}
+
+		auto& ch = m_channels[_channel];
+
+		const auto count = std::min(_samples, BufferSize);
+		const auto latency = std::min(_latency, BufferSize - count);
+
+		if(latency != ch.latency)
+		{
+			ch.fadeLatency = ch.latency;
+			ch.fadeRemaining = FadeLength;
+			ch.latency = latency;
+		}
+
+		ch.blockStart = (ch.blockStart + ch.blockSize) & g_mask;
+		ch.blockSize = count;
+
+		const auto first = std::min(count, BufferSize - ch.blockStart);
+
+		memcpy(&ch.buffer[ch.blockStart], _data, first * sizeof(float));
+		memcpy(&ch.buffer[0], _data + first, (count - first) * sizeof(float));
+	}
+
+	void BypassBuffer::read(float* _output, const uint32_t _channel, const uint32_t _samples)
+	{
+		if(_channel >= m_channels.size())
+			return;
+
+		auto& ch = m_channels[_channel];
+
+		const auto count = std::min(_samples, ch.blockSize);
+
+		uint32_t i = 0;
+
+		for(; i<count && ch.fadeRemaining; ++i, --ch.fadeRemaining)
+		{
+			const auto a = ch.buffer[(ch.blockStart + i - ch.fadeLatency) & g_mask];
+			const auto b = ch.buffer[(ch.blockStart + i - ch.latency) & g_mask];
+
+			const auto t = static_cast<float>(FadeLength - ch.fadeRemaining) / static_cast<float>(FadeLength);
+
+			_output[i] = a + (b - a) * t;
+		}
+
+		if(i < count)
+			copy(_output + i, ch, ch.latency, i, count - i);
+
+		std::fill(_output + count, _output + _samples, 0.0f);
+	}
+
+	void BypassBuffer::copy(float* _dst, const Channel& _ch, const uint32_t _latency, const uint32_t _offset, const uint32_t _samples)
+	{
+		const auto start = (_ch.blockStart + _offset - _latency) & g_mask;
+		const auto first = std::min(_samples, BufferSize - start);
+
+		memcpy(_dst, &_ch.buffer[start], first * sizeof(float));
+		memcpy(_dst + first, &_ch.buffer[0], (_samples - first) * sizeof(float));
+	}
 }
@@ -1,54 +1,35 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
-#include "dsp56kEmu/ringbuffer.h"
-
 namespace pluginLib
 {
+	// Delays the dry signal by the latency of the plugin while it is bypassed. If the latency changes, the output
+	// crossfades from the old to the new delay instead of jumping
 	class BypassBuffer
 	{
 	public:
-		using ChannelBuffer = dsp56k::RingBuffer<float, 32768, false, true>;
-
-		void write(const float* _data, uint32_t _channel, uint32_t _samples, uint32_t _latency)
-		{
-			if(_channel >= m_channels.size())
-			{
-				m_channels.resize(_channel + 1);
-				m_latency.resize(_channel + 1);
-			}
-
-			auto& ch = m_channels[_channel];
-			auto& latency = m_latency[_channel];
-
-			while(_latency > latency)
-			{
-				++latency;
-				ch.push_back(0.0f);
-			}
+		static constexpr uint32_t BufferSize = 32768;
+		static constexpr uint32_t FadeLength = 256;
 
-			while(_latency < latency)
-			{
-				--latency;
-				ch.pop_front();
-			}
-
-			for(uint32_t i=0; i<_samples; ++i)
-				ch.push_back(_data[i]);
-		}
-
-		void read(float* _output, uint32_t _channel, const uint32_t _samples)
-		{
-			if(_channel >= m_channels.size())
-				return;
-
-			for(uint32_t i=0; i<_samples; ++i)
-				_output[i] = m_channels[_channel].pop_front();
-		}
+		void write(const float* _data, uint32_t _channel, uint32_t _samples, uint32_t _latency);
+		void read(float* _output, uint32_t _channel, uint32_t _samples);
 
 	private:
-		std::vector<ChannelBuffer> m_channels;
-		std::vector<uint32_t> m_latency;
+		struct Channel
+		{
+			std::vector<float> buffer;
+			uint32_t blockStart = 0;	// buffer position of the first sample of the block that has been written last
+			uint32_t blockSize = 0;
+			uint32_t latency = 0;
+			uint32_t fadeLatency = 0;	// latency that we fade away from
+			uint32_t fadeRemaining = 0;
+		};
+
+		// copies _samples samples, starting at _offset within the last written block, delayed by _latency
+		static void copy(float* _dst, const Channel& _ch, uint32_t _latency, uint32_t _offset, uint32_t _samples);
+
+		std::vector<Channel> m_channels;
 	};
 }
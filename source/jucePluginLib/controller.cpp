@@ -1,6 +1,8 @@
 #include "controller.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <fstream>
 
 #include "parameter.h"
@@ -14,6 +16,19 @@
 
 namespace pluginLib
 {
+	constexpr size_t g_maxQueuedParameterChanges = 4096;
+
+	// if the audio thread did not pick up queued changes for this long, it is not running and changes are sent immediately
+	constexpr uint64_t g_parameterChangeFlushTimeoutMs = 100;
+
+	namespace
+	{
+		uint64_t milliseconds()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+	}
+
 	uint8_t getParameterValue(const Parameter* _p)
 	{
 		return static_cast<uint8_t>(_p->getUnnormalizedValue());
@@ -25,6 +40,13 @@ namespace pluginLib
 		, m_locking(*this)
 		, m_parameterLinks(*this)
 	{
+		m_queuedParameterChanges.reserve(g_maxQueuedParameterChanges);
+		m_sendingParameterChanges.reserve(g_maxQueuedParameterChanges);
+		m_deferredParameterChanges.reserve(g_maxQueuedParameterChanges);
+		m_parameterChangeBatch = ParameterChangeBatch(g_maxQueuedParameterChanges / ParameterChangeBatch::PartCount);
+		m_parameterChangeEvent.source = synthLib::MidiEventSource::Editor;
+		m_parameterChangeEvent.sysex.reserve(ParameterChangeEncoder::MaxSize);
+
 		if(!m_descriptions.isValid())
 		{
 			juce::NativeMessageBox::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, 
@@ -185,9 +207,42 @@ namespace pluginLib
 
 	bool Controller::combineParameterChange(uint8_t& _result, const std::string& _midiPacket, const Parameter& _parameter, ParamValue _value) const
 	{
-		const auto &desc = _parameter.getDescription();
+		std::scoped_lock lock(m_combinedBytesLock);
+
+		auto it = m_combinedBytes.find(&_parameter);
+
+		if(it == m_combinedBytes.end() || it->second.packetName != _midiPacket)
+		{
+			CombinedByte combined;
+
+			if(!createCombinedByte(combined, _midiPacket, _parameter))
+				return false;
+
+			it = m_combinedBytes.insert_or_assign(&_parameter, std::move(combined)).first;
+		}
+
+		const auto& parameters = it->second.parameters;
+
+		if (parameters.empty())
+		{
+			_result = static_cast<uint8_t>(_value);
+			return true;
+		}
+
+		_result = 0;
 
-		std::map<MidiDataType, uint8_t> data;
+		for (const auto& p : parameters)
+		{
+			const auto v = p.parameter == &_parameter ? _value : getParameterValue(p.parameter);
+			_result |= p.definition->packValue(v);
+		}
+
+		return true;
+	}
+
+	bool Controller::createCombinedByte(CombinedByte& _result, const std::string& _midiPacket, const Parameter& _parameter) const
+	{
+		const auto &desc = _parameter.getDescription();
 
 		const auto *packet = getMidiPacket(_midiPacket);
 
@@ -199,7 +254,7 @@ namespace pluginLib
 
 		const ParamIndex idx = {static_cast<uint8_t>(desc.page), _parameter.getPart(), desc.index};
 
-		const auto params = findSynthParam(idx);
+		const auto& params = findSynthParam(idx);
 
 		uint32_t byte = MidiPacket::InvalidIndex;
 
@@ -221,13 +276,10 @@ namespace pluginLib
 		if(!packet->getDefinitionsForByteIndex(definitions, byte))
 			return false;
 
+		_result.packetName = _midiPacket;
+
 		if (definitions.size() == 1)
-		{
-			_result = static_cast<uint8_t>(_value);
 			return true;
-		}
-
-		_result = 0;
 
 	    for (const auto& it : definitions)
 	    {
@@ -239,9 +291,7 @@ namespace pluginLib
 				return false;
 			}
 
-			auto* p = getParameter(i, _parameter.getPart());
-			const auto v = p == &_parameter ? _value : getParameterValue(p);
-			_result |= it->packValue(v);
+			_result.parameters.push_back({getParameter(i, _parameter.getPart()), it});
 	    }
 
 		return true;
@@ -309,13 +359,123 @@ namespace pluginLib
 
 	void Controller::sendLockedParameters(const uint8_t _part)
 	{
-        const auto lockedParameters = m_locking.getLockedParameters(_part);
+		m_locking.getLockedParameterIndices(_part).forEach([&](const uint32_t _index)
+		{
+			if(const auto* p = getParameter(_index, _part))
+				sendParameterChange(*p, static_cast<uint8_t>(p->getUnnormalizedValue()));
+		});
+	}
 
-        for (const auto& p : lockedParameters)
-        {
-	        const auto v = p->getUnnormalizedValue();
-	        sendParameterChange(*p, static_cast<uint8_t>(v));
-        }
+	void Controller::queueParameterChange(Parameter& _parameter, const ParamValue _value, const uint32_t _changeId)
+	{
+		{
+			std::scoped_lock lock(m_queuedParameterChangesLock);
+
+			// the audio thread might not run, for example if the plugin is bypassed
+			const auto audioThreadRunning = milliseconds() - m_lastParameterChangeFlush < g_parameterChangeFlushTimeoutMs;
+
+			if(audioThreadRunning && m_queuedParameterChanges.size() < m_queuedParameterChanges.capacity())
+			{
+				m_queuedParameterChanges.push_back({&_parameter, _value, _changeId});
+				return;
+			}
+		}
+
+		_parameter.sendQueuedChange();
+	}
+
+	void Controller::sendQueuedParameterChanges()
+	{
+		m_lastParameterChangeFlush = milliseconds();
+
+		{
+			std::scoped_lock lock(m_queuedParameterChangesLock);
+
+			if(m_queuedParameterChanges.empty() && m_deferredParameterChanges.empty())
+				return;
+
+			std::swap(m_queuedParameterChanges, m_sendingParameterChanges);
+		}
+
+		// returns true if the change has to wait because of the rate limit
+		const auto collect = [this](const QueuedParameterChange& _change)
+		{
+			auto* p = _change.parameter;
+			bool deferred;
+
+			if(p->takeQueuedChange(_change.value, _change.changeId, deferred))
+				m_parameterChangeBatch.add(p, p->getPart(), _change.value);
+
+			return deferred;
+		};
+
+		// rate limited changes of previous blocks are tried again, they are removed once they are sent or outdated
+		m_deferredParameterChanges.erase(std::remove_if(m_deferredParameterChanges.begin(), m_deferredParameterChanges.end(), [&](const QueuedParameterChange& _change)
+		{
+			return !collect(_change);
+		}), m_deferredParameterChanges.end());
+
+		// a parameter might be in the list multiple times, only the latest change is taken, all others are outdated
+		for (const auto& change : m_sendingParameterChanges)
+		{
+			if(collect(change))
+				m_deferredParameterChanges.push_back(change);
+		}
+
+		m_sendingParameterChanges.clear();
+
+		if(!m_parameterChangeBatch.empty())
+		{
+			sendParameterChanges(m_parameterChangeBatch);
+			m_parameterChangeBatch.clear();
+		}
+	}
+
+	void Controller::sendParameterChanges(const ParameterChangeBatch& _changes)
+	{
+		_changes.forEachPart([this](uint8_t, const ParameterChangeBatch::Changes& _partChanges)
+		{
+			for (const auto& change : _partChanges)
+				sendParameterChange(*change.parameter, change.value);
+		});
+	}
+
+	bool Controller::sendParameterChangeSysEx(const Parameter& _parameter, const std::string& _packetName, const uint8_t _value, const std::function<void(MidiPacket::Data&)>& _createData)
+	{
+		std::scoped_lock lock(m_parameterChangeLock);
+
+		auto it = m_parameterChangeEncoders.find(&_parameter);
+
+		if(it == m_parameterChangeEncoders.end())
+		{
+			const auto* packet = getMidiPacket(_packetName);
+
+			if(!packet)
+			{
+				LOG("Failed to find midi packet " << _packetName);
+				return false;
+			}
+
+			MidiPacket::Data data;
+			_createData(data);
+
+			ParameterChangeEncoder encoder;
+
+			if(!encoder.create(*packet, data))
+				return false;
+
+			it = m_parameterChangeEncoders.insert({&_parameter, encoder}).first;
+		}
+
+		const auto& encoder = it->second;
+
+		// the event is reused, its capacity is reserved in the constructor
+		auto& sysex = m_parameterChangeEvent.sysex;
+		sysex.resize(encoder.size());
+		encoder.encode(sysex.data(), sysex.size(), _value);
+
+		sendMidiEvent(m_parameterChangeEvent);
+		return true;
 	}
 
     juce::Value* Controller::getParamValueObject(const uint32_t _index, const uint8_t _part) const
@@ -507,6 +667,9 @@ namespace pluginLib
 	{
 		if(_part == m_currentPart)
 			return false;
+		// a member of a device farm owns one part of the shared device, it must not edit the parts of the other members
+		if(m_processor.getDeviceType() == DeviceType::Farm && _part != m_processor.getFarmPart())
+			return false;
 		m_currentPart = _part;
 		onCurrentPartChanged(m_currentPart);
 		return true;
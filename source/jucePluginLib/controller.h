@@ -2,12 +2,17 @@
 
 #include "parameterdescriptions.h"
 #include "parameter.h"
+#include "parameterChangeBatch.h"
+#include "parameterChangeEncoder.h"
 #include "parameterlocking.h"
 #include "softknob.h"
 
 #include "synthLib/midiTypes.h"
 
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "parameterlinks.h"
 
@@ -37,6 +42,10 @@ namespace pluginLib
 		virtual void sendParameterChange(const Parameter& _parameter, ParamValue _value) = 0;
 		void sendLockedParameters(uint8_t _part);
 
+		// host automation and changes of linked parameters. Changes are collected and sent when the audio thread calls sendQueuedParameterChanges()
+		void queueParameterChange(Parameter& _parameter, ParamValue _value, uint32_t _changeId);
+		void sendQueuedParameterChanges();
+
         juce::Value* getParamValueObject(uint32_t _index, uint8_t _part) const;
         Parameter* getParameter(uint32_t _index) const;
         Parameter* getParameter(uint32_t _index, uint8_t _part) const;
@@ -116,6 +125,12 @@ namespace pluginLib
 		void sendSysEx(const pluginLib::SysEx &) const;
 		bool sendSysEx(const std::string& _packetName) const;
 		bool sendSysEx(const std::string& _packetName, const std::map<pluginLib::MidiDataType, uint8_t>& _params) const;
+
+		// Sends a parameter change sysex. The sysex is precompiled once per parameter, subsequent changes are encoded
+		// without allocations, see ParameterChangeEncoder. _createData needs to fill everything except the parameter value,
+		// it is only called once
+		bool sendParameterChangeSysEx(const Parameter& _parameter, const std::string& _packetName, uint8_t _value, const std::function<void(MidiPacket::Data&)>& _createData);
+
 		void sendMidiEvent(const synthLib::SMidiEvent& _ev) const;
 		void sendMidiEvent(uint8_t _a, uint8_t _b, uint8_t _c, uint32_t _offset = 0, synthLib::MidiEventSource _source = synthLib::MidiEventSource::Editor) const;
 
@@ -163,7 +178,47 @@ namespace pluginLib
 
 		std::map<const Parameter*, std::unique_ptr<SoftKnob>> m_softKnobs;
 
+		struct QueuedParameterChange
+		{
+			Parameter* parameter;
+			ParamValue value;
+			uint32_t changeId;
+		};
+
+		std::mutex m_queuedParameterChangesLock;
+		std::vector<QueuedParameterChange> m_queuedParameterChanges;
+		std::vector<QueuedParameterChange> m_sendingParameterChanges;
+		std::vector<QueuedParameterChange> m_deferredParameterChanges;
+		ParameterChangeBatch m_parameterChangeBatch;
+		std::atomic<uint64_t> m_lastParameterChangeFlush{0};
+
+		std::mutex m_parameterChangeLock;
+		std::unordered_map<const Parameter*, ParameterChangeEncoder> m_parameterChangeEncoders;
+		synthLib::SMidiEvent m_parameterChangeEvent;
+
+		struct CombinedParameter
+		{
+			const Parameter* parameter = nullptr;
+			const MidiPacket::MidiDataDefinition* definition = nullptr;
+		};
+
+		struct CombinedByte
+		{
+			std::string packetName;
+			std::vector<CombinedParameter> parameters;	// empty if the parameter uses the whole byte
+		};
+
+		bool createCombinedByte(CombinedByte& _result, const std::string& _midiPacket, const Parameter& _parameter) const;
+
+		mutable std::mutex m_combinedBytesLock;
+		mutable std::unordered_map<const Parameter*, CombinedByte> m_combinedBytes;
+
 	protected:
+		// Sends all changes that have been queued during the last audio block. Called on the audio thread. The default
+		// implementation calls sendParameterChange() for each change, devices that are able to receive multiple
+		// parameters with one message should override this
+		virtual void sendParameterChanges(const ParameterChangeBatch& _changes);
+
 		// tries to find synth param in both internal and host
 		const ParameterList& findSynthParam(uint8_t _part, uint8_t _page, uint8_t _paramIndex) const;
 		const ParameterList& findSynthParam(const ParamIndex& _paramIndex) const;
@@ -307,6 +307,12 @@ namespace pluginLib
 		return InvalidIndex;
 	}
 
+	uint32_t MidiPacket::getByteIndexForDefinition(const uint32_t _definitionIndex) const
+	{
+		const auto it = m_definitionToByteIndex.find(_definitionIndex);
+		return it != m_definitionToByteIndex.end() ? it->second : InvalidIndex;
+	}
+
 	uint32_t MidiPacket::getByteIndexForParameterName(const std::string& _name) const
 	{
 		for(uint32_t i=0; i<m_definitions.size(); ++i)
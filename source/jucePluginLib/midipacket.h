@@ -89,7 +89,7 @@ namespace pluginLib
 		MidiPacket() = default;
 		explicit MidiPacket(std::string _name, std::vector<MidiDataDefinition>&& _bytes);
 
-		const std::vector<MidiDataDefinition>& definitions() { return m_definitions; }
+		const std::vector<MidiDataDefinition>& definitions() const { return m_definitions; }
 		uint32_t size() const { return m_byteSize; }
 
 		bool create(std::vector<uint8_t>& _dst, const Data& _data, const NamedParamValues& _paramValues) const;
@@ -102,6 +102,7 @@ namespace pluginLib
 		bool getParameterIndicesForByteIndex(std::vector<ParamIndex>& _result, const ParameterDescriptions& _parameters, uint32_t _byteIndex) const;
 
 		uint32_t getByteIndexForType(MidiDataType _type) const;
+		uint32_t getByteIndexForDefinition(uint32_t _definitionIndex) const;
 		uint32_t getByteIndexForParameterName(const std::string& _name) const;
 		std::vector<uint32_t> getDefinitionIndicesForParameterName(const std::string& _name) const;
 		const MidiDataDefinition *getDefinitionByParameterName(const std::string& _name) const;
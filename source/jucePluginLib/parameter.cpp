@@ -40,6 +40,10 @@ namespace pluginLib
 
     void Parameter::sendToSynth()
     {
+		// the value change notification arrives asynchronously, do not send if the controller is going to send it
+		if(m_queuedChangeId != m_handledChangeId)
+			return;
+
 		const float floatValue = m_value.getValue();
 		const auto value = juce::roundToInt(floatValue);
 
@@ -172,19 +176,79 @@ namespace pluginLib
 	}
 
     void Parameter::setUnnormalizedValue(const int _newValue, const Origin _origin)
+    {
+		// host automation is sent at the start of the next audio block, multiple changes within a block are sent once
+		applyValue(_newValue, _origin, _origin == Origin::HostAutomation);
+    }
+
+    void Parameter::setUnnormalizedValueQueued(const int _newValue, const Origin _origin)
+    {
+		applyValue(_newValue, _origin, true);
+    }
+
+    void Parameter::applyValue(const int _newValue, const Origin _origin, const bool _queue)
     {
 		if (m_changingDerivedValues)
 			return;
 
 		m_lastValueOrigin = _origin;
-		m_value.setValue(clampValue(_newValue));
 
-		if(_origin != Origin::Derived)
+		const auto queue = _queue && _origin != Origin::Derived;
+		const auto value = clampValue(_newValue);
+
+		// the audio thread must not read m_value, the value is passed along with the queued change instead
+		const auto changeId = queue ? ++m_queuedChangeId : 0;
+
+		m_value.setValue(value);
+
+		if(queue)
+			m_controller.queueParameterChange(*this, value, changeId);
+		else if(_origin != Origin::Derived)
 			sendToSynth();
 
 		forwardToDerived(_newValue);
     }
 
+    void Parameter::sendQueuedChange()
+    {
+		m_handledChangeId = m_queuedChangeId.load();
+		sendToSynth();
+    }
+
+    bool Parameter::takeQueuedChange(const ParamValue _value, const uint32_t _changeId, bool& _deferred)
+    {
+		_deferred = false;
+
+		// a parameter might be queued multiple times, only the latest change is sent
+		if(_changeId != m_queuedChangeId)
+			return false;
+
+		if(_value == m_lastValue)
+		{
+			m_handledChangeId = _changeId;
+			return false;
+		}
+
+		const auto ms = milliseconds();
+
+		if(m_rateLimit && m_lastValue != -1 && ms - m_lastSendTime < m_rateLimit)
+		{
+			_deferred = true;
+			return false;
+		}
+
+		// ignore initial update
+		const auto isInitial = m_lastValue.exchange(_value) == -1;
+
+		m_handledChangeId = _changeId;
+
+		if(isInitial)
+			return false;
+
+		m_lastSendTime = ms;
+		return true;
+    }
+
     void Parameter::setValueFromSynth(const int _newValue, const Origin _origin)
 	{
 		const auto clampedValue = clampValue(_newValue);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <set>
 
 #include "parameterdescription.h"
@@ -50,6 +51,10 @@ namespace pluginLib
 		void setValue(float _newValue) override;
 
 		void setUnnormalizedValue(int _newValue, Origin _origin);
+
+		// same as setUnnormalizedValue, but the value is sent to the device at the start of the next audio block,
+		// together with all other queued changes
+		void setUnnormalizedValueQueued(int _newValue, Origin _origin);
 		void setValueNotifyingHost(float _value, Origin _origin);
 		void setUnnormalizedValueNotifyingHost(float _value, Origin _origin);
 		void setUnnormalizedValueNotifyingHost(int _value, Origin _origin);
@@ -92,6 +97,15 @@ namespace pluginLib
 		void pushChangeGesture();
 		void popChangeGesture();
 
+		// sends the current value if it differs from the last value that has been sent
+		void sendQueuedChange();
+
+		// Used by the controller on the audio thread to collect queued changes. _value and _changeId are captured on
+		// the message thread when the change is queued. Returns true if _value needs to be sent to the device, false
+		// if a newer change has been queued or if the device has the value already. _deferred is set to true if the
+		// change has to wait because of the rate limit, it stays queued in this case
+		bool takeQueuedChange(ParamValue _value, uint32_t _changeId, bool& _deferred);
+
 	private:
 
 		struct ScopedChangeGesture
@@ -106,6 +120,7 @@ namespace pluginLib
         static juce::String genId(const Description &d, int part, int uniqueId);
 		void valueChanged(juce::Value &) override;
 		void setDerivedValue(const int _value);
+		void applyValue(int _newValue, Origin _origin, bool _queue);
 		void sendToSynth();
 		static uint64_t milliseconds();
 		void sendParameterChangeDelayed(ParamValue _value, uint32_t _uniqueId);
@@ -120,19 +135,23 @@ namespace pluginLib
 		const uint8_t m_part;
 		const int m_uniqueId;	// 0 for all unique parameters, > 0 if multiple Parameter instances reference a single synth parameter
 
-		int m_lastValue{-1};
+		std::atomic<int> m_lastValue{-1};			// written by the message thread and by the audio thread
 		Origin m_lastValueOrigin = Origin::Unknown;
 		juce::Value m_value;
 		std::set<Parameter*> m_derivedParameters;
 		bool m_changingDerivedValues = false;
 
 		uint32_t m_rateLimit = 0;		// milliseconds
-		uint64_t m_lastSendTime = 0;
+		std::atomic<uint64_t> m_lastSendTime{0};
 		uint32_t m_uniqueDelayCallbackId = 0;
 
 		bool m_isLocked = false;
 		ParameterLinkType m_linkType = None;
 		uint32_t m_changeGestureCount = 0;
 		bool m_notifyingHost = false;
+		// the controller sends queued changes at the start of the next audio block. A change is pending as long as
+		// the id of the last queued change differs from the id of the last handled one
+		std::atomic<uint32_t> m_queuedChangeId{0};
+		std::atomic<uint32_t> m_handledChangeId{0};
     };
 }
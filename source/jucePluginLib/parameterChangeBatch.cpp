@@ -0,0 +1,34 @@
+#include "parameterChangeBatch.h"
+
+namespace pluginLib
+{
+	ParameterChangeBatch::ParameterChangeBatch(const size_t _reservePerPart)
+	{
+		for (auto& part : m_parts)
+			part.reserve(_reservePerPart);
+	}
+
+	void ParameterChangeBatch::add(const Parameter* _parameter, const uint8_t _part, const ParamValue _value)
+	{
+		auto& changes = m_parts[_part & (PartCount - 1)];
+
+		// a block usually contains a few changes per part only, a linear search is faster than any lookup structure
+		for (auto& change : changes)
+		{
+			if(change.parameter != _parameter)
+				continue;
+			change.value = _value;
+			return;
+		}
+
+		changes.push_back({_parameter, _value});
+		++m_size;
+	}
+
+	void ParameterChangeBatch::clear()
+	{
+		for (auto& part : m_parts)
+			part.clear();
+		m_size = 0;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "types.h"
+
+namespace pluginLib
+{
+	class Parameter;
+
+	// Parameter changes that are sent to the device at the start of an audio block, grouped by part. A parameter is
+	// part of a batch only once, adding it again replaces the value. Once the capacity has been reserved, adding
+	// changes does not allocate
+	class ParameterChangeBatch
+	{
+	public:
+		static constexpr uint32_t PartCount = 16;
+
+		struct Change
+		{
+			const Parameter* parameter = nullptr;
+			ParamValue value = 0;
+		};
+
+		using Changes = std::vector<Change>;
+
+		explicit ParameterChangeBatch(size_t _reservePerPart = 0);
+
+		void add(const Parameter* _parameter, uint8_t _part, ParamValue _value);
+		void clear();
+
+		bool empty() const { return m_size == 0; }
+		size_t size() const { return m_size; }
+
+		const Changes& getChanges(const uint8_t _part) const { return m_parts[_part]; }
+
+		// calls _func(uint8_t _part, const Changes& _changes) for every part that has changes
+		template<typename TFunc> void forEachPart(const TFunc& _func) const
+		{
+			for(uint8_t p=0; p<PartCount; ++p)
+			{
+				if(!m_parts[p].empty())
+					_func(p, m_parts[p]);
+			}
+		}
+
+	private:
+		std::array<Changes, PartCount> m_parts;
+		size_t m_size = 0;
+	};
+}
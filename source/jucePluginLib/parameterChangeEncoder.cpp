@@ -0,0 +1,97 @@
+#include "parameterChangeEncoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "dsp56kEmu/logging.h"
+
+namespace pluginLib
+{
+	bool ParameterChangeEncoder::create(const MidiPacket& _packet, const MidiPacket::Data& _data)
+	{
+		m_size = 0;
+		m_checksumCount = 0;
+
+		if(_packet.size() > MaxSize)
+		{
+			LOG("Parameter change packet has " << _packet.size() << " bytes but the encoder supports " << MaxSize << " bytes max");
+			return false;
+		}
+
+		m_valueIndex = _packet.getByteIndexForType(MidiDataType::ParameterValue);
+
+		if(m_valueIndex == MidiPacket::InvalidIndex)
+		{
+			LOG("Parameter change packet does not contain a parameter value");
+			return false;
+		}
+
+		// the value is patched later, any value is fine to create the template
+		auto data = _data;
+		data[MidiDataType::ParameterValue] = 0;
+
+		MidiPacket::Sysex sysex;
+
+		if(!_packet.create(sysex, data))
+			return false;
+
+		const auto& defs = _packet.definitions();
+
+		for(uint32_t i=0; i<defs.size(); ++i)
+		{
+			const auto& d = defs[i];
+
+			if(d.type != MidiDataType::Checksum)
+				continue;
+
+			if(m_checksumCount >= m_checksums.size())
+			{
+				LOG("Parameter change packet has too many checksums");
+				m_checksumCount = 0;
+				return false;
+			}
+
+			auto& c = m_checksums[m_checksumCount++];
+
+			c.byteIndex = static_cast<uint8_t>(_packet.getByteIndexForDefinition(i));
+			c.first = static_cast<uint8_t>(d.checksumFirstIndex);
+			c.last = static_cast<uint8_t>(std::min(d.checksumLastIndex, _packet.size() - 1));
+			c.initValue = d.checksumInitValue;
+		}
+
+		// same order as MidiPacket::create(), a checksum might cover the byte of another checksum
+		std::sort(m_checksums.begin(), m_checksums.begin() + m_checksumCount, [](const Checksum& _a, const Checksum& _b)
+		{
+			return _a.byteIndex < _b.byteIndex;
+		});
+
+		std::copy(sysex.begin(), sysex.end(), m_template.begin());
+		m_size = static_cast<uint32_t>(sysex.size());
+
+		return true;
+	}
+
+	uint32_t ParameterChangeEncoder::encode(uint8_t* _dst, const size_t _dstSize, const uint8_t _value) const
+	{
+		if(_dstSize < m_size)
+			return 0;
+
+		memcpy(_dst, m_template.data(), m_size);
+
+		_dst[m_valueIndex] = _value;
+
+		for(uint32_t i=0; i<m_checksumCount; ++i)
+		{
+			const auto& c = m_checksums[i];
+
+			auto checksum = c.initValue;
+
+			for(uint32_t b = c.first; b <= c.last; ++b)
+				checksum += _dst[b];
+
+			_dst[c.byteIndex] = checksum & 0x7f;
+		}
+
+		return m_size;
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "midipacket.h"
+
+namespace pluginLib
+{
+	// Precompiled parameter change message for one parameter. All bytes except the parameter value are encoded once
+	// when the encoder is created, encoding a value copies that template into a caller provided buffer, inserts the
+	// value and recalculates the checksums. Encoding does not allocate
+	class ParameterChangeEncoder
+	{
+	public:
+		static constexpr uint32_t MaxSize = 32;
+
+		// _data needs to contain everything but the parameter value
+		bool create(const MidiPacket& _packet, const MidiPacket::Data& _data);
+
+		bool isValid() const { return m_size > 0; }
+		uint32_t size() const { return m_size; }
+
+		// writes the message with the given value to _dst. Returns the number of bytes written, 0 if _dst is too small
+		uint32_t encode(uint8_t* _dst, size_t _dstSize, uint8_t _value) const;
+
+	private:
+		struct Checksum
+		{
+			uint8_t byteIndex = 0;
+			uint8_t first = 0;
+			uint8_t last = 0;
+			uint8_t initValue = 0;
+		};
+
+		std::array<uint8_t, MaxSize> m_template{};
+		uint32_t m_size = 0;
+		uint32_t m_valueIndex = MidiPacket::InvalidIndex;
+
+		std::array<Checksum, 4> m_checksums{};
+		uint32_t m_checksumCount = 0;
+	};
+}
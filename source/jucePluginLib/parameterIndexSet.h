@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace pluginLib
+{
+	// Set of parameter indices, stored as a bitset. Indices are the indices of the parameter descriptions
+	class ParameterIndexSet
+	{
+	public:
+		ParameterIndexSet() = default;
+		explicit ParameterIndexSet(const size_t _size) : m_words((_size + 63) >> 6, 0) {}
+
+		void add(const uint32_t _index)
+		{
+			const auto w = _index >> 6;
+			if(w >= m_words.size())
+				m_words.resize(w + 1, 0);
+			m_words[w] |= bit(_index);
+		}
+
+		void remove(const uint32_t _index)
+		{
+			const auto w = _index >> 6;
+			if(w < m_words.size())
+				m_words[w] &= ~bit(_index);
+		}
+
+		bool contains(const uint32_t _index) const
+		{
+			const auto w = _index >> 6;
+			return w < m_words.size() && (m_words[w] & bit(_index));
+		}
+
+		bool empty() const
+		{
+			return std::all_of(m_words.begin(), m_words.end(), [](const uint64_t _w) { return _w == 0; });
+		}
+
+		void clear()
+		{
+			std::fill(m_words.begin(), m_words.end(), 0);
+		}
+
+		size_t count() const
+		{
+			size_t c = 0;
+			for (auto w : m_words)
+			{
+				for(; w; ++c)
+					w &= w - 1;
+			}
+			return c;
+		}
+
+		ParameterIndexSet& operator |= (const ParameterIndexSet& _s)
+		{
+			if(_s.m_words.size() > m_words.size())
+				m_words.resize(_s.m_words.size(), 0);
+			for(size_t i=0; i<_s.m_words.size(); ++i)
+				m_words[i] |= _s.m_words[i];
+			return *this;
+		}
+
+		ParameterIndexSet& operator &= (const ParameterIndexSet& _s)
+		{
+			for(size_t i=0; i<m_words.size(); ++i)
+				m_words[i] &= i < _s.m_words.size() ? _s.m_words[i] : 0;
+			return *this;
+		}
+
+		// returns all indices that are in one set only
+		ParameterIndexSet operator ^ (const ParameterIndexSet& _s) const
+		{
+			ParameterIndexSet res(*this);
+			if(_s.m_words.size() > res.m_words.size())
+				res.m_words.resize(_s.m_words.size(), 0);
+			for(size_t i=0; i<_s.m_words.size(); ++i)
+				res.m_words[i] ^= _s.m_words[i];
+			return res;
+		}
+
+		bool operator == (const ParameterIndexSet& _s) const
+		{
+			const auto& a = m_words.size() >= _s.m_words.size() ? m_words : _s.m_words;
+			const auto& b = m_words.size() >= _s.m_words.size() ? _s.m_words : m_words;
+
+			for(size_t i=0; i<a.size(); ++i)
+			{
+				if(a[i] != (i < b.size() ? b[i] : 0))
+					return false;
+			}
+			return true;
+		}
+
+		bool operator != (const ParameterIndexSet& _s) const
+		{
+			return !(*this == _s);
+		}
+
+		// calls _func(uint32_t _index) for all indices in ascending order
+		template<typename TFunc> void forEach(const TFunc& _func) const
+		{
+			for(size_t i=0; i<m_words.size(); ++i)
+			{
+				auto w = m_words[i];
+				auto index = static_cast<uint32_t>(i << 6);
+
+				for(; w; w >>= 1, ++index)
+				{
+					if(w & 1)
+						_func(index);
+				}
+			}
+		}
+
+	private:
+		static uint64_t bit(const uint32_t _index)
+		{
+			return 1ull << (_index & 63);
+		}
+
+		std::vector<uint64_t> m_words;
+	};
+}
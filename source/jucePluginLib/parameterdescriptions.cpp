@@ -694,6 +694,7 @@ namespace pluginLib
 		}
 
 		std::unordered_map<std::string, const Description*> paramMap;
+		ParameterIndexSet paramIndices(m_descriptions.size());
 
 		if(parameters)
 		{
@@ -726,6 +727,7 @@ namespace pluginLib
 				}
 
 				paramMap.insert({param, desc});
+				paramIndices.add(idx);
 			}
 		}
 
@@ -760,10 +762,12 @@ namespace pluginLib
 					if(paramMap.find(itParam.first) == paramMap.end())
 						paramMap.insert(itParam);
 				}
+
+				paramIndices |= region.getParamIndices();
 			}
 		}
 
-		m_regions.insert({id, ParameterRegion(id, name, std::move(paramMap))});
+		m_regions.insert({id, ParameterRegion(id, name, std::move(paramMap), std::move(paramIndices))});
 	}
 
 	void ParameterDescriptions::parseControllerMap(std::stringstream& _errors, const juce::Array<juce::var>* _controllers)
@@ -64,11 +64,13 @@ namespace pluginLib
 
 		const auto origin = m_source->getChangeOrigin();
 
+		// targets are sent with the next audio block. If many targets are linked, the device receives all of them at once
+		// and the controller can combine them into fewer messages
 		for (auto* p : m_targets)
 		{
 			const auto newTargetValue = p->getUnnormalizedValue() + sourceDiff;
 			const auto clampedTargetValue = p->getDescription().range.clipValue(newTargetValue);
-			p->setUnnormalizedValue(clampedTargetValue, origin);
+			p->setUnnormalizedValueQueued(clampedTargetValue, origin);
 		}
 	}
 }
@@ -65,12 +65,12 @@ namespace pluginLib
 		uint32_t sourceCount = 0;
 		uint32_t targetCount = 0;
 
-		for (const auto& [name, desc] : itRegion->second.getParams())
+		itRegion->second.getParamIndices().forEach([&](const uint32_t _index)
 		{
-			const auto* parameter = m_controller.getParameter(name, _part);
+			const auto* parameter = m_controller.getParameter(_index, _part);
 
 			if(!parameter)
-				continue;
+				return;
 
 			++totalCount;
 
@@ -78,7 +78,7 @@ namespace pluginLib
 
 			if(state & ParameterLinkType::Source)	++sourceCount;
 			if(state & ParameterLinkType::Target)	++targetCount;
-		}
+		});
 
 		ParameterLinkType result = None;
 
@@ -168,16 +168,16 @@ namespace pluginLib
 	{
 		bool res = false;
 
-		for(const auto& [name, desc] : _region.getParams())
+		_region.getParamIndices().forEach([&](const uint32_t _index)
 		{
-			auto* paramSource = m_controller.getParameter(name, _partSource);
-			auto* paramDest = m_controller.getParameter(name, _partDest);
+			auto* paramSource = m_controller.getParameter(_index, _partSource);
+			auto* paramDest = m_controller.getParameter(_index, _partDest);
 
 			if(_enableLink)
 				res |= add(paramSource, paramDest, _applyCurrentSourceToTarget);
 			else
 				res |= remove(paramSource, paramDest);
-		}
+		});
 
 		return res;
 	}
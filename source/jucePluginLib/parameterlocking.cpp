@@ -1,7 +1,5 @@
 #include "parameterlocking.h"
 
-#include <cassert>
-
 #include "controller.h"
 
 namespace pluginLib
@@ -19,14 +17,12 @@ namespace pluginLib
 
 		auto& regions = m_controller.getParameterDescriptions().getRegions();
 
-		const auto it = regions.find(_id);
-
-		if(it == regions.end())
+		if(regions.find(_id) == regions.end())
 			return false;
 
 		lockedRegions.insert(_id);
 
-		setParametersLocked(it->second, _part, true);
+		updateLockedParameters(_part);
 
 		return true;
 	}
@@ -38,16 +34,7 @@ namespace pluginLib
 		if(!lockedRegions.erase(_id))
 			return false;
 
-		auto& regions = m_controller.getParameterDescriptions().getRegions();
-
-		const auto it = regions.find(_id);
-
-		if(it == regions.end())
-			return false;
-
-		lockedRegions.erase(_id);
-
-		setParametersLocked(it->second, _part, false);
+		updateLockedParameters(_part);
 
 		return true;
 	}
@@ -62,73 +49,38 @@ namespace pluginLib
 		return m_lockedRegions[_part].find(_id) != m_lockedRegions[_part].end();
 	}
 
-	std::unordered_set<std::string> ParameterLocking::getLockedParameterNames(const uint8_t _part) const
+	bool ParameterLocking::isParameterLocked(const uint8_t _part, const std::string& _name) const
 	{
-		if(m_lockedRegions[_part].empty())
-			return {};
-
-		std::unordered_set<std::string> result;
-
-		auto& regions = m_controller.getParameterDescriptions().getRegions();
-
-		for (const auto& name : m_lockedRegions[_part])
-		{
-			const auto& it = regions.find(name);
-			if(it == regions.end())
-				continue;
+		if(m_lockedParameters[_part].empty())
+			return false;
 
-			const auto& region = it->second;
-			for (const auto& itParam : region.getParams())
-				result.insert(itParam.first);
-		}
+		const auto index = m_controller.getParameterIndexByName(_name);
 
-		return result;
+		return index != Controller::InvalidParameterIndex && isParameterLocked(_part, index);
 	}
 
-	std::unordered_set<const Parameter*> ParameterLocking::getLockedParameters(const uint8_t _part) const
+	void ParameterLocking::updateLockedParameters(const uint8_t _part)
 	{
-		const auto paramNames = getLockedParameterNames(_part);
+		auto& regions = m_controller.getParameterDescriptions().getRegions();
 
-		std::unordered_set<const Parameter*> results;
+		ParameterIndexSet locked(m_controller.getParameterDescriptions().getDescriptions().size());
 
-		for (const auto& paramName : paramNames)
+		for (const auto& id : m_lockedRegions[_part])
 		{
-			const auto* p = m_controller.getParameter(paramName, _part);
-			assert(p != nullptr);
-			results.insert(p);
+			const auto it = regions.find(id);
+			if(it != regions.end())
+				locked |= it->second.getParamIndices();
 		}
 
-		return results;
-	}
-
-	bool ParameterLocking::isParameterLocked(const uint8_t _part, const std::string& _name) const
-	{
-		auto& regions = m_controller.getParameterDescriptions().getRegions();
+		// a parameter that is part of multiple regions stays locked as long as one of them is locked
+		const auto changed = locked ^ m_lockedParameters[_part];
 
-		const auto& lockedRegions = getLockedRegions(_part);
+		m_lockedParameters[_part] = std::move(locked);
 
-		for (const auto& region : lockedRegions)
+		changed.forEach([&](const uint32_t _index)
 		{
-			const auto& it = regions.find(region);
-			if(it == regions.end())
-				continue;
-
-			if(it->second.containsParameter(_name))
-				return true;
-		}
-		return false;
-	}
-
-	void ParameterLocking::setParametersLocked(const ParameterRegion& _parameterRegion, const uint8_t _part, const bool _locked) const
-	{
-		for (const auto& param : _parameterRegion.getParams())
-		{
-			// if a region is unlocked but other regions still lock the same parameter, do nothing
-			if(!_locked && isParameterLocked(_part, param.first))
-				continue;
-
-			if(auto* p = m_controller.getParameter(param.first, _part))
-				p->setLocked(_locked);
-		}
+			if(auto* p = m_controller.getParameter(_index, _part))
+				p->setLocked(m_lockedParameters[_part].contains(_index));
+		});
 	}
 }
@@ -2,7 +2,6 @@
 
 #include <set>
 #include <string>
-#include <unordered_set>
 #include <array>
 
 #include "parameterregion.h"
@@ -21,17 +20,20 @@ namespace pluginLib
 		bool unlockRegion(uint8_t _part, const std::string& _id);
 		const std::set<std::string>& getLockedRegions(uint8_t _part) const;
 		bool isRegionLocked(uint8_t _part, const std::string& _id);
-		std::unordered_set<std::string> getLockedParameterNames(uint8_t _part) const;
-		std::unordered_set<const Parameter*> getLockedParameters(uint8_t _part) const;
+		const ParameterIndexSet& getLockedParameterIndices(const uint8_t _part) const { return m_lockedParameters[_part]; }
 		bool isParameterLocked(uint8_t _part, const std::string& _name) const;
+		bool isParameterLocked(const uint8_t _part, const uint32_t _index) const { return m_lockedParameters[_part].contains(_index); }
 
 	private:
-		void setParametersLocked(const ParameterRegion& _parameterRegion, uint8_t _part, bool _locked) const;
+		void updateLockedParameters(uint8_t _part);
 
 		std::set<std::string>& getLockedRegions(const uint8_t _part) { return m_lockedRegions[_part]; }
 
 		Controller& m_controller;
 
 		std::array<std::set<std::string>,16> m_lockedRegions;
+
+		// union of the parameters of all locked regions, per part
+		std::array<ParameterIndexSet,16> m_lockedParameters;
 	};
 }
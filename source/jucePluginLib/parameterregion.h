@@ -4,17 +4,19 @@
 #include <unordered_map>
 
 #include "parameterdescription.h"
+#include "parameterIndexSet.h"
 
 namespace pluginLib
 {
 	class ParameterRegion
 	{
 	public:
-		ParameterRegion(std::string _id, std::string _name, std::unordered_map<std::string, const Description*>&& _params);
+		ParameterRegion(std::string _id, std::string _name, std::unordered_map<std::string, const Description*>&& _params, ParameterIndexSet&& _paramIndices);
 
 		const auto& getId() const { return m_id; }
 		const auto& getName() const { return m_name; }
 		const auto& getParams() const { return m_params; }
+		const auto& getParamIndices() const { return m_paramIndices; }
 
 		bool containsParameter(const std::string& _name) const
 		{
@@ -25,5 +27,6 @@ namespace pluginLib
 		const std::string m_id;
 		const std::string m_name;
 		const std::unordered_map<std::string, const Description*> m_params;
+		const ParameterIndexSet m_paramIndices;
 	};
 }
@@ -24,6 +24,7 @@ namespace pluginLib::patchDB
 	DB::DB(juce::File _dir)
 	: m_settingsDir(std::move(_dir))
 	, m_loader("PatchLoader", false, dsp56k::ThreadPriority::Lowest)
+	, m_listWorker("PatchList")
 	{
 		m_settingsDir.createDirectory();
 	}
@@ -864,6 +865,7 @@ namespace pluginLib::patchDB
 
 	void DB::stopLoaderThread()
 	{
+		m_listWorker.destroy();
 		m_loader.destroy();
 	}
 
@@ -875,9 +877,15 @@ namespace pluginLib::patchDB
 		});
 	}
 
-	void DB::runOnUiThread(const std::function<void()>& _func)
+	void DB::runOnListWorker(std::function<void()>&& _func)
 	{
-		m_uiFuncs.push_back(_func);
+		m_listWorker.add(std::move(_func));
+	}
+
+	void DB::runOnUiThread(std::function<void()>&& _func)
+	{
+		std::scoped_lock lock(m_uiMutex);
+		m_uiFuncs.push_back(std::move(_func));
 	}
 
 	void DB::addDataSource(const DataSourceNodePtr& _ds)
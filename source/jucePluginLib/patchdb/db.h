@@ -84,6 +84,10 @@ namespace pluginLib::patchDB
 
 		static std::string createValidFilename(const std::string& _name);
 
+		// the list worker sorts and filters patch lists for the UI. It is separate from the loader to not wait for data sources being scanned
+		void runOnListWorker(std::function<void()>&& _func);
+		void runOnUiThread(std::function<void()>&& _func);
+
 	protected:
 		DataSourceNodePtr addDataSource(const DataSource& _ds, bool _save, const DataSourceLoadedCallback& = [](bool , std::shared_ptr<DataSourceNode>) {});
 
@@ -111,7 +115,6 @@ namespace pluginLib::patchDB
 		void stopLoaderThread();
 
 		void runOnLoaderThread(std::function<void()>&& _func);
-		void runOnUiThread(const std::function<void()>& _func);
 
 	private:
 		void addDataSource(const DataSourceNodePtr& _ds);
@@ -168,6 +171,9 @@ namespace pluginLib::patchDB
 		std::list<std::function<void()>> m_uiFuncs;
 		Dirty m_dirty;
 
+		// list worker, declared after the ui members as its jobs post results to the ui
+		JobQueue m_listWorker;
+
 		// data
 		std::shared_mutex m_dataSourcesMutex;
 		std::map<DataSource, DataSourceNodePtr> m_dataSources;	// we need a key to find duplicates, but at the same time we need pointers to do the parent relation
@@ -0,0 +1,193 @@
+#include "patchlist.h"
+
+#include <algorithm>
+#include <cstring>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "patch.h"
+#include "search.h"
+
+namespace pluginLib::patchDB
+{
+	namespace
+	{
+		struct PatchHashHasher
+		{
+			size_t operator()(const PatchHash& _hash) const
+			{
+				// the hash is already well distributed, no need to hash it again
+				uint64_t a, b;
+				static_assert(sizeof(a) + sizeof(b) == sizeof(PatchHash));
+				memcpy(&a, _hash.data(), sizeof(a));
+				memcpy(&b, _hash.data() + sizeof(a), sizeof(b));
+				return static_cast<size_t>(a ^ (b * 0x9e3779b97f4a7c15ull));
+			}
+		};
+
+		bool lessSource(const DataSourceNodePtr& _a, const DataSourceNodePtr& _b)
+		{
+			if(!_a || !_b)
+				return !_a && _b;
+			return *_a < *_b;
+		}
+
+		void sortEntries(PatchList::Entries& _entries)
+		{
+			// entries are large, sort indices and move every entry only once
+			std::vector<uint32_t> order(_entries.size());
+			for(uint32_t i=0; i<order.size(); ++i)
+				order[i] = i;
+
+			std::sort(order.begin(), order.end(), [&_entries](const uint32_t _a, const uint32_t _b)
+			{
+				const auto& a = _entries[_a];
+				const auto& b = _entries[_b];
+
+				if(a.sourceIndex != b.sourceIndex)
+					return a.sourceIndex < b.sourceIndex;
+				if(a.program != b.program)
+					return a.program < b.program;
+				return a.name < b.name;
+			});
+
+			PatchList::Entries sorted;
+			sorted.reserve(_entries.size());
+
+			for (const auto i : order)
+				sorted.emplace_back(std::move(_entries[i]));
+
+			std::swap(_entries, sorted);
+		}
+	}
+
+	PatchList::EntriesPtr PatchList::createEntries(const Search& _search)
+	{
+		std::vector<PatchPtr> patches;
+
+		{
+			std::shared_lock lock(_search.resultsMutex);
+			patches.assign(_search.results.begin(), _search.results.end());
+		}
+
+		auto entries = createEntries(patches, _search.getSourceType());
+
+		for (auto& e : entries)
+			e.lowercaseName = lowercase(e.name);
+
+		sortEntries(entries);
+
+		return std::make_shared<const Entries>(std::move(entries));
+	}
+
+	PatchList::Entries PatchList::createEntries(const std::vector<PatchPtr>& _patches, const SourceType _sourceType)
+	{
+		const auto sortBySource = _sourceType == SourceType::Folder;
+		const auto sortByProgram = _sourceType == SourceType::File || _sourceType == SourceType::Rom || _sourceType == SourceType::LocalStorage;
+
+		Entries entries;
+		entries.reserve(_patches.size());
+
+		// patches of a folder are sorted by their data source first. Rank all sources once instead of locking and
+		// comparing them for every comparison while sorting
+		std::vector<DataSourceNodePtr> sources;
+		std::vector<const DataSourceNode*> entrySources;
+		std::unordered_map<const DataSourceNode*, uint32_t> sourceIndices;
+
+		if(sortBySource)
+			entrySources.reserve(_patches.size());
+
+		for (const auto& patch : _patches)
+		{
+			auto& e = entries.emplace_back();
+
+			e.patch = patch;
+			e.name = patch->getName();
+
+			if(sortByProgram)
+				e.program = patch->program;
+
+			if(sortBySource)
+			{
+				auto source = patch->source.lock();
+				entrySources.push_back(source.get());
+				if(sourceIndices.insert({source.get(), 0}).second)
+					sources.emplace_back(std::move(source));
+			}
+		}
+
+		if(!sortBySource)
+			return entries;
+
+		std::sort(sources.begin(), sources.end(), &lessSource);
+
+		uint32_t index = 0;
+
+		for(size_t i=0; i<sources.size(); ++i)
+		{
+			// different nodes that compare equal share their index
+			if(i > 0 && lessSource(sources[i-1], sources[i]))
+				++index;
+
+			sourceIndices[sources[i].get()] = index;
+		}
+
+		for(size_t i=0; i<entries.size(); ++i)
+			entries[i].sourceIndex = sourceIndices[entrySources[i]];
+
+		return entries;
+	}
+
+	void PatchList::sort(std::vector<PatchPtr>& _patches, const SourceType _sourceType)
+	{
+		auto entries = createEntries(_patches, _sourceType);
+
+		sortEntries(entries);
+
+		for(size_t i=0; i<entries.size(); ++i)
+			_patches[i] = std::move(entries[i].patch);
+	}
+
+	bool PatchList::filter(const Entries& _entries, const Filter& _filter, const size_t _pageSize, const PageCallback& _onPage)
+	{
+		std::unordered_set<PatchHash, PatchHashHasher> knownHashes;
+		std::unordered_set<std::string_view> knownNames;
+
+		std::vector<PatchPtr> page;
+		page.reserve(std::min(_pageSize, _entries.size()));
+
+		for (const auto& e : _entries)
+		{
+			if(_filter.hideDuplicatesByHash && !knownHashes.insert(e.patch->hash).second)
+				continue;
+
+			if(_filter.hideDuplicatesByName && !knownNames.insert(e.name).second)
+				continue;
+
+			if(!_filter.text.empty() && e.lowercaseName.find(_filter.text) == std::string::npos)
+				continue;
+
+			page.push_back(e.patch);
+
+			if(page.size() < _pageSize)
+				continue;
+
+			if(!_onPage(std::move(page), false))
+				return false;
+
+			page = {};
+			page.reserve(_pageSize);
+		}
+
+		return _onPage(std::move(page), true);
+	}
+
+	std::string PatchList::lowercase(const std::string& _s)
+	{
+		auto t = _s;
+		std::transform(t.begin(), t.end(), t.begin(), tolower);
+		return t;
+	}
+}
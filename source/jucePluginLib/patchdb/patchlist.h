@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "patchdbtypes.h"
+
+namespace pluginLib::patchDB
+{
+	struct Search;
+
+	// Sorting and filtering of search results as displayed in the patch manager list. Sort keys and lowercase names are
+	// computed once per patch when the results change, changing the filter only scans these keys
+	class PatchList
+	{
+	public:
+		struct Filter
+		{
+			std::string text;	// expected to be lowercase
+			bool hideDuplicatesByHash = false;
+			bool hideDuplicatesByName = false;
+
+			bool empty() const
+			{
+				return text.empty() && !hideDuplicatesByHash && !hideDuplicatesByName;
+			}
+
+			bool operator == (const Filter& _f) const
+			{
+				return text == _f.text && hideDuplicatesByHash == _f.hideDuplicatesByHash && hideDuplicatesByName == _f.hideDuplicatesByName;
+			}
+
+			bool operator != (const Filter& _f) const
+			{
+				return !(*this == _f);
+			}
+		};
+
+		struct Entry
+		{
+			PatchPtr patch;
+			uint32_t sourceIndex = 0;	// sort order of the data source, only used for folders
+			uint32_t program = 0;		// only used for sources where the program defines the order
+			std::string name;
+			std::string lowercaseName;
+		};
+
+		using Entries = std::vector<Entry>;
+		using EntriesPtr = std::shared_ptr<const Entries>;
+
+		// returns false to stop filtering
+		using PageCallback = std::function<bool(std::vector<PatchPtr>&& _page, bool _last)>;
+
+		// creates sorted entries for the current results of a search
+		static EntriesPtr createEntries(const Search& _search);
+
+		// creates unsorted entries with sort keys only, lowercase names are not created
+		static Entries createEntries(const std::vector<PatchPtr>& _patches, SourceType _sourceType);
+
+		static void sort(std::vector<PatchPtr>& _patches, SourceType _sourceType);
+
+		// Passes all patches that match the filter to _onPage, in pages of _pageSize patches. The last page is always
+		// sent, even if it is empty. Returns false if the callback stopped filtering
+		static bool filter(const Entries& _entries, const Filter& _filter, size_t _pageSize, const PageCallback& _onPage);
+
+		static std::string lowercase(const std::string& _s);
+	};
+}
@@ -0,0 +1,75 @@
+#include "previewPlayer.h"
+
+namespace pluginLib
+{
+	void PreviewPlayer::play(PreviewAudioPtr _audio)
+	{
+		if(_audio && _audio->empty())
+			_audio.reset();
+
+		PreviewAudioPtr previous;	// released outside of the lock
+		{
+			std::scoped_lock lock(m_mutex);
+			previous = std::move(m_pending);
+			m_pending = std::move(_audio);
+			m_hasPending = true;
+			m_playing = m_pending != nullptr;
+		}
+	}
+
+	void PreviewPlayer::stop()
+	{
+		play({});
+	}
+
+	void PreviewPlayer::process(const synthLib::TAudioOutputs& _outputs, const uint32_t _channelCount, const uint32_t _numSamples, const float _hostSamplerate)
+	{
+		{
+			std::unique_lock lock(m_mutex, std::try_to_lock);
+
+			if(lock.owns_lock() && m_hasPending)
+			{
+				// swap instead of assign, the previous buffer is released by the UI thread on the next call to play()
+				std::swap(m_current, m_pending);
+				m_hasPending = false;
+				m_position = 0.0;
+			}
+		}
+
+		if(!m_current || _hostSamplerate <= 0.0f || !_channelCount)
+			return;
+
+		const auto& audio = *m_current;
+		const auto frameCount = audio.getFrameCount();
+		const auto* src = audio.data.data();
+
+		// linear interpolation is fine for auditioning, the preview has been rendered at the device samplerate
+		const double step = static_cast<double>(audio.samplerate) / static_cast<double>(_hostSamplerate);
+
+		float* outL = _outputs[0];
+		float* outR = _channelCount > 1 ? _outputs[1] : nullptr;
+
+		uint32_t i = 0;
+
+		for(; i<_numSamples; ++i)
+		{
+			const auto idx = static_cast<size_t>(m_position);
+
+			if(idx + 1 >= frameCount)
+				break;
+
+			const auto frac = static_cast<float>(m_position - static_cast<double>(idx));
+
+			const auto* a = &src[idx<<1];
+			const auto* b = a + 2;
+
+			if(outL)	outL[i] += a[0] + (b[0] - a[0]) * frac;
+			if(outR)	outR[i] += a[1] + (b[1] - a[1]) * frac;
+
+			m_position += step;
+		}
+
+		if(i < _numSamples)
+			m_playing = false;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "synthLib/audioTypes.h"
+
+namespace pluginLib
+{
+	struct PreviewAudio
+	{
+		float samplerate = 0.0f;
+		std::vector<float> data;	// interleaved stereo
+
+		size_t getFrameCount() const { return data.size() >> 1; }
+		bool empty() const { return data.empty() || samplerate <= 0.0f; }
+	};
+
+	using PreviewAudioPtr = std::shared_ptr<const PreviewAudio>;
+
+	// Plays rendered patch previews by mixing them into the plugin output. play() and stop() are called from the UI thread,
+	// process() from the audio thread, which never waits for the UI. Buffers are released on the UI thread only
+	class PreviewPlayer
+	{
+	public:
+		void play(PreviewAudioPtr _audio);
+		void stop();
+
+		bool isPlaying() const { return m_playing; }
+
+		void process(const synthLib::TAudioOutputs& _outputs, uint32_t _channelCount, uint32_t _numSamples, float _hostSamplerate);
+
+	private:
+		std::mutex m_mutex;
+		PreviewAudioPtr m_pending;
+		bool m_hasPending = false;
+
+		PreviewAudioPtr m_current;
+		double m_position = 0.0;
+		std::atomic<bool> m_playing = false;
+	};
+}
@@ -12,6 +12,7 @@
 #include "client/remoteDevice.h"
 
 #include "synthLib/deviceException.h"
+#include "synthLib/deviceFarm.h"
 #include "synthLib/os.h"
 #include "synthLib/midiBufferParser.h"
 #include "synthLib/romLoader.h"
@@ -105,8 +106,13 @@ namespace pluginLib
 	Controller& Processor::getController()
 	{
 	    if (m_controller == nullptr)
+	    {
 	        m_controller.reset(createController());
 
+	        if(m_deviceType == DeviceType::Farm)
+	            m_controller->setCurrentPart(m_farmPart);
+	    }
+
 	    return *m_controller;
 	}
 
@@ -165,12 +171,15 @@ namespace pluginLib
 		}
 
 		m_device->setDspClockPercent(m_dspClockPercent);
+		m_device->setIdleSleepSeconds(m_idleSleepSeconds);
 
 		m_plugin.reset(new synthLib::Plugin(m_device.get(), [this](synthLib::Device* _device)
 		{
 			return onDeviceInvalid(_device);
 		}));
 
+		m_plugin->setLatencyAutotune(m_latencyAutotune && !isNonRealtime());
+
 		return *m_plugin;
 	}
 
@@ -194,6 +203,23 @@ namespace pluginLib
 		return createRemoteDevice(params);
 	}
 
+	synthLib::Device* Processor::createFarmDevice()
+	{
+		// all instances of this plugin in the current process share one device
+		return new synthLib::FarmDevice({}, getProperties().name, m_farmPart, [this]
+		{
+			return createDevice();
+		});
+	}
+
+	Processor::DeviceFactory Processor::createDeviceFactory()
+	{
+		return [this]
+		{
+			return createDevice();
+		};
+	}
+
 	synthLib::Device* Processor::createDevice(const DeviceType _type)
 	{
 		switch (_type)
@@ -201,6 +227,7 @@ namespace pluginLib
 		case DeviceType::Local:		return createDevice();
 		case DeviceType::Remote:	return createRemoteDevice();
 		case DeviceType::Dummy:		return new DummyDevice({});
+		case DeviceType::Farm:		return createFarmDevice();
 		}
 		return nullptr;
 	}
@@ -221,6 +248,34 @@ namespace pluginLib
 			setLatencySamples(getPlugin().getLatencyInputToOutput());
 	}
 
+	void Processor::setLatencyAutotune(const bool _enabled)
+	{
+		m_latencyAutotune = _enabled;
+		applyLatencyAutotune();
+	}
+
+	void Processor::applyLatencyAutotune()
+	{
+		if(!m_plugin)
+			return;
+
+		// timing is meaningless while rendering offline
+		m_plugin->setLatencyAutotune(m_latencyAutotune && !isNonRealtime());
+		updateLatencySamples();
+	}
+
+	void Processor::setNonRealtime(const bool _isNonRealtime) noexcept
+	{
+		AudioProcessor::setNonRealtime(_isNonRealtime);
+		applyLatencyAutotune();
+	}
+
+	void Processor::handleAsyncUpdate()
+	{
+		// latency has been changed by autotune on the audio thread, hosts expect to be informed on the message thread
+		updateLatencySamples();
+	}
+
 	void Processor::saveCustomData(std::vector<uint8_t>& _targetBuffer)
 	{
 		baseLib::BinaryStream s;
@@ -256,6 +311,18 @@ namespace pluginLib
 			s.write(m_preferredDeviceSamplerate);
 		}
 
+		if(m_idleSleepSeconds > 0)
+		{
+			baseLib::ChunkWriter cw(s, "IDLE", 1);
+			s.write(m_idleSleepSeconds);
+		}
+
+		if(m_deviceType == DeviceType::Farm)
+		{
+			baseLib::ChunkWriter cw(s, "FARM", 1);
+			s.write(m_farmPart);
+		}
+
 		m_midiPorts.saveChunkData(s);
 	}
 
@@ -307,6 +374,16 @@ namespace pluginLib
 			setPreferredDeviceSamplerate(sr);
 		});
 
+		_cr.add("IDLE", 1, [this](baseLib::BinaryStream& _binaryStream, uint32_t _version)
+		{
+			setIdleSleepSeconds(_binaryStream.read<float>());
+		});
+
+		_cr.add("FARM", 1, [this](baseLib::BinaryStream& _binaryStream, uint32_t _version)
+		{
+			setFarmDevice(_binaryStream.read<uint8_t>());
+		});
+
 		m_midiPorts.loadChunkData(_cr);
 	}
 
@@ -336,6 +413,13 @@ namespace pluginLib
 		return m_device->getDspClockPercent();
 	}
 
+	void Processor::setIdleSleepSeconds(const float _seconds)
+	{
+		m_idleSleepSeconds = std::max(0.0f, _seconds);
+		if(m_device)
+			m_device->setIdleSleepSeconds(m_idleSleepSeconds);
+	}
+
 	uint64_t Processor::getDspClockHz() const
 	{
 		if(!m_device)
@@ -343,6 +427,14 @@ namespace pluginLib
 		return m_device->getDspClockHz();
 	}
 
+	bool Processor::getDeviceMetrics(synthLib::MetricsSnapshot& _snapshot) const
+	{
+		if(!m_device)
+			return false;
+		_snapshot = m_device->getMetrics().getSnapshot();
+		return true;
+	}
+
 	bool Processor::setPreferredDeviceSamplerate(const float _samplerate)
 	{
 		m_preferredDeviceSamplerate = _samplerate;
@@ -446,6 +538,7 @@ namespace pluginLib
 				getPlugin().setDevice(dev);
 				(void)m_device.release();
 				m_device.reset(dev);
+				m_device->setIdleSleepSeconds(m_idleSleepSeconds);
 				m_deviceType = _type;
 			}
 		}
@@ -471,6 +564,19 @@ namespace pluginLib
 		setDeviceType(DeviceType::Remote, true);
 	}
 
+	void Processor::setFarmDevice(const uint8_t _part)
+	{
+		if(m_farmPart == _part && m_deviceType == DeviceType::Farm)
+			return;
+
+		m_farmPart = _part;
+		setDeviceType(DeviceType::Farm, true);
+
+		// parameter changes and patches of our editor are sent for the current part
+		if(m_deviceType == DeviceType::Farm && m_controller)
+			m_controller->setCurrentPart(m_farmPart);
+	}
+
 	void Processor::destroyController()
 	{
 		m_controller.reset();
@@ -678,10 +784,19 @@ namespace pluginLib
 			}
 		}
 
+		// host automation of this block reaches the device before the block is rendered
+		if(hasController())
+			m_controller->sendQueuedParameterChanges();
+
 		getPlugin().process(inputs, outputs, numSamples, bpm, ppqPos, isPlaying);
 
+		if(getPlugin().pollLatencyChanged())
+			triggerAsyncUpdate();
+
 		applyOutputGain(outputs, numSamples);
 
+		m_previewPlayer.process(outputs, static_cast<uint32_t>(totalNumOutputChannels), static_cast<uint32_t>(numSamples), m_hostSamplerate);
+
 		m_midiOut.clear();
 		getPlugin().getMidiOut(m_midiOut);
 
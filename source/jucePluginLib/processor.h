@@ -6,6 +6,7 @@
 #include "bypassBuffer.h"
 #include "controller.h"
 #include "midiports.h"
+#include "previewPlayer.h"
 
 #include "bridgeLib/types.h"
 
@@ -30,13 +31,14 @@ namespace baseLib
 namespace synthLib
 {
 	struct DeviceCreateParams;
+	struct MetricsSnapshot;
 	class Plugin;
 	struct SMidiEvent;
 }
 
 namespace pluginLib
 {
-	class Processor : public juce::AudioProcessor
+	class Processor : public juce::AudioProcessor, juce::AsyncUpdater
 	{
 	public:
 		struct BinaryDataRef
@@ -72,10 +74,16 @@ namespace pluginLib
 
 		synthLib::Plugin& getPlugin();
 
+		using DeviceFactory = std::function<synthLib::Device*()>;
+
 		virtual synthLib::Device* createDevice() = 0;
+		// Resolves the current device settings and returns a function that creates a local device from them. Needs to
+		// be called on the UI thread, the returned function can be invoked on any thread
+		virtual DeviceFactory createDeviceFactory();
 		virtual bridgeClient::RemoteDevice* createRemoteDevice(const synthLib::DeviceCreateParams& _params);
 		virtual void getRemoteDeviceParams(synthLib::DeviceCreateParams& _params) const;
 		virtual bridgeClient::RemoteDevice* createRemoteDevice();
+		virtual synthLib::Device* createFarmDevice();
 		synthLib::Device* createDevice(DeviceType _type);
 
 		bool hasController() const
@@ -85,6 +93,8 @@ namespace pluginLib
 
 		virtual bool setLatencyBlocks(uint32_t _blocks);
 		virtual void updateLatencySamples();
+		virtual void setLatencyAutotune(bool _enabled);
+		bool getLatencyAutotune() const { return m_latencyAutotune; }
 
 		virtual void saveCustomData(std::vector<uint8_t>& _targetBuffer);
 		virtual void saveChunkData(baseLib::BinaryStream& s);
@@ -122,6 +132,9 @@ namespace pluginLib
 		bool setDspClockPercent(uint32_t _percent = 100);
 		uint32_t getDspClockPercent() const;
 		uint64_t getDspClockHz() const;
+		void setIdleSleepSeconds(float _seconds);
+		float getIdleSleepSeconds() const { return m_idleSleepSeconds; }
+		bool getDeviceMetrics(synthLib::MetricsSnapshot& _snapshot) const;
 
 		bool setPreferredDeviceSamplerate(float _samplerate);
 		float getPreferredDeviceSamplerate() const;
@@ -137,6 +150,7 @@ namespace pluginLib
 		bool rebootDevice();
 
 		auto& getMidiPorts() { return m_midiPorts; }
+		auto& getPreviewPlayer() { return m_previewPlayer; }
 
 		std::optional<std::pair<const char*, uint32_t>> findResource(const std::string& _filename) const;
 
@@ -151,6 +165,8 @@ namespace pluginLib
 
 		void setDeviceType(DeviceType _type, bool _forceChange = false);
 		void setRemoteDevice(const std::string& _host, uint32_t _port);
+		void setFarmDevice(uint8_t _part);
+		auto getFarmPart() const { return m_farmPart; }
 		const auto& getRemoteDeviceHost() const { return m_remoteHost; }
 		const auto& getRemoteDevicePort() const { return m_remotePort; }
 
@@ -162,6 +178,9 @@ namespace pluginLib
 	private:
 		void prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock) override;
 		void releaseResources() override;
+		void setNonRealtime(bool _isNonRealtime) noexcept override;
+		void handleAsyncUpdate() override;
+		void applyLatencyAutotune();
 
 		//==============================================================================
 		bool isBusesLayoutSupported(const BusesLayout&) const override;
@@ -209,13 +228,17 @@ namespace pluginLib
 		float m_outputGain = 1.0f;
 		float m_inputGain = 1.0f;
 		uint32_t m_dspClockPercent = 100;
+		float m_idleSleepSeconds = 0.0f;
+		bool m_latencyAutotune = false;
 		float m_preferredDeviceSamplerate = 0.0f;
 		float m_hostSamplerate = 0.0f;
 		MidiPorts m_midiPorts;
 		BypassBuffer m_bypassBuffer;
+		PreviewPlayer m_previewPlayer;
 		DeviceType m_deviceType = DeviceType::Local;
 		std::string m_remoteHost;
 		uint32_t m_remotePort = 0;
 		bridgeLib::SessionId m_remoteSessionId;
+		uint8_t m_farmPart = 0;
 	};
 }
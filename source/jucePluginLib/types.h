@@ -19,6 +19,7 @@ namespace pluginLib
 	{
 		Local,
 		Remote,
-		Dummy
+		Dummy,
+		Farm
 	};
 }
@@ -40,6 +40,7 @@ namespace mqJucePlugin
 		getController();
 		const auto latencyBlocks = getConfig().getIntValue("latencyBlocks", static_cast<int>(getPlugin().getLatencyBlocks()));
 		Processor::setLatencyBlocks(latencyBlocks);
+		Processor::setLatencyAutotune(getConfig().getBoolValue("latencyAutotune", false));
 	}
 
 	AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
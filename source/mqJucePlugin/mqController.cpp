@@ -32,7 +32,8 @@ namespace mqJucePlugin
 	    "emuRequestLcd",
 	    "emuRequestLeds",
 	    "emuSendButton",
-	    "emuSendRotary"
+	    "emuSendRotary",
+	    "emuFrontPanelClosed"
 	};
 
 	static_assert(std::size(g_midiPacketNames) == static_cast<size_t>(Controller::MidiPacketType::Count));
@@ -431,8 +432,6 @@ namespace mqJucePlugin
 	{
 		const auto &desc = _parameter.getDescription();
 
-		std::map<pluginLib::MidiDataType, uint8_t> data;
-
 		if (desc.page >= 100)
 		{
 			uint8_t v;
@@ -447,12 +446,13 @@ namespace mqJucePlugin
 			if(desc.page > 100)
 				idx += (static_cast<uint32_t>(mqLib::MultiParameter::Inst1) - static_cast<uint32_t>(mqLib::MultiParameter::Inst0)) * (desc.page - 101);
 
-			data.insert(std::make_pair(pluginLib::MidiDataType::Part, _parameter.getPart()));
-			data.insert(std::make_pair(pluginLib::MidiDataType::Page, idx >> 7));
-			data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, idx & 0x7f));
-			data.insert(std::make_pair(pluginLib::MidiDataType::ParameterValue, v));
-
-			sendSysEx(MultiParameterChange, data);
+			sendParameterChangeSysEx(_parameter, midiPacketName(MultiParameterChange), v, [&](pluginLib::MidiPacket::Data& _data)
+			{
+				_data.insert(std::make_pair(pluginLib::MidiDataType::Part, _parameter.getPart()));
+				_data.insert(std::make_pair(pluginLib::MidiDataType::Page, idx >> 7));
+				_data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, idx & 0x7f));
+				_data.insert(std::make_pair(pluginLib::MidiDataType::DeviceId, m_deviceId));
+			});
 			return;
 		}
 
@@ -460,12 +460,13 @@ namespace mqJucePlugin
 		if (!combineParameterChange(v, g_midiPacketNames[SingleDump], _parameter, _value))
 			return;
 
-		data.insert(std::make_pair(pluginLib::MidiDataType::Part, _parameter.getPart()));
-		data.insert(std::make_pair(pluginLib::MidiDataType::Page, desc.page));
-		data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, desc.index));
-		data.insert(std::make_pair(pluginLib::MidiDataType::ParameterValue, v));
-
-		sendSysEx(SingleParameterChange, data);
+		sendParameterChangeSysEx(_parameter, midiPacketName(SingleParameterChange), v, [&](pluginLib::MidiPacket::Data& _data)
+		{
+			_data.insert(std::make_pair(pluginLib::MidiDataType::Part, _parameter.getPart()));
+			_data.insert(std::make_pair(pluginLib::MidiDataType::Page, desc.page));
+			_data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, desc.index));
+			_data.insert(std::make_pair(pluginLib::MidiDataType::DeviceId, m_deviceId));
+		});
 	}
 
 	bool Controller::sendGlobalParameterChange(mqLib::GlobalParameter _param, uint8_t _value)
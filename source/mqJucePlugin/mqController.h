@@ -35,6 +35,7 @@ namespace mqJucePlugin
 	        EmuRequestLeds,
 	        EmuSendButton,
 	        EmuSendRotary,
+	        EmuFrontPanelClosed,
 
 	        Count
 	    };
@@ -115,6 +115,9 @@ namespace mqJucePlugin
 
 	FrontPanel::~FrontPanel()
 	{
+		// the device stops sending LCD and LED updates until they are requested again
+		m_controller.sendSysEx(Controller::EmuFrontPanelClosed);
+
 		m_controller.setFrontPanel(nullptr);
 		m_lcd.reset();
 	}
@@ -114,4 +114,22 @@ namespace mqJucePlugin
 		m_controller.sendSingle(applyModifications(_patch), static_cast<uint8_t>(_part));
 		return true;
 	}
+
+	bool PatchManager::createPreviewSysex(pluginLib::patchDB::DataList& _result, const pluginLib::patchDB::PatchPtr& _patch) const
+	{
+		auto data = applyModifications(_patch);
+
+		if (data.size() != std::tuple_size_v<mqLib::State::Single> && 
+			data.size() != std::tuple_size_v<mqLib::State::SingleQ>)
+			return false;
+
+		data[wLib::IdxBuffer] = static_cast<uint8_t>(mqLib::MidiBufferNum::SingleEditBufferSingleMode);
+		data[wLib::IdxLocation] = 0;
+		data[wLib::IdxDeviceId] = 0;
+
+		mqLib::State::updateChecksum(data);
+
+		_result.emplace_back(std::move(data));
+		return true;
+	}
 }
@@ -20,6 +20,7 @@ namespace mqJucePlugin
 		pluginLib::patchDB::Data applyModifications(const pluginLib::patchDB::PatchPtr& _patch) const override;
 		uint32_t getCurrentPart() const override;
 		bool activatePatch(const pluginLib::patchDB::PatchPtr& _patch, uint32_t _part) override;
+		bool createPreviewSysex(pluginLib::patchDB::DataList& _result, const pluginLib::patchDB::PatchPtr& _patch) const override;
 
 	private:
 		Editor& m_editor;
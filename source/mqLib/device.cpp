@@ -23,6 +23,7 @@ namespace mqLib
 
 		auto* hw = m_mq.getHardware();
 		hw->resetMidiCounter();
+		hw->setMetrics(&getMetrics());
 	}
 
 	Device::~Device() = default;
@@ -70,6 +71,20 @@ namespace mqLib
 		return 6;
 	}
 
+	bool Device::setHeadless(const bool _headless)
+	{
+		m_mq.setHeadless(_headless);
+		return true;
+	}
+
+	bool Device::setPartOutput(const uint8_t _part, const uint32_t _outputPair)
+	{
+		// the output pairs are Main, Sub 1 and Sub 2
+		if(_outputPair >= 3)
+			return false;
+		return m_state.setInstrumentOutput(_part, static_cast<uint8_t>(_outputPair));
+	}
+
 	void Device::readMidiOut(std::vector<synthLib::SMidiEvent>& _midiOut)
 	{
 		m_mq.receiveMidi(m_midiOutBuffer);
@@ -104,6 +119,10 @@ namespace mqLib
 
 		m_mq.process(inputs, outputs, static_cast<uint32_t>(_samples), getExtraLatencySamples());
 
+		// nobody displays the front panel until it has been requested once
+		if(!m_sysexRemote.isFrontPanelRequested())
+			return;
+
 		const auto dirty = static_cast<uint32_t>(m_mq.getDirtyFlags());
 
 		m_sysexRemote.handleDirtyFlags(m_customSysexOut, dirty);
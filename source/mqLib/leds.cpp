@@ -63,12 +63,11 @@ namespace mqLib
 		return true;
 	}
 
-	bool Leds::ret(const bool _changed) const
+	bool Leds::ret(const bool _changed)
 	{
 		if(!_changed)
 			return false;
-		if(m_changeCallback)
-			m_changeCallback();
+		m_version.fetch_add(1, std::memory_order_release);
 		return true;
 	}
 }
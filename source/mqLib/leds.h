@@ -1,7 +1,7 @@
 #pragma once
 
 #include <array>
-#include <functional>
+#include <atomic>
 #include <cstdint>
 
 namespace mc68k
@@ -13,8 +13,6 @@ namespace mqLib
 	class Leds
 	{
 	public:
-		using ChangeCallback = std::function<void()>;
-
 		enum class Led
 		{
 			// group			1				2			3				4			5
@@ -31,17 +29,16 @@ namespace mqLib
 		bool exec(const mc68k::Port& _portF, const mc68k::Port& _portGP, const mc68k::Port& _portE);
 
 		auto getLedState(Led _led) const { return m_ledState[static_cast<uint32_t>(_led)]; }
-		
-		void setChangeCallback(const ChangeCallback& _callback)
-		{
-			m_changeCallback = _callback;
-		}
+
+		// incremented whenever one or more LEDs change their state
+		uint32_t getVersion() const { return m_version.load(std::memory_order_acquire); }
+
 	private:
 		bool setLed(uint32_t _index, uint32_t _value);
-		bool ret(bool _changed) const;
+		bool ret(bool _changed);
 
-		std::array<uint32_t, static_cast<uint32_t>(Led::Count)> m_ledState;
-		uint32_t m_stateF7;
-		ChangeCallback m_changeCallback;
+		std::array<uint32_t, static_cast<uint32_t>(Led::Count)> m_ledState{};
+		uint32_t m_stateF7 = 0;
+		std::atomic<uint32_t> m_version{0};
 	};
 }
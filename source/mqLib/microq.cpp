@@ -3,8 +3,6 @@
 #include "synthLib/midiTypes.h"
 #include "synthLib/deviceException.h"
 
-#include "dsp56kEmu/threadtools.h"
-
 #include "mqhardware.h"
 #include "romloader.h"
 
@@ -41,30 +39,7 @@ namespace mqLib
 
 		m_midiOutBuffer.reserve(1024);
 
-		m_ucThread.reset(new std::thread([&]()
-		{
-			dsp56k::ThreadTools::setCurrentThreadPriority(dsp56k::ThreadPriority::Highest);
-			dsp56k::ThreadTools::setCurrentThreadName("MC68331");
-			while(!m_destroy)
-				processUcThread();
-			m_destroy = false;
-			m_hw->ucThreadTerminated();
-		}));
-
-		m_hw->getUC().getLeds().setChangeCallback([this]()
-		{
-			onLedsChanged();
-		});
-
-		m_hw->getUC().getLcd().setChangeCallback([this]()
-		{
-			onLcdChanged();
-		});
-
-		m_hw->getUC().getLcd().setCgRamChangeCallback([this]()
-		{
-			onLcdCgRamChanged();
-		});
+		m_hw->startUc();
 
 		setButton(Buttons::ButtonType::Play, true);
 		m_hw->initVoiceExpansion();
@@ -78,20 +53,17 @@ namespace mqLib
 		// we need to have passed the boot stage
 		m_hw->processAudio(1);
 
-		m_destroy = true;
-
-		// DSP needs to run to let the uc thread wake up
+		// DSP needs to run to let a uc quantum that is currently executed finish
 		const auto& esai = m_hw->getDSP().getPeriph().getEsai();
-		while(m_destroy)
+		m_hw->stopUc([&]
 		{
 			if(!esai.getAudioOutputs().empty())
 				m_hw->processAudio(1);
 			else
 				std::this_thread::yield();
-		}
+		});
 
-		m_ucThread->join();
-		m_ucThread.reset();
+		m_hw->ucThreadTerminated();
 		m_hw.reset();
 	}
 
@@ -203,47 +175,37 @@ namespace mqLib
 
 	MicroQ::DirtyFlags MicroQ::getDirtyFlags()
 	{
-		const auto f = m_dirtyFlags.exchange(0);
-		return static_cast<DirtyFlags>(f);
-	}
+		auto& uc = m_hw->getUC();
 
-	Hardware* MicroQ::getHardware()
-	{
-		return m_hw.get();
-	}
+		uint32_t f = 0;
 
-	bool MicroQ::isBootCompleted() const
-	{
-		return m_hw && m_hw->isBootCompleted();
-	}
+		auto check = [&f](uint32_t& _lastVersion, const uint32_t _version, DirtyFlags _flag)
+		{
+			if(_version == _lastVersion)
+				return;
+			_lastVersion = _version;
+			f |= static_cast<uint32_t>(_flag);
+		};
 
-	void MicroQ::onLedsChanged()
-	{
-		m_dirtyFlags.fetch_or(static_cast<uint32_t>(DirtyFlags::Leds));
+		check(m_lastLedsVersion, uc.getLeds().getVersion(), DirtyFlags::Leds);
+		check(m_lastLcdVersion, uc.getLcd().getVersion(), DirtyFlags::Lcd);
+		check(m_lastLcdCgRamVersion, uc.getLcd().getCgRamVersion(), DirtyFlags::LcdCgRam);
+
+		return static_cast<DirtyFlags>(f);
 	}
 
-	void MicroQ::onLcdChanged()
+	void MicroQ::setHeadless(const bool _headless)
 	{
-		m_dirtyFlags.fetch_or(static_cast<uint32_t>(DirtyFlags::Lcd));
+		m_hw->getUC().setHeadless(_headless);
 	}
 
-	void MicroQ::onLcdCgRamChanged()
+	Hardware* MicroQ::getHardware()
 	{
-		m_dirtyFlags.fetch_or(static_cast<uint32_t>(DirtyFlags::LcdCgRam));
+		return m_hw.get();
 	}
 
-	void MicroQ::processUcThread() const
+	bool MicroQ::isBootCompleted() const
 	{
-		for(size_t i=0; i<32; ++i)
-		{
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-		}
+		return m_hw && m_hw->isBootCompleted();
 	}
 }
@@ -103,6 +103,11 @@ namespace mqLib
 		// Dirty flags are sticky but are reset upon calling this function
 		DirtyFlags getDirtyFlags();
 
+		// In headless mode, the UC thread skips everything that is only needed to display the front panel: LEDs are not
+		// decoded and LCD changes are not tracked. Front panel state might be outdated until it changes again after
+		// headless mode has been left. Does not affect audio
+		void setHeadless(bool _headless);
+
 		// Gain access to the hardware implementation, intended for advanced use. Usually not required
 		Hardware* getHardware();
 
@@ -111,11 +116,6 @@ namespace mqLib
 
 	private:
 		void internalProcess(uint32_t _frames, uint32_t _latency);
-		void onLedsChanged();
-		void onLcdChanged();
-		void onLcdCgRamChanged();
-
-		void processUcThread() const;
 
 		std::unique_ptr<Hardware> m_hw;
 
@@ -123,8 +123,9 @@ namespace mqLib
 
 		std::vector<uint8_t> m_midiOutBuffer;
 
-		std::unique_ptr<std::thread> m_ucThread;
-		bool m_destroy = false;
-		std::atomic<uint32_t> m_dirtyFlags = 0;
+		// versions seen by the last call to getDirtyFlags()
+		uint32_t m_lastLedsVersion = 0;
+		uint32_t m_lastLcdVersion = 0;
+		uint32_t m_lastLcdCgRamVersion = 0;
 	};
 }
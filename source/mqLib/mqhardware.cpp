@@ -175,9 +175,10 @@ namespace mqLib
 		}, 0);
 	}
 
-	void Hardware::processUcCycle()
+	bool Hardware::processUcCycle()
 	{
-		syncUcToDSP();
+		if(!syncUcToDSP())
+			return false;
 
 		const auto deltaCycles = m_uc.exec();
 		if(m_esaiFrameIndex > 0)
@@ -203,6 +204,8 @@ namespace mqLib
 			}
 			m_uc.notifyDSPBooted();
 		}
+
+		return true;
 	}
 
 	void Hardware::setGlobalDefaultParameters()
@@ -307,6 +310,7 @@ namespace mqLib
 			{
 				// reduce thread contention by waiting for output buffer to be full enough to let us grab the data without entering the read mutex too often
 
+				const synthLib::ScopedMetricTimer timer(m_metrics, synthLib::MetricType::HostWaitForDsp);
 				std::unique_lock uLock(m_requestedFramesAvailableMutex);
 				m_requestedFrames = requiredSize;
 				m_requestedFramesAvailableCv.wait(uLock, [&]()
@@ -320,6 +324,9 @@ namespace mqLib
 
 			esai.processAudioOutputInterleaved(outputs, processCount);
 
+			if(m_metrics)
+				m_metrics->add(synthLib::MetricType::AudioOutputFill, esai.getAudioOutputs().size());
+
 			if constexpr (g_useVoiceExpansion)
 			{
 				for (uint32_t i = 1; i < 3; ++i)
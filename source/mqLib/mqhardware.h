@@ -66,7 +66,7 @@ namespace mqLib
 	private:
 		void setupEsaiListener();
 		void hdiProcessUCtoDSPNMIIrq();
-		void processUcCycle();
+		bool processUcCycle() override;
 		void setGlobalDefaultParameters();
 
 		const ROM m_rom;
@@ -109,6 +109,12 @@ namespace mqLib
 		m_dspResetCompleted = true;
 	}
 
+	void MqMc::setHeadless(const bool _headless)
+	{
+		m_headless = _headless;
+		m_lcd.setTrackChanges(!_headless);
+	}
+
 	uint16_t MqMc::readImm16(uint32_t addr)
 	{
 		if(addr < g_memorySize)
@@ -384,8 +390,9 @@ namespace mqLib
 //			if(s.find("SIG") != std::string::npos)
 //				dumpMemory("SIG");
 		}
-		else
+		else if(!m_headless)
 		{
+			// LEDs are output only, the firmware never reads them back
 			m_leds.exec(getPortF(), getPortGP(), getPortE());
 		}
 	}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <memory>
 
@@ -37,6 +38,9 @@ namespace mqLib
 		MqHdi08B& getHdi08B() { return m_hdi08b; }
 		MqHdi08C& getHdi08C() { return m_hdi08c; }
 
+		// skips LED decoding and LCD change tracking, see MicroQ::setHeadless
+		void setHeadless(bool _headless);
+
 		bool requestDSPReset() const { return m_dspResetRequest; }
 		void notifyDSPBooted();
 
@@ -80,6 +84,7 @@ namespace mqLib
 		std::list<uint32_t> m_lastPCs;
 		bool m_dspResetRequest = false;
 		bool m_dspResetCompleted = false;
+		std::atomic<bool> m_headless{false};
 
 #if SUPPORT_NMI_INTERRUPT
 		uint8_t m_dspInjectNmiRequest = 0;
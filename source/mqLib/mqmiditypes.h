@@ -26,7 +26,8 @@ namespace mqLib
 		EmuLEDs = 0x51,
 		EmuButtons = 0x52,
 		EmuRotaries = 0x53,
-		EmuLCDCGRata = 0x54
+		EmuLCDCGRata = 0x54,
+		EmuFrontPanelClosed = 0x55
 	};
 
 	enum class MidiBufferNum : uint8_t
@@ -234,6 +234,28 @@ namespace mqLib
 		return loadState(_state);
 	}
 
+	bool State::setInstrumentOutput(const uint8_t _instrument, const uint8_t _output)
+	{
+		if(_instrument >= 16)
+			return false;
+
+		Responses unused;
+
+		// the parameter changes are forwarded to the device in the same way as the ones of the editor
+		if(getGlobalParameter(GlobalParameter::SingleMultiMode) == 0)
+		{
+			constexpr auto p = static_cast<uint32_t>(GlobalParameter::SingleMultiMode);
+
+			receive(unused, SysEx{0xf0, wLib::IdWaldorf, IdMicroQ, wLib::IdDeviceOmni, static_cast<uint8_t>(SysexCommand::GlobalParameterChange),
+				static_cast<uint8_t>(p >> 7), static_cast<uint8_t>(p & 0x7f), 1, 0xf7}, Origin::External);
+		}
+
+		const auto p = static_cast<uint32_t>(MultiParameter::Inst0Output) + _instrument * (static_cast<uint32_t>(MultiParameter::Inst1) - static_cast<uint32_t>(MultiParameter::Inst0));
+
+		return receive(unused, SysEx{0xf0, wLib::IdWaldorf, IdMicroQ, wLib::IdDeviceOmni, static_cast<uint8_t>(SysexCommand::MultiParameterChange),
+			static_cast<uint8_t>(p >> 7), static_cast<uint8_t>(p & 0x7f), _output, 0xf7}, Origin::External);
+	}
+
 	bool State::setSingleName(std::vector<uint8_t>& _sysex, const std::string& _name)
 	{
 		if (getCommand(_sysex) != SysexCommand::SingleDump)
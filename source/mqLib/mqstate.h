@@ -90,6 +90,9 @@ namespace mqLib
 		bool getState(std::vector<uint8_t>& _state, synthLib::StateType _type) const;
 		bool setState(const std::vector<uint8_t>& _state, synthLib::StateType _type);
 
+		// switches to multi mode if needed and routes a multi instrument to an output, 0 = Main, 1 = Sub 1, 2 = Sub 2
+		bool setInstrumentOutput(uint8_t _instrument, uint8_t _output);
+
 		static bool setSingleName(std::vector<uint8_t>& _sysex, const std::string& _name);
 		static bool setCategory(std::vector<uint8_t>& _sysex, const std::string& _name);
 
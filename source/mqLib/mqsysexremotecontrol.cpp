@@ -102,7 +102,7 @@ namespace mqLib
 		response.push_back(0xf7);
 	}
 
-	bool SysexRemoteControl::receive(std::vector<synthLib::SMidiEvent>& _output, const std::vector<unsigned char>& _input) const
+	bool SysexRemoteControl::receive(std::vector<synthLib::SMidiEvent>& _output, const std::vector<unsigned char>& _input)
 	{
 		if(_input.size() < 5)
 			return false;
@@ -115,11 +115,16 @@ namespace mqLib
 		switch (static_cast<SysexCommand>(cmd))
 		{
 		case SysexCommand::EmuLCD:
+			m_frontPanelRequested = true;
 			sendSysexLCD(_output);
 			return true;
 		case SysexCommand::EmuLCDCGRata:
+			m_frontPanelRequested = true;
 			sendSysexLCDCGRam(_output);
 			return true;
+		case SysexCommand::EmuFrontPanelClosed:
+			m_frontPanelRequested = false;
+			return true;
 		case SysexCommand::EmuButtons:
 			{
 				if(_input.size() > 6)
@@ -136,6 +141,7 @@ namespace mqLib
 			return true;
 		case SysexCommand::EmuLEDs:
 			{
+				m_frontPanelRequested = true;
 				sendSysexLEDs(_output);
 			}
 			return true;
@@ -26,10 +26,14 @@ namespace mqLib
 		void sendSysexLEDs(std::vector<synthLib::SMidiEvent>& _dst) const;
 		void sendSysexRotaries(std::vector<synthLib::SMidiEvent>& _dst) const;
 
-		bool receive(std::vector<synthLib::SMidiEvent>& _output, const std::vector<uint8_t>& _input) const;
+		bool receive(std::vector<synthLib::SMidiEvent>& _output, const std::vector<uint8_t>& _input);
 		void handleDirtyFlags(std::vector<synthLib::SMidiEvent>& _output, uint32_t _dirtyFlags) const;
 
+		// true once the LCD or the LEDs have been requested, front panel updates are sent until the editor closes
+		bool isFrontPanelRequested() const { return m_frontPanelRequested; }
+
 	private:
 		MicroQ& m_mq;
+		bool m_frontPanelRequested = false;
 	};
 }
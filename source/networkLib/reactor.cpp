@@ -0,0 +1,438 @@
+#include "reactor.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>	// strerror
+
+#include "logging.h"
+#include "tcpSession.h"
+#include "tcpStream.h"
+
+#ifdef _WIN32
+#	include <winsock2.h>
+#else
+#	include <cerrno>
+#	include <fcntl.h>
+#	include <poll.h>
+#	include <unistd.h>
+#	ifdef __linux__
+#		define NETWORKLIB_EPOLL
+#		include <sys/epoll.h>
+#		include <sys/eventfd.h>
+#	endif
+#endif
+
+namespace networkLib
+{
+	namespace
+	{
+		struct PollEvent
+		{
+			int handle = -1;
+			bool readable = false;
+			bool writable = false;
+		};
+
+		constexpr uint32_t g_maxEventsPerWait = 64;
+	}
+
+	// Waits for socket events. epoll on Linux, poll/WSAPoll on other platforms
+	class Reactor::Poller
+	{
+	public:
+		Poller()
+		{
+#if defined(NETWORKLIB_EPOLL)
+			m_epoll = epoll_create1(EPOLL_CLOEXEC);
+			m_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+			epoll_event ev{};
+			ev.events = EPOLLIN;
+			ev.data.fd = m_wakeup;
+			epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &ev);
+
+			if(m_epoll < 0 || m_wakeup < 0)
+				LOGNET(LogLevel::Error, "Failed to create epoll instance, error " << errno << ": " << strerror(errno));
+#elif !defined(_WIN32)
+			int fds[2];
+			if(pipe(fds) == 0)
+			{
+				m_wakeupRead = fds[0];
+				m_wakeupWrite = fds[1];
+				fcntl(m_wakeupRead, F_SETFL, fcntl(m_wakeupRead, F_GETFL, 0) | O_NONBLOCK);
+				fcntl(m_wakeupWrite, F_SETFL, fcntl(m_wakeupWrite, F_GETFL, 0) | O_NONBLOCK);
+			}
+			else
+			{
+				LOGNET(LogLevel::Error, "Failed to create wakeup pipe, error " << errno << ": " << strerror(errno));
+			}
+#endif
+		}
+
+		~Poller()
+		{
+#if defined(NETWORKLIB_EPOLL)
+			if(m_wakeup >= 0)
+				::close(m_wakeup);
+			if(m_epoll >= 0)
+				::close(m_epoll);
+#elif !defined(_WIN32)
+			if(m_wakeupRead >= 0)
+				::close(m_wakeupRead);
+			if(m_wakeupWrite >= 0)
+				::close(m_wakeupWrite);
+#endif
+		}
+
+		Poller(const Poller&) = delete;
+		Poller& operator = (const Poller&) = delete;
+
+		void add(const int _handle)
+		{
+#if defined(NETWORKLIB_EPOLL)
+			epoll_event ev{};
+			ev.events = EPOLLIN | EPOLLRDHUP;
+			ev.data.fd = _handle;
+			epoll_ctl(m_epoll, EPOLL_CTL_ADD, _handle, &ev);
+#else
+			m_handles[_handle] = false;
+#endif
+		}
+
+		void remove(const int _handle)
+		{
+#if defined(NETWORKLIB_EPOLL)
+			epoll_event ev{};
+			epoll_ctl(m_epoll, EPOLL_CTL_DEL, _handle, &ev);
+#else
+			m_handles.erase(_handle);
+#endif
+		}
+
+		void setWriteInterest(const int _handle, const bool _write)
+		{
+#if defined(NETWORKLIB_EPOLL)
+			epoll_event ev{};
+			ev.events = EPOLLIN | EPOLLRDHUP | (_write ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+			ev.data.fd = _handle;
+			epoll_ctl(m_epoll, EPOLL_CTL_MOD, _handle, &ev);
+#else
+			const auto it = m_handles.find(_handle);
+			if(it != m_handles.end())
+				it->second = _write;
+#endif
+		}
+
+		void wakeup() const
+		{
+#if defined(NETWORKLIB_EPOLL)
+			constexpr uint64_t one = 1;
+			[[maybe_unused]] const auto res = ::write(m_wakeup, &one, sizeof(one));
+#elif !defined(_WIN32)
+			constexpr uint8_t one = 1;
+			[[maybe_unused]] const auto res = ::write(m_wakeupWrite, &one, sizeof(one));
+#endif
+		}
+
+		void wait(std::vector<PollEvent>& _events)
+		{
+			_events.clear();
+
+#if defined(NETWORKLIB_EPOLL)
+			std::array<epoll_event, g_maxEventsPerWait> events;
+
+			const auto count = epoll_wait(m_epoll, events.data(), static_cast<int>(events.size()), -1);
+
+			for(int i=0; i<count; ++i)
+			{
+				const auto& e = events[i];
+
+				if(e.data.fd == m_wakeup)
+				{
+					uint64_t value;
+					[[maybe_unused]] const auto res = ::read(m_wakeup, &value, sizeof(value));
+					continue;
+				}
+
+				PollEvent& pe = _events.emplace_back();
+				pe.handle = e.data.fd;
+				pe.readable = (e.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0;
+				pe.writable = (e.events & EPOLLOUT) != 0;
+			}
+#else
+			m_pollFds.clear();
+
+#	ifdef _WIN32
+			// no wakeup handle available, pending changes are picked up after a short timeout
+			constexpr int timeout = 10;
+#	else
+			constexpr int timeout = -1;
+			m_pollFds.push_back({m_wakeupRead, POLLIN, 0});
+#	endif
+
+			for (const auto& [handle, write] : m_handles)
+			{
+				pollfd& p = m_pollFds.emplace_back();
+				p.fd = handle;
+				p.events = static_cast<short>(POLLIN | (write ? POLLOUT : 0));
+				p.revents = 0;
+			}
+
+			if(m_pollFds.empty())
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(timeout > 0 ? timeout : 10));
+				return;
+			}
+
+#	ifdef _WIN32
+			const auto count = WSAPoll(m_pollFds.data(), static_cast<ULONG>(m_pollFds.size()), timeout);
+#	else
+			const auto count = ::poll(m_pollFds.data(), static_cast<nfds_t>(m_pollFds.size()), timeout);
+#	endif
+			if(count <= 0)
+				return;
+
+			for (const auto& p : m_pollFds)
+			{
+				if(!p.revents)
+					continue;
+
+#	ifndef _WIN32
+				if(p.fd == m_wakeupRead)
+				{
+					uint8_t buf[64];
+					while(::read(m_wakeupRead, buf, sizeof(buf)) > 0)
+					{
+					}
+					continue;
+				}
+#	endif
+				PollEvent& pe = _events.emplace_back();
+				pe.handle = static_cast<int>(p.fd);
+				pe.readable = (p.revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+				pe.writable = (p.revents & POLLOUT) != 0;
+			}
+#endif
+		}
+
+	private:
+#if defined(NETWORKLIB_EPOLL)
+		int m_epoll = -1;
+		int m_wakeup = -1;
+#else
+#	ifndef _WIN32
+		int m_wakeupRead = -1;
+		int m_wakeupWrite = -1;
+#	endif
+		std::unordered_map<int, bool> m_handles;	// handle => want write
+		std::vector<pollfd> m_pollFds;
+#endif
+	};
+
+	Reactor::Reactor(uint32_t _workerCount) : m_poller(std::make_unique<Poller>())
+	{
+		if(!_workerCount)
+			_workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+		m_ioThread.reset(new std::thread([this]
+		{
+			ioThreadFunc();
+		}));
+
+		m_workers.reserve(_workerCount);
+
+		for(uint32_t i=0; i<_workerCount; ++i)
+		{
+			m_workers.emplace_back([this]
+			{
+				workerThreadFunc();
+			});
+		}
+
+		LOGNET(LogLevel::Info, "Network reactor started with " << _workerCount << " worker threads");
+	}
+
+	Reactor::~Reactor()
+	{
+		m_exit = true;
+
+		m_poller->wakeup();
+		m_cvWork.notify_all();
+
+		m_ioThread->join();
+		m_ioThread.reset();
+
+		for (auto& worker : m_workers)
+			worker.join();
+		m_workers.clear();
+
+		m_work.clear();
+		m_sessions.clear();
+		m_pendingAdd.clear();
+	}
+
+	std::shared_ptr<TcpSession> Reactor::createSession(std::unique_ptr<TcpStream> _stream)
+	{
+		return std::make_shared<TcpSession>(*this, std::move(_stream));
+	}
+
+	std::shared_ptr<Reactor> Reactor::getShared()
+	{
+		static std::mutex mutex;
+		static std::weak_ptr<Reactor> instance;
+
+		std::scoped_lock lock(mutex);
+
+		auto reactor = instance.lock();
+
+		if(!reactor)
+		{
+			reactor = std::make_shared<Reactor>(SharedWorkerCount);
+			instance = reactor;
+		}
+
+		return reactor;
+	}
+
+	void Reactor::add(const std::shared_ptr<TcpSession>& _session)
+	{
+		{
+			std::scoped_lock lock(m_mutexPending);
+			m_pendingAdd.push_back(_session);
+		}
+		m_poller->wakeup();
+	}
+
+	void Reactor::requestUpdate(const int _handle)
+	{
+		{
+			std::scoped_lock lock(m_mutexPending);
+			m_pendingUpdate.push_back(_handle);
+		}
+		m_poller->wakeup();
+	}
+
+	void Reactor::schedule(std::shared_ptr<TcpSession> _session)
+	{
+		{
+			std::scoped_lock lock(m_mutexWork);
+			m_work.emplace_back(std::move(_session));
+		}
+		m_cvWork.notify_one();
+	}
+
+	void Reactor::ioThreadFunc()
+	{
+		std::vector<PollEvent> events;
+		events.reserve(g_maxEventsPerWait);
+
+		while(!m_exit)
+		{
+			processPending();
+
+			m_poller->wait(events);
+
+			for (const auto& e : events)
+			{
+				const auto it = m_sessions.find(e.handle);
+
+				if(it == m_sessions.end())
+					continue;
+
+				const auto& session = it->second;
+
+				if(e.writable)
+					m_poller->setWriteInterest(e.handle, session->onWritable());
+
+				if(e.readable && !session->onReadable())
+					remove(e.handle);
+				else if(!session->isValid())
+					remove(e.handle);
+			}
+		}
+
+		for (const auto& [handle, session] : m_sessions)
+			m_poller->remove(handle);
+	}
+
+	void Reactor::workerThreadFunc()
+	{
+		while(true)
+		{
+			std::shared_ptr<TcpSession> session;
+			{
+				std::unique_lock lock(m_mutexWork);
+
+				m_cvWork.wait(lock, [this]
+				{
+					return m_exit || !m_work.empty();
+				});
+
+				if(m_exit)
+					return;
+
+				session = std::move(m_work.front());
+				m_work.pop_front();
+			}
+
+			session->process();
+		}
+	}
+
+	void Reactor::processPending()
+	{
+		std::vector<std::shared_ptr<TcpSession>> added;
+		std::vector<int> updated;
+		{
+			std::scoped_lock lock(m_mutexPending);
+			std::swap(added, m_pendingAdd);
+			std::swap(updated, m_pendingUpdate);
+		}
+
+		for (auto& session : added)
+		{
+			const auto handle = session->getHandle();
+
+			m_poller->add(handle);
+			m_sessions.insert({handle, session});
+
+			// a send may have been queued and data may have arrived before the session was started
+			if(session->hasPendingSend())
+				m_poller->setWriteInterest(handle, true);
+
+			if(!session->isValid())
+				remove(handle);
+			else if(!session->onReadable())
+				remove(handle);
+		}
+
+		for (const auto handle : updated)
+		{
+			const auto it = m_sessions.find(handle);
+
+			if(it == m_sessions.end())
+				continue;
+
+			if(!it->second->isValid())
+				remove(handle);
+			else if(it->second->hasPendingSend())
+				m_poller->setWriteInterest(handle, true);
+		}
+	}
+
+	void Reactor::remove(const int _handle)
+	{
+		const auto it = m_sessions.find(_handle);
+
+		if(it == m_sessions.end())
+			return;
+
+		auto session = it->second;
+
+		m_poller->remove(_handle);
+		m_sessions.erase(it);
+
+		session->onRemoved();
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace networkLib
+{
+	class TcpSession;
+	class TcpStream;
+
+	// Event driven network core. A single IO thread waits for socket events of all sessions (epoll on Linux, poll
+	// elsewhere) and a small fixed pool of worker threads delivers the received data to the session handlers.
+	// The handler of a session is never called concurrently and receives the data in order
+	class Reactor
+	{
+	public:
+		static constexpr uint32_t SharedWorkerCount = 2;
+
+		explicit Reactor(uint32_t _workerCount = 0);	// 0 = one worker per hardware thread
+		~Reactor();
+
+		Reactor(const Reactor&) = delete;
+		Reactor(Reactor&&) = delete;
+		Reactor& operator = (const Reactor&) = delete;
+		Reactor& operator = (Reactor&&) = delete;
+
+		// the session does not deliver any data before TcpSession::start() has been called
+		std::shared_ptr<TcpSession> createSession(std::unique_ptr<TcpStream> _stream);
+
+		uint32_t getWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+		// process wide reactor, created on first use and destroyed when the last user releases it
+		static std::shared_ptr<Reactor> getShared();
+
+	private:
+		friend class TcpSession;
+		class Poller;
+
+		void add(const std::shared_ptr<TcpSession>& _session);
+		void requestUpdate(int _handle);	// send queue or closed state changed
+		void schedule(std::shared_ptr<TcpSession> _session);
+
+		void ioThreadFunc();
+		void workerThreadFunc();
+
+		void processPending();
+		void remove(int _handle);
+
+		std::unique_ptr<Poller> m_poller;
+
+		std::atomic<bool> m_exit{false};
+
+		// pending changes, written by any thread, applied by the IO thread
+		std::mutex m_mutexPending;
+		std::vector<std::shared_ptr<TcpSession>> m_pendingAdd;
+		std::vector<int> m_pendingUpdate;
+
+		// only accessed by the IO thread
+		std::unordered_map<int, std::shared_ptr<TcpSession>> m_sessions;
+
+		std::mutex m_mutexWork;
+		std::condition_variable m_cvWork;
+		std::deque<std::shared_ptr<TcpSession>> m_work;
+
+		std::unique_ptr<std::thread> m_ioThread;
+		std::vector<std::thread> m_workers;
+	};
+}
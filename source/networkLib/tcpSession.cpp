@@ -0,0 +1,485 @@
+#include "tcpSession.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>	// strerror
+
+#include "logging.h"
+#include "reactor.h"
+#include "tcpStream.h"
+
+#include "../ptypes/pinet.h"
+
+#ifdef _WIN32
+#	include <winsock2.h>
+#else
+#	include <cerrno>
+#	include <fcntl.h>
+#	include <sys/socket.h>
+#	include <sys/uio.h>
+#	include <unistd.h>
+#endif
+
+namespace networkLib
+{
+	namespace
+	{
+		constexpr size_t g_readChunkSize = 64 * 1024;
+
+#if defined(_WIN32)
+		constexpr int g_sendFlags = 0;
+#elif defined(MSG_NOSIGNAL)
+		constexpr int g_sendFlags = MSG_NOSIGNAL;
+#else
+		constexpr int g_sendFlags = 0;
+#endif
+
+		int getLastError()
+		{
+#ifdef _WIN32
+			return WSAGetLastError();
+#else
+			return errno;
+#endif
+		}
+
+		bool isWouldBlock(const int _err)
+		{
+#ifdef _WIN32
+			return _err == WSAEWOULDBLOCK;
+#else
+			return _err == EAGAIN || _err == EWOULDBLOCK;
+#endif
+		}
+
+		bool isInterrupted(const int _err)
+		{
+#ifdef _WIN32
+			return _err == WSAEINTR;
+#else
+			return _err == EINTR;
+#endif
+		}
+
+		std::string errorToString(const int _err)
+		{
+#ifdef _WIN32
+			return "socket error " + std::to_string(_err);
+#else
+			return "socket error " + std::to_string(_err) + ": " + strerror(_err);
+#endif
+		}
+
+		void setNonBlocking(const int _handle)
+		{
+#ifdef _WIN32
+			u_long mode = 1;
+			if(ioctlsocket(static_cast<SOCKET>(_handle), FIONBIO, &mode) != 0)
+			{
+				LOGNET(LogLevel::Error, "Failed to set socket to non-blocking mode, " << errorToString(getLastError()));
+			}
+#else
+			const int flags = fcntl(_handle, F_GETFL, 0);
+			if(flags < 0 || fcntl(_handle, F_SETFL, flags | O_NONBLOCK) < 0)
+			{
+				LOGNET(LogLevel::Error, "Failed to set socket to non-blocking mode, " << errorToString(getLastError()));
+			}
+#	ifdef SO_NOSIGPIPE
+			constexpr int opt = 1;
+			::setsockopt(_handle, SOL_SOCKET, SO_NOSIGPIPE, &opt, sizeof(opt));
+#	endif
+#endif
+		}
+
+		void shutdownSocket(const int _handle)
+		{
+#ifdef _WIN32
+			::shutdown(static_cast<SOCKET>(_handle), SD_BOTH);
+#else
+			::shutdown(_handle, SHUT_RDWR);
+#endif
+		}
+	}
+
+	TcpSession::TcpSession(Reactor& _reactor, std::unique_ptr<TcpStream> _stream)
+		: m_reactor(_reactor)
+		, m_stream(std::move(_stream))
+		, m_handle(m_stream->getPtypesStream()->get_handle())
+	{
+		m_received.reserve(g_readChunkSize * 2);
+		m_processing.reserve(g_readChunkSize * 2);
+
+		setNonBlocking(m_handle);
+	}
+
+	TcpSession::~TcpSession()
+	{
+		detach();
+		m_stream.reset();
+	}
+
+	void TcpSession::start(Handler& _handler)
+	{
+		{
+			std::scoped_lock lock(m_mutexHandler);
+			m_handler = &_handler;
+		}
+		m_reactor.add(shared_from_this());
+	}
+
+	void TcpSession::detach()
+	{
+		std::scoped_lock lock(m_mutexHandler);
+		m_handler = nullptr;
+	}
+
+	bool TcpSession::send(const void* _data, const size_t _size)
+	{
+		const SendBuffer buffer{_data, _size};
+		return send(&buffer, 1);
+	}
+
+	bool TcpSession::send(const SendBuffer* _buffers, const size_t _count)
+	{
+		assert(_count <= MaxSendBuffers);
+
+		if(m_closed)
+			return false;
+
+		size_t total = 0;
+		for(size_t i=0; i<_count; ++i)
+			total += _buffers[i].size;
+
+		std::scoped_lock lock(m_mutexSend);
+
+		if(m_closeWhenSent)
+			return false;
+
+		size_t sent = 0;
+
+		// try to send directly, but only if nothing is queued yet, the order has to be preserved
+		if(m_sendQueue.empty())
+		{
+			while(sent < total)
+			{
+#ifdef _WIN32
+				std::array<WSABUF, MaxSendBuffers> bufs;
+#else
+				std::array<iovec, MaxSendBuffers> bufs;
+#endif
+				size_t bufCount = 0;
+				size_t skip = sent;
+
+				for(size_t i=0; i<_count; ++i)
+				{
+					const auto& b = _buffers[i];
+
+					if(skip >= b.size)
+					{
+						skip -= b.size;
+						continue;
+					}
+
+					auto* data = static_cast<const uint8_t*>(b.data) + skip;
+					const auto size = b.size - skip;
+					skip = 0;
+#ifdef _WIN32
+					bufs[bufCount].buf = reinterpret_cast<CHAR*>(const_cast<uint8_t*>(data));
+					bufs[bufCount].len = static_cast<ULONG>(size);
+#else
+					bufs[bufCount].iov_base = const_cast<uint8_t*>(data);
+					bufs[bufCount].iov_len = size;
+#endif
+					++bufCount;
+				}
+
+#ifdef _WIN32
+				DWORD numSent = 0;
+				const auto res = WSASend(static_cast<SOCKET>(m_handle), bufs.data(), static_cast<DWORD>(bufCount), &numSent, 0, nullptr, nullptr) == 0 ? static_cast<int64_t>(numSent) : -1;
+#else
+				msghdr msg{};
+				msg.msg_iov = bufs.data();
+				msg.msg_iovlen = bufCount;
+				const auto res = static_cast<int64_t>(::sendmsg(m_handle, &msg, g_sendFlags));
+#endif
+				if(res > 0)
+				{
+					sent += static_cast<size_t>(res);
+					continue;
+				}
+
+				const auto err = getLastError();
+
+				if(isInterrupted(err))
+					continue;
+				if(isWouldBlock(err))
+					break;
+
+				setClosed(ConnectionLost, errorToString(err));
+				return false;
+			}
+
+			if(sent == total)
+				return true;
+		}
+
+		// queue what the socket did not accept
+		if(m_sendQueue.size() - m_sendQueueOffset + total - sent > MaxSendQueueSize)
+		{
+			LOGNET(LogLevel::Warning, "Peer does not accept data fast enough, more than " << (MaxSendQueueSize >> 20) << " MiB are queued, disconnecting");
+			setClosed(ConnectionLost, "Send queue limit exceeded");
+			return false;
+		}
+
+		// discard what has been sent already before the queue grows, a peer that never catches up completely would let it grow forever otherwise
+		if(m_sendQueueOffset > 0 && m_sendQueueOffset >= m_sendQueue.size() / 2)
+		{
+			m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + static_cast<ptrdiff_t>(m_sendQueueOffset));
+			m_sendQueueOffset = 0;
+		}
+
+		size_t skip = sent;
+
+		for(size_t i=0; i<_count; ++i)
+		{
+			const auto& b = _buffers[i];
+
+			if(skip >= b.size)
+			{
+				skip -= b.size;
+				continue;
+			}
+
+			const auto* data = static_cast<const uint8_t*>(b.data);
+			m_sendQueue.insert(m_sendQueue.end(), data + skip, data + b.size);
+			skip = 0;
+		}
+
+		m_reactor.requestUpdate(m_handle);
+		return true;
+	}
+
+	void TcpSession::close()
+	{
+		setClosed(ConnectionClosed, "Connection closed");
+	}
+
+	void TcpSession::closeWhenSent()
+	{
+		{
+			std::scoped_lock lock(m_mutexSend);
+
+			m_closeWhenSent = true;
+
+			// onWritable closes the session once the queue is empty
+			if(m_sendQueueOffset < m_sendQueue.size())
+				return;
+		}
+		close();
+	}
+
+	bool TcpSession::onReadable()
+	{
+		bool open = true;
+		bool schedule = false;
+
+		{
+			std::scoped_lock lock(m_mutexReceive);
+
+			while(true)
+			{
+				const auto oldSize = m_received.size();
+				m_received.resize(oldSize + g_readChunkSize);
+
+				const auto res = ::recv(m_handle, reinterpret_cast<char*>(m_received.data() + oldSize), static_cast<int>(g_readChunkSize), 0);
+
+				if(res > 0)
+				{
+					m_received.resize(oldSize + static_cast<size_t>(res));
+					schedule = true;
+
+					if(static_cast<size_t>(res) < g_readChunkSize)
+						break;
+					continue;
+				}
+
+				m_received.resize(oldSize);
+
+				if(res == 0)
+				{
+					if(!m_closeReason)
+						m_closeReason = std::make_unique<NetException>(ConnectionClosed, "Connection closed by peer");
+					open = false;
+					break;
+				}
+
+				const auto err = getLastError();
+
+				if(isInterrupted(err))
+					continue;
+				if(isWouldBlock(err))
+					break;
+
+				if(!m_closeReason)
+					m_closeReason = std::make_unique<NetException>(ConnectionLost, errorToString(err));
+				open = false;
+				break;
+			}
+
+			if(!open)
+				m_closed = true;
+
+			if(schedule && !m_scheduled)
+				m_scheduled = true;
+			else
+				schedule = false;
+		}
+
+		if(schedule)
+			m_reactor.schedule(shared_from_this());
+
+		return open;
+	}
+
+	bool TcpSession::onWritable()
+	{
+		std::scoped_lock lock(m_mutexSend);
+
+		while(m_sendQueueOffset < m_sendQueue.size())
+		{
+			const auto remaining = m_sendQueue.size() - m_sendQueueOffset;
+
+			const auto res = ::send(m_handle, reinterpret_cast<const char*>(m_sendQueue.data() + m_sendQueueOffset), static_cast<int>(std::min(remaining, static_cast<size_t>(INT32_MAX))), g_sendFlags);
+
+			if(res > 0)
+			{
+				m_sendQueueOffset += static_cast<size_t>(res);
+				continue;
+			}
+
+			const auto err = getLastError();
+
+			if(isInterrupted(err))
+				continue;
+			if(isWouldBlock(err))
+				return true;
+
+			setClosed(ConnectionLost, errorToString(err));
+			return false;
+		}
+
+		m_sendQueue.clear();
+		m_sendQueueOffset = 0;
+
+		if(m_closeWhenSent)
+			setClosed(ConnectionClosed, "Connection closed");
+
+		return false;
+	}
+
+	bool TcpSession::hasPendingSend()
+	{
+		std::scoped_lock lock(m_mutexSend);
+		return m_sendQueueOffset < m_sendQueue.size();
+	}
+
+	void TcpSession::onRemoved()
+	{
+		bool schedule;
+		{
+			std::scoped_lock lock(m_mutexReceive);
+
+			m_closed = true;
+
+			if(!m_closeReason)
+				m_closeReason = std::make_unique<NetException>(ConnectionClosed, "Connection closed");
+
+			schedule = !m_scheduled;
+			m_scheduled = true;
+		}
+
+		// deliver the remaining data and the close notification
+		if(schedule)
+			m_reactor.schedule(shared_from_this());
+	}
+
+	void TcpSession::process()
+	{
+		std::scoped_lock lockHandler(m_mutexHandler);
+
+		while(true)
+		{
+			std::unique_ptr<NetException> closeReason;
+			{
+				std::scoped_lock lock(m_mutexReceive);
+
+				if(m_received.empty())
+				{
+					if(!m_closeReason || m_closeNotified)
+					{
+						m_scheduled = false;
+						return;
+					}
+					closeReason = std::make_unique<NetException>(*m_closeReason);
+					m_closeNotified = true;
+				}
+				else if(m_processing.empty())
+				{
+					// both buffers keep their capacity, no copy and no allocation in the common case
+					std::swap(m_processing, m_received);
+				}
+				else
+				{
+					m_processing.insert(m_processing.end(), m_received.begin(), m_received.end());
+					m_received.clear();
+				}
+			}
+
+			if(closeReason)
+			{
+				m_processing.clear();
+				if(m_handler)
+					m_handler->onClosed(*closeReason);
+				continue;
+			}
+
+			if(!m_handler)
+			{
+				m_processing.clear();
+				continue;
+			}
+
+			try
+			{
+				const auto consumed = std::min(m_handler->onReceive(m_processing.data(), m_processing.size()), m_processing.size());
+				m_processing.erase(m_processing.begin(), m_processing.begin() + static_cast<ptrdiff_t>(consumed));
+			}
+			catch(const std::exception& e)
+			{
+				LOGNET(LogLevel::Error, "Exception while processing received data, closing connection: " << e.what());
+				m_processing.clear();
+				setClosed(ConnectionLost, e.what());
+			}
+		}
+	}
+
+	void TcpSession::setClosed(const ExceptionType _type, const std::string& _reason)
+	{
+		{
+			std::scoped_lock lock(m_mutexReceive);
+
+			if(!m_closeReason)
+				m_closeReason = std::make_unique<NetException>(_type, _reason);
+
+			if(m_closed.exchange(true))
+				return;
+		}
+
+		// wakes up the IO thread, which then removes the session
+		shutdownSocket(m_handle);
+		m_reactor.requestUpdate(m_handle);
+	}
+}
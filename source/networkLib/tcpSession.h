@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "exception.h"
+
+namespace networkLib
+{
+	class Reactor;
+	class TcpStream;
+
+	// Non-blocking TCP connection that is driven by a Reactor. Incoming data is delivered to a handler on one of the
+	// reactor worker threads, outgoing data is written immediately if the socket accepts it and queued otherwise
+	class TcpSession : public std::enable_shared_from_this<TcpSession>
+	{
+	public:
+		class Handler
+		{
+		public:
+			virtual ~Handler() = default;
+
+			// returns the number of bytes that have been consumed. Unconsumed bytes are passed again, prepended to the next data that arrives.
+			// The buffer is owned by the session and stays valid until the function returns, it may be parsed in place
+			virtual size_t onReceive(uint8_t* _data, size_t _size) = 0;
+
+			// called once after all received data has been delivered
+			virtual void onClosed(const NetException& _e) = 0;
+		};
+
+		struct SendBuffer
+		{
+			const void* data;
+			size_t size;
+		};
+
+		static constexpr size_t MaxSendBuffers = 8;
+
+		// data that the peer did not accept yet. A peer that stalls and lets the queue grow beyond this is disconnected
+		static constexpr size_t MaxSendQueueSize = 64 * 1024 * 1024;
+
+		TcpSession(Reactor& _reactor, std::unique_ptr<TcpStream> _stream);
+		~TcpSession();
+
+		TcpSession(const TcpSession&) = delete;
+		TcpSession(TcpSession&&) = delete;
+		TcpSession& operator = (const TcpSession&) = delete;
+		TcpSession& operator = (TcpSession&&) = delete;
+
+		void start(Handler& _handler);
+
+		// no handler function is called anymore after this returns. Waits if a handler function is running on another thread
+		void detach();
+
+		// thread-safe, data of one call is never interleaved with data of another call
+		bool send(const void* _data, size_t _size);
+
+		// gather write, sends all buffers with a single system call if the socket accepts the data
+		bool send(const SendBuffer* _buffers, size_t _count);
+
+		void close();
+
+		// closes the session once all queued data has been sent, nothing can be sent anymore after calling this
+		void closeWhenSent();
+
+		bool isValid() const { return !m_closed; }
+
+		int getHandle() const { return m_handle; }
+		const TcpStream& getStream() const { return *m_stream; }
+
+	private:
+		friend class Reactor;
+
+		// IO thread
+		bool onReadable();
+		bool onWritable();
+		bool hasPendingSend();
+		void onRemoved();
+
+		// worker thread
+		void process();
+
+		void setClosed(ExceptionType _type, const std::string& _reason);
+
+		Reactor& m_reactor;
+		std::unique_ptr<TcpStream> m_stream;
+		const int m_handle;
+
+		std::atomic<bool> m_closed{false};
+
+		std::mutex m_mutexSend;
+		std::vector<uint8_t> m_sendQueue;
+		size_t m_sendQueueOffset = 0;
+		bool m_closeWhenSent = false;
+
+		std::mutex m_mutexReceive;
+		std::vector<uint8_t> m_received;
+		bool m_scheduled = false;
+		bool m_closeNotified = false;
+		std::unique_ptr<NetException> m_closeReason;
+
+		// worker thread only
+		std::vector<uint8_t> m_processing;
+
+		std::recursive_mutex m_mutexHandler;
+		Handler* m_handler = nullptr;
+	};
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+namespace n2xFlashTest::baseline
+{
+	// Copy of hwLib::I2c and hwLib::I2cFlash before page buffering was added and per bit logging was removed. It is
+	// kept unchanged to compare the current implementation against it, both in timing and in behaviour
+
+	class I2c
+	{
+	public:
+		enum class State
+		{
+			Stop,
+			Start,
+		};
+		enum BitPos : int8_t
+		{
+			Bit7 = 7,
+			Bit6 = 6,
+			Bit5 = 5,
+			Bit4 = 4,
+			Bit3 = 3,
+			Bit2 = 2,
+			Bit1 = 1,
+			Bit0 = 0,
+			BitAck = -1,
+			BitInvalid = -2,
+		};
+
+		I2c() = default;
+
+		virtual ~I2c() = default;
+
+		void masterWrite(bool _sda, bool _scl);
+		virtual std::optional<bool> masterRead(bool _scl);
+		std::optional<bool> setSdaWrite(bool _write);
+
+		bool sda() const { return m_sda; }
+		bool scl() const { return m_scl; }
+		uint8_t byte() const { return m_byte; }
+
+	protected:
+		virtual void onStateChanged(State _state);
+		virtual void onStartCondition();
+		virtual void onStopCondition();
+		virtual void onByteWritten();
+		virtual std::optional<bool> onAck() { return {}; }
+		virtual uint8_t onReadByte() { return 0; }
+
+	private:
+		void sdaFlip(bool _sda);
+		void sclFlip(bool _scl);
+		void setState(State _state);
+
+		bool m_sdaWrite = true;	// true = write
+		bool m_sda = false;
+		bool m_scl = false;
+		State m_state = State::Stop;
+		int8_t m_nextBit = BitInvalid;
+		uint8_t m_byte;
+		bool m_ackBit = true;
+	};
+
+	class I2cFlash : public I2c
+	{
+	public:
+		static constexpr uint32_t Size = 0x10000;
+		using Data = std::array<uint8_t, Size>;
+
+		I2cFlash()
+		{
+			m_data.fill(0xff);
+		}
+
+		const Data& getData() const { return m_data; }
+
+	protected:
+		void onStartCondition() override;
+		void onStopCondition() override;
+		void onByteWritten() override;
+		std::optional<bool> onAck() override;
+		uint8_t onReadByte() override;
+
+	private:
+		enum class State
+		{
+			ReadDeviceSelect,	AckDeviceSelect,
+			ReadAddressMSB,		AckAddressMSB,
+			ReadAddressLSB,		AckAddressLSB,
+			ReadWriteData,
+		};
+
+		enum DeviceSelectMask
+		{
+			Area       = 0b1111'000'0,
+			ChipEnable = 0b0000'111'0,
+			Rw         = 0b0000'000'1,
+		};
+
+		enum DeviceSelectValues
+		{
+			AreaMemory = 0b1010'000'0,
+			AreaId     = 0b1011'000'0,
+			Read       = 0b0000'000'1,
+			Write      = 0b0000'000'0,
+		};
+
+		void writeByte(uint8_t _byte);
+		void advanceAddress();
+
+		State m_state = State::ReadDeviceSelect;
+		uint8_t m_deviceSelect = 0;
+		uint32_t m_address = 0;
+
+		Data m_data;
+	};
+}
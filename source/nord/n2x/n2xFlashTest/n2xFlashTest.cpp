@@ -0,0 +1,348 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "baselineFlash.h"
+
+#include "baseLib/commandline.h"
+
+#include "hardwareLib/i2cFlash.h"
+#include "hardwareLib/i2cTrace.h"
+
+// Replays accesses of the N2x microcontroller to its I2C flash on the current flash emulation and on a copy of the
+// emulation before page buffering was added. Both need to return identical results and end up with identical memory.
+// A trace of a real store can be recorded with a debug build, see n2x::Microcontroller::exec()
+
+namespace
+{
+	using hwLib::I2cFlash;
+	using hwLib::I2cTrace;
+
+	constexpr uint8_t g_deviceSelectWrite = 0b1010'000'0;
+	constexpr uint8_t g_deviceSelectRead  = 0b1010'000'1;
+
+	// Synthetic store that is used if no trace is given. The page count and the address are assumptions, they have not
+	// been taken from a store done by the N2x firmware
+	constexpr uint32_t g_storePages = 5;
+	constexpr uint32_t g_storeAddress = 0x4000;
+
+	// Drives the bus the same way the firmware does it via port writes, see n2x::Microcontroller, and records every
+	// port access
+	class Master
+	{
+	public:
+		Master(I2cFlash& _flash, I2cTrace& _trace) : m_flash(_flash), m_trace(_trace)
+		{
+			m_trace.setEnabled(true);
+		}
+
+		void start()
+		{
+			output(true);
+			write(true, false);
+			write(true, true);
+			write(false, true);
+			write(false, false);
+		}
+
+		void stop()
+		{
+			output(true);
+			write(false, false);
+			write(false, true);
+			write(true, true);
+		}
+
+		bool writeByte(const uint8_t _byte)
+		{
+			output(true);
+
+			for(int b=7; b>=0; --b)
+			{
+				const auto bit = ((_byte >> b) & 1) != 0;
+				write(bit, false);
+				write(bit, true);
+				write(bit, false);
+			}
+
+			// the slave acknowledges by pulling SDA low
+			output(false);
+			const auto ack = read(true);
+			read(false);
+			return ack && !*ack;
+		}
+
+		uint8_t readByte(const bool _ack)
+		{
+			output(false);
+
+			uint8_t result = 0;
+
+			for(int b=7; b>=0; --b)
+			{
+				if(const auto bit = read(true); bit && *bit)
+					result |= static_cast<uint8_t>(1 << b);
+				read(false);
+			}
+
+			// acknowledge to continue reading, a missing acknowledge ends a sequential read
+			output(true);
+			write(!_ack, false);
+			write(!_ack, true);
+			write(!_ack, false);
+
+			return result;
+		}
+
+		bool writePage(const uint16_t _address, const uint8_t* _data, const uint32_t _size)
+		{
+			start();
+
+			bool ok = writeByte(g_deviceSelectWrite) && writeByte(static_cast<uint8_t>(_address >> 8)) && writeByte(static_cast<uint8_t>(_address));
+
+			for(uint32_t i=0; i<_size; ++i)
+				ok &= writeByte(_data[i]);
+
+			stop();
+			return ok;
+		}
+
+		bool read(const uint16_t _address, uint8_t* _data, const uint32_t _size)
+		{
+			// random read: the address is set via a write transaction that is interrupted by a repeated start
+			start();
+
+			if(!writeByte(g_deviceSelectWrite) || !writeByte(static_cast<uint8_t>(_address >> 8)) || !writeByte(static_cast<uint8_t>(_address)))
+				return false;
+
+			start();
+
+			if(!writeByte(g_deviceSelectRead))
+				return false;
+
+			for(uint32_t i=0; i<_size; ++i)
+				_data[i] = readByte(i + 1 < _size);
+
+			stop();
+			return true;
+		}
+
+	private:
+		void output(const bool _output)
+		{
+			m_trace.addSdaDirection(_output);
+			m_flash.setSdaWrite(_output);
+		}
+
+		void write(const bool _sda, const bool _scl)
+		{
+			m_trace.addWrite(_sda, _scl);
+			m_flash.masterWrite(_sda, _scl);
+		}
+
+		std::optional<bool> read(const bool _scl)
+		{
+			m_trace.addRead(_scl);
+			return m_flash.masterRead(_scl);
+		}
+
+		I2cFlash& m_flash;
+		I2cTrace& m_trace;
+	};
+
+	struct Write
+	{
+		uint16_t address;
+		uint32_t size;
+	};
+
+	// full pages, partial pages, writes that roll over within a page and writes that exceed the page size, every
+	// write is followed by a read of the page. The last write is ended by a repeated start instead of a stop condition
+	bool createCheckTrace(I2cTrace& _trace)
+	{
+		const auto flash = std::make_unique<I2cFlash>();
+		Master master(*flash, _trace);
+
+		std::mt19937 rng(42);
+
+		constexpr Write writes[] =
+		{
+			{0x0000, 128}, {0x0080, 16}, {0x00f8, 16}, {0x1234, 1}, {0x2010, 200}, {0xff80, 128}, {0xfff0, 20}, {0x0040, 0}
+		};
+
+		std::vector<uint8_t> data;
+		std::vector<uint8_t> readBack(I2cFlash::PageSize);
+
+		for (const auto& w : writes)
+		{
+			data.resize(w.size);
+			for (auto& d : data)
+				d = static_cast<uint8_t>(rng());
+
+			// sequential reads do not roll over, read the whole page
+			if(!master.writePage(w.address, data.data(), w.size) || !master.read(w.address & 0xff80, readBack.data(), I2cFlash::PageSize))
+			{
+				std::cout << "Access to " << std::hex << w.address << std::dec << " was not acknowledged" << std::endl;
+				return false;
+			}
+		}
+
+		constexpr uint16_t address = 0x3000;
+
+		master.start();
+		master.writeByte(g_deviceSelectWrite);
+		master.writeByte(static_cast<uint8_t>(address >> 8));
+		master.writeByte(static_cast<uint8_t>(address));
+		for(uint8_t b=1; b<=3; ++b)
+			master.writeByte(b);
+
+		return master.read(address, readBack.data(), 3);
+	}
+
+	bool createStoreTrace(I2cTrace& _trace)
+	{
+		const auto flash = std::make_unique<I2cFlash>();
+		Master master(*flash, _trace);
+
+		std::vector<uint8_t> data(I2cFlash::PageSize);
+
+		for(uint32_t p=0; p<g_storePages; ++p)
+		{
+			for(size_t i=0; i<data.size(); ++i)
+				data[i] = static_cast<uint8_t>((p * I2cFlash::PageSize + i) * 7);
+
+			if(!master.writePage(static_cast<uint16_t>(g_storeAddress + p * I2cFlash::PageSize), data.data(), I2cFlash::PageSize))
+				return false;
+		}
+		return true;
+	}
+
+	bool compare(const char* _name, const I2cTrace& _trace)
+	{
+		const auto baselineFlash = std::make_unique<n2xFlashTest::baseline::I2cFlash>();
+		const auto currentFlash = std::make_unique<I2cFlash>();
+
+		std::vector<int8_t> baselineResults;
+		std::vector<int8_t> currentResults;
+
+		_trace.replay(*baselineFlash, baselineResults);
+		_trace.replay(*currentFlash, currentResults);
+
+		for(size_t i=0; i<baselineResults.size(); ++i)
+		{
+			if(baselineResults[i] == currentResults[i])
+				continue;
+
+			std::cout << _name << ": port access " << i << " returned " << static_cast<int>(currentResults[i]) << ", baseline returned " << static_cast<int>(baselineResults[i]) << std::endl;
+			return false;
+		}
+
+		const auto& baselineData = baselineFlash->getData();
+		const auto& currentData = currentFlash->getData();
+
+		for(size_t i=0; i<baselineData.size(); ++i)
+		{
+			if(baselineData[i] == currentData[i])
+				continue;
+
+			std::cout << _name << ": flash content at " << std::hex << i << " is " << static_cast<int>(currentData[i]) << ", baseline is " << static_cast<int>(baselineData[i]) << std::dec << std::endl;
+			return false;
+		}
+
+		std::cout << _name << ": " << _trace.getEvents().size() << " port accesses, results and flash content are identical" << std::endl;
+		return true;
+	}
+
+	template<typename TFlash> double measure(const I2cTrace& _trace, const double _seconds)
+	{
+		const auto flash = std::make_unique<TFlash>();
+
+		std::vector<int8_t> results;
+
+		using Clock = std::chrono::high_resolution_clock;
+
+		const auto start = Clock::now();
+
+		uint64_t replays = 0;
+		double elapsed = 0.0;
+
+		do
+		{
+			_trace.replay(*flash, results);
+			++replays;
+			elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		}
+		while(elapsed < _seconds);
+
+		return elapsed * 1000000.0 / static_cast<double>(replays);
+	}
+
+	void printUsage()
+	{
+		std::cout << "Compares the N2x I2C flash emulation with the emulation before page buffering" << std::endl << std::endl;
+
+		std::cout << "Usage:" << std::endl;
+		std::cout << "  n2xFlashTest [-trace <file>] [-seconds <s>]" << std::endl << std::endl;
+
+		std::cout << "Options:" << std::endl;
+		std::cout << "  -trace <file>             replays a trace recorded by n2x::Microcontroller, a synthetic store is used if omitted" << std::endl;
+		std::cout << "  -seconds <s>              time spent per measurement, default 1, 0 only compares the results" << std::endl;
+	}
+}
+
+int main(const int _argc, char* _argv[])
+{
+	const baseLib::CommandLine cmd(_argc, _argv);
+
+	if(cmd.contains("help"))
+	{
+		printUsage();
+		return 0;
+	}
+
+	I2cTrace checkTrace;
+
+	if(!createCheckTrace(checkTrace) || !compare("Transactions", checkTrace))
+		return -1;
+
+	I2cTrace storeTrace;
+
+	const auto traceFile = cmd.get("trace");
+
+	if(!traceFile.empty())
+	{
+		if(!storeTrace.load(traceFile))
+		{
+			std::cout << "Failed to load trace " << traceFile << std::endl;
+			return -1;
+		}
+	}
+	else if(!createStoreTrace(storeTrace))
+	{
+		std::cout << "Synthetic store was not acknowledged" << std::endl;
+		return -1;
+	}
+
+	const auto name = traceFile.empty() ? "Synthetic store of " + std::to_string(g_storePages) + " pages" : "Trace " + traceFile;
+
+	if(!compare(name.c_str(), storeTrace))
+		return -1;
+
+	const auto seconds = static_cast<double>(cmd.getFloat("seconds", 1.0f));
+
+	if(seconds <= 0.0)
+		return 0;
+
+	// the baseline formats a log message for every bit and every byte, it is measured with the logging of this build
+	const auto usBaseline = measure<n2xFlashTest::baseline::I2cFlash>(storeTrace, seconds);
+	const auto usCurrent = measure<I2cFlash>(storeTrace, seconds);
+
+	std::cout << std::fixed << std::setprecision(2)
+		<< "  baseline: " << usBaseline << " us" << std::endl
+		<< "  current:  " << usCurrent << " us" << std::endl;
+
+	return 0;
+}
@@ -8,6 +8,7 @@
 #include "dsp56kEmu/logging.h"
 
 #include "n2xLib/n2xmiditypes.h"
+#include "n2xLib/n2xparameterchanges.h"
 
 #include "synthLib/midiTranslator.h"
 
@@ -27,7 +28,13 @@ namespace
 		return g_midiPacketNames[static_cast<uint32_t>(_type)];
 	}
 
-	constexpr uint32_t g_multiPage = 10;
+	// a single parameter without CC is sent as a complete single dump, the device is not able to process them fast enough
+	constexpr uint32_t g_sysexRateLimitMs = 150;
+
+	n2x::MultiParam toMultiParam(const pluginLib::Description& _desc)
+	{
+		return n2x::ParameterChanges::toMultiParam(_desc.page, _desc.index);
+	}
 }
 
 namespace n2xJucePlugin
@@ -42,6 +49,22 @@ namespace n2xJucePlugin
 		    return juce::String(temp);
 	    });
 
+		const auto& descriptions = getParameterDescriptions();
+
+		for(uint32_t i=0; i<descriptions.getDescriptions().size(); ++i)
+		{
+			const auto ccs = descriptions.getControllerMap().getControlChanges(synthLib::M_CONTROLCHANGE, i);
+
+			if(ccs.empty())
+				continue;
+
+			for(uint8_t p=0; p<getPartCount(); ++p)
+			{
+				if(const auto* param = getParameter(i, p))
+					m_controlChanges.insert({param, ccs.front()});
+			}
+		}
+
 		Controller::onStateLoaded();
 
 		m_currentPartChanged.set(onCurrentPartChanged, [this](const uint8_t& _part)
@@ -80,7 +103,13 @@ namespace n2xJucePlugin
 
 		if(n2x::State::parseKnobSysex(knobType, knobValue, _msg))
 		{
-			if(m_state.receive(_msg, _source))
+			bool received;
+			{
+				std::scoped_lock lock(m_stateLock);
+				received = m_state.receive(_msg, _source);
+			}
+
+			if(received)
 			{
 				onKnobChanged(knobType, knobValue);
 				return true;
@@ -106,7 +135,10 @@ namespace n2xJucePlugin
 
 		if(bank == n2x::SysexByte::SingleDumpBankEditBuffer && program < getPartCount())
 		{
-			m_state.receive(_msg, synthLib::MidiEventSource::Plugin);
+			{
+				std::scoped_lock lock(m_stateLock);
+				m_state.receive(_msg, synthLib::MidiEventSource::Plugin);
+			}
 			applyPatchParameters(params, program);
 			onProgramChanged();
 			return true;
@@ -133,13 +165,16 @@ namespace n2xJucePlugin
 		if(bank != n2x::SysexByte::MultiDumpBankEditBuffer)
 			return false;
 
-		m_state.receive(_msg, synthLib::MidiEventSource::Plugin);
+		{
+			std::scoped_lock lock(m_stateLock);
+			m_state.receive(_msg, synthLib::MidiEventSource::Plugin);
+		}
 
 		applyPatchParameters(params, 0);
 
 		onProgramChanged();
 
-		const auto part = m_state.getMultiParam(n2x::SelectedChannel, 0);
+		const auto part = getMultiParameter(n2x::SelectedChannel);
 		if(part < getPartCount())	// if have seen dumps that have invalid stuff in here
 		{
 			// we ignore this for now, is annoying if the selected part changes whenever we load a multi
@@ -159,9 +194,12 @@ namespace n2xJucePlugin
 
 		const auto origin = midiEventSourceToParameterOrigin(_e.source);
 
-		m_state.receive(_e);
-
-		const auto parts = m_state.getPartsForMidiChannel(_e);
+		std::vector<uint8_t> parts;
+		{
+			std::scoped_lock lock(m_stateLock);
+			m_state.receive(_e);
+			parts = m_state.getPartsForMidiChannel(_e);
+		}
 
 		for (const uint8_t part : parts)
 		{
@@ -191,35 +229,26 @@ namespace n2xJucePlugin
 
 	void Controller::sendParameterChange(const pluginLib::Parameter& _parameter, pluginLib::ParamValue _value)
 	{
-		if(_parameter.getDescription().page >= g_multiPage)
+		if(_parameter.getDescription().page >= n2x::ParameterChanges::MultiPage)
 		{
 			sendMultiParameter(_parameter, static_cast<uint8_t>(_value));
 			return;
 		}
 
-		constexpr uint32_t sysexRateLimitMs = 150;
-
 		pluginLib::Parameter& nonConstParam = const_cast<pluginLib::Parameter&>(_parameter);
 
 		const auto singleParam = static_cast<n2x::SingleParam>(_parameter.getDescription().index);
 		const uint8_t part = _parameter.getPart();
 
-		const auto& controllerMap = getParameterDescriptions().getControllerMap();
+		uint8_t cc;
 
-		uint32_t descIndex;
-		if(!getParameterDescriptions().getIndexByName(descIndex, _parameter.getDescription().name))
-			assert(false && "parameter not found");
-
-		const auto& ccs = controllerMap.getControlChanges(synthLib::M_CONTROLCHANGE, descIndex);
-		if(ccs.empty())
+		if(!getControlChange(cc, _parameter))
 		{
-			nonConstParam.setRateLimitMilliseconds(sysexRateLimitMs);
+			nonConstParam.setRateLimitMilliseconds(g_sysexRateLimitMs);
 			setSingleParameter(part, singleParam, static_cast<uint8_t>(_value));
 			return;
 		}
 
-		const auto cc = ccs.front();
-
 		if(cc == n2x::ControlChange::CCSync)
 		{
 			// sync and ringmod have the same CC, combine them
@@ -227,50 +256,100 @@ namespace n2xJucePlugin
 			_value = v & 3;	// strip Distortion, it has its own CC
 		}
 
-		const auto ch = m_state.getPartMidiChannel(part);
-
-		const auto parts = m_state.getPartsForMidiChannel(ch);
-
 		auto ev = synthLib::SMidiEvent{synthLib::MidiEventSource::Editor, static_cast<uint8_t>(synthLib::M_CONTROLCHANGE + part), cc, static_cast<uint8_t>(_value)};
 
 		nonConstParam.setRateLimitMilliseconds(0);
+
+		std::scoped_lock lock(m_stateLock);
 		m_state.changeSingleParameter(part, ev);
 		sendMidiEvent(n2x::State::createPartCC(part, ev));
 	}
 
+	void Controller::sendParameterChanges(const pluginLib::ParameterChangeBatch& _changes)
+	{
+		std::scoped_lock lock(m_stateLock);
+
+		n2x::ParameterChanges changes(m_state);
+		uint8_t cc;
+
+		_changes.forEachPart([&](const uint8_t _part, const pluginLib::ParameterChangeBatch::Changes& _partChanges)
+		{
+			for (const auto& change : _partChanges)
+			{
+				const auto& param = *change.parameter;
+				const auto& desc = param.getDescription();
+
+				switch (changes.add(_part, desc.page, desc.index, static_cast<uint8_t>(change.value), getControlChange(cc, param)))
+				{
+				case n2x::ParameterChanges::Target::Single:
+					const_cast<pluginLib::Parameter&>(param).setRateLimitMilliseconds(g_sysexRateLimitMs);
+					break;
+				case n2x::ParameterChanges::Target::Multi:
+					break;
+				case n2x::ParameterChanges::Target::ControlChange:
+					sendParameterChange(param, change.value);
+					break;
+				}
+			}
+
+			if(changes.isSingleChanged(_part))
+				sendSingle(_part);
+		});
+
+		if(changes.isMultiChanged())
+			sendMulti();
+	}
+
 	void Controller::setSingleParameter(uint8_t _part, n2x::SingleParam _sp, uint8_t _value)
 	{
-		if(!m_state.changeSingleParameter(_part, _sp, _value))
-			return;
+		std::scoped_lock lock(m_stateLock);
+		if(m_state.changeSingleParameter(_part, _sp, _value))
+			sendSingle(_part);
+	}
+
+	void Controller::setMultiParameter(n2x::MultiParam _mp, uint8_t _value)
+	{
+		std::scoped_lock lock(m_stateLock);
+		if(m_state.changeMultiParameter(_mp, _value))
+			sendMulti();
+	}
 
+	void Controller::sendSingle(const uint8_t _part) const
+	{
+		std::scoped_lock lock(m_stateLock);
 		const auto& single = m_state.getSingle(_part);
 		auto sysex = pluginLib::SysEx{single.begin(), single.end()};
 		sysex = n2x::State::validateDump(sysex);
 		pluginLib::Controller::sendSysEx(sysex);
 	}
 
-	void Controller::setMultiParameter(n2x::MultiParam _mp, uint8_t _value)
+	void Controller::sendMulti()
 	{
-		if(!m_state.changeMultiParameter(_mp, _value))
-			return;
+		std::scoped_lock lock(m_stateLock);
 		const auto& multi = m_state.updateAndGetMulti();
 		auto sysex = pluginLib::SysEx{multi.begin(), multi.end()};
 		sysex = n2x::State::validateDump(sysex);
 		pluginLib::Controller::sendSysEx(sysex);
 	}
 
+	bool Controller::getControlChange(uint8_t& _cc, const pluginLib::Parameter& _parameter) const
+	{
+		const auto it = m_controlChanges.find(&_parameter);
+		if(it == m_controlChanges.end())
+			return false;
+		_cc = it->second;
+		return true;
+	}
+
 	uint8_t Controller::getMultiParameter(const n2x::MultiParam _param) const
 	{
+		std::scoped_lock lock(m_stateLock);
 		return m_state.getMultiParam(_param, 0);
 	}
 
 	void Controller::sendMultiParameter(const pluginLib::Parameter& _parameter, const uint8_t _value)
 	{
-		const auto& desc = _parameter.getDescription();
-
-		const auto mp = static_cast<n2x::MultiParam>(desc.index + (desc.page - g_multiPage) * 128);
-
-		setMultiParameter(mp, _value);
+		setMultiParameter(toMultiParam(_parameter.getDescription()), _value);
 	}
 
 	bool Controller::sendSysEx(MidiPacketType _packet, const std::map<pluginLib::MidiDataType, uint8_t>& _params) const
@@ -307,6 +386,7 @@ namespace n2xJucePlugin
 
 	std::vector<uint8_t> Controller::createMultiDump(const n2x::SysexByte _bank, const uint8_t _program)
 	{
+		std::scoped_lock lock(m_stateLock);
 		const auto multi = m_state.updateAndGetMulti();
 
 		std::vector<uint8_t> result(multi.begin(), multi.end());
@@ -339,10 +419,9 @@ namespace n2xJucePlugin
 
 		auto applyLockedParamsToSingle = [&](n2x::State::SingleDump& _dump, const uint8_t _singlePart)
 		{
-			const auto& lockedParameters = getParameterLocking().getLockedParameters(_singlePart);
-
-			for (auto& lockedParam : lockedParameters)
+			getParameterLocking().getLockedParameterIndices(_singlePart).forEach([&](const uint32_t _index)
 			{
+				const auto* lockedParam = getParameter(_index, _singlePart);
 				const auto& name = lockedParam->getDescription().name;
 
 				if(name == "Sync" || name == "RingMod" || name == "Distortion")
@@ -357,12 +436,12 @@ namespace n2xJucePlugin
 					const auto val = lockedParam->getUnnormalizedValue();
 					n2x::State::changeSingleParameter(_dump, singleParam, static_cast<uint8_t>(val));
 				}
-			}
+			});
 		};
 
 		if(isSingle)
 		{
-			if(!getParameterLocking().getLockedParameters(part).empty())
+			if(!getParameterLocking().getLockedParameterIndices(part).empty())
 			{
 				n2x::State::SingleDump dump;
 				std::copy_n(d.begin(), d.size(), dump.begin());
@@ -432,12 +511,14 @@ namespace n2xJucePlugin
 
 	std::string Controller::getSingleName(const uint8_t _part) const
 	{
+		std::scoped_lock lock(m_stateLock);
 		const auto& single = m_state.getSingle(_part);
 		return PatchManager::getPatchName({single.begin(), single.end()});
 	}
 
 	std::string Controller::getPatchName(const uint8_t _part) const
 	{
+		std::scoped_lock lock(m_stateLock);
 		const auto& multi = m_state.getMulti();
 
 		const auto bank = multi[n2x::SysexIndex::IdxMsgType];
@@ -448,6 +529,7 @@ namespace n2xJucePlugin
 
 	bool Controller::getKnobState(uint8_t& _result, const n2x::KnobType _type) const
 	{
+		std::scoped_lock lock(m_stateLock);
 		return m_state.getKnobState(_result, _type);
 	}
 
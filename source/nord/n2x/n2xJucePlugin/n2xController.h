@@ -1,5 +1,8 @@
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include "jucePluginLib/controller.h"
 #include "n2xLib/n2xstate.h"
 
@@ -38,6 +41,7 @@ namespace n2xJucePlugin
 		bool parseControllerMessage(const synthLib::SMidiEvent&) override;
 
 		void sendParameterChange(const pluginLib::Parameter& _parameter, pluginLib::ParamValue _value) override;
+		void sendParameterChanges(const pluginLib::ParameterChangeBatch& _changes) override;
 
 		void setSingleParameter(uint8_t _part, n2x::SingleParam _sp, uint8_t _value);
 		void setMultiParameter(n2x::MultiParam _mp, uint8_t _value);
@@ -63,9 +67,18 @@ namespace n2xJucePlugin
 		bool getKnobState(uint8_t& _result, n2x::KnobType _type) const;
 
 	private:
+		void sendSingle(uint8_t _part) const;
+		void sendMulti();
+		bool getControlChange(uint8_t& _cc, const pluginLib::Parameter& _parameter) const;
+
 		uint8_t combineSyncRingModDistortion(uint8_t _part, uint8_t _currentCombinedValue, bool _lockedOnly);
 
+		// the state is modified by the UI thread and by the audio thread if queued parameter changes are sent
+		mutable std::recursive_mutex m_stateLock;
 		n2x::State m_state;
+
+		// the first control change of each parameter that is controllable via CC, resolved once
+		std::unordered_map<const pluginLib::Parameter*, uint8_t> m_controlChanges;
 		pluginLib::EventListener<uint8_t> m_currentPartChanged;
 	};
 }
@@ -6,6 +6,7 @@
 #include "juce_cryptography/hashing/juce_MD5.h"
 
 #include "n2xLib/n2xmiditypes.h"
+#include "n2xLib/n2xstate.h"
 
 namespace n2xJucePlugin
 {
@@ -129,6 +130,24 @@ namespace n2xJucePlugin
 		return true;
 	}
 
+	bool PatchManager::createPreviewSysex(pluginLib::patchDB::DataList& _result, const pluginLib::patchDB::PatchPtr& _patch) const
+	{
+		const auto isSingle = n2x::State::isSingleDump(_patch->sysex);
+		const auto isMulti = n2x::State::isMultiDump(_patch->sysex);
+
+		if(!isSingle && !isMulti)
+			return false;
+
+		auto d = _patch->sysex;
+
+		d[n2x::SysexIndex::IdxMsgType] = isSingle ? n2x::SysexByte::SingleDumpBankEditBuffer : n2x::SysexByte::MultiDumpBankEditBuffer;
+		d[n2x::SysexIndex::IdxMsgSpec] = 0;
+		d[n2x::SysexIndex::IdxDevice] = n2x::DefaultDeviceId;
+
+		_result.emplace_back(n2x::State::validateDump(d));
+		return true;
+	}
+
 	bool PatchManager::parseFileData(pluginLib::patchDB::DataList& _results, const pluginLib::patchDB::Data& _data)
 	{
 		return jucePluginEditorLib::patchManager::PatchManager::parseFileData(_results, _data);
@@ -38,6 +38,7 @@ namespace n2xJucePlugin
 		getController();
 		const auto latencyBlocks = getConfig().getIntValue("latencyBlocks", static_cast<int>(getPlugin().getLatencyBlocks()));
 		Processor::setLatencyBlocks(latencyBlocks);
+		Processor::setLatencyAutotune(getConfig().getBoolValue("latencyAutotune", false));
 	}
 
 	AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
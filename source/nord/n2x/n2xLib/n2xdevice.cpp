@@ -10,6 +10,7 @@ namespace n2x
 		, m_hardware(_params.romData, _params.romName)
 		, m_state(&m_hardware, &getMidiTranslator())
 	{
+		m_hardware.setMetrics(&getMetrics());
 	}
 
 	float Device::getSamplerate() const
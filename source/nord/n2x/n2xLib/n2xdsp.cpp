@@ -190,7 +190,10 @@ namespace n2x
 
 			hwLib::ScopedResumeDSP rA(m_hardware.getDSPA().getHaltDSP());
 			hwLib::ScopedResumeDSP rB(m_hardware.getDSPB().getHaltDSP());
-			m_triggerInterruptDone.wait();
+
+			// we are running on a worker of the uc executor, wait in short slices and give the DSP threads the chance to run in between
+			while(!m_triggerInterruptDone.waitFor(std::chrono::microseconds(100)))
+				std::this_thread::yield();
 		}
 
 		hdiTransferDSPtoUC();
@@ -1,13 +1,16 @@
 #include "n2xhardware.h"
 
 #include "n2xromloader.h"
-#include "dsp56kEmu/threadtools.h"
 #include "synthLib/deviceException.h"
 
 namespace n2x
 {
 	constexpr uint32_t g_syncEsaiFrameRate = 16;
 	constexpr uint32_t g_syncHaltDspEsaiThreshold = 32;
+	constexpr uint32_t g_ucQuantum = 1024;	// instructions per time slice of the uc executor
+	constexpr uint32_t g_dspAtoBBatchSize = 8;	// DSP A may run ahead of DSP B by this number of frames before it needs to wait
+
+	static_assert((g_dspAtoBBatchSize & (g_dspAtoBBatchSize - 1)) == 0, "DSP A to B batch size must be power of two");
 
 	static_assert((g_syncEsaiFrameRate & (g_syncEsaiFrameRate - 1)) == 0, "esai frame sync rate must be power of two");
 	static_assert(g_syncHaltDspEsaiThreshold >= g_syncEsaiFrameRate * 2, "esai DSP halt threshold must be greater than two times the sync rate");
@@ -36,10 +39,7 @@ namespace n2x
 		m_dspA.getPeriph().getEsai().setCallback([this](dsp56k::Audio*){ onEsaiCallbackA(); }, 0);
 		m_dspB.getPeriph().getEsai().setCallback([this](dsp56k::Audio*){ onEsaiCallbackB(); }, 0);
 
-		m_ucThread.reset(new std::thread([this]
-		{
-			ucThreadFunc();
-		}));
+		startUc();
 
 		while(!m_bootFinished)
 			processAudio(8,8);
@@ -48,10 +48,13 @@ namespace n2x
 
 	Hardware::~Hardware()
 	{
-		m_destroy = true;
-
-		while(m_destroy)
+		// DSPs need to run to let a uc quantum that is currently executed finish
+		stopUc([this]
+		{
 			processAudio(8,64);
+		});
+
+		resumeDSPs();
 
 		m_dspA.terminate();
 		m_dspB.terminate();
@@ -73,8 +76,6 @@ namespace n2x
 			if(m_dspA.getPeriph().getEsai().getAudioOutputs().empty())
 				m_dspA.getPeriph().getEsai().getAudioOutputs().push_back({});
 		}
-
-		m_ucThread->join();
 	}
 
 	bool Hardware::isValid() const
@@ -82,14 +83,35 @@ namespace n2x
 		return m_rom.isValid();
 	}
 
-	void Hardware::processUC()
+	bool Hardware::processUC()
 	{
-		syncUCtoDSP();
+		if(!syncUCtoDSP())
+			return false;
 
 		const auto deltaCycles = m_uc.exec();
 
 		if(m_esaiFrameIndex > 0)
 			m_remainingUcCycles -= static_cast<int64_t>(deltaCycles);
+
+		return true;
+	}
+
+	bool Hardware::runUcQuantum()
+	{
+		const synthLib::ScopedMetricTimer timer(m_metrics, synthLib::MetricType::UcQuantum);
+
+		for(uint32_t i=0; i<g_ucQuantum; ++i)
+		{
+			if(!processUC())
+				return false;
+		}
+		return true;
+	}
+
+	void Hardware::onUcResumed(const Clock::duration _suspendedTime)
+	{
+		if(m_metrics)
+			m_metrics->add(synthLib::MetricType::UcWaitForDsp, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(_suspendedTime).count()));
 	}
 
 	void Hardware::processAudio(uint32_t _frames, const uint32_t _latency)
@@ -129,6 +151,7 @@ namespace n2x
 			{
 				// reduce thread contention by waiting for output buffer to be full enough to let us grab the data without entering the read mutex too often
 
+				const synthLib::ScopedMetricTimer timer(m_metrics, synthLib::MetricType::HostWaitForDsp);
 				std::unique_lock uLock(m_requestedFramesAvailableMutex);
 				m_requestedFrames = requiredSize;
 				m_requestedFramesAvailableCv.wait(uLock, [&]()
@@ -143,6 +166,9 @@ namespace n2x
 			// read output of DSP B to regular audio output
 			esaiB.processAudioOutputInterleaved(outputs, processCount);
 
+			if(m_metrics)
+				m_metrics->add(synthLib::MetricType::AudioOutputFill, esaiB.getAudioOutputs().size());
+
 			outputs[0] += processCount;
 			outputs[1] += processCount;
 			outputs[2] += processCount;
@@ -174,6 +200,13 @@ namespace n2x
 		m_bootFinished = true;
 	}
 
+	void Hardware::setMetrics(synthLib::DeviceMetrics* _metrics)
+	{
+		m_metrics = _metrics;
+		m_dspA.getHaltDSP().setMetrics(_metrics);
+		m_dspB.getHaltDSP().setMetrics(_metrics);
+	}
+
 	void Hardware::ensureBufferSize(const uint32_t _frames)
 	{
 		if(m_dummyInput.size() >= _frames)
@@ -184,17 +217,17 @@ namespace n2x
 
 		for (auto& audioOutput : m_audioOutputs)
 			audioOutput.resize(_frames, 0);
-
-		m_dspAtoBBuffer.resize(_frames * 4);
 	}
 
 	void Hardware::onEsaiCallbackA()
 	{
-		// forward DSP A output to DSP B input
+		// forward DSP A output to DSP B input. The frame is reused, pushing it copies into an existing slot of the
+		// input ring of DSP B without allocating memory
 		const auto out = m_dspA.getPeriph().getEsai().getAudioOutputs().pop_front();
 
-		dsp56k::Audio::RxFrame in;
-		in.resize(out.size());
+		auto& in = m_dspAtoBFrame;
+		if(in.size() != out.size())
+			in.resize(out.size());
 
 		in[0] = dsp56k::Audio::RxSlot{out[0][0]};
 		in[1] = dsp56k::Audio::RxSlot{out[1][0]};
@@ -203,7 +236,9 @@ namespace n2x
 
 		m_dspB.getPeriph().getEsai().getAudioInputs().push_back(in);
 
-		m_semDspAtoB.wait();
+		// DSP A is throttled in batches instead of waiting for DSP B on every frame
+		if((++m_dspAtoBFramesSent & (g_dspAtoBBatchSize-1)) == 0)
+			m_semDspAtoB.wait();
 	}
 
 	void Hardware::processMidiInput()
@@ -224,14 +259,15 @@ namespace n2x
 
 	void Hardware::onEsaiCallbackB()
 	{
-		m_semDspAtoB.notify();
+		if((++m_dspAtoBFramesReceived & (g_dspAtoBBatchSize-1)) == 0)
+			m_semDspAtoB.notify();
 
 		++m_esaiFrameIndex;
 
 		processMidiInput();
 
 		if((m_esaiFrameIndex & (g_syncEsaiFrameRate-1)) == 0)
-			m_esaiFrameAddedCv.notify_one();
+			wakeUpUc();
 
 		m_requestedFramesAvailableMutex.lock();
 
@@ -247,6 +283,7 @@ namespace n2x
 
 		if(m_esaiFrameIndex >= m_maxEsaiCallbacks + m_esaiLatency)
 		{
+			const synthLib::ScopedMetricTimer timer(m_metrics, synthLib::MetricType::DspWaitForHost);
 			std::unique_lock uLock(m_haltDSPmutex);
 			m_haltDSPcv.wait(uLock, [&]
 			{
@@ -255,20 +292,20 @@ namespace n2x
 		}
 	}
 
-	void Hardware::syncUCtoDSP()
+	bool Hardware::syncUCtoDSP()
 	{
 		if(m_remainingUcCycles > 0)
-			return;
+			return true;
 
 		// we can only use ESAI to clock the uc once it has been enabled
 		if(m_esaiFrameIndex <= 0)
-			return;
+			return true;
 
 		if(m_esaiFrameIndex == m_lastEsaiFrameIndex)
 		{
+			// let the DSPs run, the uc executor suspends us until the ESAI callback wakes us up again
 			resumeDSPs();
-			std::unique_lock uLock(m_esaiFrameAddedMutex);
-			m_esaiFrameAddedCv.wait(uLock, [this]{return m_esaiFrameIndex > m_lastEsaiFrameIndex;});
+			return false;
 		}
 
 		const auto esaiFrameIndex = m_esaiFrameIndex;
@@ -293,26 +330,8 @@ namespace n2x
 			haltDSPs();
 
 		m_lastEsaiFrameIndex = esaiFrameIndex;
-	}
-
-	void Hardware::ucThreadFunc()
-	{
-		dsp56k::ThreadTools::setCurrentThreadName("MC68331");
-		dsp56k::ThreadTools::setCurrentThreadPriority(dsp56k::ThreadPriority::Highest);
 
-		while(!m_destroy)
-		{
-			processUC();
-			processUC();
-			processUC();
-			processUC();
-			processUC();
-			processUC();
-			processUC();
-			processUC();
-		}
-		resumeDSPs();
-		m_destroy = false;
+		return true;
 	}
 
 	void Hardware::advanceSamples(const uint32_t _samples, const uint32_t _latency)
@@ -4,21 +4,29 @@
 #include "n2xmc.h"
 #include "n2xrom.h"
 
+#include "hardwareLib/ucExecutor.h"
+
 #include "synthLib/audioTypes.h"
+#include "synthLib/deviceMetrics.h"
 #include "synthLib/midiTypes.h"
 
 namespace n2x
 {
-	class Hardware
+	class Hardware : public hwLib::UcExecutor::Task
 	{
 	public:
 		using AudioOutputs = std::array<std::vector<dsp56k::TWord>, 4>;
 		Hardware(const std::vector<uint8_t>& _romData = {}, const std::string& _romName = {});
-		~Hardware();
+		~Hardware() override;
 
 		bool isValid() const;
 
-		void processUC();
+		// returns false if the uc has to wait for the DSP
+		bool processUC();
+
+		// UcExecutor::Task
+		bool runUcQuantum() override;
+		void onUcResumed(Clock::duration _suspendedTime) override;
 
 		Microcontroller& getUC() {return m_uc; }
 
@@ -47,13 +55,14 @@ namespace n2x
 
 		const std::string& getRomFilename() const { return m_rom.getFilename(); }
 
+		void setMetrics(synthLib::DeviceMetrics* _metrics);
+
 	private:
 		void ensureBufferSize(uint32_t _frames);
 		void onEsaiCallbackA();
 		void processMidiInput();
 		void onEsaiCallbackB();
-		void syncUCtoDSP();
-		void ucThreadFunc();
+		bool syncUCtoDSP();
 		void advanceSamples(uint32_t _samples, uint32_t _latency);
 
 		Rom m_rom;
@@ -63,7 +72,6 @@ namespace n2x
 
 		std::vector<dsp56k::TWord> m_dummyInput;
 		std::vector<dsp56k::TWord> m_dummyOutput;
-		std::vector<dsp56k::TWord> m_dspAtoBBuffer;
 
 		AudioOutputs m_audioOutputs;
 
@@ -73,18 +81,16 @@ namespace n2x
 		uint32_t m_lastEsaiFrameIndex = 0;
 		int64_t m_remainingUcCycles = 0;
 		double m_remainingUcCyclesD = 0;
-		std::mutex m_esaiFrameAddedMutex;
-		std::condition_variable m_esaiFrameAddedCv;
 		std::mutex m_requestedFramesAvailableMutex;
 		std::condition_variable m_requestedFramesAvailableCv;
 		size_t m_requestedFrames = 0;
 		bool m_dspHalted = false;
-		dsp56k::SpscSemaphore m_semDspAtoB;
 
-		dsp56k::RingBuffer<dsp56k::Audio::RxFrame, 4, true> m_dspAtoBbuf;
-
-		std::unique_ptr<std::thread> m_ucThread;
-		bool m_destroy = false;
+		// DSP A to DSP B audio
+		dsp56k::SpscSemaphore m_semDspAtoB;
+		dsp56k::Audio::RxFrame m_dspAtoBFrame;
+		uint32_t m_dspAtoBFramesSent = 0;
+		uint32_t m_dspAtoBFramesReceived = 0;
 
 		// Midi
 		dsp56k::RingBuffer<synthLib::SMidiEvent, 16384, true> m_midiIn;
@@ -97,5 +103,7 @@ namespace n2x
 		std::condition_variable m_haltDSPcv;
 
 		bool m_bootFinished = false;
+
+		synthLib::DeviceMetrics* m_metrics = nullptr;
 	};
 }
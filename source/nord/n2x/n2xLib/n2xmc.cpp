@@ -79,9 +79,13 @@ namespace n2x
 			}
 
 			if(sdaD && sclD)
+			{
+				m_flashTrace.addWrite(sdaV, sclV);
 				m_flash.masterWrite(sdaV, sclV);
+			}
 			else if(!sdaD && sclD)
 			{
+				m_flashTrace.addRead(sclV);
 				if(const auto res = m_flash.masterRead(sclV))
 				{
 					auto r = v;
@@ -89,7 +93,7 @@ namespace n2x
 					r |= *res ? (1<<g_bitSDA) : 0;
 
 					getPortGP().writeRX(r);
-					LOG("PortGP return SDA=" << *res);
+//					LOG("PortGP return SDA=" << *res);
 				}
 				else
 				{
@@ -104,13 +108,14 @@ namespace n2x
 			const auto p = _port.getDirection();
 			const auto sda = (p >> g_bitSDA) & 1;
 			const auto scl = (p >> g_bitSCL) & 1;
-			LOG("PortGP dir SDA=" << (sda?"w":"r") << " SCL=" << (scl?"w":"r"));
+//			LOG("PortGP dir SDA=" << (sda?"w":"r") << " SCL=" << (scl?"w":"r"));
 			if(scl)
 			{
+				m_flashTrace.addSdaDirection(sda);
 				const auto ack = m_flash.setSdaWrite(sda);
 				if(ack)
 				{
-					LOG("Write ACK " << (*ack));
+//					LOG("Write ACK " << (*ack));
 					getPortGP().writeRX(*ack ? (1<<g_bitSDA) : 0);
 				}
 			}
@@ -310,6 +315,10 @@ namespace n2x
 		static volatile bool writeFlash = false;
 		static volatile bool writeRam = false;
 
+		// record the flash accesses while storing a patch, write them afterwards to replay them with n2xFlashTest
+		static volatile bool recordFlashTrace = false;
+		static volatile bool writeFlashTrace = false;
+
 		if(writeFlash)
 		{
 			writeFlash = false;
@@ -321,6 +330,15 @@ namespace n2x
 			writeRam = false;
 			baseLib::filesystem::writeFile("romRam_runtime.bin", m_romRam);
 		}
+
+		m_flashTrace.setEnabled(recordFlashTrace);
+
+		if(writeFlashTrace)
+		{
+			writeFlashTrace = false;
+			m_flashTrace.saveAs("flash_runtime.i2ctrace");
+			m_flashTrace.clear();
+		}
 #endif
 		const auto cycles = Mc68k::exec();
 
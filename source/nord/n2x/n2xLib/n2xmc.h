@@ -7,6 +7,7 @@
 
 #include "mc68k/mc68k.h"
 
+#include "hardwareLib/i2cTrace.h"
 #include "hardwareLib/sciMidi.h"
 
 namespace n2x
@@ -42,6 +43,7 @@ namespace n2x
 		std::array<uint8_t, g_dspBothAddress> m_romRam;
 
 		Flash m_flash;
+		hwLib::I2cTrace m_flashTrace;	// records only if enabled in a debug build, see exec()
 
 		Hdi08DspA m_hdi08A;
 		Hdi08DspB m_hdi08B;
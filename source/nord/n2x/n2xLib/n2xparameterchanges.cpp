@@ -0,0 +1,39 @@
+#include "n2xparameterchanges.h"
+
+#include "n2xstate.h"
+
+namespace n2x
+{
+	ParameterChanges::Target ParameterChanges::getTarget(const uint32_t _page, const bool _hasControlChange)
+	{
+		if(_page >= MultiPage)
+			return Target::Multi;
+		return _hasControlChange ? Target::ControlChange : Target::Single;
+	}
+
+	MultiParam ParameterChanges::toMultiParam(const uint32_t _page, const uint32_t _index)
+	{
+		return static_cast<MultiParam>(_index + (_page - MultiPage) * 128);
+	}
+
+	ParameterChanges::Target ParameterChanges::add(const uint8_t _part, const uint32_t _page, const uint32_t _index, const uint8_t _value, const bool _hasControlChange)
+	{
+		const auto target = getTarget(_page, _hasControlChange);
+
+		switch (target)
+		{
+		case Target::Single:
+			if(m_state.changeSingleParameter(_part, static_cast<SingleParam>(_index), _value))
+				m_singleChanged[_part] = true;
+			break;
+		case Target::Multi:
+			if(m_state.changeMultiParameter(toMultiParam(_page, _index), _value))
+				m_multiChanged = true;
+			break;
+		case Target::ControlChange:
+			break;
+		}
+
+		return target;
+	}
+}
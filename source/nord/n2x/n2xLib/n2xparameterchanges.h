@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "n2xmiditypes.h"
+
+namespace n2x
+{
+	class State;
+
+	// The N2x has no sysex message for a single parameter, every parameter change without CC needs a complete dump.
+	// The changes of an audio block are applied to the state first, afterwards one single dump is sent per changed
+	// part and one multi dump for all multi parameters. Parameters that have a CC are sent as CC by the caller
+	class ParameterChanges
+	{
+	public:
+		enum class Target
+		{
+			Single,
+			Multi,
+			ControlChange,
+		};
+
+		static constexpr uint32_t MultiPage = 10;	// parameter descriptions on this page and above are multi parameters
+
+		explicit ParameterChanges(State& _state) : m_state(_state) {}
+
+		static Target getTarget(uint32_t _page, bool _hasControlChange);
+		static MultiParam toMultiParam(uint32_t _page, uint32_t _index);
+
+		// single and multi parameters are applied to the state, control changes are not
+		Target add(uint8_t _part, uint32_t _page, uint32_t _index, uint8_t _value, bool _hasControlChange);
+
+		bool isSingleChanged(const uint8_t _part) const { return m_singleChanged[_part]; }
+		bool isMultiChanged() const { return m_multiChanged; }
+
+	private:
+		State& m_state;
+		std::array<bool, 4> m_singleChanged{};
+		bool m_multiChanged = false;
+	};
+}
@@ -0,0 +1,193 @@
+#include <iostream>
+#include <vector>
+
+#include "n2xLib/n2xparameterchanges.h"
+#include "n2xLib/n2xstate.h"
+
+// Checks how the n2x plugin controller groups the parameter changes of an audio block into dumps and CCs, see
+// n2xJucePlugin::Controller::sendParameterChanges()
+
+namespace
+{
+	using n2x::ParameterChanges;
+	using n2x::State;
+
+	constexpr uint8_t g_partCount = 4;
+	constexpr uint32_t g_stepsPerBlock = 8;		// UI changes per audio block while dragging a knob quickly
+
+	// the parameters of a region that change at once when a region is linked across all parts
+	const std::vector<n2x::SingleParam> g_region =
+	{
+		n2x::O2Pitch, n2x::O2PitchFine, n2x::Mix, n2x::Cutoff, n2x::Resonance, n2x::FilterEnvAmount, n2x::PW, n2x::FmDepth,
+		n2x::FilterEnvA, n2x::FilterEnvD, n2x::FilterEnvS, n2x::FilterEnvR, n2x::AmpEnvA, n2x::AmpEnvD, n2x::AmpEnvS, n2x::AmpEnvR
+	};
+
+	const std::vector<n2x::MultiParam> g_multiParams = { n2x::BendRange, n2x::UnisonDetune };
+
+	struct Messages
+	{
+		uint32_t singleDumps = 0;
+		uint32_t multiDumps = 0;
+		uint32_t controlChanges = 0;
+	};
+
+	uint32_t getPage(const n2x::MultiParam _param)
+	{
+		return ParameterChanges::MultiPage + static_cast<uint32_t>(_param) / 128;
+	}
+
+	uint32_t getIndex(const n2x::MultiParam _param)
+	{
+		return static_cast<uint32_t>(_param) & 127;
+	}
+
+	// counts the messages that the controller sends after all changes of a block have been added
+	Messages getMessages(const ParameterChanges& _changes, const uint32_t _controlChanges)
+	{
+		Messages m;
+		for(uint8_t p=0; p<g_partCount; ++p)
+			m.singleDumps += _changes.isSingleChanged(p) ? 1 : 0;
+		m.multiDumps = _changes.isMultiChanged() ? 1 : 0;
+		m.controlChanges = _controlChanges;
+		return m;
+	}
+
+	bool check(const char* _name, const Messages& _messages, const Messages& _expected)
+	{
+		std::cout << _name << ": " << _messages.singleDumps << " single dumps, " << _messages.multiDumps << " multi dumps, " << _messages.controlChanges << " CCs" << std::endl;
+
+		if(_messages.singleDumps == _expected.singleDumps && _messages.multiDumps == _expected.multiDumps && _messages.controlChanges == _expected.controlChanges)
+			return true;
+
+		std::cout << "  Expected " << _expected.singleDumps << " single dumps, " << _expected.multiDumps << " multi dumps, " << _expected.controlChanges << " CCs" << std::endl;
+		return false;
+	}
+
+	// A region without CCs is edited on part 0 and linked to all other parts. All changes of all parts end up in one
+	// single dump per part, the state has the latest values
+	bool testLinkedRegion(State& _state)
+	{
+		ParameterChanges changes(_state);
+
+		uint32_t ccs = 0;
+
+		for(uint32_t s=0; s<g_stepsPerBlock; ++s)
+		{
+			for(uint8_t p=0; p<g_partCount; ++p)
+			{
+				for (const auto param : g_region)
+				{
+					if(changes.add(p, 0, param, static_cast<uint8_t>(s + 1), false) == ParameterChanges::Target::ControlChange)
+						++ccs;
+				}
+			}
+		}
+
+		if(!check("Linked region", getMessages(changes, ccs), {g_partCount, 0, 0}))
+			return false;
+
+		for(uint8_t p=0; p<g_partCount; ++p)
+		{
+			for (const auto param : g_region)
+			{
+				const auto v = State::getSingleParam(_state.getSingle(p), param, 0);
+
+				if(v == g_stepsPerBlock)
+					continue;
+
+				std::cout << "  Parameter " << param << " of part " << static_cast<int>(p) << " is " << static_cast<int>(v) << ", expected " << g_stepsPerBlock << std::endl;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// values that the device has already do not cause a dump
+	bool testUnchanged(State& _state)
+	{
+		ParameterChanges changes(_state);
+
+		for(uint8_t p=0; p<g_partCount; ++p)
+		{
+			for (const auto param : g_region)
+				changes.add(p, 0, param, static_cast<uint8_t>(g_stepsPerBlock), false);
+		}
+
+		return check("Unchanged values", getMessages(changes, 0), {0, 0, 0});
+	}
+
+	// multi parameters of all pages end up in one multi dump and do not touch the singles
+	bool testMulti(State& _state)
+	{
+		ParameterChanges changes(_state);
+
+		uint8_t value = 1;
+
+		for (const auto param : g_multiParams)
+		{
+			if(changes.add(0, getPage(param), getIndex(param), value++, false) != ParameterChanges::Target::Multi)
+			{
+				std::cout << "  Multi parameter " << param << " has not been detected as such" << std::endl;
+				return false;
+			}
+		}
+
+		if(!check("Multi parameters", getMessages(changes, 0), {0, 1, 0}))
+			return false;
+
+		value = 1;
+
+		for (const auto param : g_multiParams)
+		{
+			const auto v = _state.getMultiParam(param, 0);
+
+			if(v == value++)
+				continue;
+
+			std::cout << "  Multi parameter " << param << " is " << static_cast<int>(v) << ", expected " << static_cast<int>(value - 1) << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	// parameters with a CC are sent as CC by the caller, they do not change the state and do not cause a dump. A CC
+	// is not decisive for multi parameters, they are always part of the multi dump
+	bool testControlChanges(State& _state)
+	{
+		ParameterChanges changes(_state);
+
+		uint32_t ccs = 0;
+
+		for(uint8_t p=0; p<g_partCount; ++p)
+		{
+			for (const auto param : g_region)
+			{
+				if(changes.add(p, 0, param, 100, true) == ParameterChanges::Target::ControlChange)
+					++ccs;
+			}
+		}
+
+		changes.add(0, 0, n2x::Cutoff, 50, false);
+		changes.add(0, getPage(n2x::BendRange), getIndex(n2x::BendRange), 12, true);
+
+		if(!check("CCs, one single and one multi parameter", getMessages(changes, ccs), {1, 1, g_partCount * static_cast<uint32_t>(g_region.size())}))
+			return false;
+
+		if(State::getSingleParam(_state.getSingle(1), n2x::Cutoff, 0) != g_stepsPerBlock)
+		{
+			std::cout << "  A parameter sent as CC modified the state" << std::endl;
+			return false;
+		}
+		return true;
+	}
+}
+
+int main()
+{
+	State state(nullptr, nullptr);
+
+	if(!testLinkedRegion(state) || !testUnchanged(state) || !testMulti(state) || !testControlChanges(state))
+		return -1;
+
+	return 0;
+}
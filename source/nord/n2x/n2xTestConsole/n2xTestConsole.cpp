@@ -1,7 +1,12 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 
 #include "n2xLib/n2xhardware.h"
 
+#include "baseLib/commandline.h"
+
 #include "synthLib/wavWriter.h"
 
 static constexpr bool g_factoryDemo = true;
@@ -11,8 +16,16 @@ namespace n2x
 	class Hardware;
 }
 
-int main()
+int main(int _argc, char* _argv[])
 {
+	const baseLib::CommandLine commandLine(_argc, _argv);
+
+	// -benchmark [seconds]: render the given amount of audio as fast as possible instead of writing a wav file forever.
+	// Prints the realtime factor and a hash of the output, the hash needs to be identical between builds to ensure that
+	// the output is still bit-exact
+	const auto benchmark = commandLine.contains("benchmark");
+	const auto benchmarkSeconds = static_cast<uint32_t>(std::max(1, commandLine.getInt("benchmark", 20)));
+
 	std::unique_ptr<n2x::Hardware> hw;
 	hw.reset(new n2x::Hardware());
 
@@ -30,21 +43,28 @@ int main()
 	std::vector<dsp56k::TWord> stereoOutput;
 	stereoOutput.resize(blockSize<<1);
 
-	synthLib::AsyncWriter writer("n2xEmu_out.wav", n2x::g_samplerate, false);
+	std::unique_ptr<synthLib::AsyncWriter> writer;
+
+	if(!benchmark)
+		writer.reset(new synthLib::AsyncWriter("n2xEmu_out.wav", n2x::g_samplerate, false));
 
 	uint32_t totalSamples = 0;
 
-	while(true)
+	auto seconds = [&](uint32_t _seconds)
+	{
+		return _seconds * (n2x::g_samplerate / blockSize) * blockSize;
+	};
+
+	uint64_t hash = 14695981039346656037ull;	// FNV-1a
+
+	const auto tStart = std::chrono::steady_clock::now();
+
+	while(!benchmark || totalSamples < seconds(benchmarkSeconds))
 	{
 		hw->processAudio(blockSize, blockSize);
 
 		totalSamples += blockSize;
 
-		auto seconds = [&](uint32_t _seconds)
-		{
-			return _seconds * (n2x::g_samplerate / blockSize) * blockSize;
-		};
-
 		if constexpr (g_factoryDemo)
 		{
 			// Run factory demo, press shift + osc sync
@@ -69,9 +89,28 @@ int main()
 			stereoOutput[(i<<1)+1] = outs[1][i] + outs[3][i];
 		}
 
-		writer.append([&](std::vector<dsp56k::TWord>& _wavOut)
+		if(benchmark)
 		{
-			_wavOut.insert(_wavOut.end(), stereoOutput.begin(), stereoOutput.end());
-		});
+			for (const auto s : stereoOutput)
+			{
+				hash ^= s;
+				hash *= 1099511628211ull;
+			}
+		}
+		else
+		{
+			writer->append([&](std::vector<dsp56k::TWord>& _wavOut)
+			{
+				_wavOut.insert(_wavOut.end(), stereoOutput.begin(), stereoOutput.end());
+			});
+		}
 	}
+
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+	const auto rendered = static_cast<double>(totalSamples) / static_cast<double>(n2x::g_samplerate);
+
+	std::cout << "Rendered " << rendered << " seconds of audio in " << elapsed << " seconds, realtime factor " << (rendered / elapsed) << '\n';
+	std::cout << "Output hash " << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << '\n';
+
+	return 0;
 }
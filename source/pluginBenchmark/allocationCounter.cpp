@@ -0,0 +1,58 @@
+#include "allocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<uint64_t> g_allocationCount{0};
+
+	void* allocate(const size_t _size)
+	{
+		++g_allocationCount;
+
+		if(auto* p = std::malloc(_size ? _size : 1))
+			return p;
+
+		throw std::bad_alloc();
+	}
+}
+
+void* operator new(const size_t _size)
+{
+	return allocate(_size);
+}
+
+void* operator new[](const size_t _size)
+{
+	return allocate(_size);
+}
+
+void operator delete(void* _p) noexcept
+{
+	std::free(_p);
+}
+
+void operator delete[](void* _p) noexcept
+{
+	std::free(_p);
+}
+
+void operator delete(void* _p, size_t) noexcept
+{
+	std::free(_p);
+}
+
+void operator delete[](void* _p, size_t) noexcept
+{
+	std::free(_p);
+}
+
+namespace pluginBenchmark
+{
+	uint64_t AllocationCounter::get()
+	{
+		return g_allocationCount.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace pluginBenchmark
+{
+	// counts all calls to the global operator new of the process
+	class AllocationCounter
+	{
+	public:
+		static uint64_t get();
+	};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace baseLib
+{
+	class CommandLine;
+}
+
+namespace pluginBenchmark
+{
+	struct Benchmark
+	{
+		const char* name;
+		const char* description;
+		bool (*run)(const baseLib::CommandLine& _cmd);	// returns false if the benchmark detected a functional error
+	};
+
+	bool runBypassBenchmark(const baseLib::CommandLine& _cmd);
+	bool runLockingBenchmark(const baseLib::CommandLine& _cmd);
+	bool runParameterChangeBenchmark(const baseLib::CommandLine& _cmd);
+	bool runParameterLinkBenchmark(const baseLib::CommandLine& _cmd);
+	bool runResamplerBenchmark(const baseLib::CommandLine& _cmd);
+}
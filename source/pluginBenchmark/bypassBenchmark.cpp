@@ -0,0 +1,152 @@
+#include "benchmark.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "baseLib/commandline.h"
+
+#include "jucePluginLib/bypassBuffer.h"
+
+namespace pluginBenchmark
+{
+	namespace
+	{
+		constexpr uint32_t g_channels = 2;
+		constexpr uint32_t g_blockSize = 128;
+		constexpr float g_samplerate = 48000.0f;
+		constexpr float g_frequency = 440.0f;
+
+		// the largest step between two samples of the sine is 2 * pi * f / fs = 0.058. Anything above that is a click
+		constexpr float g_maxStep = 0.1f;
+
+		struct Sine
+		{
+			double phase = 0.0;
+
+			void fill(float* _dst, const uint32_t _count)
+			{
+				constexpr double inc = 2.0 * 3.14159265358979323846 * g_frequency / g_samplerate;
+
+				for(uint32_t i=0; i<_count; ++i)
+				{
+					_dst[i] = static_cast<float>(std::sin(phase));
+					phase += inc;
+				}
+			}
+		};
+
+		// feeds a sine through the bypass buffer while the latency changes and checks that the output has no jumps and
+		// that it ends up being the input, delayed by the latency
+		bool testLatencyChanges()
+		{
+			constexpr uint32_t latencies[] = {0, 64, 1000, 37, 4000, 512, 3, 0, 16383};
+			constexpr uint32_t blocksPerLatency = 40;
+
+			pluginLib::BypassBuffer bypass;
+			Sine sine;
+
+			std::vector<float> input;
+			std::vector<float> output;
+
+			std::vector<float> in(g_blockSize);
+			std::vector<float> out(g_blockSize);
+
+			for (const auto latency : latencies)
+			{
+				for(uint32_t b=0; b<blocksPerLatency; ++b)
+				{
+					sine.fill(in.data(), g_blockSize);
+
+					for(uint32_t c=0; c<g_channels; ++c)
+					{
+						bypass.write(in.data(), c, g_blockSize, latency);
+						bypass.read(out.data(), c, g_blockSize);
+					}
+
+					input.insert(input.end(), in.begin(), in.end());
+					output.insert(output.end(), out.begin(), out.end());
+				}
+
+				const auto blockEnd = output.size();
+
+				// fades are done, the tail needs to be the delayed input
+				for(size_t i=blockEnd - g_blockSize; i<blockEnd; ++i)
+				{
+					const auto expected = i >= latency ? input[i - latency] : 0.0f;
+
+					if(output[i] == expected)
+						continue;
+
+					std::cout << "  Output is not the input delayed by " << latency << " samples at sample " << i << std::endl;
+					return false;
+				}
+			}
+
+			float maxStep = 0.0f;
+			size_t maxStepPos = 0;
+
+			for(size_t i=1; i<output.size(); ++i)
+			{
+				const auto step = std::fabs(output[i] - output[i-1]);
+
+				if(step > maxStep)
+				{
+					maxStep = step;
+					maxStepPos = i;
+				}
+			}
+
+			std::cout << "  Largest step between two samples while changing the latency: " << std::setprecision(4) << maxStep << " at sample " << maxStepPos << ", threshold " << g_maxStep << std::endl;
+
+			return maxStep <= g_maxStep;
+		}
+
+		void measure(const double _seconds)
+		{
+			pluginLib::BypassBuffer bypass;
+
+			std::vector<float> data(g_blockSize);
+			Sine().fill(data.data(), g_blockSize);
+
+			using Clock = std::chrono::high_resolution_clock;
+
+			const auto start = Clock::now();
+
+			uint64_t blocks = 0;
+			double elapsed = 0.0;
+
+			do
+			{
+				for(uint32_t i=0; i<1024; ++i)
+				{
+					for(uint32_t c=0; c<g_channels; ++c)
+					{
+						bypass.write(data.data(), c, g_blockSize, 1000);
+						bypass.read(data.data(), c, g_blockSize);
+					}
+				}
+
+				blocks += 1024;
+				elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+			while(elapsed < _seconds);
+
+			const auto audioSeconds = static_cast<double>(blocks) * g_blockSize / g_samplerate;
+
+			std::cout << "  " << g_channels << " channels, block size " << g_blockSize << ": " << std::fixed << std::setprecision(0) << audioSeconds / elapsed << "x realtime" << std::endl;
+		}
+	}
+
+	bool runBypassBenchmark(const baseLib::CommandLine& _cmd)
+	{
+		if(!testLatencyChanges())
+			return false;
+
+		measure(static_cast<double>(_cmd.getFloat("seconds", 1.0f)));
+
+		return true;
+	}
+}
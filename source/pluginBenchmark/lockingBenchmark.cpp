@@ -0,0 +1,284 @@
+#include "benchmark.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testPlugin.h"
+
+#include "baseLib/commandline.h"
+
+#include "jucePluginLib/parameterIndexSet.h"
+
+namespace pluginBenchmark
+{
+	namespace
+	{
+		using pluginLib::ParameterIndexSet;
+
+		constexpr uint8_t g_partCount = 16;
+		constexpr uint32_t g_parameterCount = 512;
+		constexpr uint32_t g_regionCount = 24;
+		constexpr uint32_t g_lockedRegionsPerPart = 4;
+
+		// a synthetic set of parameters and regions, similar in size to the ones of the Virus
+		std::vector<TestRegion> createRegions(std::mt19937& _rng)
+		{
+			std::vector<TestRegion> regions;
+
+			for(uint32_t r=0; r<g_regionCount; ++r)
+			{
+				TestRegion region;
+				region.id = "region" + std::to_string(r);
+
+				const auto first = _rng() % g_parameterCount;
+				const auto count = 8 + _rng() % 64;
+
+				for(uint32_t i=0; i<count; ++i)
+					region.parameters.push_back((first + i) % g_parameterCount);
+
+				regions.push_back(std::move(region));
+			}
+			return regions;
+		}
+
+		// checks the locked parameters against the parameter names of all locked regions
+		bool verifyLockedParameters(pluginLib::Controller& _controller)
+		{
+			const auto& locking = _controller.getParameterLocking();
+			const auto& regions = _controller.getParameterDescriptions().getRegions();
+
+			for(uint8_t p=0; p<g_partCount; ++p)
+			{
+				std::set<std::string> lockedNames;
+
+				for (const auto& id : locking.getLockedRegions(p))
+				{
+					for (const auto& it : regions.find(id)->second.getParams())
+						lockedNames.insert(it.first);
+				}
+
+				if(lockedNames.size() != locking.getLockedParameterIndices(p).count())
+				{
+					std::cout << "  Locked parameter count mismatch for part " << static_cast<int>(p) << std::endl;
+					return false;
+				}
+
+				for(uint32_t i=0; i<g_parameterCount; ++i)
+				{
+					const auto name = getTestParameterName(i);
+					const auto expected = lockedNames.find(name) != lockedNames.end();
+
+					if(locking.isParameterLocked(p, i) != expected || locking.isParameterLocked(p, name) != expected || _controller.getParameter(i, p)->isLocked() != expected)
+					{
+						std::cout << "  Parameter " << name << " of part " << static_cast<int>(p) << " is " << (expected ? "not " : "") << "locked" << std::endl;
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		using Values = std::vector<int>;
+
+		// applies a preset to all parts, skipping locked parameters. Returns the number of locked parameters
+		uint32_t applyPresetByName(const pluginLib::ParameterLocking& _locking, const std::vector<std::string>& _names, std::vector<Values>& _parts, const Values& _preset)
+		{
+			uint32_t lockedCount = 0;
+
+			for(uint8_t p=0; p<g_partCount; ++p)
+			{
+				for(uint32_t i=0; i<g_parameterCount; ++i)
+				{
+					if(!_locking.isParameterLocked(p, _names[i]))
+						_parts[p][i] = _preset[i];
+					else
+						++lockedCount;
+				}
+			}
+			return lockedCount;
+		}
+
+		uint32_t applyPresetByIndex(const pluginLib::ParameterLocking& _locking, std::vector<Values>& _parts, const Values& _preset)
+		{
+			uint32_t lockedCount = 0;
+
+			for(uint8_t p=0; p<g_partCount; ++p)
+			{
+				const auto& locked = _locking.getLockedParameterIndices(p);
+
+				for(uint32_t i=0; i<g_parameterCount; ++i)
+				{
+					if(!locked.contains(i))
+						_parts[p][i] = _preset[i];
+					else
+						++lockedCount;
+				}
+			}
+			return lockedCount;
+		}
+
+		// compares the bitset against std::set for random operations
+		bool testIndexSet()
+		{
+			std::mt19937 rng(42);
+
+			for(uint32_t iteration=0; iteration<100; ++iteration)
+			{
+				ParameterIndexSet a(rng() % 300), b;
+				std::set<uint32_t> refA, refB;
+
+				for(uint32_t i=0; i<200; ++i)
+				{
+					const auto index = rng() % 700;
+
+					switch(rng() % 3)
+					{
+					case 0:		a.add(index); refA.insert(index); break;
+					case 1:		a.remove(index); refA.erase(index); break;
+					default:	b.add(index); refB.insert(index); break;
+					}
+				}
+
+				std::set<uint32_t> refUnion(refA), refIntersection, refXor;
+				refUnion.insert(refB.begin(), refB.end());
+
+				for (auto i : refUnion)
+				{
+					const auto inA = refA.count(i) != 0;
+					const auto inB = refB.count(i) != 0;
+					if(inA && inB)	refIntersection.insert(i);
+					if(inA != inB)	refXor.insert(i);
+				}
+
+				auto toSet = [](const ParameterIndexSet& _s)
+				{
+					std::set<uint32_t> res;
+					_s.forEach([&](const uint32_t _i) { res.insert(_i); });
+					return res;
+				};
+
+				auto u = a; u |= b;
+				auto n = a; n &= b;
+				const auto x = a ^ b;
+
+				if(toSet(a) != refA || a.count() != refA.size() || a.empty() != refA.empty() ||
+					toSet(u) != refUnion || toSet(n) != refIntersection || toSet(x) != refXor ||
+					(x == ParameterIndexSet()) != refXor.empty())
+				{
+					std::cout << "  Parameter index set does not match std::set in iteration " << iteration << std::endl;
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template<typename TFunc> double measure(const double _seconds, const TFunc& _func)
+		{
+			using Clock = std::chrono::high_resolution_clock;
+
+			const auto start = Clock::now();
+
+			uint64_t count = 0;
+			double elapsed = 0.0;
+
+			do
+			{
+				for(uint32_t i=0; i<16; ++i)
+					_func();
+
+				count += 16;
+				elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+			while(elapsed < _seconds);
+
+			return elapsed * 1000000.0 / static_cast<double>(count);
+		}
+	}
+
+	bool runLockingBenchmark(const baseLib::CommandLine& _cmd)
+	{
+		if(!testIndexSet())
+			return false;
+
+		std::mt19937 rng(1234);
+
+		TestProcessor processor(createParameterDescriptions(g_parameterCount, createRegions(rng)));
+		auto& controller = processor.getTestController();
+
+		if(!controller.getParameterDescriptions().isValid())
+		{
+			std::cout << "  Failed to parse parameter descriptions: " << controller.getParameterDescriptions().getErrors() << std::endl;
+			return false;
+		}
+
+		auto& locking = controller.getParameterLocking();
+
+		if(locking.lockRegion(0, "unknownRegion"))
+		{
+			std::cout << "  Locking an unknown region succeeded" << std::endl;
+			return false;
+		}
+
+		for(uint8_t p=0; p<g_partCount; ++p)
+		{
+			for(uint32_t i=0; i<g_lockedRegionsPerPart; ++i)
+				locking.lockRegion(p, "region" + std::to_string(rng() % g_regionCount));
+		}
+
+		if(!verifyLockedParameters(controller))
+			return false;
+
+		// regions overlap, parameters that are part of another locked region need to stay locked
+		for(uint8_t p=0; p<g_partCount; p += 2)
+		{
+			const auto id = *std::as_const(locking).getLockedRegions(p).begin();
+
+			if(!locking.unlockRegion(p, id) || !verifyLockedParameters(controller) || !locking.lockRegion(p, id))
+			{
+				std::cout << "  Unlocking region " << id << " of part " << static_cast<int>(p) << " failed" << std::endl;
+				return false;
+			}
+		}
+
+		if(!verifyLockedParameters(controller))
+			return false;
+
+		std::vector<std::string> names;
+		for(uint32_t i=0; i<g_parameterCount; ++i)
+			names.push_back(getTestParameterName(i));
+
+		Values preset(g_parameterCount);
+		for(uint32_t i=0; i<g_parameterCount; ++i)
+			preset[i] = static_cast<int>(i & 127);
+
+		std::vector<Values> partsByName(g_partCount, Values(g_parameterCount, -1));
+		std::vector<Values> partsByIndex(g_partCount, Values(g_parameterCount, -1));
+
+		const auto lockedByName = applyPresetByName(locking, names, partsByName, preset);
+		const auto lockedByIndex = applyPresetByIndex(locking, partsByIndex, preset);
+
+		if(lockedByName != lockedByIndex || partsByName != partsByIndex)
+		{
+			std::cout << "  Preset application differs between name and index based locking" << std::endl;
+			return false;
+		}
+
+		const auto seconds = static_cast<double>(_cmd.getFloat("seconds", 1.0f));
+
+		const auto usByName = measure(seconds, [&] { applyPresetByName(locking, names, partsByName, preset); });
+		const auto usByIndex = measure(seconds, [&] { applyPresetByIndex(locking, partsByIndex, preset); });
+
+		std::cout << "  " << static_cast<int>(g_partCount) << " parts, " << g_parameterCount << " parameters, " << lockedByIndex << " locked" << std::endl;
+		std::cout << std::fixed << std::setprecision(2);
+		std::cout << "  Preset application, lookup by name:  " << std::setw(10) << usByName << " us" << std::endl;
+		std::cout << "  Preset application, lookup by index: " << std::setw(10) << usByIndex << " us" << std::endl;
+
+		return true;
+	}
+}
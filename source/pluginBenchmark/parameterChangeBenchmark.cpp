@@ -0,0 +1,251 @@
+#include "benchmark.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "allocationCounter.h"
+
+#include "baseLib/commandline.h"
+
+#include "jucePluginLib/midipacket.h"
+#include "jucePluginLib/parameterChangeEncoder.h"
+
+#include "synthLib/midiTypes.h"
+
+namespace pluginBenchmark
+{
+	namespace
+	{
+		using pluginLib::MidiDataType;
+		using pluginLib::MidiPacket;
+
+		constexpr uint32_t g_partCount = 16;
+		constexpr uint32_t g_parametersPerPart = 100;
+		constexpr uint32_t g_changesPerBlock = g_partCount * g_parametersPerPart;
+		constexpr uint8_t g_deviceId = 0x10;
+
+		MidiPacket::MidiDataDefinition byte(const uint8_t _value)
+		{
+			MidiPacket::MidiDataDefinition d;
+			d.type = MidiDataType::Byte;
+			d.byte = _value;
+			return d;
+		}
+
+		MidiPacket::MidiDataDefinition data(const MidiDataType _type)
+		{
+			MidiPacket::MidiDataDefinition d;
+			d.type = _type;
+			return d;
+		}
+
+		MidiPacket::MidiDataDefinition checksum(const uint32_t _first, const uint32_t _last)
+		{
+			MidiPacket::MidiDataDefinition d;
+			d.type = MidiDataType::Checksum;
+			d.checksumFirstIndex = _first;
+			d.checksumLastIndex = _last;
+			return d;
+		}
+
+		// same layout as the parameter change of the Virus
+		MidiPacket createPacketVirus()
+		{
+			return MidiPacket("parameterchange", {
+				byte(0xf0), byte(0x00), byte(0x20), byte(0x33), byte(0x01),
+				data(MidiDataType::DeviceId), data(MidiDataType::Page), data(MidiDataType::Part),
+				data(MidiDataType::ParameterIndex), data(MidiDataType::ParameterValue),
+				byte(0xf7)
+			});
+		}
+
+		// same layout as the single parameter change of the Microwave II/XT, including a checksum
+		MidiPacket createPacketXt()
+		{
+			return MidiPacket("singleparameterchange", {
+				byte(0xf0), byte(0x3e), byte(0x0e),
+				data(MidiDataType::DeviceId), byte(0x20),
+				data(MidiDataType::Page), data(MidiDataType::ParameterIndex), data(MidiDataType::Part),
+				data(MidiDataType::ParameterValue),
+				checksum(5, 8),
+				byte(0xf7)
+			});
+		}
+
+		struct Parameter
+		{
+			uint8_t part;
+			uint8_t page;
+			uint8_t index;
+		};
+
+		std::vector<Parameter> createParameters()
+		{
+			std::vector<Parameter> params;
+			params.reserve(g_changesPerBlock);
+
+			for(uint32_t p=0; p<g_partCount; ++p)
+			{
+				for(uint32_t i=0; i<g_parametersPerPart; ++i)
+					params.push_back({static_cast<uint8_t>(p), static_cast<uint8_t>(i >> 7), static_cast<uint8_t>(i & 0x7f)});
+			}
+			return params;
+		}
+
+		uint8_t getValue(const uint32_t _block, const uint32_t _param)
+		{
+			return static_cast<uint8_t>((_block + _param) & 0x7f);
+		}
+
+		struct Result
+		{
+			double changesPerSecond = 0.0;
+			double allocationsPerBlock = 0.0;
+		};
+
+		// _encode(block, events) encodes one block of changes into the given events. The events stand in for the slots
+		// of the MIDI ring buffer of synthLib::Plugin, they are reused from block to block
+		template<typename TEncode>
+		Result measure(const double _seconds, TEncode&& _encode)
+		{
+			std::vector<synthLib::SMidiEvent> events(g_changesPerBlock);
+
+			// warm up, the events allocate their sysex storage once
+			_encode(0, events);
+
+			using Clock = std::chrono::high_resolution_clock;
+
+			const auto allocationsBefore = AllocationCounter::get();
+			const auto start = Clock::now();
+
+			uint32_t blocks = 0;
+			double elapsed = 0.0;
+
+			do
+			{
+				for(uint32_t i=0; i<16; ++i)
+					_encode(++blocks, events);
+
+				elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+			while(elapsed < _seconds);
+
+			Result r;
+			r.changesPerSecond = static_cast<double>(blocks) * g_changesPerBlock / elapsed;
+			r.allocationsPerBlock = static_cast<double>(AllocationCounter::get() - allocationsBefore) / blocks;
+			return r;
+		}
+
+		void print(const char* _name, const Result& _r)
+		{
+			std::cout << "  " << std::left << std::setw(36) << _name << std::right << std::fixed
+				<< std::setprecision(0) << std::setw(14) << _r.changesPerSecond << " changes/s"
+				<< std::setprecision(1) << std::setw(10) << _r.allocationsPerBlock << " allocations/block" << std::endl;
+		}
+
+		bool run(const MidiPacket& _packet, const double _seconds)
+		{
+			const auto params = createParameters();
+
+			// what the controllers did before: build a data map and encode the packet for every change
+			auto encodeMap = [&](const uint32_t _block, std::vector<synthLib::SMidiEvent>& _events)
+			{
+				for(uint32_t i=0; i<params.size(); ++i)
+				{
+					const auto& p = params[i];
+
+					std::map<MidiDataType, uint8_t> d;
+					d.insert(std::make_pair(MidiDataType::DeviceId, g_deviceId));
+					d.insert(std::make_pair(MidiDataType::Page, p.page));
+					d.insert(std::make_pair(MidiDataType::Part, p.part));
+					d.insert(std::make_pair(MidiDataType::ParameterIndex, p.index));
+					d.insert(std::make_pair(MidiDataType::ParameterValue, getValue(_block, i)));
+
+					std::vector<uint8_t> sysex;
+					_packet.create(sysex, d);
+
+					synthLib::SMidiEvent ev(synthLib::MidiEventSource::Editor);
+					ev.sysex = sysex;
+					_events[i] = ev;
+				}
+			};
+
+			std::vector<pluginLib::ParameterChangeEncoder> encoders(params.size());
+
+			for(size_t i=0; i<params.size(); ++i)
+			{
+				const auto& p = params[i];
+
+				MidiPacket::Data d;
+				d.insert(std::make_pair(MidiDataType::DeviceId, g_deviceId));
+				d.insert(std::make_pair(MidiDataType::Page, p.page));
+				d.insert(std::make_pair(MidiDataType::Part, p.part));
+				d.insert(std::make_pair(MidiDataType::ParameterIndex, p.index));
+
+				if(!encoders[i].create(_packet, d))
+				{
+					std::cout << "Failed to create parameter change encoder" << std::endl;
+					return false;
+				}
+			}
+
+			synthLib::SMidiEvent scratch(synthLib::MidiEventSource::Editor);
+			scratch.sysex.reserve(pluginLib::ParameterChangeEncoder::MaxSize);
+
+			auto encodePrecompiled = [&](const uint32_t _block, std::vector<synthLib::SMidiEvent>& _events)
+			{
+				for(uint32_t i=0; i<encoders.size(); ++i)
+				{
+					const auto& e = encoders[i];
+					scratch.sysex.resize(e.size());
+					e.encode(scratch.sysex.data(), scratch.sysex.size(), getValue(_block, i));
+					_events[i] = scratch;
+				}
+			};
+
+			// both need to produce identical messages
+			{
+				std::vector<synthLib::SMidiEvent> a(g_changesPerBlock), b(g_changesPerBlock);
+
+				for(uint32_t block=0; block<128; block += 37)
+				{
+					encodeMap(block, a);
+					encodePrecompiled(block, b);
+
+					for(uint32_t i=0; i<g_changesPerBlock; ++i)
+					{
+						if(a[i].sysex == b[i].sysex)
+							continue;
+
+						std::cout << "Encoder output differs from MidiPacket::create() for parameter " << i << ", block " << block << std::endl;
+						return false;
+					}
+				}
+			}
+
+			print("data map + MidiPacket::create", measure(_seconds, encodeMap));
+			print("ParameterChangeEncoder", measure(_seconds, encodePrecompiled));
+
+			return true;
+		}
+	}
+
+	bool runParameterChangeBenchmark(const baseLib::CommandLine& _cmd)
+	{
+		const auto seconds = static_cast<double>(_cmd.getFloat("seconds", 1.0f));
+
+		std::cout << g_partCount << " parts x " << g_parametersPerPart << " automated parameters per block" << std::endl;
+
+		std::cout << "Virus parameter change:" << std::endl;
+
+		if(!run(createPacketVirus(), seconds))
+			return false;
+
+		std::cout << "Microwave II/XT parameter change with checksum:" << std::endl;
+
+		return run(createPacketXt(), seconds);
+	}
+}
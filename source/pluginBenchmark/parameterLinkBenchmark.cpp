@@ -0,0 +1,197 @@
+#include "benchmark.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "allocationCounter.h"
+#include "testPlugin.h"
+
+#include "baseLib/commandline.h"
+
+namespace pluginBenchmark
+{
+	namespace
+	{
+		using pluginLib::Parameter;
+
+		constexpr uint8_t g_partCount = 16;
+		constexpr uint32_t g_regionSize = 24;			// parameters of a linked region that change at once, for example when loading a preset into a region
+		constexpr uint32_t g_stepsPerBlock = 8;			// UI changes per audio block while dragging a knob quickly
+		constexpr uint32_t g_blocks = 64;
+
+		// parameter 0 forms a region of its own, parameters 1 to g_regionSize are a region, too
+		constexpr uint32_t g_parameterCount = g_regionSize + 1;
+
+		std::vector<TestRegion> createRegions()
+		{
+			TestRegion single{"single", {0}};
+			TestRegion region{"region", {}};
+
+			for(uint32_t i=1; i<=g_regionSize; ++i)
+				region.parameters.push_back(i);
+
+			return {single, region};
+		}
+
+		struct Sweep
+		{
+			size_t uiMessages = 0;		// messages of the edited parameters of the source part, sent immediately
+			size_t blockMessages = 0;	// messages of the linked parameters, sent at the start of the audio block
+			uint64_t blockAllocations = 0;
+		};
+
+		// A parameter of part 0 is changed by the UI several times per block. The region of that parameter is linked to
+		// all other parts. Before batching, every step sent a message for every part immediately
+		bool sweep(Sweep& _result, TestController& _controller, const uint32_t _firstParameter, const uint32_t _parameterCount)
+		{
+			for(uint32_t b=0; b<g_blocks; ++b)
+			{
+				// the audio thread starts a block
+				auto allocations = AllocationCounter::get();
+				_controller.resetSentMessageCount();
+				_controller.sendQueuedParameterChanges();
+				_result.blockMessages += _controller.getSentMessageCount();
+				_result.blockAllocations += AllocationCounter::get() - allocations;
+
+				_controller.resetSentMessageCount();
+
+				for(uint32_t s=0; s<g_stepsPerBlock; ++s)
+				{
+					const auto value = static_cast<pluginLib::ParamValue>((b * g_stepsPerBlock + s + 1) & 127);
+
+					for(uint32_t i=_firstParameter; i<_firstParameter + _parameterCount; ++i)
+					{
+						auto* source = _controller.getParameter(i, 0);
+						source->setUnnormalizedValue(value, Parameter::Origin::Ui);
+
+						// value change notifications are asynchronous, deliver them now to let the parameter links
+						// update their targets
+						source->getValueObject().getValueSource().sendChangeMessage(true);
+					}
+				}
+
+				_result.uiMessages += _controller.getSentMessageCount();
+			}
+
+			// flush the last block and check that every part received the values of the source part
+			_controller.resetSentMessageCount();
+			_controller.sendQueuedParameterChanges();
+			_result.blockMessages += _controller.getSentMessageCount();
+
+			for(uint32_t i=_firstParameter; i<_firstParameter + _parameterCount; ++i)
+			{
+				const auto expected = _controller.getParameter(i, 0)->getUnnormalizedValue();
+
+				for(uint8_t p=0; p<g_partCount; ++p)
+				{
+					const auto* param = _controller.getParameter(i, p);
+
+					if(param->getUnnormalizedValue() != expected || _controller.getSentValue(i, p) != expected)
+					{
+						std::cout << "  Parameter " << getTestParameterName(i) << " of part " << static_cast<int>(p) << " is " << param->getUnnormalizedValue()
+							<< ", device received " << _controller.getSentValue(i, p) << ", expected " << expected << std::endl;
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		bool check(const char* _name, const Sweep& _sweep, const uint32_t _parameterCount, const size_t _expectedPerBlock)
+		{
+			// without batching, every change was sent as a message of its own
+			const auto unbatched = static_cast<size_t>(g_stepsPerBlock) * _parameterCount * g_partCount;
+
+			const auto perBlock = _sweep.blockMessages / g_blocks;
+
+			std::cout << "  " << std::left << std::setw(44) << _name << std::right
+				<< std::setw(6) << _sweep.uiMessages / g_blocks << " + " << std::setw(4) << perBlock << " messages/block, " << std::setw(6) << unbatched << " without batching" << std::endl;
+
+			if(_sweep.uiMessages != static_cast<size_t>(g_stepsPerBlock) * _parameterCount * g_blocks)
+			{
+				std::cout << "  Expected " << g_stepsPerBlock * _parameterCount << " messages per block for the source part" << std::endl;
+				return false;
+			}
+
+			if(_sweep.blockMessages != _expectedPerBlock * g_blocks)
+			{
+				std::cout << "  Expected " << _expectedPerBlock << " messages per block for the linked parts" << std::endl;
+				return false;
+			}
+
+			if(_sweep.blockAllocations)
+			{
+				std::cout << "  Sending queued changes allocated memory " << _sweep.blockAllocations << " times" << std::endl;
+				return false;
+			}
+			return true;
+		}
+	}
+
+	bool runParameterLinkBenchmark(const baseLib::CommandLine& _cmd)
+	{
+		TestProcessor processor(createParameterDescriptions(g_parameterCount, createRegions()));
+		auto& controller = processor.getTestController();
+
+		if(!controller.getParameterDescriptions().isValid())
+		{
+			std::cout << "  Failed to parse parameter descriptions: " << controller.getParameterDescriptions().getErrors() << std::endl;
+			return false;
+		}
+
+		// the device already knows the initial values, as if a preset has been received
+		for(uint8_t p=0; p<g_partCount; ++p)
+		{
+			for(uint32_t i=0; i<g_parameterCount; ++i)
+				controller.getParameter(i, p)->setValueFromSynth(0, Parameter::Origin::PresetChange);
+		}
+
+		auto& links = controller.getParameterLinks();
+
+		for(uint8_t p=1; p<g_partCount; ++p)
+		{
+			if(!links.linkRegion("single", 0, p, false) || !links.linkRegion("region", 0, p, false))
+			{
+				std::cout << "  Failed to link part " << static_cast<int>(p) << std::endl;
+				return false;
+			}
+		}
+
+		constexpr uint32_t linkedParts = g_partCount - 1;
+
+		Sweep single, region;
+
+		// devices that send dumps instead of single parameter changes group the batch by part, the grouping of the
+		// n2x is checked by n2xParameterChangesTest
+		if(!sweep(single, controller, 0, 1) || !check("linked parameter, 16 parts", single, 1, linkedParts))
+			return false;
+
+		if(!sweep(region, controller, 1, g_regionSize) || !check("linked region, 16 parts", region, g_regionSize, linkedParts * g_regionSize))
+			return false;
+
+		const auto seconds = static_cast<double>(_cmd.getFloat("seconds", 1.0f));
+
+		using Clock = std::chrono::high_resolution_clock;
+
+		const auto start = Clock::now();
+
+		uint64_t blocks = 0;
+		double elapsed = 0.0;
+
+		do
+		{
+			Sweep s;
+			sweep(s, controller, 1, g_regionSize);
+			blocks += g_blocks;
+			elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		}
+		while(elapsed < seconds);
+
+		std::cout << "  Editing and linking " << g_stepsPerBlock * g_regionSize * linkedParts << " changes per block: "
+			<< std::fixed << std::setprecision(2) << elapsed * 1000000.0 / static_cast<double>(blocks) << " us/block" << std::endl;
+
+		return true;
+	}
+}
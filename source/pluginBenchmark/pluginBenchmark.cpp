@@ -0,0 +1,79 @@
+#include <iostream>
+#include <iterator>
+
+#include "benchmark.h"
+
+#include "baseLib/commandline.h"
+
+using namespace pluginBenchmark;
+
+namespace
+{
+	constexpr Benchmark g_benchmarks[] =
+	{
+		{"bypass", "delaying the dry signal while bypassed, including a check for clicks if the latency changes", &runBypassBenchmark},
+		{"locking", "application of a preset to 16 parts with locked parameter regions", &runLockingBenchmark},
+		{"parameterChange", "encoding of automated parameter changes into sysex", &runParameterChangeBenchmark},
+		{"parameterLink", "device messages per audio block for parameters and regions that are linked across 16 parts", &runParameterLinkBenchmark},
+		{"resampler", "samplerate conversion between host and device for common host samplerates and block sizes", &runResamplerBenchmark}
+	};
+
+	void printUsage()
+	{
+		std::cout << "Headless micro benchmarks of the plugin framework" << std::endl << std::endl;
+
+		std::cout << "Usage:" << std::endl;
+		std::cout << "  pluginBenchmark [-run <name>] [-seconds <s>]" << std::endl << std::endl;
+
+		std::cout << "Options:" << std::endl;
+		std::cout << "  -run <name>               runs the given benchmark only, all benchmarks are run if omitted" << std::endl;
+		std::cout << "  -seconds <s>              time spent per measurement, default 1" << std::endl << std::endl;
+
+		std::cout << "Benchmarks:" << std::endl;
+		for (const auto& b : g_benchmarks)
+			std::cout << "  " << b.name << ": " << b.description << std::endl;
+	}
+}
+
+int main(const int _argc, char* _argv[])
+{
+	const baseLib::CommandLine commandLine(_argc, _argv);
+
+	if(commandLine.contains("help") || commandLine.contains("h"))
+	{
+		printUsage();
+		return 0;
+	}
+
+	const auto name = commandLine.get("run");
+
+	bool found = false;
+	bool success = true;
+
+	for (const auto& b : g_benchmarks)
+	{
+		if(!name.empty() && name != b.name)
+			continue;
+
+		found = true;
+
+		std::cout << "--- " << b.name << std::endl;
+
+		if(!b.run(commandLine))
+		{
+			std::cout << "Benchmark " << b.name << " failed" << std::endl;
+			success = false;
+		}
+
+		std::cout << std::endl;
+	}
+
+	if(!found)
+	{
+		std::cout << "Unknown benchmark " << name << std::endl << std::endl;
+		printUsage();
+		return -1;
+	}
+
+	return success ? 0 : -1;
+}
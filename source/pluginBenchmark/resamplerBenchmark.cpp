@@ -0,0 +1,123 @@
+#include "benchmark.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "allocationCounter.h"
+
+#include "baseLib/commandline.h"
+
+#include "synthLib/resamplerInOut.h"
+
+namespace pluginBenchmark
+{
+	namespace
+	{
+		// 12 outputs is the worst case, the Virus TI. Its device samplerate has to be converted to any host samplerate
+		constexpr uint32_t g_channelsIn = 2;
+		constexpr uint32_t g_channelsOut = 12;
+		constexpr float g_deviceSamplerate = 46875.0f;
+
+		constexpr float g_hostSamplerates[] = {44100.0f, 48000.0f, 88200.0f, 96000.0f};
+		constexpr uint32_t g_blockSizes[] = {32, 64, 128, 256, 512, 1024};
+
+		struct Result
+		{
+			double realtimeFactor = 0.0;
+			double allocationsPerBlock = 0.0;
+		};
+
+		Result measure(const float _hostSamplerate, const uint32_t _blockSize, const double _seconds)
+		{
+			synthLib::ResamplerInOut resampler(g_channelsIn, g_channelsOut);
+			resampler.setSamplerates(_hostSamplerate, g_deviceSamplerate);
+
+			std::vector<std::vector<float>> inputData(g_channelsIn, std::vector<float>(_blockSize, 0.0f));
+			std::vector<std::vector<float>> outputData(g_channelsOut, std::vector<float>(_blockSize, 0.0f));
+
+			for (auto& d : inputData)
+			{
+				for(size_t i=0; i<d.size(); ++i)
+					d[i] = static_cast<float>(i & 63) / 64.0f - 0.5f;
+			}
+
+			synthLib::TAudioInputs inputs{};
+			synthLib::TAudioOutputs outputs{};
+
+			for(uint32_t c=0; c<g_channelsIn; ++c)
+				inputs[c] = inputData[c].data();
+			for(uint32_t c=0; c<g_channelsOut; ++c)
+				outputs[c] = outputData[c].data();
+
+			synthLib::ResamplerInOut::TMidiVec midiIn, midiOut;
+
+			// stands in for the device, it copies its inputs to its outputs
+			auto processFunc = [](const synthLib::TAudioInputs& _ins, const synthLib::TAudioOutputs& _outs, const size_t _count, const synthLib::ResamplerInOut::TMidiVec&, synthLib::ResamplerInOut::TMidiVec&)
+			{
+				for(uint32_t c=0; c<g_channelsOut; ++c)
+				{
+					const auto* in = _ins[c % g_channelsIn];
+					auto* out = _outs[c];
+
+					for(size_t i=0; i<_count; ++i)
+						out[i] = in[i];
+				}
+			};
+
+			// warm up, buffers grow to their final size
+			for(uint32_t i=0; i<64; ++i)
+				resampler.process(inputs, outputs, midiIn, midiOut, _blockSize, processFunc);
+
+			using Clock = std::chrono::high_resolution_clock;
+
+			const auto allocationsBefore = AllocationCounter::get();
+			const auto start = Clock::now();
+
+			uint64_t blocks = 0;
+			double elapsed = 0.0;
+
+			do
+			{
+				for(uint32_t i=0; i<64; ++i)
+				{
+					resampler.process(inputs, outputs, midiIn, midiOut, _blockSize, processFunc);
+					midiOut.clear();
+				}
+
+				blocks += 64;
+				elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+			while(elapsed < _seconds);
+
+			const auto audioSeconds = static_cast<double>(blocks) * _blockSize / _hostSamplerate;
+
+			Result r;
+			r.realtimeFactor = audioSeconds / elapsed;
+			r.allocationsPerBlock = static_cast<double>(AllocationCounter::get() - allocationsBefore) / static_cast<double>(blocks);
+			return r;
+		}
+	}
+
+	bool runResamplerBenchmark(const baseLib::CommandLine& _cmd)
+	{
+		const auto seconds = static_cast<double>(_cmd.getFloat("seconds", 1.0f)) / 4.0;
+
+		std::cout << "ResamplerInOut, " << g_channelsIn << " inputs, " << g_channelsOut << " outputs, device samplerate " << g_deviceSamplerate << " Hz" << std::endl;
+
+		for (const auto sr : g_hostSamplerates)
+		{
+			for (const auto bs : g_blockSizes)
+			{
+				const auto r = measure(sr, bs, seconds);
+
+				std::cout << "  " << std::setw(6) << static_cast<uint32_t>(sr) << " Hz, block size " << std::setw(4) << bs
+					<< std::fixed << std::setprecision(0) << std::setw(10) << r.realtimeFactor << "x realtime"
+					<< std::setprecision(1) << std::setw(10) << r.allocationsPerBlock << " allocations/block" << std::endl;
+			}
+		}
+
+		return true;
+	}
+}
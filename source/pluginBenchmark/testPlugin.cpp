@@ -0,0 +1,110 @@
+#include "testPlugin.h"
+
+#include <sstream>
+
+#include "jucePluginLib/dummydevice.h"
+
+namespace pluginBenchmark
+{
+	namespace
+	{
+		const char* const g_parameterDescriptionsFilename = "pluginBenchmarkParameterDescriptions.json";
+
+		std::string g_parameterDescriptions;
+
+		const char* g_originalFileNames[] = {g_parameterDescriptionsFilename};
+		const char* g_namedResourceList[] = {"pluginBenchmarkParameterDescriptions_json"};
+
+		const char* getNamedResource(const char*, int& _size)
+		{
+			_size = static_cast<int>(g_parameterDescriptions.size());
+			return g_parameterDescriptions.c_str();
+		}
+
+		pluginLib::Processor::Properties createProperties(std::string&& _parameterDescriptions)
+		{
+			g_parameterDescriptions = std::move(_parameterDescriptions);
+
+			return pluginLib::Processor::Properties{"pluginBenchmark", "The Usual Suspects", true, true, false, false, "Tbnc", "",
+				pluginLib::Processor::BinaryDataRef{1, g_originalFileNames, g_namedResourceList, &getNamedResource}};
+		}
+	}
+
+	std::string createParameterDescriptions(const uint32_t _parameterCount, const std::vector<TestRegion>& _regions)
+	{
+		std::stringstream ss;
+
+		ss << "{\"parameterdescriptiondefaults\": {\"isPublic\":true, \"isBipolar\":false, \"toText\":\"unsigned\", \"name\":\"\", \"class\":\"\","
+			" \"min\":0, \"max\":127, \"isBool\":false, \"isDiscrete\":false, \"page\":0, \"step\":0},\n";
+
+		ss << "\"parameterdescriptions\": [\n";
+		for(uint32_t i=0; i<_parameterCount; ++i)
+			ss << (i ? ",\n" : "") << "{\"index\":" << i << ", \"name\":\"" << getTestParameterName(i) << "\"}";
+		ss << "],\n";
+
+		ss << "\"valuelists\": {\"unsigned\": [";
+		for(uint32_t i=0; i<128; ++i)
+			ss << (i ? "," : "") << '"' << i << '"';
+		ss << "]},\n";
+
+		ss << "\"regions\": [\n";
+		for(size_t r=0; r<_regions.size(); ++r)
+		{
+			const auto& region = _regions[r];
+
+			ss << (r ? ",\n" : "") << "{\"id\":\"" << region.id << "\", \"name\":\"" << region.id << "\", \"parameters\":[";
+			for(size_t i=0; i<region.parameters.size(); ++i)
+				ss << (i ? "," : "") << '"' << getTestParameterName(region.parameters[i]) << '"';
+			ss << "]}";
+		}
+		ss << "]}\n";
+
+		return ss.str();
+	}
+
+	TestController::TestController(pluginLib::Processor& _processor) : Controller(_processor, g_parameterDescriptionsFilename)
+	{
+		registerParams(_processor);
+
+		const auto count = getParameterDescriptions().getDescriptions().size();
+
+		for(uint8_t p=0; p<getPartCount(); ++p)
+		{
+			for(uint32_t i=0; i<count; ++i)
+				m_valueIndices.insert({getParameter(i, p), p * count + i});
+		}
+
+		m_sentValues.resize(count * getPartCount(), -1);
+	}
+
+	void TestController::sendParameterChange(const pluginLib::Parameter& _parameter, const pluginLib::ParamValue _value)
+	{
+		++m_sentMessageCount;
+		recordValue(_parameter, _value);
+	}
+
+	pluginLib::ParamValue TestController::getSentValue(const uint32_t _index, const uint8_t _part) const
+	{
+		return m_sentValues[_part * getParameterDescriptions().getDescriptions().size() + _index];
+	}
+
+	void TestController::recordValue(const pluginLib::Parameter& _parameter, const pluginLib::ParamValue _value)
+	{
+		m_sentValues[m_valueIndices.find(&_parameter)->second] = _value;
+	}
+
+	TestProcessor::TestProcessor(std::string _parameterDescriptions)
+		: Processor(BusesProperties().withOutput("Output", juce::AudioChannelSet::stereo(), true), createProperties(std::move(_parameterDescriptions)))
+	{
+	}
+
+	synthLib::Device* TestProcessor::createDevice()
+	{
+		return new pluginLib::DummyDevice({});
+	}
+
+	pluginLib::Controller* TestProcessor::createController()
+	{
+		return new TestController(*this);
+	}
+}
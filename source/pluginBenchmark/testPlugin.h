@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "jucePluginLib/controller.h"
+#include "jucePluginLib/processor.h"
+
+namespace pluginBenchmark
+{
+	struct TestRegion
+	{
+		std::string id;
+		std::vector<uint32_t> parameters;
+	};
+
+	// creates parameter descriptions json with parameters named "Param<index>", range 0-127
+	std::string createParameterDescriptions(uint32_t _parameterCount, const std::vector<TestRegion>& _regions);
+
+	inline std::string getTestParameterName(const uint32_t _index)
+	{
+		return "Param" + std::to_string(_index);
+	}
+
+	// Records the values that are sent to the device and counts the messages that the device receives. Recording
+	// does not allocate
+	class TestController : public pluginLib::Controller
+	{
+	public:
+		explicit TestController(pluginLib::Processor& _processor);
+
+		void sendParameterChange(const pluginLib::Parameter& _parameter, pluginLib::ParamValue _value) override;
+		bool parseSysexMessage(const pluginLib::SysEx&, synthLib::MidiEventSource) override { return false; }
+		bool parseControllerMessage(const synthLib::SMidiEvent&) override { return false; }
+		void onStateLoaded() override {}
+
+		size_t getSentMessageCount() const { return m_sentMessageCount; }
+		void resetSentMessageCount() { m_sentMessageCount = 0; }
+
+		// returns the value that has been sent last or -1 if nothing has been sent
+		pluginLib::ParamValue getSentValue(uint32_t _index, uint8_t _part) const;
+
+	private:
+		void recordValue(const pluginLib::Parameter& _parameter, pluginLib::ParamValue _value);
+
+		std::unordered_map<const pluginLib::Parameter*, size_t> m_valueIndices;
+		std::vector<pluginLib::ParamValue> m_sentValues;
+		size_t m_sentMessageCount = 0;
+	};
+
+	// Headless processor with a dummy device. The parameter descriptions are provided as binary data, only one
+	// instance may exist at a time
+	class TestProcessor : public pluginLib::Processor
+	{
+	public:
+		explicit TestProcessor(std::string _parameterDescriptions);
+
+		TestController& getTestController() { return static_cast<TestController&>(getController()); }
+
+		juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+		bool hasEditor() const override { return false; }
+
+		synthLib::Device* createDevice() override;
+
+	private:
+		pluginLib::Controller* createController() override;
+	};
+}
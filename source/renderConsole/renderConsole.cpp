@@ -0,0 +1,219 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "baseLib/commandline.h"
+#include "baseLib/filesystem.h"
+
+#include "renderConsoleLib/jobRunner.h"
+
+using namespace renderConsoleLib;
+
+namespace
+{
+	void printUsage()
+	{
+		std::cout << "Renders midi files with any of the emulated devices faster than realtime" << std::endl << std::endl;
+
+		std::cout << "Usage:" << std::endl;
+		std::cout << "  renderConsole -device <name> -midi <file.mid> -out <file.wav> [options]" << std::endl;
+		std::cout << "  renderConsole -jobs <jobfile.txt> [options]" << std::endl << std::endl;
+
+		std::cout << "Options:" << std::endl;
+		std::cout << "  -device <name>         device to use, one of:";
+		for (const auto type : DeviceFactory::getSupportedTypes())
+			std::cout << ' ' << DeviceFactory::getName(type);
+		std::cout << std::endl;
+		std::cout << "  -rom <file>            ROM/firmware file, if omitted, the ROM is searched for next to the executable" << std::endl;
+		std::cout << "  -state <file>          device state or sysex file that is applied before rendering" << std::endl;
+		std::cout << "  -bank <file.syx>       preset bank that is sent to the device before rendering" << std::endl;
+		std::cout << "  -program <n|all>       program change to send. 'all' creates one job per preset of the bank" << std::endl;
+		std::cout << "  -midi <file.mid>       midi file to render" << std::endl;
+		std::cout << "  -out <file.wav>        output file" << std::endl;
+		std::cout << "  -samplerate <hz>       device samplerate, default is the native device samplerate" << std::endl;
+		std::cout << "  -blocksize <n>         samples processed per block, default 64" << std::endl;
+		std::cout << "  -preroll <seconds>     time to apply state/bank before rendering starts, default 1" << std::endl;
+		std::cout << "  -tail <seconds>        time rendered after the end of the midi file, default 2" << std::endl;
+		std::cout << "  -length <seconds>      fixed render length, overrides midi file length + tail" << std::endl;
+		std::cout << "  -threads <n>           number of jobs to render in parallel, default " << JobRunner::getDefaultThreadCount() << std::endl;
+		std::cout << "  -jobs <file>           text file with one job per line, using the same options as the command line." << std::endl;
+		std::cout << "                         Options given on the command line serve as defaults for all jobs" << std::endl;
+	}
+
+	std::vector<std::string> tokenize(const std::string& _line)
+	{
+		std::vector<std::string> tokens;
+		std::string current;
+		bool quoted = false;
+		bool hasToken = false;
+
+		for (const char c : _line)
+		{
+			if(c == '"')
+			{
+				quoted = !quoted;
+				hasToken = true;
+			}
+			else if(!quoted && (c == ' ' || c == '\t'))
+			{
+				if(hasToken)
+					tokens.emplace_back(std::move(current));
+				current.clear();
+				hasToken = false;
+			}
+			else
+			{
+				current += c;
+				hasToken = true;
+			}
+		}
+
+		if(hasToken)
+			tokens.emplace_back(std::move(current));
+
+		return tokens;
+	}
+
+	baseLib::CommandLine parseLine(const std::string& _line)
+	{
+		auto tokens = tokenize(_line);
+
+		std::vector<char*> argv;
+		argv.reserve(tokens.size() + 1);
+
+		std::string exe;
+		argv.push_back(exe.data());
+
+		for (auto& token : tokens)
+			argv.push_back(token.data());
+
+		return {static_cast<int>(argv.size()), argv.data()};
+	}
+
+	// expands a job with -program all into one job per preset of the bank
+	bool addJob(JobRunner& _runner, const baseLib::PropertyMap& _defaults, const baseLib::PropertyMap& _args)
+	{
+		baseLib::PropertyMap props;
+		props.add(_args);
+		props.add(_defaults);
+
+		RenderJob job;
+
+		if(props.get("program") != "all")
+		{
+			if(!job.fromProperties(props))
+				return false;
+			_runner.add(job);
+			return true;
+		}
+
+		if(!job.fromProperties(props) || job.bankFile.empty())
+			return false;
+
+		std::vector<std::vector<uint8_t>> presets;
+
+		if(!JobRenderer::loadSysex(presets, job.bankFile) || presets.empty())
+			return false;
+
+		const auto outBase = baseLib::filesystem::stripExtension(job.outputFile);
+		const auto outExt = baseLib::filesystem::getExtension(job.outputFile);
+
+		for(size_t i=0; i<presets.size(); ++i)
+		{
+			std::stringstream ss;
+			ss << outBase << '_' << std::setw(3) << std::setfill('0') << i << outExt;
+
+			RenderJob j = job;
+			j.program = static_cast<int32_t>(i);
+			j.outputFile = ss.str();
+			_runner.add(j);
+		}
+		return true;
+	}
+}
+
+int main(const int _argc, char* _argv[])
+{
+	const baseLib::CommandLine commandLine(_argc, _argv);
+
+	if(commandLine.empty() || commandLine.contains("help") || commandLine.contains("h"))
+	{
+		printUsage();
+		return 0;
+	}
+
+	JobRunner runner(static_cast<uint32_t>(commandLine.getInt("threads", 0)));
+
+	const auto jobFile = commandLine.get("jobs");
+
+	if(!jobFile.empty())
+	{
+		std::ifstream file(jobFile);
+
+		if(!file.is_open())
+		{
+			std::cout << "Failed to open job file " << jobFile << std::endl;
+			return -1;
+		}
+
+		std::string line;
+		uint32_t lineNumber = 0;
+
+		while(std::getline(file, line))
+		{
+			++lineNumber;
+
+			if(!line.empty() && line.back() == '\r')
+				line.pop_back();
+
+			if(line.empty() || line.front() == '#')
+				continue;
+
+			const auto args = parseLine(line);
+
+			if(args.empty())
+				continue;
+
+			if(!addJob(runner, commandLine, args))
+			{
+				std::cout << "Invalid job in line " << lineNumber << ": " << line << std::endl;
+				return -1;
+			}
+		}
+	}
+	else if(!addJob(runner, {}, commandLine))
+	{
+		std::cout << "Invalid arguments" << std::endl << std::endl;
+		printUsage();
+		return -1;
+	}
+
+	if(!runner.size())
+	{
+		std::cout << "No jobs to render" << std::endl;
+		return -1;
+	}
+
+	std::cout << "Rendering " << runner.size() << " job(s) using " << runner.getThreadCount() << " thread(s)" << std::endl;
+
+	const auto failCount = runner.run([&](const size_t _index, const RenderJob& _job, const RenderResult& _result)
+	{
+		std::cout << '[' << (_index + 1) << '/' << runner.size() << "] " << _job.getDescription() << ": ";
+
+		if(_result.success)
+		{
+			std::cout << std::fixed << std::setprecision(2)
+				<< (static_cast<double>(_result.sampleCount) / static_cast<double>(_result.samplerate)) << "s audio in "
+				<< _result.renderSeconds << "s, " << _result.getRealtimeFactor() << "x realtime" << std::endl;
+		}
+		else
+		{
+			std::cout << "FAILED, " << _result.error << std::endl;
+		}
+	});
+
+	std::cout << "Finished, " << (runner.size() - failCount) << " succeeded, " << failCount << " failed" << std::endl;
+
+	return failCount ? -1 : 0;
+}
@@ -0,0 +1,88 @@
+#include "demoScenario.h"
+
+#include "synthLib/deviceException.h"
+#include "synthLib/scenario.h"
+
+#if RENDERCONSOLE_VIRUS
+#include "virusLib/device.h"
+#endif
+
+#if RENDERCONSOLE_MQ
+#include "mqLib/device.h"
+#endif
+
+namespace renderConsoleLib
+{
+	namespace
+	{
+		template<typename T> T& getDevice(synthLib::Device& _device)
+		{
+			auto* d = dynamic_cast<T*>(&_device);
+			if(!d)
+				throw synthLib::DeviceException(synthLib::DeviceError::Invalid, "Device type mismatch, unable to start demo");
+			return *d;
+		}
+	}
+
+	bool DemoScenario::isSupported(const DeviceType _type)
+	{
+		switch (_type)
+		{
+		case DeviceType::VirusABC:
+		case DeviceType::VirusSnow:
+		case DeviceType::VirusTI:
+		case DeviceType::VirusTI2:	return RENDERCONSOLE_VIRUS;
+		case DeviceType::MicroQ:	return RENDERCONSOLE_MQ;
+		default:					return false;
+		}
+	}
+
+	bool DemoScenario::addDemoPhase(synthLib::Scenario& _scenario, const DeviceType _type, const double _seconds)
+	{
+		if(!isSupported(_type))
+			return false;
+
+		_scenario.addPhase("demo", _seconds);
+
+		switch (_type)
+		{
+#if RENDERCONSOLE_VIRUS
+		case DeviceType::VirusABC:
+		case DeviceType::VirusSnow:
+		case DeviceType::VirusTI:
+		case DeviceType::VirusTI2:
+			_scenario.addAction(0.0, [](synthLib::Device& _device)
+			{
+				if(!getDevice<virusLib::Device>(_device).startDemoPlayback())
+					throw synthLib::DeviceException(synthLib::DeviceError::Invalid, "The ROM does not contain a demo song");
+			});
+			return true;
+#endif
+#if RENDERCONSOLE_MQ
+		case DeviceType::MicroQ:
+			{
+				// Multimode + Peek, then Play starts the demo. Timings are the ones used by mqPerformanceTest
+				using Button = mqLib::Buttons::ButtonType;
+
+				auto button = [&](const uint32_t _samplePos, const Button _button, const bool _pressed)
+				{
+					_scenario.addAction(static_cast<double>(_samplePos) / 44100.0, [_button, _pressed](synthLib::Device& _device)
+					{
+						getDevice<mqLib::Device>(_device).getMicroQ().setButton(_button, _pressed);
+					});
+				};
+
+				button(30000, Button::Multimode, true);
+				button(40000, Button::Peek, true);
+				button(60000, Button::Peek, false);
+				button(60000, Button::Multimode, false);
+				button(70000, Button::Play, true);
+				button(80000, Button::Play, false);
+			}
+			return true;
+#endif
+		default:
+			return false;
+		}
+	}
+}
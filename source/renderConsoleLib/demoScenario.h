@@ -0,0 +1,23 @@
+#pragma once
+
+#include "deviceFactory.h"
+
+namespace synthLib
+{
+	class Scenario;
+}
+
+namespace renderConsoleLib
+{
+	// Starts the demo song that is built into the firmware of a device. The Virus plays the demo from ROM data via its
+	// microcontroller, the microQ is operated via its front panel buttons the same way a user would do it
+	class DemoScenario
+	{
+	public:
+		static bool isSupported(DeviceType _type);
+
+		// adds a phase that starts the demo and lets it play for _seconds. If the device fails to start the demo,
+		// a synthLib::DeviceException is thrown while the scenario runs
+		static bool addDemoPhase(synthLib::Scenario& _scenario, DeviceType _type, double _seconds);
+	};
+}
@@ -0,0 +1,164 @@
+#include "deviceFactory.h"
+
+#include <iterator>
+
+#include "baseLib/filesystem.h"
+
+#include "synthLib/device.h"
+#include "synthLib/deviceException.h"
+
+#if RENDERCONSOLE_VIRUS
+#include "virusLib/device.h"
+#include "virusLib/romloader.h"
+#endif
+
+#if RENDERCONSOLE_MQ
+#include "mqLib/device.h"
+#endif
+
+#if RENDERCONSOLE_XT
+#include "xtLib/xtDevice.h"
+#endif
+
+#if RENDERCONSOLE_N2X
+#include "n2xLib/n2xdevice.h"
+#endif
+
+namespace renderConsoleLib
+{
+	namespace
+	{
+		constexpr const char* g_names[] =
+		{
+			"virus",
+			"virusSnow",
+			"virusTI",
+			"virusTI2",
+			"microq",
+			"xt",
+			"n2x"
+		};
+
+		static_assert(std::size(g_names) == static_cast<size_t>(DeviceType::Count));
+
+		bool isSupported(const DeviceType _type)
+		{
+			switch (_type)
+			{
+			case DeviceType::VirusABC:
+			case DeviceType::VirusSnow:
+			case DeviceType::VirusTI:
+			case DeviceType::VirusTI2:	return RENDERCONSOLE_VIRUS;
+			case DeviceType::MicroQ:	return RENDERCONSOLE_MQ;
+			case DeviceType::Xt:		return RENDERCONSOLE_XT;
+			case DeviceType::N2x:		return RENDERCONSOLE_N2X;
+			default:					return false;
+			}
+		}
+
+		[[maybe_unused]] synthLib::DeviceCreateParams createParams(const std::string& _romFile, const float _preferredSamplerate)
+		{
+			synthLib::DeviceCreateParams p;
+
+			p.preferredSamplerate = _preferredSamplerate;
+			p.hostSamplerate = _preferredSamplerate;
+
+			if(_romFile.empty())
+				return p;
+
+			if(!baseLib::filesystem::readFile(p.romData, _romFile))
+				throw synthLib::DeviceException(synthLib::DeviceError::FirmwareMissing, "Failed to read ROM file " + _romFile);
+
+			p.romName = _romFile;
+			p.romHash = baseLib::MD5(p.romData);
+
+			return p;
+		}
+
+#if RENDERCONSOLE_VIRUS
+		std::unique_ptr<synthLib::Device> createVirus(const virusLib::DeviceModel _model, const std::string& _romFile, const float _preferredSamplerate)
+		{
+			const auto rom = virusLib::ROMLoader::findROM(_romFile, _model);
+
+			if(!rom.isValid())
+				throw synthLib::DeviceException(synthLib::DeviceError::FirmwareMissing, "No valid Virus firmware found" + (_romFile.empty() ? std::string() : " at " + _romFile));
+
+			synthLib::DeviceCreateParams p;
+			p.preferredSamplerate = _preferredSamplerate;
+			p.hostSamplerate = _preferredSamplerate;
+			p.romName = rom.getFilename();
+			p.romData = rom.getRomFileData();
+			p.romHash = baseLib::MD5(p.romData);
+			p.customData = static_cast<uint32_t>(rom.getModel());
+
+			return std::make_unique<virusLib::Device>(p);
+		}
+#endif
+	}
+
+	DeviceType DeviceFactory::getTypeByName(const std::string& _name)
+	{
+		const auto name = baseLib::filesystem::lowercase(_name);
+
+		for(size_t i=0; i<std::size(g_names); ++i)
+		{
+			if(baseLib::filesystem::lowercase(g_names[i]) == name)
+				return static_cast<DeviceType>(i);
+		}
+
+		return DeviceType::Invalid;
+	}
+
+	const char* DeviceFactory::getName(const DeviceType _type)
+	{
+		if(_type == DeviceType::Invalid || _type >= DeviceType::Count)
+			return "invalid";
+		return g_names[static_cast<size_t>(_type)];
+	}
+
+	std::vector<DeviceType> DeviceFactory::getSupportedTypes()
+	{
+		std::vector<DeviceType> types;
+
+		for(size_t i=0; i<static_cast<size_t>(DeviceType::Count); ++i)
+		{
+			if(isSupported(static_cast<DeviceType>(i)))
+				types.push_back(static_cast<DeviceType>(i));
+		}
+		return types;
+	}
+
+	std::unique_ptr<synthLib::Device> DeviceFactory::create(const DeviceType _type, const std::string& _romFile, const float _preferredSamplerate/* = 0.0f*/)
+	{
+		if(!isSupported(_type))
+			throw synthLib::DeviceException(synthLib::DeviceError::Invalid, std::string("Device type ") + getName(_type) + " is not supported by this build");
+
+		std::unique_ptr<synthLib::Device> device;
+
+		switch (_type)
+		{
+#if RENDERCONSOLE_VIRUS
+		case DeviceType::VirusABC:	device = createVirus(virusLib::DeviceModel::ABC, _romFile, _preferredSamplerate);	break;
+		case DeviceType::VirusSnow:	device = createVirus(virusLib::DeviceModel::Snow, _romFile, _preferredSamplerate);	break;
+		case DeviceType::VirusTI:	device = createVirus(virusLib::DeviceModel::TI, _romFile, _preferredSamplerate);	break;
+		case DeviceType::VirusTI2:	device = createVirus(virusLib::DeviceModel::TI2, _romFile, _preferredSamplerate);	break;
+#endif
+#if RENDERCONSOLE_MQ
+		case DeviceType::MicroQ:	device = std::make_unique<mqLib::Device>(createParams(_romFile, _preferredSamplerate));	break;
+#endif
+#if RENDERCONSOLE_XT
+		case DeviceType::Xt:		device = std::make_unique<xt::Device>(createParams(_romFile, _preferredSamplerate));		break;
+#endif
+#if RENDERCONSOLE_N2X
+		case DeviceType::N2x:		device = std::make_unique<n2x::Device>(createParams(_romFile, _preferredSamplerate));	break;
+#endif
+		default:
+			break;
+		}
+
+		if(!device || !device->isValid())
+			throw synthLib::DeviceException(synthLib::DeviceError::FirmwareMissing, std::string("Failed to create device of type ") + getName(_type));
+
+		return device;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace synthLib
+{
+	class Device;
+}
+
+namespace renderConsoleLib
+{
+	enum class DeviceType
+	{
+		Invalid = -1,
+
+		VirusABC,
+		VirusSnow,
+		VirusTI,
+		VirusTI2,
+		MicroQ,
+		Xt,
+		N2x,
+
+		Count
+	};
+
+	class DeviceFactory
+	{
+	public:
+		static DeviceType getTypeByName(const std::string& _name);
+		static const char* getName(DeviceType _type);
+		static std::vector<DeviceType> getSupportedTypes();
+
+		// creates and boots a device. If _romFile is empty, the default rom search paths are used. Throws synthLib::DeviceException on failure
+		static std::unique_ptr<synthLib::Device> create(DeviceType _type, const std::string& _romFile, float _preferredSamplerate = 0.0f);
+	};
+}
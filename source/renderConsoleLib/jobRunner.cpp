@@ -0,0 +1,77 @@
+#include "jobRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "dsp56kEmu/threadtools.h"
+
+namespace renderConsoleLib
+{
+	JobRunner::JobRunner(const uint32_t _threadCount) : m_threadCount(_threadCount ? _threadCount : getDefaultThreadCount())
+	{
+	}
+
+	void JobRunner::add(RenderJob _job)
+	{
+		m_jobs.emplace_back(std::move(_job));
+	}
+
+	size_t JobRunner::run(const ResultCallback& _callback)
+	{
+		m_results.clear();
+		m_results.resize(m_jobs.size());
+
+		std::atomic<size_t> nextJob = 0;
+		std::atomic<size_t> failCount = 0;
+		std::mutex mutexCallback;
+
+		auto threadFunc = [&](const uint32_t _threadIndex)
+		{
+			dsp56k::ThreadTools::setCurrentThreadName("render" + std::to_string(_threadIndex));
+
+			while(true)
+			{
+				const auto index = nextJob++;
+
+				if(index >= m_jobs.size())
+					break;
+
+				const auto& job = m_jobs[index];
+
+				m_results[index] = JobRenderer::render(job);
+
+				if(!m_results[index].success)
+					++failCount;
+
+				if(_callback)
+				{
+					std::scoped_lock lock(mutexCallback);
+					_callback(index, job, m_results[index]);
+				}
+			}
+		};
+
+		const auto threadCount = std::min(static_cast<size_t>(m_threadCount), m_jobs.size());
+
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+
+		for(uint32_t i=0; i<threadCount; ++i)
+			threads.emplace_back(threadFunc, i);
+
+		for (auto& t : threads)
+			t.join();
+
+		return failCount;
+	}
+
+	uint32_t JobRunner::getDefaultThreadCount()
+	{
+		// every device runs at least one DSP thread and possibly a microcontroller thread on its own. The job
+		// thread mostly waits for the DSP, so one job per two cores keeps all cores busy without oversubscription
+		const auto cores = std::thread::hardware_concurrency();
+		return std::max(1u, cores >> 1);
+	}
+}
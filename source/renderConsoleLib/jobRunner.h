@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "renderJob.h"
+
+namespace renderConsoleLib
+{
+	// Renders a list of jobs on a fixed number of worker threads. Each job creates its own device instance
+	class JobRunner
+	{
+	public:
+		using ResultCallback = std::function<void(size_t _jobIndex, const RenderJob&, const RenderResult&)>;
+
+		explicit JobRunner(uint32_t _threadCount = 0);
+
+		void add(RenderJob _job);
+		size_t size() const { return m_jobs.size(); }
+
+		// blocks until all jobs are finished, returns the number of failed jobs
+		size_t run(const ResultCallback& _callback = {});
+
+		const std::vector<RenderResult>& getResults() const { return m_results; }
+
+		uint32_t getThreadCount() const { return m_threadCount; }
+
+		static uint32_t getDefaultThreadCount();
+
+	private:
+		const uint32_t m_threadCount;
+		std::vector<RenderJob> m_jobs;
+		std::vector<RenderResult> m_results;
+	};
+}
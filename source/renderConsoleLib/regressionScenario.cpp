@@ -0,0 +1,96 @@
+#include "regressionScenario.h"
+
+#include "synthLib/midiTypes.h"
+#include "synthLib/scenario.h"
+
+namespace renderConsoleLib
+{
+	namespace
+	{
+		using synthLib::SMidiEvent;
+		using synthLib::MidiEventSource;
+
+		SMidiEvent midi(const uint8_t _a, const uint8_t _b, const uint8_t _c = 0)
+		{
+			return SMidiEvent(MidiEventSource::Host, _a, _b, _c);
+		}
+
+		void note(synthLib::Scenario& _scenario, const double _start, const double _length, const uint8_t _note, const uint8_t _velocity)
+		{
+			_scenario.addEvent(_start, midi(synthLib::M_NOTEON, _note, _velocity));
+			_scenario.addEvent(_start + _length, midi(synthLib::M_NOTEOFF, _note, 64));
+		}
+	}
+
+	void RegressionScenario::create(synthLib::Scenario& _scenario, const DeviceType _type)
+	{
+		_scenario.addPhase("boot", getBootSeconds(_type));
+
+		// single notes across the keyboard with increasing velocity, then chords up to eight voices
+		_scenario.addPhase("notes", 0.0);
+		{
+			double t = 0.0;
+
+			for(uint8_t i=0; i<8; ++i, t += 0.25)
+				note(_scenario, t, 0.2, static_cast<uint8_t>(36 + i * 6), static_cast<uint8_t>(16 + i * 15));
+
+			constexpr uint8_t chord[] = {48, 55, 60, 64, 67, 71, 74, 79};
+
+			for(uint8_t voices=2; voices<=8; voices += 2, t += 0.5)
+			{
+				for(uint8_t i=0; i<voices; ++i)
+					note(_scenario, t, 0.4, chord[i], 100);
+			}
+		}
+
+		// a held chord while controllers and pitch bend are swept
+		_scenario.addPhase("controllers", 0.0);
+		{
+			constexpr double length = 2.0;
+			constexpr uint32_t steps = 64;
+
+			for (const uint8_t n : {48, 60, 67})
+				note(_scenario, 0.0, length, n, 100);
+
+			for(uint32_t i=0; i<=steps; ++i)
+			{
+				const auto t = length * static_cast<double>(i) / steps;
+				const auto up = static_cast<uint8_t>(i * 127 / steps);
+				const auto bend = static_cast<uint16_t>(i * 0x3fff / steps);
+
+				_scenario.addEvent(t, midi(synthLib::M_CONTROLCHANGE, synthLib::MC_MODULATION, up));
+				_scenario.addEvent(t, midi(synthLib::M_PITCHBEND, bend & 0x7f, (bend >> 7) & 0x7f));
+			}
+
+			_scenario.addEvent(length, midi(synthLib::M_CONTROLCHANGE, synthLib::MC_MODULATION, 0));
+			_scenario.addEvent(length, midi(synthLib::M_PITCHBEND, 0x00, 0x40));
+		}
+
+		// a few programs of the factory bank, each one plays a short chord
+		_scenario.addPhase("programs", 0.0);
+		{
+			double t = 0.0;
+
+			for(uint8_t program=1; program<=8; ++program, t += 0.75)
+			{
+				_scenario.addEvent(t, midi(synthLib::M_PROGRAMCHANGE, program));
+
+				for (const uint8_t n : {52, 59, 64})
+					note(_scenario, t + 0.1, 0.5, n, 90);
+			}
+		}
+
+		// release tails and effects, the device is expected to become silent
+		_scenario.addPhase("release", 2.0);
+	}
+
+	double RegressionScenario::getBootSeconds(const DeviceType _type)
+	{
+		switch (_type)
+		{
+		case DeviceType::MicroQ:
+		case DeviceType::Xt:		return 3.0;
+		default:					return 1.0;
+		}
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "deviceFactory.h"
+
+namespace synthLib
+{
+	class Scenario;
+}
+
+namespace renderConsoleLib
+{
+	// A scripted midi sequence that exercises the parts of a device that are usually affected by changes to the
+	// emulation: boot, notes of different velocities and polyphony, controllers, pitch bend and program changes.
+	// Everything is sent on the first midi channel, which is the one that a device listens to after a factory reset
+	class RegressionScenario
+	{
+	public:
+		static void create(synthLib::Scenario& _scenario, DeviceType _type);
+
+		// time the device needs to boot before it processes midi
+		static double getBootSeconds(DeviceType _type);
+	};
+}
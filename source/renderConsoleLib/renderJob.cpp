@@ -0,0 +1,240 @@
+#include "renderJob.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>	// memcmp
+
+#include "baseLib/filesystem.h"
+#include "baseLib/propertyMap.h"
+
+#include "synthLib/device.h"
+#include "synthLib/deviceException.h"
+#include "synthLib/midiFile.h"
+#include "synthLib/midiToSysex.h"
+#include "synthLib/offlineRenderer.h"
+#include "synthLib/wavWriter.h"
+
+namespace renderConsoleLib
+{
+	namespace
+	{
+		bool isSysexData(const std::vector<uint8_t>& _data)
+		{
+			if(_data.empty())
+				return false;
+			if(_data.front() == synthLib::M_STARTOFSYSEX)
+				return true;
+			return _data.size() >= 4 && memcmp(_data.data(), "MThd", 4) == 0;
+		}
+	}
+
+	bool RenderJob::fromProperties(const baseLib::PropertyMap& _props)
+	{
+		if(_props.contains("device"))
+			deviceType = DeviceFactory::getTypeByName(_props.get("device"));
+
+		romFile = _props.get("rom", romFile);
+		stateFile = _props.get("state", stateFile);
+		bankFile = _props.get("bank", bankFile);
+		program = _props.getInt("program", program);
+		midiFile = _props.get("midi", midiFile);
+		outputFile = _props.get("out", outputFile);
+
+		samplerate = _props.getFloat("samplerate", samplerate);
+		blockSize = static_cast<uint32_t>(_props.getInt("blocksize", static_cast<int>(blockSize)));
+
+		prerollSeconds = _props.getFloat("preroll", prerollSeconds);
+		sysexIntervalSeconds = _props.getFloat("sysexInterval", sysexIntervalSeconds);
+		tailSeconds = _props.getFloat("tail", tailSeconds);
+		lengthSeconds = _props.getFloat("length", lengthSeconds);
+
+		return deviceType != DeviceType::Invalid && !outputFile.empty() && (!midiFile.empty() || lengthSeconds > 0.0f);
+	}
+
+	std::string RenderJob::getDescription() const
+	{
+		std::string desc = DeviceFactory::getName(deviceType);
+
+		if(!stateFile.empty())
+			desc += ", state " + baseLib::filesystem::getFilenameWithoutPath(stateFile);
+		if(!bankFile.empty())
+			desc += ", bank " + baseLib::filesystem::getFilenameWithoutPath(bankFile);
+		if(program >= 0)
+			desc += ", program " + std::to_string(program);
+		if(!midiFile.empty())
+			desc += ", midi " + baseLib::filesystem::getFilenameWithoutPath(midiFile);
+
+		return desc + " => " + outputFile;
+	}
+
+	RenderResult JobRenderer::render(const RenderJob& _job)
+	{
+		RenderResult result;
+
+		const auto timeStart = std::chrono::steady_clock::now();
+
+		std::unique_ptr<synthLib::Device> device;
+
+		try
+		{
+			device = DeviceFactory::create(_job.deviceType, _job.romFile, _job.samplerate);
+
+			// nobody looks at the front panel while rendering offline
+			device->setHeadless(true);
+		}
+		catch(const synthLib::DeviceException& e)
+		{
+			result.error = e.what();
+			return result;
+		}
+
+		synthLib::OfflineRenderer renderer(*device, _job.samplerate, _job.blockSize);
+
+		const auto samplerate = renderer.getSamplerate();
+
+		auto toSamples = [&](const double _seconds)
+		{
+			return synthLib::MidiFile::toSamplePosition(_seconds, samplerate);
+		};
+
+		// state and bank data is applied during the preroll phase
+		uint64_t sysexPos = 0;
+
+		auto scheduleSysex = [&](const std::string& _file)
+		{
+			std::vector<std::vector<uint8_t>> messages;
+
+			if(!loadSysex(messages, _file) || messages.empty())
+				return false;
+
+			for (auto& sysex : messages)
+			{
+				synthLib::SMidiEvent ev(synthLib::MidiEventSource::Host);
+				ev.sysex = std::move(sysex);
+				renderer.addEvent(sysexPos, ev);
+				sysexPos += toSamples(_job.sysexIntervalSeconds);
+			}
+			return true;
+		};
+
+		if(!_job.stateFile.empty())
+		{
+			std::vector<uint8_t> state;
+
+			if(!baseLib::filesystem::readFile(state, _job.stateFile))
+			{
+				result.error = "Failed to read state file " + _job.stateFile;
+				return result;
+			}
+
+			if(isSysexData(state))
+			{
+				if(!scheduleSysex(_job.stateFile))
+				{
+					result.error = "Failed to load state " + _job.stateFile;
+					return result;
+				}
+			}
+			else if(!renderer.setState(state))
+			{
+				result.error = "Device refused state " + _job.stateFile;
+				return result;
+			}
+		}
+
+		if(!_job.bankFile.empty() && !scheduleSysex(_job.bankFile))
+		{
+			result.error = "Failed to load preset bank " + _job.bankFile;
+			return result;
+		}
+
+		if(_job.program >= 0)
+		{
+			if(_job.program >= 128)
+				renderer.addEvent(sysexPos, synthLib::SMidiEvent(synthLib::MidiEventSource::Host, synthLib::M_CONTROLCHANGE, synthLib::MC_BANKSELECTMSB, static_cast<uint8_t>(_job.program >> 7)));
+			renderer.addEvent(sysexPos, synthLib::SMidiEvent(synthLib::MidiEventSource::Host, synthLib::M_PROGRAMCHANGE, static_cast<uint8_t>(_job.program & 0x7f)));
+			sysexPos += toSamples(_job.sysexIntervalSeconds);
+		}
+
+		const auto preroll = std::max(toSamples(_job.prerollSeconds), sysexPos + toSamples(_job.prerollSeconds * 0.5));
+
+		double lengthSeconds = _job.lengthSeconds;
+
+		if(!_job.midiFile.empty())
+		{
+			synthLib::MidiFile midi;
+
+			if(!midi.loadFromFile(_job.midiFile))
+			{
+				result.error = "Failed to load midi file " + _job.midiFile;
+				return result;
+			}
+
+			renderer.addEvents(midi, preroll);
+
+			if(lengthSeconds <= 0.0)
+				lengthSeconds = midi.getDuration() + _job.tailSeconds;
+		}
+
+		const auto sampleCount = toSamples(lengthSeconds);
+		const auto channelCount = renderer.getChannelCount();
+
+		if(!sampleCount || !channelCount)
+		{
+			result.error = "Nothing to render";
+			return result;
+		}
+
+		renderer.skip(preroll);
+
+		synthLib::WavWriter writer;
+
+		std::vector<float> interleaved;
+		const auto flushSize = static_cast<size_t>(samplerate) * channelCount;
+		interleaved.reserve(flushSize + renderer.getBlockSize() * channelCount);
+
+		bool writeFailed = false;
+
+		auto flush = [&]
+		{
+			if(interleaved.empty() || writeFailed)
+				return;
+			if(!writer.write(_job.outputFile, 32, true, static_cast<int>(channelCount), static_cast<int>(samplerate), interleaved))
+				writeFailed = true;
+			interleaved.clear();
+		};
+
+		renderer.render(sampleCount, [&](const synthLib::OfflineRenderer::TChannels& _channels, const uint32_t _size)
+		{
+			for(uint32_t i=0; i<_size; ++i)
+			{
+				for(uint32_t c=0; c<channelCount; ++c)
+					interleaved.push_back(_channels[c][i]);
+			}
+
+			if(interleaved.size() >= flushSize)
+				flush();
+		});
+
+		flush();
+
+		if(writeFailed)
+		{
+			result.error = "Failed to write output file " + _job.outputFile;
+			return result;
+		}
+
+		result.success = true;
+		result.sampleCount = sampleCount;
+		result.samplerate = samplerate;
+		result.channelCount = channelCount;
+		result.renderSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - timeStart).count();
+
+		return result;
+	}
+
+	bool JobRenderer::loadSysex(std::vector<std::vector<uint8_t>>& _messages, const std::string& _filename)
+	{
+		return synthLib::MidiToSysex::extractSysexFromFile(_messages, _filename);
+	}
+}
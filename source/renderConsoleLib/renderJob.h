@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "deviceFactory.h"
+
+namespace baseLib
+{
+	class PropertyMap;
+}
+
+namespace renderConsoleLib
+{
+	struct RenderJob
+	{
+		DeviceType deviceType = DeviceType::Invalid;
+		std::string romFile;
+
+		std::string stateFile;		// device state as written by synthLib::Plugin::getState or any sysex (.syx/.mid) file
+		std::string bankFile;		// preset bank (.syx/.mid), sent to the device before the program change is issued
+		int32_t program = -1;		// program change sent after the state/bank has been applied, -1 = none
+
+		std::string midiFile;
+		std::string outputFile;
+
+		float samplerate = 0.0f;	// 0 = native device samplerate
+		uint32_t blockSize = 64;
+
+		float prerollSeconds = 1.0f;		// time given to the device to apply state/bank, not part of the output
+		float sysexIntervalSeconds = 0.05f;	// time between consecutive sysex messages of state/bank files
+		float tailSeconds = 2.0f;			// rendered after the last midi event
+		float lengthSeconds = 0.0f;			// if nonzero, overrides the length derived from the midi file
+
+		bool fromProperties(const baseLib::PropertyMap& _props);
+		std::string getDescription() const;
+	};
+
+	struct RenderResult
+	{
+		bool success = false;
+		std::string error;
+
+		uint64_t sampleCount = 0;
+		float samplerate = 0.0f;
+		uint32_t channelCount = 0;
+
+		double renderSeconds = 0.0;
+
+		double getRealtimeFactor() const
+		{
+			if(renderSeconds <= 0.0 || samplerate <= 0.0f)
+				return 0.0;
+			return static_cast<double>(sampleCount) / static_cast<double>(samplerate) / renderSeconds;
+		}
+	};
+
+	class JobRenderer
+	{
+	public:
+		static RenderResult render(const RenderJob& _job);
+
+		static bool loadSysex(std::vector<std::vector<uint8_t>>& _messages, const std::string& _filename);
+	};
+}
@@ -0,0 +1,359 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+#include "baseLib/commandline.h"
+
+#include "renderConsoleLib/demoScenario.h"
+#include "renderConsoleLib/deviceFactory.h"
+#include "renderConsoleLib/renderJob.h"
+
+#include "synthLib/device.h"
+#include "synthLib/deviceException.h"
+#include "synthLib/midiFile.h"
+#include "synthLib/scenario.h"
+#include "synthLib/scenarioRunner.h"
+#include "synthLib/wavWriter.h"
+
+using namespace renderConsoleLib;
+
+namespace
+{
+	void printUsage()
+	{
+		std::cout << "Plays reproducible scenarios against any of the emulated devices for profiling and regression testing" << std::endl << std::endl;
+
+		std::cout << "Usage:" << std::endl;
+		std::cout << "  scenarioConsole -device <name> [-demo <seconds>] [-midi <file.mid>] [-trace <file>] [options]" << std::endl << std::endl;
+
+		std::cout << "Phases are played in this order: boot, bank, trace, midi, demo" << std::endl << std::endl;
+
+		std::cout << "Options:" << std::endl;
+		std::cout << "  -device <name>            device to use, one of:";
+		for (const auto type : DeviceFactory::getSupportedTypes())
+			std::cout << ' ' << DeviceFactory::getName(type);
+		std::cout << std::endl;
+		std::cout << "  -rom <file>               ROM/firmware file, if omitted, the ROM is searched for next to the executable" << std::endl;
+		std::cout << "  -samplerate <hz>          device samplerate, default is the native device samplerate" << std::endl;
+		std::cout << "  -blocksize <n>            samples processed per block, default 64" << std::endl;
+		std::cout << "  -boot <seconds>           idle time after device creation, default 1" << std::endl;
+		std::cout << "  -bank <file.syx>          preset bank that is sent to the device" << std::endl;
+		std::cout << "  -program <n>              program change sent after the bank" << std::endl;
+		std::cout << "  -trace <file>             event trace as written by -saveTrace" << std::endl;
+		std::cout << "  -midi <file.mid>          midi file to play" << std::endl;
+		std::cout << "  -tail <seconds>           time played after the end of the midi file, default 2" << std::endl;
+		std::cout << "  -demo <seconds>           plays the demo song of the device firmware for the given time" << std::endl;
+		std::cout << "  -saveTrace <file>         writes the midi events of the scenario to a trace file" << std::endl;
+		std::cout << "  -out <file.wav>           writes the audio of the first run" << std::endl;
+		std::cout << "  -writeReference <file>    writes the audio hashes of the first run to a reference file" << std::endl;
+		std::cout << "  -reference <file>         compares the audio hashes of every run against a reference file" << std::endl;
+		std::cout << "  -repeat <n>               number of runs, each with a new device instance, default 1" << std::endl;
+		std::cout << "  -metrics                  prints device timing and buffer statistics after each run" << std::endl;
+		std::cout << "  -headless                 runs the device without front panel, LCD and LEDs are not updated" << std::endl;
+		std::cout << "  -compareHeadless          alternates runs with and without -headless and compares their UC thread time" << std::endl;
+	}
+
+	bool createScenario(synthLib::Scenario& _scenario, const baseLib::CommandLine& _cmd, const DeviceType _type)
+	{
+		_scenario.addPhase("boot", _cmd.getFloat("boot", 1.0f));
+
+		const auto bankFile = _cmd.get("bank");
+
+		if(!bankFile.empty() || _cmd.contains("program"))
+		{
+			constexpr double interval = 0.05;
+
+			auto& phase = _scenario.addPhase("bank", 0.5);
+
+			std::vector<std::vector<uint8_t>> presets;
+
+			if(!bankFile.empty() && !JobRenderer::loadSysex(presets, bankFile))
+			{
+				std::cout << "Failed to load preset bank " << bankFile << std::endl;
+				return false;
+			}
+
+			double t = 0.0;
+
+			for (auto& preset : presets)
+			{
+				synthLib::SMidiEvent ev(synthLib::MidiEventSource::Host);
+				ev.sysex = std::move(preset);
+				_scenario.addEvent(t, ev);
+				t += interval;
+			}
+
+			if(_cmd.contains("program"))
+			{
+				_scenario.addEvent(t, synthLib::SMidiEvent(synthLib::MidiEventSource::Host, synthLib::M_PROGRAMCHANGE, static_cast<uint8_t>(_cmd.getInt("program") & 0x7f)));
+				t += interval;
+			}
+
+			phase.seconds = std::max(phase.seconds, t + 0.5);
+		}
+
+		const auto traceFile = _cmd.get("trace");
+
+		if(!traceFile.empty())
+		{
+			synthLib::Scenario trace;
+
+			if(!trace.loadTrace(traceFile))
+			{
+				std::cout << "Failed to load trace " << traceFile << std::endl;
+				return false;
+			}
+
+			for (const auto& phase : trace.getPhases())
+			{
+				_scenario.addPhase(phase.name, phase.seconds);
+				for (const auto& e : phase.events)
+					_scenario.addEvent(e.seconds, e.event);
+			}
+		}
+
+		const auto midiFile = _cmd.get("midi");
+
+		if(!midiFile.empty())
+		{
+			synthLib::MidiFile midi;
+
+			if(!midi.loadFromFile(midiFile))
+			{
+				std::cout << "Failed to load midi file " << midiFile << std::endl;
+				return false;
+			}
+
+			_scenario.addMidiFile("midi", midi, _cmd.getFloat("tail", 2.0f));
+		}
+
+		if(_cmd.contains("demo") && !DemoScenario::addDemoPhase(_scenario, _type, _cmd.getFloat("demo", 60.0f)))
+		{
+			std::cout << "Device " << DeviceFactory::getName(_type) << " does not support demo playback" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	std::string toHex(const uint64_t _hash)
+	{
+		std::stringstream ss;
+		ss << std::hex << std::setw(16) << std::setfill('0') << _hash;
+		return ss.str();
+	}
+
+	void printResult(const synthLib::ScenarioResult& _result)
+	{
+		for (const auto& phase : _result.phases)
+		{
+			const auto audioSeconds = static_cast<double>(phase.sampleCount) / static_cast<double>(_result.samplerate);
+
+			std::cout << "  " << std::left << std::setw(12) << phase.name << std::right << std::fixed << std::setprecision(2)
+				<< std::setw(8) << audioSeconds << "s audio in " << std::setw(8) << phase.renderSeconds << "s";
+
+			if(phase.renderSeconds > 0.0)
+				std::cout << ", " << std::setw(6) << (audioSeconds / phase.renderSeconds) << "x realtime";
+
+			std::cout << ", hash " << toHex(phase.hash) << std::endl;
+		}
+	}
+
+	// time the microcontroller thread spent executing instructions, summed over several runs
+	struct UcTime
+	{
+		uint32_t runs = 0;
+		uint64_t quantums = 0;
+		uint64_t nanoseconds = 0;
+
+		void add(const synthLib::MetricsSnapshot& _metrics)
+		{
+			const auto& m = _metrics.get(synthLib::MetricType::UcQuantum);
+			++runs;
+			quantums += m.count;
+			nanoseconds += m.sum;
+		}
+
+		double getMillisecondsPerRun() const { return runs ? static_cast<double>(nanoseconds) / 1e6 / runs : 0.0; }
+		double getMicrosecondsPerQuantum() const { return quantums ? static_cast<double>(nanoseconds) / 1e3 / static_cast<double>(quantums) : 0.0; }
+	};
+
+	void printUcTime(const char* _name, const UcTime& _time)
+	{
+		std::cout << "  " << std::left << std::setw(12) << _name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(10) << _time.getMillisecondsPerRun() << " ms UC time per run, "
+			<< std::setw(8) << _time.getMicrosecondsPerQuantum() << " us per quantum, " << _time.runs << " run(s)" << std::endl;
+	}
+}
+
+int main(const int _argc, char* _argv[])
+{
+	const baseLib::CommandLine commandLine(_argc, _argv);
+
+	if(commandLine.empty() || commandLine.contains("help") || commandLine.contains("h"))
+	{
+		printUsage();
+		return 0;
+	}
+
+	const auto type = DeviceFactory::getTypeByName(commandLine.get("device"));
+
+	if(type == DeviceType::Invalid)
+	{
+		std::cout << "Invalid device" << std::endl << std::endl;
+		printUsage();
+		return -1;
+	}
+
+	synthLib::Scenario scenario;
+
+	if(!createScenario(scenario, commandLine, type))
+		return -1;
+
+	const auto saveTraceFile = commandLine.get("saveTrace");
+
+	if(!saveTraceFile.empty() && !scenario.saveTrace(saveTraceFile))
+	{
+		std::cout << "Failed to write trace " << saveTraceFile << std::endl;
+		return -1;
+	}
+
+	synthLib::ScenarioResult reference;
+
+	const auto referenceFile = commandLine.get("reference");
+
+	if(!referenceFile.empty() && !reference.load(referenceFile))
+	{
+		std::cout << "Failed to load reference " << referenceFile << std::endl;
+		return -1;
+	}
+
+	const auto romFile = commandLine.get("rom");
+	const auto samplerate = commandLine.getFloat("samplerate", 0.0f);
+	const auto blockSize = static_cast<uint32_t>(commandLine.getInt("blocksize", 64));
+	const auto repeat = std::max(1, commandLine.getInt("repeat", 1));
+	const auto outFile = commandLine.get("out");
+	const auto writeReferenceFile = commandLine.get("writeReference");
+	const auto compareHeadless = commandLine.contains("compareHeadless");
+
+	int failCount = 0;
+	UcTime ucTime[2];	// without, with headless mode
+	synthLib::ScenarioResult firstResult;
+
+	for(int r=0; r<repeat; ++r)
+	{
+		// when comparing, every second run is headless. The audio has to be identical, the determinism check covers that
+		const auto headless = compareHeadless ? (r & 1) != 0 : commandLine.contains("headless");
+
+		std::cout << "Run " << (r + 1) << '/' << repeat << ", " << DeviceFactory::getName(type) << ", " << std::fixed << std::setprecision(2) << scenario.getDuration() << "s";
+		if(headless)
+			std::cout << ", headless";
+		std::cout << std::endl;
+
+		synthLib::ScenarioResult result;
+		synthLib::MetricsSnapshot metrics;
+
+		std::vector<float> interleaved;
+
+		try
+		{
+			const auto device = DeviceFactory::create(type, romFile, samplerate);
+
+			if(headless && !device->setHeadless(true))
+				std::cout << "  Device " << DeviceFactory::getName(type) << " does not support headless mode" << std::endl;
+
+			synthLib::ScenarioRunner runner(*device, samplerate, blockSize);
+
+			synthLib::OfflineRenderer::BlockCallback onBlock;
+
+			if(r == 0 && !outFile.empty())
+			{
+				const auto channelCount = runner.getRenderer().getChannelCount();
+
+				onBlock = [&](const synthLib::OfflineRenderer::TChannels& _channels, const uint32_t _size)
+				{
+					for(uint32_t i=0; i<_size; ++i)
+					{
+						for(uint32_t c=0; c<channelCount; ++c)
+							interleaved.push_back(_channels[c][i]);
+					}
+				};
+			}
+
+			result = runner.run(scenario, onBlock);
+
+			metrics = device->getMetrics().getSnapshot();
+		}
+		catch(const synthLib::DeviceException& e)
+		{
+			std::cout << "FAILED, " << e.what() << std::endl;
+			return -1;
+		}
+
+		printResult(result);
+
+		ucTime[headless ? 1 : 0].add(metrics);
+
+		if(commandLine.contains("metrics"))
+			std::cout << metrics.toString();
+
+		if(r == 0)
+		{
+			if(!interleaved.empty())
+			{
+				synthLib::WavWriter writer;
+				if(!writer.write(outFile, 32, true, static_cast<int>(result.channelCount), static_cast<int>(result.samplerate), interleaved))
+					std::cout << "Failed to write output file " << outFile << std::endl;
+			}
+
+			if(!writeReferenceFile.empty() && !result.save(writeReferenceFile))
+				std::cout << "Failed to write reference " << writeReferenceFile << std::endl;
+
+			firstResult = result;
+		}
+		else
+		{
+			// every run uses a fresh device, the output has to be identical
+			const auto d = result.compare(firstResult);
+
+			if(d.diverged)
+			{
+				std::cout << "  Run is not deterministic, " << d.reason << " at sample " << d.samplePos << std::endl;
+				++failCount;
+			}
+		}
+
+		if(!referenceFile.empty())
+		{
+			const auto d = result.compare(reference);
+
+			if(d.diverged)
+			{
+				std::cout << "  Differs from reference, " << d.reason << " at sample " << d.samplePos << std::endl;
+				++failCount;
+			}
+			else
+			{
+				std::cout << "  Matches reference" << std::endl;
+			}
+		}
+	}
+
+	if(repeat > 1)
+		std::cout << "Finished " << repeat << " runs, " << failCount << " failure(s)" << std::endl;
+
+	if(compareHeadless)
+	{
+		std::cout << "UC thread time:" << std::endl;
+		printUcTime("front panel", ucTime[0]);
+		printUcTime("headless", ucTime[1]);
+
+		if(ucTime[0].runs && ucTime[1].runs && ucTime[0].getMillisecondsPerRun() > 0.0)
+			std::cout << "  Headless saves " << std::setprecision(1) << (1.0 - ucTime[1].getMillisecondsPerRun() / ucTime[0].getMillisecondsPerRun()) * 100.0 << "% of UC thread time" << std::endl;
+		else
+			std::cout << "  Use -repeat 2 or more to compare both modes" << std::endl;
+	}
+
+	return failCount ? -1 : 0;
+}
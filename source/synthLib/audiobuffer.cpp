@@ -1,19 +1,27 @@
 #include "audiobuffer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>	// memcpy
 
 namespace synthLib
 {
-	void AudioBuffer::insertZeroes(size_t _size)
+	void AudioBuffer::insertZeroes(const size_t _size)
 	{
-		TChannel zeroes;
-		zeroes.resize(_size, 0.0f);
+		if(m_data.empty() || !_size)
+			return;
 
-		for(size_t c=0; c<m_data.size(); ++c)
+		if(m_readPos < _size)
 		{
-			m_data[c].insert(m_data[c].begin(), zeroes.begin(), zeroes.end());
+			ensureCapacity(m_size + _size);
+			compact(_size);
 		}
+
+		m_readPos -= _size;
+		m_size += _size;
+
+		for (auto& c : m_data)
+			std::fill_n(c.data() + m_readPos, _size, 0.0f);
 	}
 
 	AudioBuffer::AudioBuffer(size_t _channelCount, const size_t _capacity)
@@ -22,86 +30,151 @@ namespace synthLib
 		reserve(_capacity);
 	}
 
-	void AudioBuffer::reserve(size_t _capacity)
+	void AudioBuffer::reserve(const size_t _capacity)
 	{
-		for(auto i=0; i<m_data.size(); ++i)
-		{
-			if(m_data[i].capacity() < _capacity)
-				m_data[i].reserve(_capacity);
-		}
+		if(capacity() >= _capacity)
+			return;
+
+		for (auto& c : m_data)
+			c.resize(_capacity, 0.0f);
 	}
 
-	void AudioBuffer::resize(size_t _capacity)
+	void AudioBuffer::resize(const size_t _capacity)
 	{
-		for(auto i=0; i<m_data.size(); ++i)
+		if(m_data.empty())
+			return;
+
+		if(_capacity > m_size)
 		{
-			m_data[i].resize(_capacity);
+			ensureCapacity(_capacity);
+
+			for (auto& c : m_data)
+				std::fill(c.data() + m_readPos + m_size, c.data() + m_readPos + _capacity, 0.0f);
 		}
+
+		m_size = _capacity;
+
+		if(!m_size)
+			m_readPos = 0;
 	}
 
 	void AudioBuffer::append(const TBuffer& _data)
 	{
 		assert(_data.size() == m_data.size());
 
+		if(m_data.empty())
+			return;
+
+		const auto count = _data.front().size();
+
+		ensureCapacity(m_size + count);
+
 		for(size_t c=0; c<_data.size(); ++c)
 		{
-			append(m_data[c], &_data[c].front(), _data[c].size());
+			assert(_data[c].size() == count);
+			memcpy(m_data[c].data() + m_readPos + m_size, _data[c].data(), count * sizeof(float));
 		}
+
+		m_size += count;
 	}
 
-	void AudioBuffer::append(const float** _data, size_t _size)
+	void AudioBuffer::append(const float** _data, const size_t _size)
 	{
+		if(m_data.empty())
+			return;
+
+		ensureCapacity(m_size + _size);
+
 		for(size_t c=0; c<m_data.size(); ++c)
-		{
-			append(m_data[c], _data[c], _size);
-		}
+			memcpy(m_data[c].data() + m_readPos + m_size, _data[c], _size * sizeof(float));
+
+		m_size += _size;
 	}
 
-	void AudioBuffer::append(const TAudioInputs& _data, size_t _size)
+	void AudioBuffer::append(const TAudioInputs& _data, const size_t _size)
 	{
-		const auto c = std::min(m_data.size(), _data.size());
+		if(m_data.empty())
+			return;
+
+		ensureCapacity(m_size + _size);
 
-		for(size_t i=0; i<c; ++i)
-			append(m_data[i], _data[i], _size);
+		const auto count = std::min(m_data.size(), _data.size());
+
+		for(size_t c=0; c<m_data.size(); ++c)
+		{
+			auto* dst = m_data[c].data() + m_readPos + m_size;
+
+			if(c < count)
+				memcpy(dst, _data[c], _size * sizeof(float));
+			else
+				std::fill_n(dst, _size, 0.0f);
+		}
+
+		m_size += _size;
 	}
 
 	void AudioBuffer::remove(const size_t _count)
 	{
-		for(size_t c=0; c<m_data.size(); ++c)
+		if(_count >= m_size)
 		{
-			if(_count >= m_data[c].size())
-				m_data[c].clear();
-			else
-				m_data[c].erase(m_data[c].begin(), m_data[c].begin() + _count);
+			m_readPos = 0;
+			m_size = 0;
+			return;
 		}
+
+		m_readPos += _count;
+		m_size -= _count;
 	}
 
 	void AudioBuffer::fillPointers(TAudioOutputs& _pointers, size_t _offset)
 	{
 		for(size_t c=0; c<m_data.size(); ++c)
-			_pointers[c] = &m_data[c][_offset];
+			_pointers[c] = m_data[c].data() + m_readPos + _offset;
 	}
 
 	void AudioBuffer::fillPointers(TAudioInputs& _pointers, size_t _offset) const
 	{
 		for(size_t c=0; c<m_data.size(); ++c)
-			_pointers[c] = &m_data[c][_offset];
+			_pointers[c] = m_data[c].data() + m_readPos + _offset;
 		for(size_t c=m_data.size(); c<_pointers.size(); ++c)
 			_pointers[c] = nullptr;
 	}
 
 	size_t AudioBuffer::size() const
 	{
-		if(m_data.empty())
-			return 0;
-		return m_data[0].size();
+		return m_size;
 	}
 
-	void AudioBuffer::append(TChannel& _dst, const float* _data, size_t _size)
+	void AudioBuffer::ensureCapacity(const size_t _size)
 	{
-		const auto oldSize = _dst.size();
-		_dst.resize(oldSize + _size);
-		memcpy(&_dst[oldSize], _data, _size * sizeof(float));
+		if(m_readPos + _size <= capacity())
+			return;
+
+		if(_size > capacity())
+		{
+			const auto newCapacity = std::max(_size, capacity() << 1);
+
+			for (auto& c : m_data)
+				c.resize(newCapacity, 0.0f);
+		}
+
+		if(m_readPos)
+			compact();
 	}
 
+	void AudioBuffer::compact(const size_t _gap)
+	{
+		assert(_gap + m_size <= capacity());
+
+		if(m_readPos == _gap)
+			return;
+
+		if(m_size)
+		{
+			for (auto& c : m_data)
+				memmove(c.data() + _gap, c.data() + m_readPos, m_size * sizeof(float));
+		}
+
+		m_readPos = _gap;
+	}
 }
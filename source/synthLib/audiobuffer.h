@@ -6,6 +6,9 @@
 
 namespace synthLib
 {
+	// Multichannel sample buffer that is appended at the end and consumed from the front. Removing samples advances a
+	// read position instead of moving the remaining data, the data is moved to the front only if there is no space left
+	// at the end, which happens rarely if samples are consumed as fast as they are appended
 	class AudioBuffer
 	{
 	public:
@@ -19,7 +22,7 @@ namespace synthLib
 		void append(const TAudioInputs& _data, size_t _size);
 
 		void remove(size_t _count);
-		
+
 		void fillPointers(TAudioOutputs& _pointers, size_t _offset = 0);
 		void fillPointers(TAudioInputs& _pointers, size_t _offset = 0) const;
 		size_t size() const;
@@ -32,14 +35,19 @@ namespace synthLib
 
 		void insertZeroes(size_t _size);
 
-		const std::vector<float>& getChannel(const size_t _channel) const { return m_data[_channel]; }
-		float* getChannel(const size_t _channel) { return &m_data[_channel].front(); }
+		const float* getChannel(const size_t _channel) const { return m_data[_channel].data() + m_readPos; }
+		float* getChannel(const size_t _channel) { return m_data[_channel].data() + m_readPos; }
 
 		bool empty() const { return size() == 0; }
 
 		AudioBuffer(size_t _channelCount = 2, size_t _capacity = 1024);
 	private:
-		static void append(TChannel& _dst, const float* _data, size_t _size);
-		TBuffer m_data;
+		size_t capacity() const { return m_data.empty() ? 0 : m_data[0].size(); }
+		void ensureCapacity(size_t _size);
+		void compact(size_t _gap = 0);
+
+		TBuffer m_data;		// each channel is sized to the capacity, valid data is in [m_readPos, m_readPos + m_size)
+		size_t m_readPos = 0;
+		size_t m_size = 0;
 	};
 }
@@ -4,6 +4,7 @@
 #include "dsp56kEmu/dsp.h"
 #include "dsp56kEmu/memory.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace dsp56k;
@@ -34,10 +35,62 @@ namespace synthLib
 		process(in, out, _numSamples, midi, midi);
 	}
 
+	namespace
+	{
+		// one LSB of the 24 bit DSP output
+		constexpr float g_silenceThreshold = 1.0f / static_cast<float>(1 << 23);
+
+		template<typename T> bool isSilent(const T& _buffers, const uint32_t _channelCount, const size_t _size)
+		{
+			for(size_t c=0; c<std::min(static_cast<size_t>(_channelCount), _buffers.size()); ++c)
+			{
+				const auto* buf = _buffers[c];
+
+				if(!buf)
+					continue;
+
+				for(size_t i=0; i<_size; ++i)
+				{
+					if(std::fabs(buf[i]) > g_silenceThreshold)
+						return false;
+				}
+			}
+			return true;
+		}
+	}
+
 	void Device::process(const TAudioInputs& _inputs, const TAudioOutputs& _outputs, const size_t _size, const std::vector<SMidiEvent>& _midiIn, std::vector<SMidiEvent>& _midiOut)
 	{
+		const ScopedMetricTimer timer(m_metrics, MetricType::BlockTime);
+
 		_midiOut.clear();
 
+		if(const float idleSleepSeconds = m_idleSleepSeconds; idleSleepSeconds != m_idleSleepSecondsProcess)
+		{
+			m_idleSleepSecondsProcess = idleSleepSeconds;
+			m_silentSamples = 0;
+
+			if(idleSleepSeconds <= 0.0f)
+				m_sleeping = false;
+		}
+
+		if(m_sleeping)
+		{
+			if(_midiIn.empty() && isSilent(_inputs, getChannelCountIn(), _size))
+			{
+				for (auto* out : _outputs)
+				{
+					if(out)
+						std::fill_n(out, _size, 0.0f);
+				}
+				return;
+			}
+
+			// resume where we stopped, the emulation did not advance while sleeping
+			m_sleeping = false;
+			m_silentSamples = 0;
+		}
+
 		for (const auto& ev : _midiIn)
 		{
 			m_translatorOut.clear();
@@ -51,6 +104,28 @@ namespace synthLib
 		processAudio(_inputs, _outputs, _size);
 
 		readMidiOut(_midiOut);
+
+		m_metrics.addProcessedSamples(_size, getSamplerate());
+
+		if(m_idleSleepSecondsProcess <= 0.0f)
+			return;
+
+		if(!_midiIn.empty() || !_midiOut.empty() || !isSilent(_inputs, getChannelCountIn(), _size) || !isSilent(_outputs, getChannelCountOut(), _size))
+		{
+			m_silentSamples = 0;
+			return;
+		}
+
+		m_silentSamples += _size;
+
+		if(static_cast<float>(m_silentSamples) >= m_idleSleepSecondsProcess * getSamplerate())
+			m_sleeping = true;
+	}
+
+	void Device::setIdleSleepSeconds(const float _seconds)
+	{
+		// applied by the audio thread on the next call to process()
+		m_idleSleepSeconds = std::max(0.0f, _seconds);
 	}
 
 	void Device::setExtraLatencySamples(const uint32_t _size)
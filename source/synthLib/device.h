@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 #include <string>
 
 #include "audioTypes.h"
+#include "deviceMetrics.h"
 #include "deviceTypes.h"
 
 #include "midiTypes.h"
@@ -82,11 +84,29 @@ namespace synthLib
 		virtual uint32_t getDspClockPercent() const = 0;
 		virtual uint64_t getDspClockHz() const = 0;
 
+		// A headless device skips everything that is only needed to display its front panel, such as LCD and LED
+		// updates, for example if it is rendered offline. Does not affect audio. Returns false if not supported
+		virtual bool setHeadless([[maybe_unused]] bool _headless) { return false; }
+
+		// Routes a part to a stereo output pair, the device switches to multi mode if needed. Returns false if the
+		// device cannot route the part to that pair
+		virtual bool setPartOutput([[maybe_unused]] uint8_t _part, [[maybe_unused]] uint32_t _outputPair) { return false; }
 
 		ASMJIT_NOINLINE virtual void release(std::vector<SMidiEvent>& _events);
 
 		auto& getMidiTranslator() { return m_midiTranslator; }
 
+		DeviceMetrics& getMetrics() { return m_metrics; }
+		const DeviceMetrics& getMetrics() const { return m_metrics; }
+
+		// Opt-in idle mode. If the audio in- and outputs have been silent for the given time and no midi has been
+		// received, the device is no longer processed and outputs silence. The emulation then blocks on its empty
+		// audio input and uses no CPU. The next midi event or non-silent input resumes it from where it stopped.
+		// 0 = disabled
+		void setIdleSleepSeconds(float _seconds);
+		float getIdleSleepSeconds() const { return m_idleSleepSeconds; }
+		bool isSleeping() const { return m_sleeping; }
+
 	protected:
 		virtual void readMidiOut(std::vector<SMidiEvent>& _midiOut) = 0;
 		virtual void processAudio(const TAudioInputs& _inputs, const TAudioOutputs& _outputs, size_t _samples) = 0;
@@ -102,5 +122,14 @@ namespace synthLib
 
 		MidiTranslator m_midiTranslator;
 		std::vector<SMidiEvent> m_translatorOut;
+
+		DeviceMetrics m_metrics;
+
+		// idle sleep. The setting is written by the UI thread and picked up by the audio thread in process(), the
+		// remaining state is owned by the audio thread
+		std::atomic<float> m_idleSleepSeconds = 0.0f;
+		float m_idleSleepSecondsProcess = 0.0f;
+		size_t m_silentSamples = 0;
+		std::atomic<bool> m_sleeping = false;
 	};
 }
@@ -0,0 +1,438 @@
+#include "deviceFarm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>	// memcpy
+
+#include "deviceException.h"
+
+#include "dsp56kEmu/logging.h"
+
+namespace synthLib
+{
+	namespace
+	{
+		constexpr size_t g_maxBufferedMidiEvents = 4096;
+	}
+
+	DeviceFarm::DeviceFarm(Device* _device) : m_device(_device), m_outputs(_device->getChannelCountOut(), 1024)
+	{
+	}
+
+	DeviceFarm::~DeviceFarm() = default;
+
+	std::shared_ptr<DeviceFarm> DeviceFarm::get(const std::string& _id, const DeviceFactory& _factory)
+	{
+		static std::mutex mutex;
+		static std::map<std::string, std::weak_ptr<DeviceFarm>> farms;
+
+		std::scoped_lock lock(mutex);
+
+		auto& farm = farms[_id];
+
+		if(auto f = farm.lock())
+			return f;
+
+		auto* device = _factory();
+
+		if(!device)
+			throw DeviceException(DeviceError::Unknown, "Failed to create device for device farm " + _id);
+
+		LOG("Created device farm " << _id);
+
+		auto f = std::make_shared<DeviceFarm>(device);
+		farm = f;
+		return f;
+	}
+
+	void DeviceFarm::attach(const FarmDevice& _member)
+	{
+		std::scoped_lock lock(m_mutex);
+
+		Member m;
+		m.part = _member.getPart();
+
+		assignOutputPair(m);
+
+		m_members.insert({&_member, std::move(m)});
+	}
+
+	void DeviceFarm::detach(const FarmDevice& _member)
+	{
+		std::scoped_lock lock(m_mutex);
+
+		const auto it = m_members.find(&_member);
+		if(it == m_members.end())
+			return;
+
+		// notes that are still held must not continue to play on the pair once another member gets it
+		if(it->second.outputPair != NoOutputPair)
+			m_midiIn.emplace_back(MidiEventSource::Internal, static_cast<uint8_t>(M_CONTROLCHANGE | it->second.part), MC_ALLNOTESOFF, 0);
+
+		m_members.erase(it);
+
+		// the pair that has been released can be used by a member that has none
+		for (auto& it : m_members)
+		{
+			if(it.second.outputPair == NoOutputPair)
+				assignOutputPair(it.second);
+		}
+	}
+
+	void DeviceFarm::onStateChanged()
+	{
+		for (auto& it : m_members)
+			it.second.outputPair = NoOutputPair;
+
+		for (auto& it : m_members)
+			assignOutputPair(it.second);
+	}
+
+	void DeviceFarm::assignOutputPair(Member& _member)
+	{
+		const auto pairCount = m_device->getChannelCountOut() >> 1;
+
+		// start with the pair that matches the part
+		for(uint32_t i=0; i<pairCount; ++i)
+		{
+			const auto pair = (_member.part + i) % pairCount;
+
+			if(isOutputPairUsed(pair) || !m_device->setPartOutput(_member.part, pair))
+				continue;
+
+			_member.outputPair = pair;
+
+			LOG("Device farm: part " << static_cast<int>(_member.part + 1) << " routed to output pair " << pair);
+			return;
+		}
+
+		// A device that cannot route parts plays all of them on its first pair. Only one member can use it, all
+		// others would hear the parts of that member
+		const auto anyPairUsed = std::any_of(m_members.begin(), m_members.end(), [](const auto& _it)
+		{
+			return _it.second.outputPair != NoOutputPair;
+		});
+
+		if(pairCount > 0 && !anyPairUsed)
+		{
+			_member.outputPair = 0;
+
+			LOG("Device farm: part " << static_cast<int>(_member.part + 1) << " not routed, using the first output pair");
+			return;
+		}
+
+		_member.outputPair = NoOutputPair;
+
+		LOG("Device farm: no output pair left for part " << static_cast<int>(_member.part + 1) << ", it is silenced");
+	}
+
+	bool DeviceFarm::isOutputPairUsed(const uint32_t _pair) const
+	{
+		return std::any_of(m_members.begin(), m_members.end(), [&](const auto& _it)
+		{
+			return _it.second.outputPair == _pair;
+		});
+	}
+
+	bool DeviceFarm::setSamplerate(const float _samplerate)
+	{
+		std::scoped_lock lock(m_mutex);
+
+		if(m_members.size() > 1)
+			return std::fabs(m_device->getSamplerate() - _samplerate) < 1.0f;
+
+		return m_device->setSamplerate(_samplerate);
+	}
+
+	void DeviceFarm::getSupportedSamplerates(std::vector<float>& _dst)
+	{
+		std::scoped_lock lock(m_mutex);
+
+		if(m_members.size() > 1)
+			_dst.push_back(m_device->getSamplerate());
+		else
+			m_device->getSupportedSamplerates(_dst);
+	}
+
+	void DeviceFarm::getPreferredSamplerates(std::vector<float>& _dst)
+	{
+		std::scoped_lock lock(m_mutex);
+
+		if(m_members.size() > 1)
+			_dst.push_back(m_device->getSamplerate());
+		else
+			m_device->getPreferredSamplerates(_dst);
+	}
+
+	uint32_t DeviceFarm::getSharedExtraLatencySamples() const
+	{
+		uint32_t latency = 0;
+
+		for (const auto& it : m_members)
+			latency = std::max(latency, it.first->getExtraLatencySamples());
+
+		return latency;
+	}
+
+	void DeviceFarm::addMidiEvent(const FarmDevice& _member, const SMidiEvent& _ev)
+	{
+		std::scoped_lock lock(m_mutex);
+
+		const auto it = m_members.find(&_member);
+		if(it == m_members.end())
+			return;
+
+		// a silenced member must not play notes, they would be heard on the pair of another member
+		if(it->second.outputPair == NoOutputPair && _ev.sysex.empty() && _ev.a < 0xf0)
+			return;
+
+		m_midiIn.push_back(_ev);
+	}
+
+	void DeviceFarm::readMidiOut(const FarmDevice& _member, std::vector<SMidiEvent>& _midiOut)
+	{
+		std::scoped_lock lock(m_mutex);
+
+		const auto it = m_members.find(&_member);
+		if(it == m_members.end())
+			return;
+
+		auto& midiOut = it->second.midiOut;
+		_midiOut.insert(_midiOut.end(), midiOut.begin(), midiOut.end());
+		midiOut.clear();
+	}
+
+	void DeviceFarm::processAudio(const FarmDevice& _member, const TAudioOutputs& _outputs, const size_t _samples)
+	{
+		std::scoped_lock lock(m_mutex);
+
+		const auto it = m_members.find(&_member);
+		if(it == m_members.end())
+			return;
+
+		auto& audio = it->second.audio;
+
+		it->second.blockSize = _samples;
+
+		// the first member that runs out of audio processes the device for everyone
+		if(audio.size() < _samples)
+			produce(_samples - audio.size());
+
+		for(size_t c=0; c<_outputs.size(); ++c)
+		{
+			auto* out = _outputs[c];
+
+			if(!out)
+				continue;
+
+			if(c < 2)
+				memcpy(out, audio.getChannel(c), _samples * sizeof(float));
+			else
+				std::fill_n(out, _samples, 0.0f);
+		}
+
+		audio.remove(_samples);
+	}
+
+	void DeviceFarm::produce(const size_t _samples)
+	{
+		if(const auto extraLatency = getSharedExtraLatencySamples(); m_device->getExtraLatencySamples() != extraLatency)
+			m_device->setExtraLatencySamples(extraLatency);
+
+		m_outputs.ensureSize(_samples);
+
+		if(m_silence.size() < _samples)
+			m_silence.resize(_samples, 0.0f);
+
+		TAudioInputs inputs{};
+		TAudioOutputs outputs{};
+
+		for(size_t c=0; c<std::min(static_cast<size_t>(m_device->getChannelCountIn()), inputs.size()); ++c)
+			inputs[c] = m_silence.data();
+
+		m_outputs.fillPointers(outputs);
+
+		// events of members that have been processed after the previous call arrive late, they are played asap
+		for (auto& ev : m_midiIn)
+			ev.offset = std::min(ev.offset, static_cast<uint32_t>(_samples - 1));
+
+		m_midiOut.clear();
+		m_device->process(inputs, outputs, _samples, m_midiIn, m_midiOut);
+		m_midiIn.clear();
+
+		for (auto& it : m_members)
+		{
+			auto& m = it.second;
+
+			// a member without output pair receives silence
+			const float* pair[2] = {m_silence.data(), m_silence.data()};
+
+			if(m.outputPair != NoOutputPair)
+			{
+				pair[0] = outputs[m.outputPair * 2];
+				pair[1] = outputs[m.outputPair * 2 + 1];
+			}
+
+			m.audio.append(pair, _samples);
+
+			// a member that has not been processed since the previous call, such as a bypassed instance, keeps the
+			// most recent block only. Otherwise it would play late from now on
+			const auto blockSize = std::max(_samples, m.blockSize);
+
+			if(m.audio.size() > blockSize)
+				m.audio.remove(m.audio.size() - blockSize);
+		}
+
+		// channel messages go to the owner of the channel, everything else goes to all members
+		for (const auto& ev : m_midiOut)
+		{
+			const auto isChannelMessage = ev.sysex.empty() && ev.a < 0xf0;
+
+			for (auto& it : m_members)
+			{
+				auto& m = it.second;
+
+				if(isChannelMessage && (ev.a & 0x0f) != m.part)
+					continue;
+
+				if(m.midiOut.size() < g_maxBufferedMidiEvents)
+					m.midiOut.push_back(ev);
+			}
+		}
+	}
+
+	FarmDevice::FarmDevice(const DeviceCreateParams& _params, const std::string& _farmId, const uint8_t _part, const DeviceFarm::DeviceFactory& _factory)
+		: Device(_params)
+		, m_part(_part & 0x0f)
+		, m_farm(DeviceFarm::get(_farmId, _factory))
+	{
+		m_farm->attach(*this);
+	}
+
+	FarmDevice::~FarmDevice()
+	{
+		m_farm->detach(*this);
+	}
+
+	float FarmDevice::getSamplerate() const
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().getSamplerate();
+	}
+
+	bool FarmDevice::setSamplerate(const float _samplerate)
+	{
+		return m_farm->setSamplerate(_samplerate);
+	}
+
+	void FarmDevice::getSupportedSamplerates(std::vector<float>& _dst) const
+	{
+		m_farm->getSupportedSamplerates(_dst);
+	}
+
+	void FarmDevice::getPreferredSamplerates(std::vector<float>& _dst) const
+	{
+		m_farm->getPreferredSamplerates(_dst);
+	}
+
+	uint32_t FarmDevice::getInternalLatencyMidiToOutput() const
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().getInternalLatencyMidiToOutput() + getAdditionalLatency();
+	}
+
+	uint32_t FarmDevice::getInternalLatencyInputToOutput() const
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().getInternalLatencyInputToOutput() + getAdditionalLatency();
+	}
+
+	uint32_t FarmDevice::getAdditionalLatency() const
+	{
+		// if another member requested a higher extra latency, our audio is delayed by the difference
+		const auto shared = m_farm->getSharedExtraLatencySamples();
+		const auto own = getExtraLatencySamples();
+		return shared > own ? shared - own : 0;
+	}
+
+	bool FarmDevice::isValid() const
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().isValid();
+	}
+
+#if SYNTHLIB_DEMO_MODE == 0
+	bool FarmDevice::getState(std::vector<uint8_t>& _state, const StateType _type)
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().getState(_state, _type);
+	}
+
+	bool FarmDevice::setState(const std::vector<uint8_t>& _state, const StateType _type)
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+
+		// joining a farm must not replace the state of the parts of all other members
+		if(m_farm->getMemberCount() > 1)
+			return false;
+
+		if(!m_farm->getDevice().setState(_state, _type))
+			return false;
+
+		m_farm->onStateChanged();
+		return true;
+	}
+#endif
+
+	uint32_t FarmDevice::getChannelCountIn()
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().getChannelCountIn();
+	}
+
+	uint32_t FarmDevice::getChannelCountOut()
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().getChannelCountOut();
+	}
+
+	bool FarmDevice::setDspClockPercent(const uint32_t _percent)
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().setDspClockPercent(_percent);
+	}
+
+	uint32_t FarmDevice::getDspClockPercent() const
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().getDspClockPercent();
+	}
+
+	uint64_t FarmDevice::getDspClockHz() const
+	{
+		std::scoped_lock lock(m_farm->getMutex());
+		return m_farm->getDevice().getDspClockHz();
+	}
+
+	void FarmDevice::readMidiOut(std::vector<SMidiEvent>& _midiOut)
+	{
+		m_farm->readMidiOut(*this, _midiOut);
+	}
+
+	void FarmDevice::processAudio(const TAudioInputs&, const TAudioOutputs& _outputs, const size_t _samples)
+	{
+		m_farm->processAudio(*this, _outputs, _samples);
+	}
+
+	bool FarmDevice::sendMidi(const SMidiEvent& _ev, std::vector<SMidiEvent>&)
+	{
+		auto ev = _ev;
+
+		// move channel messages to the channel of our part
+		if(ev.sysex.empty() && ev.a < 0xf0)
+			ev.a = static_cast<uint8_t>((ev.a & 0xf0) | m_part);
+
+		m_farm->addMidiEvent(*this, ev);
+		return true;
+	}
+}
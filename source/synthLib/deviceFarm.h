@@ -0,0 +1,143 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "audiobuffer.h"
+#include "device.h"
+
+namespace synthLib
+{
+	class FarmDevice;
+
+	// One emulated device that is shared by several plugin instances of the same process. Each instance attaches via a
+	// FarmDevice that owns one part of the multitimbral device. The device is processed by whichever instance needs
+	// audio first, all other instances read the audio that has been produced for them in the meantime. A multitimbral
+	// arrangement therefore costs one emulation instead of one per part.
+	// Every member needs a stereo output pair of its own that the device routes its part to. A member that does not get
+	// one, because all pairs are taken or the device cannot route parts, receives silence
+	class DeviceFarm
+	{
+	public:
+		using DeviceFactory = std::function<Device*()>;
+
+		explicit DeviceFarm(Device* _device);
+		~DeviceFarm();
+
+		DeviceFarm(const DeviceFarm&) = delete;
+		DeviceFarm(DeviceFarm&&) = delete;
+		DeviceFarm& operator = (const DeviceFarm&) = delete;
+		DeviceFarm& operator = (DeviceFarm&&) = delete;
+
+		// returns the farm with the given id. If it does not exist yet, _factory is called to create its device
+		static std::shared_ptr<DeviceFarm> get(const std::string& _id, const DeviceFactory& _factory);
+
+		Device& getDevice() { return *m_device; }
+
+		void attach(const FarmDevice& _member);
+		void detach(const FarmDevice& _member);
+
+		// Needs to be called while holding the lock
+		size_t getMemberCount() const { return m_members.size(); }
+
+		// a new state may have changed the output routing of the device, it is applied again. Needs to be called while holding the lock
+		void onStateChanged();
+
+		// the device is shared, the samplerate can only be changed while there is one member. All other members
+		// have to resample to the samplerate of the device
+		bool setSamplerate(float _samplerate);
+		void getSupportedSamplerates(std::vector<float>& _dst);
+		void getPreferredSamplerates(std::vector<float>& _dst);
+
+		// the device runs with the highest extra latency that any member requested. Needs to be called while holding the lock
+		uint32_t getSharedExtraLatencySamples() const;
+
+		void addMidiEvent(const FarmDevice& _member, const SMidiEvent& _ev);
+		void readMidiOut(const FarmDevice& _member, std::vector<SMidiEvent>& _midiOut);
+		void processAudio(const FarmDevice& _member, const TAudioOutputs& _outputs, size_t _samples);
+
+		// the device is shared, all calls need to be made while holding this lock
+		std::mutex& getMutex() { return m_mutex; }
+
+	private:
+		static constexpr uint32_t NoOutputPair = 0xffffffff;
+
+		struct Member
+		{
+			uint8_t part = 0;
+			uint32_t outputPair = NoOutputPair;
+			size_t blockSize = 0;
+			AudioBuffer audio;
+			std::vector<SMidiEvent> midiOut;
+		};
+
+		void assignOutputPair(Member& _member);
+		bool isOutputPairUsed(uint32_t _pair) const;
+
+		void produce(size_t _samples);
+
+		std::unique_ptr<Device> m_device;
+
+		std::mutex m_mutex;
+		std::map<const FarmDevice*, Member> m_members;
+
+		std::vector<SMidiEvent> m_midiIn;
+		std::vector<SMidiEvent> m_midiOut;
+
+		AudioBuffer m_outputs;
+		std::vector<float> m_silence;
+	};
+
+	// Device that represents one part of a shared DeviceFarm device. Channel messages are moved to the MIDI channel
+	// of the part, audio is taken from the output pair that the part is routed to. Audio inputs are not supported
+	class FarmDevice : public Device
+	{
+	public:
+		FarmDevice(const DeviceCreateParams& _params, const std::string& _farmId, uint8_t _part, const DeviceFarm::DeviceFactory& _factory);
+		~FarmDevice() override;
+
+		FarmDevice(const FarmDevice&) = delete;
+		FarmDevice(FarmDevice&&) = delete;
+		FarmDevice& operator = (const FarmDevice&) = delete;
+		FarmDevice& operator = (FarmDevice&&) = delete;
+
+		uint8_t getPart() const { return m_part; }
+
+		float getSamplerate() const override;
+		bool setSamplerate(float _samplerate) override;
+		void getSupportedSamplerates(std::vector<float>& _dst) const override;
+		void getPreferredSamplerates(std::vector<float>& _dst) const override;
+
+		uint32_t getInternalLatencyMidiToOutput() const override;
+		uint32_t getInternalLatencyInputToOutput() const override;
+
+		bool isValid() const override;
+
+#if SYNTHLIB_DEMO_MODE == 0
+		bool getState(std::vector<uint8_t>& _state, StateType _type) override;
+		bool setState(const std::vector<uint8_t>& _state, StateType _type) override;
+#endif
+
+		uint32_t getChannelCountIn() override;
+		uint32_t getChannelCountOut() override;
+
+		bool setDspClockPercent(uint32_t _percent) override;
+		uint32_t getDspClockPercent() const override;
+		uint64_t getDspClockHz() const override;
+
+	protected:
+		void readMidiOut(std::vector<SMidiEvent>& _midiOut) override;
+		void processAudio(const TAudioInputs& _inputs, const TAudioOutputs& _outputs, size_t _samples) override;
+		bool sendMidi(const SMidiEvent& _ev, std::vector<SMidiEvent>& _response) override;
+
+	private:
+		uint32_t getAdditionalLatency() const;
+
+		const uint8_t m_part;
+		std::shared_ptr<DeviceFarm> m_farm;
+	};
+}
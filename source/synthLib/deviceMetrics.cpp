@@ -0,0 +1,157 @@
+#include "deviceMetrics.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace synthLib
+{
+	namespace
+	{
+		uint32_t getBucket(uint64_t _value)
+		{
+			uint32_t bucket = 0;
+			while(_value)
+			{
+				++bucket;
+				_value >>= 1;
+			}
+			return std::min(bucket, MetricHistogram::BucketCount - 1);
+		}
+
+		constexpr const char* g_names[] =
+		{
+			"Block time",
+			"Resampler",
+			"Host wait for DSP",
+			"DSP wait for host",
+			"DSP wait for UC",
+			"UC wait for DSP",
+			"UC quantum",
+			"Audio output fill",
+		};
+
+		static_assert(std::size(g_names) == static_cast<size_t>(MetricType::Count));
+	}
+
+	uint64_t MetricHistogram::Snapshot::getPercentile(const double _percentile) const
+	{
+		if(!count)
+			return 0;
+
+		const auto target = static_cast<uint64_t>(static_cast<double>(count) * std::clamp(_percentile, 0.0, 1.0));
+
+		uint64_t acc = 0;
+
+		for(uint32_t i=0; i<BucketCount; ++i)
+		{
+			acc += buckets[i];
+			if(acc >= target && buckets[i])
+				return std::min<uint64_t>(i ? (1ull << i) - 1 : 0ull, max);
+		}
+		return max;
+	}
+
+	void MetricHistogram::add(const uint64_t _value)
+	{
+		m_count.fetch_add(1, std::memory_order_relaxed);
+		m_sum.fetch_add(_value, std::memory_order_relaxed);
+		m_buckets[getBucket(_value)].fetch_add(1, std::memory_order_relaxed);
+
+		auto max = m_max.load(std::memory_order_relaxed);
+		while(_value > max && !m_max.compare_exchange_weak(max, _value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void MetricHistogram::reset()
+	{
+		m_count = 0;
+		m_sum = 0;
+		m_max = 0;
+		for (auto& bucket : m_buckets)
+			bucket = 0;
+	}
+
+	MetricHistogram::Snapshot MetricHistogram::getSnapshot() const
+	{
+		Snapshot s;
+		s.count = m_count.load(std::memory_order_relaxed);
+		s.sum = m_sum.load(std::memory_order_relaxed);
+		s.max = m_max.load(std::memory_order_relaxed);
+		for(size_t i=0; i<BucketCount; ++i)
+			s.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+		return s;
+	}
+
+	double MetricsSnapshot::getRealtimeLoad() const
+	{
+		if(!processedSamples || samplerate <= 0.0f)
+			return 0.0;
+
+		const auto audioNs = static_cast<double>(processedSamples) * 1e9 / static_cast<double>(samplerate);
+		return static_cast<double>(get(MetricType::BlockTime).sum) / audioNs;
+	}
+
+	std::string MetricsSnapshot::toString() const
+	{
+		std::stringstream ss;
+
+		ss << std::fixed << std::setprecision(1);
+		ss << "Realtime load " << (getRealtimeLoad() * 100.0) << "%, " << processedSamples << " samples processed" << std::endl;
+
+		for(size_t i=0; i<metrics.size(); ++i)
+		{
+			const auto type = static_cast<MetricType>(i);
+			const auto& m = metrics[i];
+
+			if(!m.count)
+				continue;
+
+			ss << DeviceMetrics::getName(type) << ": ";
+
+			if(DeviceMetrics::isTime(type))
+			{
+				ss << "avg " << (m.getAverage() / 1000.0) << " us, p99 <= " << (static_cast<double>(m.getPercentile(0.99)) / 1000.0) << " us, max " << (static_cast<double>(m.max) / 1000.0) << " us, total " << (static_cast<double>(m.sum) / 1e6) << " ms";
+			}
+			else
+			{
+				ss << "avg " << m.getAverage() << ", p99 <= " << m.getPercentile(0.99) << ", max " << m.max;
+			}
+
+			ss << ", " << m.count << " samples" << std::endl;
+		}
+
+		return ss.str();
+	}
+
+	MetricsSnapshot DeviceMetrics::getSnapshot() const
+	{
+		MetricsSnapshot s;
+		for(size_t i=0; i<m_metrics.size(); ++i)
+			s.metrics[i] = m_metrics[i].getSnapshot();
+		s.processedSamples = m_processedSamples.load(std::memory_order_relaxed);
+		s.samplerate = m_samplerate.load(std::memory_order_relaxed);
+		return s;
+	}
+
+	void DeviceMetrics::reset()
+	{
+		for (auto& m : m_metrics)
+			m.reset();
+		m_processedSamples = 0;
+	}
+
+	const char* DeviceMetrics::getName(const MetricType _type)
+	{
+		if(_type >= MetricType::Count)
+			return "invalid";
+		return g_names[static_cast<size_t>(_type)];
+	}
+
+	bool DeviceMetrics::isTime(const MetricType _type)
+	{
+		return _type != MetricType::AudioOutputFill;
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace synthLib
+{
+	enum class MetricType : uint8_t
+	{
+		BlockTime,			// ns, time spent in Device::process per block
+		Resampler,			// ns, time spent in Plugin::process per block excluding the device
+		HostWaitForDsp,		// ns, audio thread waiting for the DSP to produce enough output
+		DspWaitForHost,		// ns, DSP thread idle because it is ahead of the audio thread
+		DspWaitForUc,		// ns, DSP thread halted to let the microcontroller catch up
+		UcWaitForDsp,		// ns, microcontroller thread waiting for the DSP to advance
+		UcQuantum,			// ns, microcontroller thread executing one time slice of instructions
+		AudioOutputFill,	// frames in the DSP audio output ring after a block has been read
+
+		Count
+	};
+
+	// Lock-free histogram with power of two buckets. Safe to be written from one thread and read from any other thread
+	class MetricHistogram
+	{
+	public:
+		static constexpr uint32_t BucketCount = 48;
+
+		struct Snapshot
+		{
+			uint64_t count = 0;
+			uint64_t sum = 0;
+			uint64_t max = 0;
+			std::array<uint64_t, BucketCount> buckets{};
+
+			double getAverage() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+
+			// upper bound of the bucket that contains the given percentile (0..1)
+			uint64_t getPercentile(double _percentile) const;
+		};
+
+		void add(uint64_t _value);
+		void reset();
+
+		Snapshot getSnapshot() const;
+
+	private:
+		std::atomic<uint64_t> m_count{0};
+		std::atomic<uint64_t> m_sum{0};
+		std::atomic<uint64_t> m_max{0};
+		std::array<std::atomic<uint32_t>, BucketCount> m_buckets{};
+	};
+
+	struct MetricsSnapshot
+	{
+		std::array<MetricHistogram::Snapshot, static_cast<size_t>(MetricType::Count)> metrics;
+		uint64_t processedSamples = 0;
+		float samplerate = 0.0f;
+
+		const MetricHistogram::Snapshot& get(const MetricType _type) const { return metrics[static_cast<size_t>(_type)]; }
+
+		// ratio of the time spent in Device::process to the duration of the processed audio, 1.0 = realtime limit reached
+		double getRealtimeLoad() const;
+
+		std::string toString() const;
+	};
+
+	// Timing and buffer statistics of one device instance. Recording is cheap enough to stay enabled in release builds
+	class DeviceMetrics
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		void setEnabled(const bool _enabled) { m_enabled = _enabled; }
+		bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+		void add(const MetricType _type, const uint64_t _value)
+		{
+			if(isEnabled())
+				m_metrics[static_cast<size_t>(_type)].add(_value);
+		}
+
+		void addProcessedSamples(const uint64_t _count, const float _samplerate)
+		{
+			m_processedSamples.fetch_add(_count, std::memory_order_relaxed);
+			m_samplerate.store(_samplerate, std::memory_order_relaxed);
+		}
+
+		MetricsSnapshot getSnapshot() const;
+		void reset();
+
+		static const char* getName(MetricType _type);
+		static bool isTime(MetricType _type);
+
+	private:
+		std::array<MetricHistogram, static_cast<size_t>(MetricType::Count)> m_metrics;
+		std::atomic<uint64_t> m_processedSamples{0};
+		std::atomic<float> m_samplerate{0.0f};
+		std::atomic<bool> m_enabled{true};
+	};
+
+	// Adds the time spent in its scope to a metric. Does nothing if no metrics object is given or metrics are disabled
+	class ScopedMetricTimer
+	{
+	public:
+		ScopedMetricTimer(DeviceMetrics* _metrics, const MetricType _type)
+			: m_metrics(_metrics && _metrics->isEnabled() ? _metrics : nullptr)
+			, m_type(_type)
+			, m_start(m_metrics ? DeviceMetrics::Clock::now() : DeviceMetrics::Clock::time_point())
+		{
+		}
+
+		ScopedMetricTimer(DeviceMetrics& _metrics, const MetricType _type) : ScopedMetricTimer(&_metrics, _type)
+		{
+		}
+
+		~ScopedMetricTimer()
+		{
+			if(m_metrics)
+				m_metrics->add(m_type, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(DeviceMetrics::Clock::now() - m_start).count()));
+		}
+
+		ScopedMetricTimer(const ScopedMetricTimer&) = delete;
+		ScopedMetricTimer(ScopedMetricTimer&&) = delete;
+		ScopedMetricTimer& operator = (const ScopedMetricTimer&) = delete;
+		ScopedMetricTimer& operator = (ScopedMetricTimer&&) = delete;
+
+	private:
+		DeviceMetrics* const m_metrics;
+		const MetricType m_type;
+		const DeviceMetrics::Clock::time_point m_start;
+	};
+}
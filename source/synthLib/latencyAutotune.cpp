@@ -0,0 +1,88 @@
+#include "latencyAutotune.h"
+
+#include <algorithm>
+
+namespace synthLib
+{
+	namespace
+	{
+		constexpr double g_warmupSeconds = 2.0;		// JIT compilation after device creation makes the first blocks slow
+
+		constexpr double g_raiseLoad = 0.8;			// a block that needs more than this of its deadline is a near miss
+		constexpr double g_raiseHoldSeconds = 1.0;	// time to refill the pipeline after raising before raising again
+
+		constexpr double g_lowerLoad = 0.5;			// max load during the observation period to be allowed to lower
+		constexpr double g_lowerDelayMin = 30.0;
+		constexpr double g_lowerDelayMax = 600.0;
+	}
+
+	void LatencyAutotune::setRange(const uint32_t _min, const uint32_t _max)
+	{
+		m_min = _min;
+		m_max = std::max(_min, _max);
+
+		reset(std::clamp(m_latencyBlocks, m_min, m_max));
+	}
+
+	void LatencyAutotune::reset(const uint32_t _latencyBlocks)
+	{
+		m_latencyBlocks = std::clamp(_latencyBlocks, m_min, m_max);
+
+		m_warmup = g_warmupSeconds;
+		m_sinceChange = 0.0;
+		m_maxLoad = 0.0;
+		m_lowerDelay = g_lowerDelayMin;
+		m_lastChangeWasLower = false;
+	}
+
+	bool LatencyAutotune::process(const Clock::duration _processTime, const double _blockSeconds)
+	{
+		if(_blockSeconds <= 0.0)
+			return false;
+
+		if(m_warmup > 0.0)
+		{
+			m_warmup -= _blockSeconds;
+			return false;
+		}
+
+		const auto load = std::chrono::duration<double>(_processTime).count() / _blockSeconds;
+
+		m_sinceChange += _blockSeconds;
+		m_maxLoad = std::max(m_maxLoad, load);
+
+		if(load >= g_raiseLoad)
+		{
+			if(m_latencyBlocks >= m_max || m_sinceChange < g_raiseHoldSeconds)
+				return false;
+
+			// lowering was too optimistic, wait longer until trying again
+			if(m_lastChangeWasLower && m_sinceChange < m_lowerDelay)
+				m_lowerDelay = std::min(m_lowerDelay * 2.0, g_lowerDelayMax);
+
+			++m_latencyBlocks;
+
+			m_sinceChange = 0.0;
+			m_maxLoad = 0.0;
+			m_lastChangeWasLower = false;
+			return true;
+		}
+
+		if(m_latencyBlocks <= m_min || m_sinceChange < m_lowerDelay)
+			return false;
+
+		const auto canLower = m_maxLoad < g_lowerLoad;
+
+		// either way, start a new observation period
+		m_sinceChange = 0.0;
+		m_maxLoad = 0.0;
+		m_lastChangeWasLower = false;
+
+		if(!canLower)
+			return false;
+
+		--m_latencyBlocks;
+		m_lastChangeWasLower = true;
+		return true;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace synthLib
+{
+	// Adjusts the number of extra latency blocks at runtime. The time that is needed to process a host block is compared
+	// to the duration of that block, which is the deadline of the host. If processing comes close to the deadline, a
+	// dropout is about to happen and the latency is raised by one block to give the DSP more headroom. If all blocks
+	// have been processed well within their deadline for a long time, the latency is lowered by one block.
+	// If a lowered latency has to be raised again soon after, the time until the next attempt to lower it is doubled
+	class LatencyAutotune
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		void setRange(uint32_t _min, uint32_t _max);
+		uint32_t getMin() const { return m_min; }
+		uint32_t getMax() const { return m_max; }
+
+		// restarts measuring. The first blocks after a reset are ignored as the device might still be warming up
+		void reset(uint32_t _latencyBlocks);
+		void reset() { reset(m_latencyBlocks); }
+
+		// returns true if the latency has been changed
+		bool process(Clock::duration _processTime, double _blockSeconds);
+
+		uint32_t getLatencyBlocks() const { return m_latencyBlocks; }
+
+	private:
+		uint32_t m_min = 0;
+		uint32_t m_max = 8;
+		uint32_t m_latencyBlocks = 0;
+
+		double m_warmup = 0.0;			// seconds of audio that are ignored
+		double m_sinceChange = 0.0;		// seconds of audio since the last change or the start of the current observation
+		double m_maxLoad = 0.0;			// highest ratio of processing time to block duration since then
+		double m_lowerDelay = 0.0;
+		bool m_lastChangeWasLower = false;
+	};
+}
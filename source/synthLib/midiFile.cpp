@@ -0,0 +1,284 @@
+#include "midiFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>	// memcmp
+
+#include "midiBufferParser.h"
+
+#include "baseLib/filesystem.h"
+
+#include "dsp56kEmu/logging.h"
+
+namespace synthLib
+{
+	namespace
+	{
+		uint32_t readBE32(const uint8_t* _data)
+		{
+			return static_cast<uint32_t>(_data[0]) << 24 | static_cast<uint32_t>(_data[1]) << 16 | static_cast<uint32_t>(_data[2]) << 8 | _data[3];
+		}
+
+		uint16_t readBE16(const uint8_t* _data)
+		{
+			return static_cast<uint16_t>(_data[0] << 8 | _data[1]);
+		}
+	}
+
+	bool MidiFile::loadFromFile(const std::string& _filename)
+	{
+		std::vector<uint8_t> data;
+		if(!baseLib::filesystem::readFile(data, _filename))
+		{
+			LOG("Failed to read midi file " << _filename);
+			return false;
+		}
+		return loadFromData(data);
+	}
+
+	bool MidiFile::loadFromData(const std::vector<uint8_t>& _data)
+	{
+		m_tickEvents.clear();
+		m_tempoChanges.clear();
+		m_events.clear();
+		m_lastTick = 0;
+		m_duration = 0.0;
+
+		if(_data.size() < 14 || memcmp(_data.data(), "MThd", 4) != 0)
+			return false;
+
+		const auto headerLen = readBE32(&_data[4]);
+
+		if(headerLen < 6 || 8 + headerLen > _data.size())
+			return false;
+
+		const auto numTracks = readBE16(&_data[10]);
+		m_division = readBE16(&_data[12]);
+
+		if(!m_division)
+			return false;
+
+		size_t pos = 8 + headerLen;
+		uint32_t order = 0;
+
+		uint32_t tracksRead = 0;
+
+		while(tracksRead < numTracks && pos + 8 <= _data.size())
+		{
+			const auto chunkLen = readBE32(&_data[pos + 4]);
+
+			if(pos + 8 + chunkLen > _data.size())
+			{
+				LOG("Midi file track " << tracksRead << " is truncated, expected " << chunkLen << " bytes");
+				break;
+			}
+
+			// skip unknown chunks as required by the spec
+			if(memcmp(&_data[pos], "MTrk", 4) == 0)
+			{
+				parseTrack(&_data[pos + 8], chunkLen, order);
+				++tracksRead;
+			}
+
+			pos += 8 + chunkLen;
+		}
+
+		std::sort(m_tempoChanges.begin(), m_tempoChanges.end(), [](const TempoChange& _a, const TempoChange& _b)
+		{
+			return _a.tick < _b.tick;
+		});
+
+		// merge all tracks, events at the same tick keep their file order
+		std::sort(m_tickEvents.begin(), m_tickEvents.end(), [](const TickEvent& _a, const TickEvent& _b)
+		{
+			if(_a.tick != _b.tick)
+				return _a.tick < _b.tick;
+			return _a.order < _b.order;
+		});
+
+		m_events.reserve(m_tickEvents.size());
+
+		for (auto& e : m_tickEvents)
+		{
+			auto& ev = m_events.emplace_back();
+			ev.seconds = ticksToSeconds(e.tick);
+			ev.event = std::move(e.event);
+		}
+
+		m_tickEvents.clear();
+
+		m_duration = ticksToSeconds(m_lastTick);
+
+		return true;
+	}
+
+	uint64_t MidiFile::toSamplePosition(const double _seconds, const float _samplerate)
+	{
+		return static_cast<uint64_t>(std::floor(_seconds * static_cast<double>(_samplerate) + 0.5));
+	}
+
+	bool MidiFile::parseTrack(const uint8_t* _data, const size_t _size, uint32_t& _order)
+	{
+		size_t pos = 0;
+		uint64_t tick = 0;
+		uint8_t runningStatus = 0;
+
+		while(pos < _size)
+		{
+			uint32_t delta;
+			if(!readVarLen(delta, _data, _size, pos))
+				return false;
+
+			tick += delta;
+
+			if(pos >= _size)
+				return false;
+
+			uint8_t status = _data[pos];
+
+			if(status < 0x80)
+			{
+				// running status, the byte we just peeked is the first data byte
+				if(!runningStatus)
+					return false;
+				status = runningStatus;
+			}
+			else
+			{
+				++pos;
+			}
+
+			if(status == 0xff)
+			{
+				// meta event
+				if(pos >= _size)
+					return false;
+
+				const auto type = _data[pos++];
+
+				uint32_t len;
+				if(!readVarLen(len, _data, _size, pos) || pos + len > _size)
+					return false;
+
+				if(type == 0x51 && len == 3)
+				{
+					auto& t = m_tempoChanges.emplace_back();
+					t.tick = tick;
+					t.microsecondsPerQuarter = static_cast<uint32_t>(_data[pos]) << 16 | static_cast<uint32_t>(_data[pos+1]) << 8 | _data[pos+2];
+				}
+
+				pos += len;
+
+				if(type == 0x2f)
+				{
+					// the delta time of end of track extends the duration of the file
+					m_lastTick = std::max(m_lastTick, tick);
+					break;
+				}
+
+				continue;
+			}
+
+			if(status == M_STARTOFSYSEX || status == M_ENDOFSYSEX)
+			{
+				uint32_t len;
+				if(!readVarLen(len, _data, _size, pos) || pos + len > _size)
+					return false;
+
+				// F7 is used as escape to transmit arbitrary bytes or to continue a sysex packet, we only support
+				// complete sysex messages that are stored in a single F0 event
+				if(status == M_STARTOFSYSEX)
+				{
+					auto& e = m_tickEvents.emplace_back();
+					e.tick = tick;
+					e.order = _order++;
+					e.event.source = MidiEventSource::Host;
+					e.event.sysex.reserve(len + 1);
+					e.event.sysex.push_back(M_STARTOFSYSEX);
+					e.event.sysex.insert(e.event.sysex.end(), _data + pos, _data + pos + len);
+
+					if(e.event.sysex.back() != M_ENDOFSYSEX)
+						e.event.sysex.push_back(M_ENDOFSYSEX);
+				}
+
+				pos += len;
+				m_lastTick = std::max(m_lastTick, tick);
+				continue;
+			}
+
+			if(status >= 0xf0)
+			{
+				// system common/realtime messages are not allowed in midi files
+				return false;
+			}
+
+			runningStatus = status;
+
+			const auto len = MidiBufferParser::lengthFromStatusByte(status);
+
+			if(pos + len - 1 > _size)
+				return false;
+
+			auto& e = m_tickEvents.emplace_back();
+			e.tick = tick;
+			e.order = _order++;
+			e.event.source = MidiEventSource::Host;
+			e.event.a = status;
+			e.event.b = len > 1 ? _data[pos] : 0;
+			e.event.c = len > 2 ? _data[pos+1] : 0;
+
+			pos += len - 1;
+
+			m_lastTick = std::max(m_lastTick, tick);
+		}
+		return true;
+	}
+
+	double MidiFile::ticksToSeconds(const uint64_t _tick) const
+	{
+		if(m_division & 0x8000)
+		{
+			// SMPTE timing, upper byte is the negative frame rate, lower byte the ticks per frame
+			const auto fps = static_cast<double>(-static_cast<int8_t>(m_division >> 8));
+			const auto ticksPerFrame = static_cast<double>(m_division & 0xff);
+			return static_cast<double>(_tick) / (fps * ticksPerFrame);
+		}
+
+		const auto ticksPerQuarter = static_cast<double>(m_division);
+
+		double seconds = 0.0;
+		uint64_t lastTick = 0;
+		uint32_t tempo = 500000;
+
+		for (const auto& t : m_tempoChanges)
+		{
+			if(t.tick >= _tick)
+				break;
+
+			seconds += static_cast<double>(t.tick - lastTick) * tempo / (ticksPerQuarter * 1000000.0);
+			lastTick = t.tick;
+			tempo = t.microsecondsPerQuarter;
+		}
+
+		return seconds + static_cast<double>(_tick - lastTick) * tempo / (ticksPerQuarter * 1000000.0);
+	}
+
+	bool MidiFile::readVarLen(uint32_t& _result, const uint8_t* _data, const size_t _size, size_t& _pos)
+	{
+		_result = 0;
+
+		for(uint32_t i=0; i<4; ++i)
+		{
+			if(_pos >= _size)
+				return false;
+
+			const auto b = _data[_pos++];
+
+			_result = (_result << 7) | (b & 0x7f);
+
+			if(!(b & 0x80))
+				return true;
+		}
+		return false;
+	}
+}
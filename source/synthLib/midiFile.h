@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "midiTypes.h"
+
+namespace synthLib
+{
+	// Reads a standard midi file (format 0 or 1) and converts all channel and sysex events of all tracks
+	// into one list of events sorted by time, with the tempo map already applied
+	class MidiFile
+	{
+	public:
+		struct Event
+		{
+			double seconds = 0.0;
+			SMidiEvent event;
+		};
+
+		bool loadFromFile(const std::string& _filename);
+		bool loadFromData(const std::vector<uint8_t>& _data);
+
+		const std::vector<Event>& getEvents() const { return m_events; }
+		double getDuration() const { return m_duration; }
+
+		bool empty() const { return m_events.empty(); }
+
+		static uint64_t toSamplePosition(double _seconds, float _samplerate);
+
+	private:
+		struct TickEvent
+		{
+			uint64_t tick = 0;
+			uint32_t order = 0;
+			SMidiEvent event;
+		};
+
+		struct TempoChange
+		{
+			uint64_t tick = 0;
+			uint32_t microsecondsPerQuarter = 500000;
+		};
+
+		bool parseTrack(const uint8_t* _data, size_t _size, uint32_t& _order);
+		double ticksToSeconds(uint64_t _tick) const;
+
+		static bool readVarLen(uint32_t& _result, const uint8_t* _data, size_t _size, size_t& _pos);
+
+		uint16_t m_division = 96;
+
+		std::vector<TickEvent> m_tickEvents;
+		std::vector<TempoChange> m_tempoChanges;
+		uint64_t m_lastTick = 0;
+
+		std::vector<Event> m_events;
+		double m_duration = 0.0;
+	};
+}
@@ -0,0 +1,118 @@
+#include "offlineRenderer.h"
+
+#include <algorithm>
+
+#include "device.h"
+#include "midiFile.h"
+
+namespace synthLib
+{
+	OfflineRenderer::OfflineRenderer(Device& _device, const float _samplerate, const uint32_t _blockSize)
+		: m_device(_device)
+		, m_plugin(&_device, [](Device* _d) { return _d; })
+		, m_samplerate(_samplerate > 0.0f ? _samplerate : _device.getSamplerate())
+		, m_blockSize(std::max(_blockSize, 1u))
+	{
+		// no extra latency needed, we are never in a hurry
+		m_plugin.setLatencyBlocks(0);
+		m_plugin.setHostSamplerate(m_samplerate, m_samplerate);
+		m_plugin.setBlockSize(m_blockSize);
+
+		m_outputs.resize(std::min(static_cast<size_t>(m_device.getChannelCountOut()), m_outputPointers.size()));
+
+		for(size_t i=0; i<m_outputs.size(); ++i)
+		{
+			m_outputs[i].resize(m_blockSize, 0.0f);
+			m_outputPointers[i] = m_outputs[i].data();
+		}
+	}
+
+	OfflineRenderer::~OfflineRenderer() = default;
+
+	void OfflineRenderer::addEvent(const uint64_t _samplePos, const SMidiEvent& _event)
+	{
+		if(!m_events.empty() && m_events.back().samplePos > _samplePos)
+			m_eventsSorted = false;
+
+		m_events.push_back({std::max(_samplePos, m_position), _event});
+	}
+
+	void OfflineRenderer::addEvents(const MidiFile& _midiFile, const uint64_t _offset)
+	{
+		m_events.reserve(m_events.size() + _midiFile.getEvents().size());
+
+		for (const auto& e : _midiFile.getEvents())
+			addEvent(_offset + MidiFile::toSamplePosition(e.seconds, m_samplerate), e.event);
+	}
+
+#if !SYNTHLIB_DEMO_MODE
+	bool OfflineRenderer::setState(const std::vector<uint8_t>& _state) const
+	{
+		return m_plugin.setState(_state);
+	}
+#endif
+
+	void OfflineRenderer::render(uint64_t _sampleCount, const BlockCallback& _callback)
+	{
+		while(_sampleCount > 0)
+		{
+			const auto size = static_cast<uint32_t>(std::min(_sampleCount, static_cast<uint64_t>(m_blockSize)));
+
+			processBlock(size);
+
+			if(_callback)
+				_callback(m_outputs, size);
+
+			_sampleCount -= size;
+		}
+	}
+
+	void OfflineRenderer::skip(const uint64_t _sampleCount)
+	{
+		render(_sampleCount, {});
+	}
+
+	uint64_t OfflineRenderer::getLastEventPosition() const
+	{
+		uint64_t pos = 0;
+		for (const auto& e : m_events)
+			pos = std::max(pos, e.samplePos);
+		return pos;
+	}
+
+	void OfflineRenderer::processBlock(const uint32_t _size)
+	{
+		if(!m_eventsSorted)
+		{
+			std::stable_sort(m_events.begin() + static_cast<ptrdiff_t>(m_nextEvent), m_events.end(), [](const ScheduledEvent& _a, const ScheduledEvent& _b)
+			{
+				return _a.samplePos < _b.samplePos;
+			});
+			m_eventsSorted = true;
+		}
+
+		const auto blockEnd = m_position + _size;
+
+		while(m_nextEvent < m_events.size() && m_events[m_nextEvent].samplePos < blockEnd)
+		{
+			auto& e = m_events[m_nextEvent++];
+			e.event.offset = static_cast<uint32_t>(e.samplePos - m_position);
+			m_plugin.addMidiEvent(e.event);
+		}
+
+		if(m_nextEvent == m_events.size())
+		{
+			m_events.clear();
+			m_nextEvent = 0;
+		}
+
+		const TAudioInputs inputs{};
+
+		m_plugin.process(inputs, m_outputPointers, _size, 0.0f, 0.0f, false);
+
+		m_midiOut.clear();
+		m_plugin.getMidiOut(m_midiOut);
+
+		m_position = blockEnd;
+	}
+}
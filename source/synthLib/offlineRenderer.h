@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "audioTypes.h"
+#include "midiTypes.h"
+#include "plugin.h"
+
+namespace synthLib
+{
+	class Device;
+	class MidiFile;
+
+	// Drives a device as fast as the emulation allows, without any realtime constraints. Midi events are
+	// scheduled at absolute sample positions and are delivered sample accurate within the rendered blocks
+	class OfflineRenderer
+	{
+	public:
+		using TChannels = std::vector<std::vector<float>>;
+		using BlockCallback = std::function<void(const TChannels&, uint32_t)>;
+
+		OfflineRenderer(Device& _device, float _samplerate, uint32_t _blockSize = 64);
+		~OfflineRenderer();
+
+		OfflineRenderer(const OfflineRenderer&) = delete;
+		OfflineRenderer(OfflineRenderer&&) = delete;
+		OfflineRenderer& operator = (const OfflineRenderer&) = delete;
+		OfflineRenderer& operator = (OfflineRenderer&&) = delete;
+
+		void addEvent(uint64_t _samplePos, const SMidiEvent& _event);
+		void addEvents(const MidiFile& _midiFile, uint64_t _offset = 0);
+
+#if !SYNTHLIB_DEMO_MODE
+		bool setState(const std::vector<uint8_t>& _state) const;
+#endif
+		void render(uint64_t _sampleCount, const BlockCallback& _callback);
+		void skip(uint64_t _sampleCount);
+
+		uint64_t getPosition() const { return m_position; }
+		uint64_t getLastEventPosition() const;
+
+		uint32_t getChannelCount() const { return static_cast<uint32_t>(m_outputs.size()); }
+		float getSamplerate() const { return m_samplerate; }
+		uint32_t getBlockSize() const { return m_blockSize; }
+
+		Plugin& getPlugin() { return m_plugin; }
+
+	private:
+		struct ScheduledEvent
+		{
+			uint64_t samplePos;
+			SMidiEvent event;
+		};
+
+		void processBlock(uint32_t _size);
+
+		Device& m_device;
+		Plugin m_plugin;
+
+		const float m_samplerate;
+		const uint32_t m_blockSize;
+
+		std::vector<ScheduledEvent> m_events;
+		size_t m_nextEvent = 0;
+		bool m_eventsSorted = true;
+
+		TChannels m_outputs;
+		TAudioOutputs m_outputPointers{};
+		std::vector<SMidiEvent> m_midiOut;
+
+		uint64_t m_position = 0;
+	};
+}
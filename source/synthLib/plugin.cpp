@@ -1,6 +1,7 @@
 #include "plugin.h"
 #include "device.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "os.h"
@@ -91,12 +92,34 @@ namespace synthLib
 		processMidiInEvents();
 		processMidiClock(_bpm, _ppqPos, _isPlaying, _count);
 
+		auto& metrics = m_device->getMetrics();
+		const auto measure = metrics.isEnabled() || m_latencyAutotuneEnabled;
+		const auto timeStart = measure ? DeviceMetrics::Clock::now() : DeviceMetrics::Clock::time_point();
+		DeviceMetrics::Clock::duration deviceTime{};
+
 		m_resampler.process(inputs, outputs, m_midiIn, m_midiOut, static_cast<uint32_t>(_count), 
 			[&](const TAudioInputs& _ins, const TAudioOutputs& _outs, size_t _c, const ResamplerInOut::TMidiVec& _midiIn, ResamplerInOut::TMidiVec& _midiOut)
 		{
+			const auto t = measure ? DeviceMetrics::Clock::now() : DeviceMetrics::Clock::time_point();
 			m_device->process(_ins, _outs, _c, _midiIn, _midiOut);
+			if(measure)
+				deviceTime += DeviceMetrics::Clock::now() - t;
 		});
 
+		if(measure)
+		{
+			const auto processTime = DeviceMetrics::Clock::now() - timeStart;
+
+			// whatever has not been spent in the device is resampling and midi/audio buffering overhead
+			metrics.add(MetricType::Resampler, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(processTime - deviceTime).count()));
+
+			if(m_latencyAutotuneEnabled && m_latencyAutotune.process(processTime, static_cast<double>(_count) * m_hostSamplerateInv))
+			{
+				updateDeviceLatency();
+				m_latencyChanged = true;
+			}
+		}
+
 		m_midiIn.clear();
 	}
 
@@ -132,6 +155,8 @@ namespace synthLib
 		// MIDI clock has to send the start event again, some device find it confusing and do strange things if there isn't any
 		m_midiClock.restart();
 
+		m_latencyAutotune.reset();
+
 		updateDeviceLatency();
 	}
 
@@ -199,10 +224,32 @@ namespace synthLib
 			return false;
 
 		m_extraLatencyBlocks = _latencyBlocks;
+		m_latencyAutotune.setRange(_latencyBlocks, std::max(_latencyBlocks, m_latencyAutotune.getMax()));
 		updateDeviceLatency();
 		return true;
 	}
 
+	void Plugin::setLatencyAutotune(const bool _enabled, const uint32_t _maxBlocks)
+	{
+		std::lock_guard lock(m_lock);
+
+		if(_enabled == m_latencyAutotuneEnabled && _maxBlocks == m_latencyAutotune.getMax())
+			return;
+
+		m_latencyAutotuneEnabled = _enabled;
+
+		m_latencyAutotune.setRange(m_extraLatencyBlocks, _maxBlocks);
+		m_latencyAutotune.reset(m_extraLatencyBlocks);
+
+		updateDeviceLatency();
+	}
+
+	uint32_t Plugin::getEffectiveLatencyBlocks() const
+	{
+		std::lock_guard lock(m_lock);
+		return m_latencyAutotuneEnabled ? m_latencyAutotune.getLatencyBlocks() : m_extraLatencyBlocks;
+	}
+
 	void Plugin::processMidiClock(const float _bpm, const float _ppqPos, const bool _isPlaying, const size_t _sampleCount)
 	{
 		m_midiClock.process(_bpm, _ppqPos, _isPlaying, _sampleCount);
@@ -221,7 +268,7 @@ namespace synthLib
 		if(m_blockSize <= 0 || m_hostSamplerate <= 0)
 			return;
 
-		const auto latency = static_cast<uint32_t>(std::ceil(static_cast<float>(m_blockSize * m_extraLatencyBlocks) * m_device->getSamplerate() * m_hostSamplerateInv));
+		const auto latency = static_cast<uint32_t>(std::ceil(static_cast<float>(m_blockSize * getEffectiveLatencyBlocks()) * m_device->getSamplerate() * m_hostSamplerateInv));
 		m_device->setExtraLatencySamples(latency);
 
 		m_deviceLatencyMidiToOutput = static_cast<uint32_t>(static_cast<float>(m_device->getInternalLatencyMidiToOutput()) * m_hostSamplerate / m_device->getSamplerate());
@@ -285,12 +332,12 @@ namespace synthLib
 	uint32_t Plugin::getLatencyMidiToOutput() const
 	{
 		std::lock_guard lock(m_lock);
-		return m_blockSize * m_extraLatencyBlocks + m_deviceLatencyMidiToOutput + m_resampler.getOutputLatency();
+		return m_blockSize * getEffectiveLatencyBlocks() + m_deviceLatencyMidiToOutput + m_resampler.getOutputLatency();
 	}
 
 	uint32_t Plugin::getLatencyInputToOutput() const
 	{
 		std::lock_guard lock(m_lock);
-		return m_blockSize * m_extraLatencyBlocks + m_deviceLatencyInputToOutput + m_resampler.getOutputLatency() + m_resampler.getInputLatency();
+		return m_blockSize * getEffectiveLatencyBlocks() + m_deviceLatencyInputToOutput + m_resampler.getOutputLatency() + m_resampler.getInputLatency();
 	}
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <functional>
 
@@ -10,6 +11,7 @@
 #include "dsp56kEmu/ringbuffer.h"
 
 #include "deviceTypes.h"
+#include "latencyAutotune.h"
 #include "midiClock.h"
 
 namespace synthLib
@@ -52,6 +54,17 @@ namespace synthLib
 		bool setLatencyBlocks(uint32_t _latencyBlocks);
 		uint32_t getLatencyBlocks() const { return m_extraLatencyBlocks; }
 
+		// If enabled, the latency blocks set via setLatencyBlocks() are the minimum and the latency is raised up to
+		// _maxBlocks if processing comes close to the deadline of the host
+		void setLatencyAutotune(bool _enabled, uint32_t _maxBlocks = 8);
+		bool getLatencyAutotune() const { return m_latencyAutotuneEnabled; }
+
+		// latency blocks that are currently in use, differs from getLatencyBlocks() if autotune is enabled
+		uint32_t getEffectiveLatencyBlocks() const;
+
+		// returns true once after the latency has been changed by autotune, the host needs to be informed
+		bool pollLatencyChanged() { return m_latencyChanged.exchange(false); }
+
 	private:
 		void processMidiClock(float _bpm, float _ppqPos, bool _isPlaying, size_t _sampleCount);
 		float* getDummyBuffer(size_t _minimumSize);
@@ -85,6 +98,10 @@ namespace synthLib
 
 		uint32_t m_extraLatencyBlocks = 1;
 
+		LatencyAutotune m_latencyAutotune;
+		bool m_latencyAutotuneEnabled = false;
+		std::atomic<bool> m_latencyChanged{false};
+
 		float m_deviceSamplerate = 0.0f;
 		CallbackDeviceInvalid m_callbackDeviceInvalid;
 	};
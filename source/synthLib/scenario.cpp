@@ -0,0 +1,148 @@
+#include "scenario.h"
+
+#include <algorithm>
+
+#include "midiFile.h"
+
+#include "baseLib/binarystream.h"
+#include "baseLib/filesystem.h"
+
+namespace synthLib
+{
+	namespace
+	{
+		constexpr char g_chunkScenario[] = "Scen";
+		constexpr uint32_t g_chunkScenarioVersion = 1;
+	}
+
+	Scenario::Phase& Scenario::addPhase(const std::string& _name, const double _seconds)
+	{
+		auto& phase = m_phases.emplace_back();
+		phase.name = _name;
+		phase.seconds = std::max(0.0, _seconds);
+		return phase;
+	}
+
+	void Scenario::addEvent(const double _seconds, const SMidiEvent& _event)
+	{
+		auto& phase = getCurrentPhase();
+		const auto t = std::max(0.0, _seconds);
+		phase.events.push_back({t, _event});
+		phase.seconds = std::max(phase.seconds, t);
+	}
+
+	void Scenario::addAction(const double _seconds, const Action& _action)
+	{
+		auto& phase = getCurrentPhase();
+		const auto t = std::max(0.0, _seconds);
+		phase.actions.push_back({t, _action});
+		phase.seconds = std::max(phase.seconds, t);
+	}
+
+	Scenario::Phase& Scenario::addMidiFile(const std::string& _name, const MidiFile& _midiFile, const double _tailSeconds)
+	{
+		auto& phase = addPhase(_name, _midiFile.getDuration() + _tailSeconds);
+
+		phase.events.reserve(_midiFile.getEvents().size());
+
+		for (const auto& e : _midiFile.getEvents())
+			phase.events.push_back({e.seconds, e.event});
+
+		return phase;
+	}
+
+	double Scenario::getDuration() const
+	{
+		double duration = 0.0;
+		for (const auto& phase : m_phases)
+			duration += phase.seconds;
+		return duration;
+	}
+
+	bool Scenario::saveTrace(std::vector<uint8_t>& _data) const
+	{
+		baseLib::BinaryStream s;
+		{
+			baseLib::ChunkWriter cw(s, g_chunkScenario, g_chunkScenarioVersion);
+
+			s.write(static_cast<uint32_t>(m_phases.size()));
+
+			for (const auto& phase : m_phases)
+			{
+				s.write(phase.name);
+				s.write(phase.seconds);
+				s.write(static_cast<uint32_t>(phase.events.size()));
+
+				for (const auto& e : phase.events)
+				{
+					s.write(e.seconds);
+					s.write(e.event.a);
+					s.write(e.event.b);
+					s.write(e.event.c);
+					s.write(e.event.sysex);
+				}
+			}
+		}
+		s.toVector(_data);
+		return true;
+	}
+
+	bool Scenario::saveTrace(const std::string& _filename) const
+	{
+		std::vector<uint8_t> data;
+		return saveTrace(data) && baseLib::filesystem::writeFile(_filename, data);
+	}
+
+	bool Scenario::loadTrace(const std::vector<uint8_t>& _data)
+	{
+		try
+		{
+			baseLib::BinaryStream stream(_data);
+
+			auto s = stream.tryReadChunk(g_chunkScenario, g_chunkScenarioVersion);
+
+			if(!s)
+				return false;
+
+			std::vector<Phase> phases;
+			phases.resize(s.read<uint32_t>());
+
+			for (auto& phase : phases)
+			{
+				phase.name = s.readString();
+				phase.seconds = s.read<double>();
+				phase.events.resize(s.read<uint32_t>());
+
+				for (auto& e : phase.events)
+				{
+					e.seconds = s.read<double>();
+					e.event.source = MidiEventSource::Host;
+					e.event.a = s.read<uint8_t>();
+					e.event.b = s.read<uint8_t>();
+					e.event.c = s.read<uint8_t>();
+					s.read(e.event.sysex);
+				}
+			}
+
+			m_phases = std::move(phases);
+			return true;
+		}
+		catch(std::range_error&)
+		{
+			return false;
+		}
+	}
+
+	bool Scenario::loadTrace(const std::string& _filename)
+	{
+		std::vector<uint8_t> data;
+		return baseLib::filesystem::readFile(data, _filename) && loadTrace(data);
+	}
+
+	Scenario::Phase& Scenario::getCurrentPhase()
+	{
+		if(m_phases.empty())
+			return addPhase("main", 0.0);
+		return m_phases.back();
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "midiTypes.h"
+
+namespace synthLib
+{
+	class Device;
+	class MidiFile;
+
+	// A reproducible sequence of phases that is played against a device, for example "boot", "load bank", "demo song".
+	// All times are relative to the start of a phase and are converted to sample positions by the runner, so the
+	// result does not depend on the speed of the host.
+	// Midi events can be saved to and loaded from trace files, actions are code and therefore not part of a trace
+	class Scenario
+	{
+	public:
+		using Action = std::function<void(Device&)>;
+
+		struct Event
+		{
+			double seconds = 0.0;
+			SMidiEvent event;
+		};
+
+		struct TimedAction
+		{
+			double seconds = 0.0;
+			Action action;
+		};
+
+		struct Phase
+		{
+			std::string name;
+			double seconds = 0.0;
+			std::vector<Event> events;
+			std::vector<TimedAction> actions;
+		};
+
+		// adds a new phase, following events and actions are added to it
+		Phase& addPhase(const std::string& _name, double _seconds);
+
+		void addEvent(double _seconds, const SMidiEvent& _event);
+		void addAction(double _seconds, const Action& _action);
+
+		// adds a phase containing all events of the midi file, the phase is extended by _tailSeconds
+		Phase& addMidiFile(const std::string& _name, const MidiFile& _midiFile, double _tailSeconds = 2.0);
+
+		const std::vector<Phase>& getPhases() const { return m_phases; }
+		bool empty() const { return m_phases.empty(); }
+		double getDuration() const;
+
+		bool saveTrace(std::vector<uint8_t>& _data) const;
+		bool saveTrace(const std::string& _filename) const;
+		bool loadTrace(const std::vector<uint8_t>& _data);
+		bool loadTrace(const std::string& _filename);
+
+	private:
+		Phase& getCurrentPhase();
+
+		std::vector<Phase> m_phases;
+	};
+}
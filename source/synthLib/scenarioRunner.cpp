@@ -0,0 +1,277 @@
+#include "scenarioRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>	// memcpy
+
+#include "device.h"
+#include "midiFile.h"
+#include "scenario.h"
+
+#include "baseLib/binarystream.h"
+#include "baseLib/filesystem.h"
+
+namespace synthLib
+{
+	namespace
+	{
+		constexpr char g_chunkResult[] = "ScRe";
+		constexpr uint32_t g_chunkResultVersion = 1;
+
+		// FNV-1a, processed per 32 bit word. Not cryptographic, but stable across platforms and fast enough to not show up in profiles
+		constexpr uint64_t g_hashInit = 0xcbf29ce484222325ull;
+		constexpr uint64_t g_hashPrime = 0x100000001b3ull;
+
+		uint64_t hashWord(const uint64_t _hash, const uint32_t _word)
+		{
+			return (_hash ^ _word) * g_hashPrime;
+		}
+
+		uint32_t toWord(const float _f)
+		{
+			uint32_t w;
+			memcpy(&w, &_f, sizeof(w));
+			return w;
+		}
+	}
+
+	ScenarioResult::Divergence ScenarioResult::compare(const ScenarioResult& _reference) const
+	{
+		Divergence d;
+
+		auto diverge = [&](const size_t _phase, const uint64_t _pos, std::string _reason)
+		{
+			d.diverged = true;
+			d.phase = _phase;
+			d.samplePos = _pos;
+			d.reason = std::move(_reason);
+			return d;
+		};
+
+		if(samplerate != _reference.samplerate)
+			return diverge(0, 0, "samplerate differs, " + std::to_string(samplerate) + " vs reference " + std::to_string(_reference.samplerate));
+		if(channelCount != _reference.channelCount)
+			return diverge(0, 0, "channel count differs, " + std::to_string(channelCount) + " vs reference " + std::to_string(_reference.channelCount));
+		if(hashBlockSize != _reference.hashBlockSize)
+			return diverge(0, 0, "hash block size differs, " + std::to_string(hashBlockSize) + " vs reference " + std::to_string(_reference.hashBlockSize));
+
+		const auto phaseCount = std::min(phases.size(), _reference.phases.size());
+
+		for(size_t p=0; p<phaseCount; ++p)
+		{
+			const auto& a = phases[p];
+			const auto& b = _reference.phases[p];
+
+			if(a.hash == b.hash && a.sampleCount == b.sampleCount)
+				continue;
+
+			const auto blockCount = std::min(a.blockHashes.size(), b.blockHashes.size());
+
+			for(size_t i=0; i<blockCount; ++i)
+			{
+				if(a.blockHashes[i] != b.blockHashes[i])
+					return diverge(p, i * hashBlockSize, "audio differs in phase '" + a.name + "'");
+			}
+
+			return diverge(p, std::min(a.sampleCount, b.sampleCount), "length of phase '" + a.name + "' differs, " + std::to_string(a.sampleCount) + " vs reference " + std::to_string(b.sampleCount) + " samples");
+		}
+
+		if(phases.size() != _reference.phases.size())
+			return diverge(phaseCount, 0, "phase count differs, " + std::to_string(phases.size()) + " vs reference " + std::to_string(_reference.phases.size()));
+
+		return d;
+	}
+
+	uint64_t ScenarioResult::getSampleCount() const
+	{
+		uint64_t count = 0;
+		for (const auto& phase : phases)
+			count += phase.sampleCount;
+		return count;
+	}
+
+	uint64_t ScenarioResult::getPhaseStart(const size_t _phase) const
+	{
+		uint64_t pos = 0;
+		for(size_t i=0; i<_phase && i<phases.size(); ++i)
+			pos += phases[i].sampleCount;
+		return pos;
+	}
+
+	double ScenarioResult::getRenderSeconds() const
+	{
+		double seconds = 0.0;
+		for (const auto& phase : phases)
+			seconds += phase.renderSeconds;
+		return seconds;
+	}
+
+	bool ScenarioResult::save(const std::string& _filename) const
+	{
+		baseLib::BinaryStream s;
+		{
+			baseLib::ChunkWriter cw(s, g_chunkResult, g_chunkResultVersion);
+
+			s.write(samplerate);
+			s.write(channelCount);
+			s.write(hashBlockSize);
+			s.write(static_cast<uint32_t>(phases.size()));
+
+			for (const auto& phase : phases)
+			{
+				s.write(phase.name);
+				s.write(phase.sampleCount);
+				s.write(phase.renderSeconds);
+				s.write(phase.hash);
+				s.write(phase.blockHashes);
+			}
+		}
+
+		std::vector<uint8_t> data;
+		s.toVector(data);
+		return baseLib::filesystem::writeFile(_filename, data);
+	}
+
+	bool ScenarioResult::load(const std::string& _filename)
+	{
+		std::vector<uint8_t> data;
+
+		if(!baseLib::filesystem::readFile(data, _filename))
+			return false;
+
+		try
+		{
+			baseLib::BinaryStream stream(data);
+
+			auto s = stream.tryReadChunk(g_chunkResult, g_chunkResultVersion);
+
+			if(!s)
+				return false;
+
+			ScenarioResult r;
+
+			r.samplerate = s.read<float>();
+			r.channelCount = s.read<uint32_t>();
+			r.hashBlockSize = s.read<uint32_t>();
+			r.phases.resize(s.read<uint32_t>());
+
+			for (auto& phase : r.phases)
+			{
+				phase.name = s.readString();
+				phase.sampleCount = s.read<uint64_t>();
+				phase.renderSeconds = s.read<double>();
+				phase.hash = s.read<uint64_t>();
+				s.read(phase.blockHashes);
+			}
+
+			*this = std::move(r);
+			return true;
+		}
+		catch(std::range_error&)
+		{
+			return false;
+		}
+	}
+
+	ScenarioRunner::ScenarioRunner(Device& _device, const float _samplerate, const uint32_t _blockSize, const uint32_t _hashBlockSize)
+		: m_device(_device)
+		, m_renderer(_device, _samplerate, _blockSize)
+		, m_hashBlockSize(std::max(_hashBlockSize, 1u))
+	{
+	}
+
+	ScenarioResult ScenarioRunner::run(const Scenario& _scenario, const OfflineRenderer::BlockCallback& _callback)
+	{
+		ScenarioResult result;
+
+		result.samplerate = m_renderer.getSamplerate();
+		result.channelCount = m_renderer.getChannelCount();
+		result.hashBlockSize = m_hashBlockSize;
+
+		const auto channelCount = result.channelCount;
+
+		auto toSamples = [&](const double _seconds)
+		{
+			return MidiFile::toSamplePosition(_seconds, result.samplerate);
+		};
+
+		for (const auto& phase : _scenario.getPhases())
+		{
+			auto& phaseResult = result.phases.emplace_back();
+			phaseResult.name = phase.name;
+			phaseResult.hash = g_hashInit;
+
+			const auto phaseStart = m_renderer.getPosition();
+			const auto phaseLength = toSamples(phase.seconds);
+
+			for (const auto& e : phase.events)
+				m_renderer.addEvent(phaseStart + toSamples(e.seconds), e.event);
+
+			std::vector<const Scenario::TimedAction*> actions;
+			actions.reserve(phase.actions.size());
+			for (const auto& a : phase.actions)
+				actions.push_back(&a);
+
+			std::stable_sort(actions.begin(), actions.end(), [](const Scenario::TimedAction* _a, const Scenario::TimedAction* _b)
+			{
+				return _a->seconds < _b->seconds;
+			});
+
+			uint64_t blockHash = g_hashInit;
+			uint32_t blockFill = 0;
+
+			auto onBlock = [&](const OfflineRenderer::TChannels& _channels, const uint32_t _size)
+			{
+				for(uint32_t i=0; i<_size; ++i)
+				{
+					for(uint32_t c=0; c<channelCount; ++c)
+					{
+						const auto w = toWord(_channels[c][i]);
+						blockHash = hashWord(blockHash, w);
+						phaseResult.hash = hashWord(phaseResult.hash, w);
+					}
+
+					if(++blockFill == m_hashBlockSize)
+					{
+						phaseResult.blockHashes.push_back(blockHash);
+						blockHash = g_hashInit;
+						blockFill = 0;
+					}
+				}
+
+				if(_callback)
+					_callback(_channels, _size);
+			};
+
+			const auto timeStart = std::chrono::steady_clock::now();
+
+			uint64_t rendered = 0;
+
+			// actions split the rendering at their sample position, which is part of the scenario and therefore deterministic, too
+			for (const auto* a : actions)
+			{
+				const auto pos = std::min(toSamples(a->seconds), phaseLength);
+
+				if(pos > rendered)
+				{
+					m_renderer.render(pos - rendered, onBlock);
+					rendered = pos;
+				}
+
+				a->action(m_device);
+			}
+
+			if(phaseLength > rendered)
+				m_renderer.render(phaseLength - rendered, onBlock);
+
+			phaseResult.renderSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - timeStart).count();
+
+			if(blockFill)
+				phaseResult.blockHashes.push_back(blockHash);
+
+			phaseResult.sampleCount = phaseLength;
+		}
+
+		return result;
+	}
+}
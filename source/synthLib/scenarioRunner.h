@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "offlineRenderer.h"
+
+namespace synthLib
+{
+	class Scenario;
+
+	struct ScenarioPhaseResult
+	{
+		std::string name;
+		uint64_t sampleCount = 0;
+		double renderSeconds = 0.0;		// measured only, has no influence on the rendered audio
+
+		uint64_t hash = 0;
+		std::vector<uint64_t> blockHashes;	// one hash per ScenarioResult::hashBlockSize samples
+	};
+
+	struct ScenarioResult
+	{
+		float samplerate = 0.0f;
+		uint32_t channelCount = 0;
+		uint32_t hashBlockSize = 0;
+
+		std::vector<ScenarioPhaseResult> phases;
+
+		struct Divergence
+		{
+			bool diverged = false;
+			size_t phase = 0;
+			uint64_t samplePos = 0;		// first hash block that differs, relative to the phase start
+			std::string reason;
+		};
+
+		// compares the audio hashes against a reference result that has been created by another build
+		Divergence compare(const ScenarioResult& _reference) const;
+
+		uint64_t getSampleCount() const;
+
+		// position of the first sample of a phase, relative to the start of the scenario
+		uint64_t getPhaseStart(size_t _phase) const;
+		double getRenderSeconds() const;
+
+		bool save(const std::string& _filename) const;
+		bool load(const std::string& _filename);
+	};
+
+	// Plays a scenario against a device via the OfflineRenderer. The audio of each phase is hashed so that the
+	// output of different builds can be compared without keeping the audio around
+	class ScenarioRunner
+	{
+	public:
+		static constexpr uint32_t DefaultHashBlockSize = 4096;
+
+		ScenarioRunner(Device& _device, float _samplerate = 0.0f, uint32_t _blockSize = 64, uint32_t _hashBlockSize = DefaultHashBlockSize);
+
+		// the callback receives the audio of all phases, for example to write it to disk
+		ScenarioResult run(const Scenario& _scenario, const OfflineRenderer::BlockCallback& _callback = {});
+
+		OfflineRenderer& getRenderer() { return m_renderer; }
+
+	private:
+		Device& m_device;
+		OfflineRenderer m_renderer;
+		const uint32_t m_hashBlockSize;
+	};
+}
@@ -0,0 +1,353 @@
+#include "threadPlacement.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+#include "dsp56kEmu/logging.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace synthLib
+{
+	namespace
+	{
+		using CpuList = ThreadPlacement::CpuList;
+
+		struct Topology
+		{
+			std::vector<CpuList> nodes;
+			std::vector<CpuList> cores;		// SMT siblings per physical core
+			std::vector<uint32_t> coreNodes;
+		};
+
+		// parses lists such as "0-3,8,10-11"
+		CpuList parseCpuList(const std::string& _list)
+		{
+			CpuList res;
+
+			size_t pos = 0;
+
+			while(pos < _list.size())
+			{
+				auto end = _list.find(',', pos);
+				if(end == std::string::npos)
+					end = _list.size();
+
+				const auto range = _list.substr(pos, end - pos);
+				pos = end + 1;
+
+				if(range.empty() || !isdigit(static_cast<unsigned char>(range.front())))
+					continue;
+
+				const auto dash = range.find('-');
+
+				const auto first = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+				const auto last = dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+
+				for(auto i=first; i<=last; ++i)
+					res.push_back(i);
+			}
+
+			return res;
+		}
+
+		CpuList readCpuList(const std::string& _filename)
+		{
+			std::ifstream file(_filename);
+			if(!file.is_open())
+				return {};
+
+			std::string line;
+			std::getline(file, line);
+			return parseCpuList(line);
+		}
+
+		Topology readTopology()
+		{
+			Topology t;
+
+#ifdef __linux__
+			const std::string sysNode = "/sys/devices/system/node/";
+			const std::string sysCpu = "/sys/devices/system/cpu/";
+
+			for (const auto n : readCpuList(sysNode + "online"))
+			{
+				auto cpus = readCpuList(sysNode + "node" + std::to_string(n) + "/cpulist");
+				if(!cpus.empty())
+					t.nodes.push_back(std::move(cpus));
+			}
+
+			// kernels without NUMA support do not have the node folder
+			if(t.nodes.empty())
+			{
+				auto cpus = readCpuList(sysCpu + "online");
+				if(!cpus.empty())
+					t.nodes.push_back(std::move(cpus));
+			}
+
+			for(uint32_t n=0; n<t.nodes.size(); ++n)
+			{
+				const auto& nodeCpus = t.nodes[n];
+
+				CpuList assigned;
+
+				for (const auto cpu : nodeCpus)
+				{
+					if(std::find(assigned.begin(), assigned.end(), cpu) != assigned.end())
+						continue;
+
+					auto siblings = readCpuList(sysCpu + "cpu" + std::to_string(cpu) + "/topology/thread_siblings_list");
+
+					// only keep siblings that belong to the same node
+					siblings.erase(std::remove_if(siblings.begin(), siblings.end(), [&](const uint32_t _cpu)
+					{
+						return std::find(nodeCpus.begin(), nodeCpus.end(), _cpu) == nodeCpus.end();
+					}), siblings.end());
+
+					if(siblings.empty())
+						siblings.push_back(cpu);
+
+					assigned.insert(assigned.end(), siblings.begin(), siblings.end());
+
+					t.cores.push_back(std::move(siblings));
+					t.coreNodes.push_back(n);
+				}
+			}
+
+			LOG("Thread placement: found " << t.nodes.size() << " NUMA nodes with " << t.cores.size() << " physical cores");
+#endif
+			return t;
+		}
+
+		const Topology& getTopology()
+		{
+			static const Topology topology = readTopology();
+			return topology;
+		}
+	}
+
+	ThreadPlacement::ScopedSlot::ScopedSlot(const Slot& _slot)
+	{
+		if(!_slot.isValid())
+			return;
+
+		m_previousCpus = getCurrentThreadCpus();
+
+		if(!setCurrentThreadCpus(_slot.cpus))
+			m_previousCpus.clear();
+	}
+
+	ThreadPlacement::ScopedSlot::~ScopedSlot()
+	{
+		if(!m_previousCpus.empty())
+			setCurrentThreadCpus(m_previousCpus);
+	}
+
+	ThreadPlacement::ThreadPlacement(const Mode _mode, const uint32_t _coresPerDevice)
+		: m_mode(isSupported() ? _mode : Mode::Off)
+		, m_coresPerDevice(std::max(1u, _coresPerDevice))
+	{
+		if(_mode != Mode::Off && m_mode == Mode::Off)
+			LOG("Thread placement is not supported on this platform, ignoring mode " << toString(_mode));
+
+		if(m_mode == Mode::Off)
+			return;
+
+		const auto& t = getTopology();
+
+		m_nodeUseCount.resize(t.nodes.size(), 0);
+
+		for(size_t i=0; i<t.cores.size(); ++i)
+		{
+			Core c;
+			c.node = t.coreNodes[i];
+			c.cpus = t.cores[i];
+			m_cores.push_back(std::move(c));
+		}
+	}
+
+	ThreadPlacement::Slot ThreadPlacement::acquire()
+	{
+		if(m_mode == Mode::Off || m_nodeUseCount.empty())
+			return {};
+
+		std::scoped_lock lock(m_mutex);
+
+		const auto node = static_cast<uint32_t>(std::distance(m_nodeUseCount.begin(), std::min_element(m_nodeUseCount.begin(), m_nodeUseCount.end())));
+
+		Slot slot;
+		slot.node = static_cast<int32_t>(node);
+
+		if(m_mode == Mode::Node)
+		{
+			slot.cpus = getNodeCpus(node);
+		}
+		else
+		{
+			std::vector<uint32_t> candidates;
+
+			for(uint32_t i=0; i<m_cores.size(); ++i)
+			{
+				if(m_cores[i].node == node)
+					candidates.push_back(i);
+			}
+
+			// least used cores first, neighbouring cores are kept together if the use count is identical
+			std::stable_sort(candidates.begin(), candidates.end(), [&](const uint32_t _a, const uint32_t _b)
+			{
+				return m_cores[_a].useCount < m_cores[_b].useCount;
+			});
+
+			candidates.resize(std::min(static_cast<size_t>(m_coresPerDevice), candidates.size()));
+
+			for (const auto c : candidates)
+			{
+				auto& core = m_cores[c];
+				++core.useCount;
+				slot.cores.push_back(c);
+				slot.cpus.insert(slot.cpus.end(), core.cpus.begin(), core.cpus.end());
+			}
+
+			std::sort(slot.cpus.begin(), slot.cpus.end());
+		}
+
+		if(!slot.isValid())
+			return {};
+
+		++m_nodeUseCount[node];
+
+		return slot;
+	}
+
+	void ThreadPlacement::release(const Slot& _slot)
+	{
+		if(!_slot.isValid())
+			return;
+
+		std::scoped_lock lock(m_mutex);
+
+		auto& nodeUseCount = m_nodeUseCount[static_cast<uint32_t>(_slot.node)];
+
+		if(nodeUseCount > 0)
+			--nodeUseCount;
+
+		for (const auto c : _slot.cores)
+		{
+			if(m_cores[c].useCount > 0)
+				--m_cores[c].useCount;
+		}
+	}
+
+	ThreadPlacement::Mode ThreadPlacement::parseMode(const std::string& _mode)
+	{
+		if(_mode == "node")
+			return Mode::Node;
+		if(_mode == "cores")
+			return Mode::Cores;
+		return Mode::Off;
+	}
+
+	const char* ThreadPlacement::toString(const Mode _mode)
+	{
+		switch (_mode)
+		{
+		case Mode::Node:	return "node";
+		case Mode::Cores:	return "cores";
+		default:			return "off";
+		}
+	}
+
+	bool ThreadPlacement::isSupported()
+	{
+#ifdef __linux__
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	uint32_t ThreadPlacement::getNodeCount()
+	{
+		return static_cast<uint32_t>(getTopology().nodes.size());
+	}
+
+	const ThreadPlacement::CpuList& ThreadPlacement::getNodeCpus(const uint32_t _node)
+	{
+		static const CpuList empty;
+		const auto& nodes = getTopology().nodes;
+		return _node < nodes.size() ? nodes[_node] : empty;
+	}
+
+	int32_t ThreadPlacement::getCurrentThreadNode()
+	{
+		if(getNodeCount() <= 1)
+			return -1;
+
+		const auto cpus = getCurrentThreadCpus();
+
+		if(cpus.empty())
+			return -1;
+
+		const auto& nodes = getTopology().nodes;
+
+		for(size_t n=0; n<nodes.size(); ++n)
+		{
+			const auto& nodeCpus = nodes[n];
+
+			const auto inNode = std::all_of(cpus.begin(), cpus.end(), [&](const uint32_t _cpu)
+			{
+				return std::find(nodeCpus.begin(), nodeCpus.end(), _cpu) != nodeCpus.end();
+			});
+
+			if(inNode)
+				return static_cast<int32_t>(n);
+		}
+
+		return -1;
+	}
+
+	ThreadPlacement::CpuList ThreadPlacement::getCurrentThreadCpus()
+	{
+		CpuList res;
+#ifdef __linux__
+		cpu_set_t set;
+		CPU_ZERO(&set);
+
+		if(pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+			return res;
+
+		for(uint32_t i=0; i<CPU_SETSIZE; ++i)
+		{
+			if(CPU_ISSET(i, &set))
+				res.push_back(i);
+		}
+#endif
+		return res;
+	}
+
+	bool ThreadPlacement::setCurrentThreadCpus(const CpuList& _cpus)
+	{
+		if(_cpus.empty())
+			return false;
+#ifdef __linux__
+		cpu_set_t set;
+		CPU_ZERO(&set);
+
+		for (const auto cpu : _cpus)
+		{
+			if(cpu < CPU_SETSIZE)
+				CPU_SET(cpu, &set);
+		}
+
+		if(pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0)
+			return true;
+
+		LOG("Failed to set thread affinity");
+#endif
+		return false;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace synthLib
+{
+	// Keeps the threads of a device close together on machines with multiple NUMA nodes. A device is either limited to
+	// the CPUs of one node or to a group of physical cores of one node, including their SMT siblings.
+	// Threads inherit the affinity of the thread that creates them. Applying a slot to the thread that creates a device
+	// places all threads that are created by the device. Memory that is first touched by these threads, such as the
+	// DSP memory that is cleared when a device is created, is allocated on the same node.
+	// Only supported on Linux, all functions are no-ops on other platforms
+	class ThreadPlacement
+	{
+	public:
+		enum class Mode
+		{
+			Off,
+			Node,	// all CPUs of the least used node
+			Cores	// a group of physical cores of the least used node
+		};
+
+		using CpuList = std::vector<uint32_t>;
+
+		struct Slot
+		{
+			int32_t node = -1;
+			CpuList cpus;					// empty = thread placement is not used
+			std::vector<uint32_t> cores;	// indices of used physical cores in Cores mode
+
+			bool isValid() const { return !cpus.empty(); }
+		};
+
+		// applies a slot to the current thread and restores the previous affinity when going out of scope
+		class ScopedSlot
+		{
+		public:
+			explicit ScopedSlot(const Slot& _slot);
+			~ScopedSlot();
+
+			ScopedSlot(const ScopedSlot&) = delete;
+			ScopedSlot(ScopedSlot&&) = delete;
+			ScopedSlot& operator = (const ScopedSlot&) = delete;
+			ScopedSlot& operator = (ScopedSlot&&) = delete;
+
+		private:
+			CpuList m_previousCpus;
+		};
+
+		ThreadPlacement(Mode _mode = Mode::Off, uint32_t _coresPerDevice = 2);
+
+		Mode getMode() const { return m_mode; }
+
+		Slot acquire();
+		void release(const Slot& _slot);
+
+		static Mode parseMode(const std::string& _mode);
+		static const char* toString(Mode _mode);
+
+		static bool isSupported();
+
+		static uint32_t getNodeCount();
+		static const CpuList& getNodeCpus(uint32_t _node);
+
+		// returns the node that the current thread is limited to or -1 if it may run on CPUs of multiple nodes
+		static int32_t getCurrentThreadNode();
+
+		static CpuList getCurrentThreadCpus();
+		static bool setCurrentThreadCpus(const CpuList& _cpus);
+
+	private:
+		struct Core
+		{
+			uint32_t node = 0;
+			CpuList cpus;	// SMT siblings
+			uint32_t useCount = 0;
+		};
+
+		const Mode m_mode;
+		const uint32_t m_coresPerDevice;
+
+		std::mutex m_mutex;
+		std::vector<Core> m_cores;
+		std::vector<uint32_t> m_nodeUseCount;
+	};
+}
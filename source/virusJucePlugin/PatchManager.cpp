@@ -423,6 +423,17 @@ namespace genericVirusUI
 		return m_controller.activatePatch(applyModifications(_patch), _part);
 	}
 
+	bool PatchManager::createPreviewSysex(pluginLib::patchDB::DataList& _result, const pluginLib::patchDB::PatchPtr& _patch) const
+	{
+		auto msg = m_controller.modifySingleDump(applyModifications(_patch), virusLib::BankNumber::EditBuffer, virusLib::ProgramType::SINGLE);
+
+		if(msg.empty())
+			return false;
+
+		_result.emplace_back(std::move(msg));
+		return true;
+	}
+
 	void PatchManager::addRomPatches()
 	{
 		const auto& singles = m_controller.getSinglePresets();
@@ -31,6 +31,7 @@ namespace genericVirusUI
 
 		// PatchManager impl
 		bool activatePatch(const pluginLib::patchDB::PatchPtr& _patch, uint32_t _part) override;
+		bool createPreviewSysex(pluginLib::patchDB::DataList& _result, const pluginLib::patchDB::PatchPtr& _patch) const override;
 
 	private:
 		void addRomPatches();
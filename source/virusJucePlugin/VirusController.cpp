@@ -421,8 +421,6 @@ namespace virus
 
 			const uint8_t ch = patch.progNumber == virusLib::SINGLE ? 0 : patch.progNumber;
 
-            const auto locked = m_locking.getLockedParameterNames(ch);
-
 			// if there are locked parameters and the current values in the received preset do not match
 			// the values of the parameters that are locked, create a new preset that contains all
 			// locked parameter values and send it back to the device
@@ -433,7 +431,7 @@ namespace virus
 	            auto* p = getParameter(parameterValue.first.second, ch);
 
 				// if a parameter is not locked, apply it
-                if(locked.find(p->getDescription().name) == locked.end())
+                if(!m_locking.isParameterLocked(ch, parameterValue.first.second))
 					p->setValueFromSynth(parameterValue.second, pluginLib::Parameter::Origin::PresetChange);
 				// otherwise, remember the locked parameter if the locked value doesn't match the preset value
 				else if (parameterValue.second != p->getUnnormalizedValue())
@@ -691,7 +689,13 @@ namespace virus
     {
         const auto& desc = _parameter.getDescription();
 
-        sendParameterChange(desc.page, _parameter.getPart(), desc.index, static_cast<uint8_t>(_value));
+        sendParameterChangeSysEx(_parameter, midiPacketName(MidiPacketType::ParameterChange), static_cast<uint8_t>(_value), [&](pluginLib::MidiPacket::Data& _data)
+        {
+            _data.insert(std::make_pair(pluginLib::MidiDataType::Page, desc.page));
+            _data.insert(std::make_pair(pluginLib::MidiDataType::Part, _parameter.getPart()));
+            _data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, desc.index));
+            _data.insert(std::make_pair(pluginLib::MidiDataType::DeviceId, m_deviceId));
+        });
     }
 
     bool Controller::sendParameterChange(uint8_t _page, uint8_t _part, uint8_t _index, uint8_t _value) const
@@ -79,6 +79,7 @@ namespace virus
 
 		const auto latencyBlocks = getConfig().getIntValue("latencyBlocks", static_cast<int>(getPlugin().getLatencyBlocks()));
 		Processor::setLatencyBlocks(latencyBlocks);
+		Processor::setLatencyAutotune(getConfig().getBoolValue("latencyAutotune", false));
 
 		zynthianExportLv2Presets();
 	}
@@ -90,6 +91,16 @@ namespace virus
 		return new virusLib::Device(p, true);
 	}
 
+	pluginLib::Processor::DeviceFactory VirusProcessor::createDeviceFactory()
+	{
+		synthLib::DeviceCreateParams p;
+		getRemoteDeviceParams(p);
+		return [p]
+		{
+			return new virusLib::Device(p, true);
+		};
+	}
+
 	void VirusProcessor::getRemoteDeviceParams(synthLib::DeviceCreateParams& _params) const
 	{
 		pluginLib::Processor::getRemoteDeviceParams(_params);
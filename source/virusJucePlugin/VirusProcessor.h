@@ -58,6 +58,7 @@ namespace virus
 		//
 	private:
 	    synthLib::Device* createDevice() override;
+	    DeviceFactory createDeviceFactory() override;
 		void getRemoteDeviceParams(synthLib::DeviceCreateParams& _params) const override;
 
 	    pluginLib::Controller* createController() override;
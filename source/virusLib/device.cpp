@@ -1,14 +1,18 @@
 #include "device.h"
 
+#include "demoplaybackTI.h"
 #include "dspMultiTI.h"
 #include "dspSingleSnow.h"
 #include "romfile.h"
 
 #include "dsp56kEmu/jit.h"
 
+#include "baseLib/chunkScanner.h"
+
 #include "synthLib/deviceException.h"
 #include "synthLib/midiToSysex.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "dspMemoryPatches.h"
@@ -73,6 +77,7 @@ namespace virusLib
 	Device::~Device()
 	{
 		m_dsp->getAudio().setCallback(nullptr,0);
+		m_demo.reset();
 		m_mc.reset();
 		m_dsp.reset();
 	}
@@ -214,26 +219,7 @@ namespace virusLib
 
 	bool Device::find4CC(uint32_t& _offset, const std::vector<uint8_t>& _data, const std::string_view& _4cc)
 	{
-		if(_data.size() < (_offset + _4cc.size()))
-			return false;
-
-		for(uint32_t i=_offset; i<_data.size() - _4cc.size(); ++i)
-		{
-			bool valid = true;
-			for(size_t j=0; j<_4cc.size(); ++j)
-			{
-				if(static_cast<char>(_data[i + j]) == _4cc[j])
-					continue;
-				valid = false;
-				break;
-			}
-			if(valid)
-			{
-				_offset = i;
-				return true;
-			}
-		}
-		return false;
+		return baseLib::ChunkScanner(_data).find(_offset, _4cc);
 	}
 
 	bool Device::parseTIcontrolPreset(std::vector<synthLib::SMidiEvent>& _events, const std::vector<uint8_t>& _state)
@@ -241,37 +227,25 @@ namespace virusLib
 		if(_state.size() < 8)
 			return false;
 
+		const baseLib::ChunkScanner scanner(_state);
+
 		uint32_t readPos = 0;
 
 		uint32_t numFound = 0;
 
-		while(readPos < _state.size() - 4)
+		auto nextLen = [&readPos, &scanner]() -> uint32_t
 		{
-			if(!find4CC(readPos, _state, "MIDI"))
-				break;
+			uint32_t len = 0;
+			scanner.readBE32(len, readPos);
+			readPos += 4;
+			return len;
+		};
 
-			if(readPos >= _state.size())
+		while(readPos < _state.size() - 4)
+		{
+			if(!scanner.find(readPos, "MIDI"))
 				break;
 
-			auto readLen = [&_state](const size_t _offset) -> uint32_t
-			{
-				if(_offset + 4 > _state.size())
-					return 0;
-				const uint32_t o =
-					(static_cast<uint32_t>(_state[_offset+0]) << 24) | 
-					(static_cast<uint32_t>(_state[_offset+1]) << 16) |
-					(static_cast<uint32_t>(_state[_offset+2]) << 8) |
-					(static_cast<uint32_t>(_state[_offset+3]));
-				return o;
-			};
-
-			auto nextLen = [&readPos, &readLen]() -> uint32_t
-			{
-				const auto len = readLen(readPos);
-				readPos += 4;
-				return len;
-			};
-
 			const auto dataLen = nextLen();
 
 			if(dataLen + readPos > _state.size())
@@ -288,29 +262,29 @@ namespace virusLib
 				if(!midiDataLen)
 					break;
 
-				if((readPos + midiDataLen) > _state.size())
+				const auto midiData = scanner.span(readPos, midiDataLen);
+
+				if(midiData.empty())
 					break;
 
 				synthLib::SMidiEvent& e = _events.emplace_back();
 
-				e.sysex.assign(_state.begin() + readPos, _state.begin() + readPos + midiDataLen);
-
-				if(e.sysex.front() != 0xf0)
+				if(midiData[0] != 0xf0)
+				{
+					assert(midiData.size <= 3);
+					e.a = midiData[0];
+					if(midiData.size > 1)
+						e.b = midiData[1];
+					if(midiData.size > 2)
+						e.c = midiData[2];
+				}
+				else
 				{
-					assert(e.sysex.size() <= 3);
-					e.a = e.sysex[0];
-					if(e.sysex.size() > 1)
-						e.b = e.sysex[1];
-					if(e.sysex.size() > 2)
-						e.c = e.sysex[2];
-
-					e.sysex.clear();
+					e.sysex = midiData.toVector();
+					++numFound;
 				}
 
 				readPos += midiDataLen;
-
-				if(!e.sysex.empty())
-					++numFound;
 			}			
 		}
 
@@ -319,14 +293,23 @@ namespace virusLib
 
 	bool Device::parsePowercorePreset(std::vector<std::vector<uint8_t>>& _sysexPresets, const std::vector<uint8_t>& _data)
 	{
+		if(_data.size() < 4)
+			return false;
+
+		const baseLib::ChunkScanner scanner(_data);
+
 		uint32_t off = 0;
 
 		uint32_t numFound = 0;
 
+		constexpr uint32_t presetSize = 256;			// presets seem to be stored without sysex packaging
+		constexpr uint32_t padding = 5;					// five unknown bytes betweeen two presets
+		constexpr uint32_t headerSize = 9;
+
 		while(off < _data.size() - 4)
 		{
 			// VST2 fxp/fxb chunk must exist
-			if(!find4CC(off, _data, "CcnK"))
+			if(!scanner.find(off, "CcnK"))
 				break;
 
 			off += 4;
@@ -334,9 +317,9 @@ namespace virusLib
 			uint32_t pos;
 
 			// fxp or fxb?
-			if(find4CC(off, _data, "FPCh"))
+			if(scanner.find(off, "FPCh"))
 				pos = off + 0x34;					// fxp
-			else if(find4CC(off, _data, "FBCh"))
+			else if(scanner.find(off, "FBCh"))
 				pos = off + 0x98;					// fxb
 			else
 				continue;
@@ -346,8 +329,8 @@ namespace virusLib
 
 			++pos;	// skip first byte, version?
 
-			constexpr uint32_t presetSize = 256;			// presets seem to be stored without sysex packaging
-			constexpr uint32_t padding = 5;					// five unknown bytes betweeen two presets
+			// reserve for the maximum number of presets that can follow
+			_sysexPresets.reserve(_sysexPresets.size() + (_data.size() - pos + padding) / (presetSize + padding));
 
 			uint8_t programIndex = 0;
 
@@ -363,11 +346,15 @@ namespace virusLib
 				if(name.size() != 10)
 					break;
 
-				// pack into sysex
-				std::vector<uint8_t>& sysex = _sysexPresets.emplace_back(std::vector<uint8_t>{0xf0, 0x00, 0x20, 0x33, 0x01, OMNI_DEVICE_ID, 0x10, 0x01, programIndex});
-				sysex.insert(sysex.end(), _data.begin() + pos, _data.begin() + pos + presetSize);
-				sysex.push_back(Microcontroller::calcChecksum(sysex));
-				sysex.push_back(0xf7);
+				// pack into sysex, allocated once with its final size
+				auto& sysex = _sysexPresets.emplace_back(headerSize + presetSize + 2);
+
+				const uint8_t header[headerSize] = {0xf0, 0x00, 0x20, 0x33, 0x01, OMNI_DEVICE_ID, 0x10, 0x01, programIndex};
+				memcpy(sysex.data(), header, headerSize);
+				memcpy(sysex.data() + headerSize, &_data[pos], presetSize);
+
+				sysex[headerSize + presetSize] = Microcontroller::calcChecksum(sysex, 5, headerSize + presetSize);
+				sysex[headerSize + presetSize + 1] = 0xf7;
 
 				++numFound;
 
@@ -394,10 +381,16 @@ namespace virusLib
 		}
 
 		constexpr size_t presetSize = sizeof(Microcontroller::TPreset);
-		Microcontroller::TPreset preset;
+		constexpr size_t halfSize = presetSize >> 1;
+		constexpr size_t headerSize = 9;
+		constexpr size_t sysexSize = headerSize + halfSize + 1 + halfSize + 2;	// header, 256 preset bytes, 1st checksum, 256 preset bytes, 2nd checksum, EOX
 
 		constexpr uint32_t maxPresets = (4 + 26) * 128;	// 4x RAM banks, 26x ROM banks, 128 patches per bank
 
+		const auto presetCount = std::min(static_cast<size_t>(maxPresets), (_data.size() - 0x20) / presetSize);
+
+		_sysexPresets.reserve(_sysexPresets.size() + presetCount);
+
 		uint32_t presetIdx = 0;
 
 		// presets start at $20
@@ -405,27 +398,28 @@ namespace virusLib
 		// The sysex packaging is missing, i.e. the single dump header, the checksums and the sysex terminator
 		for(size_t i=0x20; i<_data.size() - presetSize; i += presetSize)
 		{
-			memcpy(preset.data(), &_data[i], presetSize);
-
-			const auto name = ROMFile::getSingleName(preset);
+			const auto* preset = &_data[i];
 
-			if(name.empty())
+			// same as ROMFile::getSingleName(), but without copying the preset
+			if(preset[240] < 32 || preset[240] > 127)
 				break;
 
-			auto& sysex = _sysexPresets.emplace_back(std::vector<uint8_t>{
+			auto& sysex = _sysexPresets.emplace_back(sysexSize);
+
+			const uint8_t header[headerSize] = {
 				0xf0, 0x00, 0x20, 0x33, 0x01, OMNI_DEVICE_ID, DUMP_SINGLE,
 				static_cast<uint8_t>((presetIdx >> 7) & 0x7f),
-				static_cast<uint8_t>(presetIdx & 0x7f)});
+				static_cast<uint8_t>(presetIdx & 0x7f)};
 
-			sysex.reserve(9 + 256 + 1 + 256 + 2);	// header, 256 preset bytes, 1st checksum, 256 preset bytes, 2nd checksum, EOX
+			constexpr size_t checksumA = headerSize + halfSize;
+			constexpr size_t checksumB = checksumA + 1 + halfSize;
 
-			for(size_t j=0; j<256; ++j)
-				sysex.push_back(preset[j]);
-			sysex.push_back(Microcontroller::calcChecksum(sysex));
-			for(size_t j=256; j<512; ++j)
-				sysex.push_back(preset[j]);
-			sysex.push_back(Microcontroller::calcChecksum(sysex));
-			sysex.push_back(0xf7);
+			memcpy(&sysex[0], header, headerSize);
+			memcpy(&sysex[headerSize], preset, halfSize);
+			sysex[checksumA] = Microcontroller::calcChecksum(sysex, 5, checksumA);
+			memcpy(&sysex[checksumA + 1], preset + halfSize, halfSize);
+			sysex[checksumB] = Microcontroller::calcChecksum(sysex, 5, checksumB);
+			sysex[checksumB + 1] = 0xf7;
 
 			++presetIdx;
 
@@ -540,12 +534,44 @@ namespace virusLib
 		}
 
 		m_dsp->processAudio(inputs, outputs, _samples, getExtraLatencySamples());
+
+		getMetrics().add(synthLib::MetricType::AudioOutputFill, m_dsp->getAudio().getAudioOutputs().size());
 	}
 
 	void Device::onAudioWritten()
 	{
 		m_mc->getMidiQueue(0).onAudioWritten();
 		m_mc->process();
+
+		if(m_demoActive)
+		{
+			std::scoped_lock lock(m_demoMutex);
+			if(m_demo)
+				m_demo->process(1);
+		}
+	}
+
+	bool Device::startDemoPlayback()
+	{
+		if(m_rom.getDemoData().empty())
+			return false;
+
+		std::unique_ptr<DemoPlayback> demo(m_rom.isTIFamily() ? new DemoPlaybackTI(*m_mc) : new DemoPlayback(*m_mc));
+
+		if(!demo->loadBinData(m_rom.getDemoData()))
+			return false;
+
+		std::scoped_lock lock(m_demoMutex);
+		m_demo = std::move(demo);
+		m_demoActive = true;
+		return true;
+	}
+
+	void Device::stopDemoPlayback()
+	{
+		std::scoped_lock lock(m_demoMutex);
+		m_demoActive = false;
+		m_demo.reset();
 	}
 
 	void Device::configureDSP(DspSingle& _dsp, const ROMFile& _rom, const float _samplerate)
@@ -626,6 +652,16 @@ namespace virusLib
 		return !m_dsp ? 0 : m_dsp->getEsxiClock().getSpeedInHz();
 	}
 
+	bool Device::setPartOutput(const uint8_t _part, const uint32_t _outputPair)
+	{
+		// Out 1 to Out 3 of the A, B and C. The order of the TI outputs is not known, routing is not supported there
+		if(m_rom.isTIFamily() || _outputPair >= 3)
+			return false;
+
+		// stereo output selection values are 1 = Out 1, 4 = Out 2 and 7 = Out 3, see Microcontroller::sendInitControlCommands()
+		return m_mc->setPartOutput(_part, static_cast<uint8_t>(1 + _outputPair * 3));
+	}
+
 	void Device::applyDspMemoryPatches(const DspSingle* _dspA, const DspSingle* _dspB, const ROMFile& _rom)
 	{
 		DspMemoryPatches::apply(_dspA, _rom.getHash());
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
+#include "demoplayback.h"
 #include "dspSingle.h"
 #include "frontpanelState.h"
 #include "synthLib/midiTypes.h"
@@ -55,9 +59,15 @@ namespace virusLib
 		uint32_t getDspClockPercent() const override;
 		uint64_t getDspClockHz() const override;
 
+		bool setPartOutput(uint8_t _part, uint32_t _outputPair) override;
+
 		static void applyDspMemoryPatches(const DspSingle* _dspA, const DspSingle* _dspB, const ROMFile& _rom);
 		void applyDspMemoryPatches() const;
 
+		// Plays the demo song of the ROM. Playback is driven by the emulated audio clock, not by wall clock time
+		bool startDemoPlayback();
+		void stopDemoPlayback();
+
 	private:
 		bool sendMidi(const synthLib::SMidiEvent& _ev, std::vector<synthLib::SMidiEvent>& _response) override;
 		void readMidiOut(std::vector<synthLib::SMidiEvent>& _midiOut) override;
@@ -75,5 +85,9 @@ namespace virusLib
 		float m_samplerate;
 		FrontpanelState m_frontpanelStateDSP;
 		synthLib::SMidiEvent m_frontpanelStateMidiEvent;
+
+		std::mutex m_demoMutex;
+		std::unique_ptr<DemoPlayback> m_demo;
+		std::atomic<bool> m_demoActive = false;
 	};
 }
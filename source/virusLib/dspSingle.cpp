@@ -22,6 +22,7 @@ namespace virusLib
 			dsp56k::alignedSize<dsp56k::Memory>() + 
 			dsp56k::Memory::calcMemSize(_memorySize, g_externalMemStart) * sizeof(uint32_t);
 
+		// the buffer is cleared here, its pages are allocated on the NUMA node of this thread. See synthLib::ThreadPlacement
 		m_buffer.resize(dsp56k::alignedSize(requiredMemSize));
 
 		auto* buf = m_buffer.data();
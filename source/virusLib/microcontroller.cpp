@@ -381,6 +381,19 @@ uint8_t Microcontroller::getPartMidiChannel(const uint8_t _part) const
 	return m_multiEditBuffer[MD_PART_MIDI_CHANNEL + _part];
 }
 
+bool Microcontroller::setPartOutput(const uint8_t _part, const uint8_t _output)
+{
+	if(_part >= getPartCount())
+		return false;
+
+	std::vector<SMidiEvent> responses;
+
+	if(m_globalSettings[PLAY_MODE] != PlayModeMulti)
+		sendSysex({M_STARTOFSYSEX, 0x00, 0x20, 0x33, 0x01, OMNI_DEVICE_ID, globalSettingsPage(), 0, PLAY_MODE, PlayModeMulti, M_ENDOFSYSEX}, responses, MidiEventSource::Internal);
+
+	return sendSysex({M_STARTOFSYSEX, 0x00, 0x20, 0x33, 0x01, OMNI_DEVICE_ID, PAGE_C, _part, PART_OUTPUT_SELECT, _output, M_ENDOFSYSEX}, responses, MidiEventSource::Internal);
+}
+
 bool Microcontroller::isPolyPressureForPageBEnabled() const
 {
 	return m_globalSettings[MIDI_CONTROL_HIGH_PAGE] == 1;
@@ -69,6 +69,9 @@ public:
 	void setSamplerate(float _samplerate);
 
 	uint8_t getPartMidiChannel(uint8_t _part) const;
+
+	// switches to multi mode if needed and sets the output select of a part
+	bool setPartOutput(uint8_t _part, uint8_t _output);
 	bool isPolyPressureForPageBEnabled() const;
 
 private:
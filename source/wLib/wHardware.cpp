@@ -12,6 +12,8 @@ namespace wLib
 {
 	constexpr uint32_t g_syncEsaiFrameRate = 8;
 	constexpr uint32_t g_syncHaltDspEsaiThreshold = 16;
+	constexpr uint32_t g_ucQuantum = 1024;	// instructions per time slice of the uc executor
+	constexpr std::chrono::microseconds g_ucYieldLoopWaitTime(100);
 
 	static_assert((g_syncEsaiFrameRate & (g_syncEsaiFrameRate - 1)) == 0, "esai frame sync rate must be power of two");
 	static_assert(g_syncHaltDspEsaiThreshold >= g_syncEsaiFrameRate * 2, "esai DSP halt threshold must be greater than two times the sync rate");
@@ -55,8 +57,14 @@ namespace wLib
 			}
 			else
 			{
+				// we are running on a worker of the uc executor. The condition might become false without another ESAI
+				// frame being produced, for example if the DSP is throttled by the host, so do not wait for a frame forever
+				const auto esaiFrameIndex = m_esaiFrameIndex;
 				std::unique_lock uLock(m_esaiFrameAddedMutex);
-				m_esaiFrameAddedCv.wait(uLock);
+				m_esaiFrameAddedCv.wait_for(uLock, g_ucYieldLoopWaitTime, [&]
+				{
+					return m_esaiFrameIndex != esaiFrameIndex || !_continue();
+				});
 			}
 		}
 
@@ -64,6 +72,24 @@ namespace wLib
 			haltDSP();
 	}
 
+	bool Hardware::runUcQuantum()
+	{
+		const synthLib::ScopedMetricTimer timer(m_metrics, synthLib::MetricType::UcQuantum);
+
+		for(uint32_t i=0; i<g_ucQuantum; ++i)
+		{
+			if(!processUcCycle())
+				return false;
+		}
+		return true;
+	}
+
+	void Hardware::onUcResumed(const Clock::duration _suspendedTime)
+	{
+		if(m_metrics)
+			m_metrics->add(synthLib::MetricType::UcWaitForDsp, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(_suspendedTime).count()));
+	}
+
 	void Hardware::sendMidi(const synthLib::SMidiEvent& _ev)
 	{
 		m_midiIn.push_back(_ev);
@@ -81,7 +107,10 @@ namespace wLib
 		processMidiInput();
 
 		if((m_esaiFrameIndex & (g_syncEsaiFrameRate-1)) == 0)
+		{
 			m_esaiFrameAddedCv.notify_one();
+			wakeUpUc();
+		}
 
 		m_requestedFramesAvailableMutex.lock();
 
@@ -96,23 +125,29 @@ namespace wLib
 		}
 
 		std::unique_lock uLock(m_haltDSPmutex);
+
+		if(!m_haltDSP)
+			return;
+
+		const synthLib::ScopedMetricTimer timer(m_metrics, synthLib::MetricType::DspWaitForUc);
 		m_haltDSPcv.wait(uLock, [&]{ return m_haltDSP == false; });
 	}
 
-	void Hardware::syncUcToDSP()
+	bool Hardware::syncUcToDSP()
 	{
 		if(m_remainingUcCycles > 0)
-			return;
+			return true;
 
 		// we can only use ESAI to clock the uc once it has been enabled
 		if(m_esaiFrameIndex <= 0)
-			return;
+			return true;
 
 		if(m_esaiFrameIndex == m_lastEsaiFrameIndex)
 		{
+			// all cycles of the frames produced so far have been used. Let the DSP run, the uc executor suspends us
+			// until the ESAI callback wakes us up again
 			resumeDSP();
-			std::unique_lock uLock(m_esaiFrameAddedMutex);
-			m_esaiFrameAddedCv.wait(uLock, [this]{return m_esaiFrameIndex > m_lastEsaiFrameIndex;});
+			return false;
 		}
 
 		const auto esaiFrameIndex = m_esaiFrameIndex;
@@ -145,6 +180,8 @@ namespace wLib
 		}
 
 		m_lastEsaiFrameIndex = esaiFrameIndex;
+
+		return true;
 	}
 
 	void Hardware::processMidiInput()
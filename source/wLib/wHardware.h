@@ -6,6 +6,9 @@
 #include "dsp56kEmu/ringbuffer.h"
 #include "dsp56kEmu/types.h"
 
+#include "hardwareLib/ucExecutor.h"
+
+#include "synthLib/deviceMetrics.h"
 #include "synthLib/midiTypes.h"
 
 namespace hwLib
@@ -25,11 +28,11 @@ namespace dsp56k
 
 namespace wLib
 {
-	class Hardware
+	class Hardware : public hwLib::UcExecutor::Task
 	{
 	public:
 		Hardware(const double& _samplerate);
-		virtual ~Hardware() = default;
+		~Hardware() override = default;
 
 		virtual hwLib::SciMidi& getMidi() = 0;
 		virtual mc68k::Mc68k& getUc() = 0;
@@ -42,9 +45,18 @@ namespace wLib
 		void sendMidi(const synthLib::SMidiEvent& _ev);
 		void receiveMidi(std::vector<uint8_t>& _data);
 
+		void setMetrics(synthLib::DeviceMetrics* _metrics) { m_metrics = _metrics; }
+
+		// UcExecutor::Task
+		bool runUcQuantum() override;
+		void onUcResumed(Clock::duration _suspendedTime) override;
+
 	protected:
+		// returns false if the uc has to wait for the DSP
+		virtual bool processUcCycle() = 0;
+
 		void onEsaiCallback(dsp56k::Audio& _audio);
-		void syncUcToDSP();
+		bool syncUcToDSP();
 		void processMidiInput();
 
 		// timing
@@ -72,5 +84,7 @@ namespace wLib
 		std::mutex m_haltDSPmutex;
 		bool m_processAudio = false;
 		bool m_bootCompleted = false;
+
+		synthLib::DeviceMetrics* m_metrics = nullptr;
 	};
 }
@@ -40,6 +40,7 @@ namespace xtJucePlugin
 		getController();
 		const auto latencyBlocks = getConfig().getIntValue("latencyBlocks", static_cast<int>(getPlugin().getLatencyBlocks()));
 		Processor::setLatencyBlocks(latencyBlocks);
+		Processor::setLatencyAutotune(getConfig().getBoolValue("latencyAutotune", false));
 	}
 
 	AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
@@ -59,6 +60,16 @@ namespace xtJucePlugin
 		return new xt::Device(p);
 	}
 
+	pluginLib::Processor::DeviceFactory AudioPluginAudioProcessor::createDeviceFactory()
+	{
+		synthLib::DeviceCreateParams p;
+		getRemoteDeviceParams(p);
+		return [p]
+		{
+			return new xt::Device(p);
+		};
+	}
+
 	void AudioPluginAudioProcessor::getRemoteDeviceParams(synthLib::DeviceCreateParams& _params) const
 	{
 		Processor::getRemoteDeviceParams(_params);
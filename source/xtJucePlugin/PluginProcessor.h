@@ -13,6 +13,7 @@ namespace xtJucePlugin
 	    jucePluginEditorLib::PluginEditorState* createEditorState() override;
 
 		synthLib::Device* createDevice() override;
+		DeviceFactory createDeviceFactory() override;
 		void getRemoteDeviceParams(synthLib::DeviceCreateParams& _params) const override;
 
 	    pluginLib::Controller* createController() override;
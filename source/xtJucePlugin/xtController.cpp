@@ -33,6 +33,7 @@ namespace
 	    "emuRequestLeds",
 	    "emuSendButton",
 	    "emuSendRotary",
+	    "emuFrontPanelClosed",
 	    "requestWave",
 	    "waveDump",
 		"requestTable",
@@ -568,16 +569,15 @@ namespace xtJucePlugin
 	{
 		const auto &desc = _parameter.getDescription();
 
-		std::map<pluginLib::MidiDataType, uint8_t> data;
-
 		switch (desc.page)
 		{
 		case g_pageGlobal:
 			{
-				data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, _parameter.getDescription().index & 0x7f));
-				data.insert(std::make_pair(pluginLib::MidiDataType::ParameterValue, _value));
-
-				sendSysEx(GlobalParameterChange, data);
+				sendParameterChangeSysEx(_parameter, midiPacketName(GlobalParameterChange), static_cast<uint8_t>(_value), [&](pluginLib::MidiPacket::Data& _data)
+				{
+					_data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, desc.index & 0x7f));
+					_data.insert(std::make_pair(pluginLib::MidiDataType::DeviceId, m_deviceId));
+				});
 			}
 			return;
 		case g_pageMulti:
@@ -602,12 +602,13 @@ namespace xtJucePlugin
 				else
 					page = static_cast<uint8_t>(xt::LocationH::MultiDumpMultiEditBuffer);
 
-				data.insert(std::make_pair(pluginLib::MidiDataType::Part, _parameter.getPart()));
-				data.insert(std::make_pair(pluginLib::MidiDataType::Page, page));
-				data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, desc.index));
-				data.insert(std::make_pair(pluginLib::MidiDataType::ParameterValue, v));
-
-				sendSysEx(MultiParameterChange, data);
+				sendParameterChangeSysEx(_parameter, midiPacketName(MultiParameterChange), v, [&](pluginLib::MidiPacket::Data& _data)
+				{
+					_data.insert(std::make_pair(pluginLib::MidiDataType::Part, _parameter.getPart()));
+					_data.insert(std::make_pair(pluginLib::MidiDataType::Page, page));
+					_data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, desc.index));
+					_data.insert(std::make_pair(pluginLib::MidiDataType::DeviceId, m_deviceId));
+				});
 			}
 			return;
 		case g_pageSoftKnobs:
@@ -620,12 +621,13 @@ namespace xtJucePlugin
 				if (!combineParameterChange(v, g_midiPacketNames[SingleDump], _parameter, _value))
 					return;
 
-				data.insert(std::make_pair(pluginLib::MidiDataType::Part, _parameter.getPart()));
-				data.insert(std::make_pair(pluginLib::MidiDataType::Page, desc.page));
-				data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, desc.index));
-				data.insert(std::make_pair(pluginLib::MidiDataType::ParameterValue, v));
-
-				sendSysEx(SingleParameterChange, data);
+				sendParameterChangeSysEx(_parameter, midiPacketName(SingleParameterChange), v, [&](pluginLib::MidiPacket::Data& _data)
+				{
+					_data.insert(std::make_pair(pluginLib::MidiDataType::Part, _parameter.getPart()));
+					_data.insert(std::make_pair(pluginLib::MidiDataType::Page, desc.page));
+					_data.insert(std::make_pair(pluginLib::MidiDataType::ParameterIndex, desc.index));
+					_data.insert(std::make_pair(pluginLib::MidiDataType::DeviceId, m_deviceId));
+				});
 			}
 			break;
 		}
@@ -41,6 +41,7 @@ namespace xtJucePlugin
 	        EmuRequestLeds,
 	        EmuSendButton,
 	        EmuSendRotary,
+	        EmuFrontPanelClosed,
 			RequestWave,
 			WaveDump,
 			RequestTable,
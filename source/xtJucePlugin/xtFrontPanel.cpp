@@ -38,6 +38,9 @@ namespace xtJucePlugin
 
 	FrontPanel::~FrontPanel()
 	{
+		// the device stops sending LCD and LED updates until they are requested again
+		m_controller.sendSysEx(Controller::EmuFrontPanelClosed);
+
 		m_controller.setFrontPanel(nullptr);
 		m_lcd.reset();
 	}
@@ -179,6 +179,44 @@ namespace xtJucePlugin
 		return true;
 	}
 
+	bool PatchManager::createPreviewSysex(pluginLib::patchDB::DataList& _result, const pluginLib::patchDB::PatchPtr& _patch) const
+	{
+		auto data = applyModifications(_patch);
+
+		if(data.size() == xt::Mw1::g_singleDumpLength)
+		{
+			// MW1 dumps are loaded to the current instrument, which is the edit buffer of a device in single mode
+			_result.emplace_back(std::move(data));
+			return true;
+		}
+
+		if(data.size() > std::tuple_size_v<xt::State::Single>)
+		{
+			// combined patch, send table and waves first, followed by the single itself
+			std::vector<xt::SysEx> dumps;
+
+			if(!xt::State::splitCombinedPatch(dumps, data) || dumps.empty())
+				return false;
+
+			for(size_t i=1; i<dumps.size(); ++i)
+				_result.emplace_back(std::move(dumps[i]));
+
+			data = std::move(dumps.front());
+		}
+
+		if(data.size() != std::tuple_size_v<xt::State::Single>)
+			return false;
+
+		data[wLib::IdxBuffer] = static_cast<uint8_t>(xt::LocationH::SingleEditBufferSingleMode);
+		data[wLib::IdxLocation] = 0;
+		data[wLib::IdxDeviceId] = 0;
+
+		xt::State::updateChecksum(data, wLib::IdxCommand);
+
+		_result.emplace_back(std::move(data));
+		return true;
+	}
+
 	bool PatchManager::parseFileData(pluginLib::patchDB::DataList& _results, const pluginLib::patchDB::Data& _data)
 	{
 		if(!jucePluginEditorLib::patchManager::PatchManager::parseFileData(_results, _data))
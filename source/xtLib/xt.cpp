@@ -2,8 +2,6 @@
 
 #include "synthLib/midiTypes.h"
 
-#include "dsp56kEmu/threadtools.h"
-
 #include "xtHardware.h"
 #include "xtRomLoader.h"
 
@@ -18,26 +16,9 @@ namespace xt
 
 		m_midiOutBuffer.reserve(1024);
 
-		m_ucThread.reset(new std::thread([&]()
-		{
-			dsp56k::ThreadTools::setCurrentThreadPriority(dsp56k::ThreadPriority::Highest);
-			dsp56k::ThreadTools::setCurrentThreadName("MC68331");
-			while(!m_destroy)
-				processUcThread();
-			m_destroy = false;
-			m_hw->ucThreadTerminated();
-		}));
+		m_hw->startUc();
 
 		m_hw->initVoiceExpansion();
-
-		m_hw->getUC().setLcdDirtyCallback([this]
-		{
-			m_dirtyFlags.fetch_or(static_cast<uint32_t>(DirtyFlags::Lcd));
-		});
-		m_hw->getUC().setLedsDirtyCallback([this]
-		{
-			m_dirtyFlags.fetch_or(static_cast<uint32_t>(DirtyFlags::Leds));
-		});
 	}
 
 	Xt::~Xt()
@@ -48,20 +29,17 @@ namespace xt
 		// we need to have passed the boot stage
 		m_hw->processAudio(1);
 
-		m_destroy = true;
-
-		// DSP needs to run to let the uc thread wake up
+		// DSP needs to run to let a uc quantum that is currently executed finish
 		const auto& esai = m_hw->getDSP().getPeriph().getEssi0();
-		while(m_destroy)
+		m_hw->stopUc([&]
 		{
 			if(!esai.getAudioOutputs().empty())
 				m_hw->processAudio(1);
 			else
 				std::this_thread::yield();
-		}
+		});
 
-		m_ucThread->join();
-		m_ucThread.reset();
+		m_hw->ucThreadTerminated();
 		m_hw.reset();
 	}
 
@@ -146,8 +124,27 @@ namespace xt
 
 	Xt::DirtyFlags Xt::getDirtyFlags()
 	{
-		const auto r = m_dirtyFlags.exchange(0);
-		return static_cast<DirtyFlags>(r);
+		const auto& pic = m_hw->getUC().getPic();
+
+		uint32_t f = 0;
+
+		auto check = [&f](uint32_t& _lastVersion, const uint32_t _version, DirtyFlags _flag)
+		{
+			if(_version == _lastVersion)
+				return;
+			_lastVersion = _version;
+			f |= static_cast<uint32_t>(_flag);
+		};
+
+		check(m_lastLedsVersion, pic.getLedsVersion(), DirtyFlags::Leds);
+		check(m_lastLcdVersion, pic.getLcdVersion(), DirtyFlags::Lcd);
+
+		return static_cast<DirtyFlags>(f);
+	}
+
+	void Xt::setHeadless(const bool _headless)
+	{
+		m_hw->getUC().setHeadless(_headless);
 	}
 
 	void Xt::readLCD(std::array<char, 80>& _lcdData) const
@@ -164,19 +161,4 @@ namespace xt
 	{
 		return m_hw->getUC().getButton(_button);
 	}
-
-	void Xt::processUcThread() const
-	{
-		for(size_t i=0; i<32; ++i)
-		{
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-			m_hw->process();
-		}
-	}
 }
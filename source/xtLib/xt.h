@@ -49,8 +49,13 @@ namespace xt
 
 		bool isBootCompleted() const;
 
+		// Dirty flags are sticky but are reset upon calling this function
 		DirtyFlags getDirtyFlags();
 
+		// In headless mode, the UC thread neither decodes LCD text nor LEDs. Front panel state might be outdated until it
+		// changes again after headless mode has been left. Does not affect audio
+		void setHeadless(bool _headless);
+
 		void readLCD(std::array<char, 80>& _lcdData) const;
 
 		bool getLedState(LedType _led) const;
@@ -59,16 +64,14 @@ namespace xt
 	private:
 		void internalProcess(uint32_t _frames, uint32_t _latency);
 
-		void processUcThread() const;
-
 		std::unique_ptr<Hardware> m_hw;
 
 		std::mutex m_mutex;
 
 		std::vector<uint8_t> m_midiOutBuffer;
 
-		std::unique_ptr<std::thread> m_ucThread;
-		bool m_destroy = false;
-		std::atomic<uint32_t> m_dirtyFlags = 0;
+		// versions seen by the last call to getDirtyFlags()
+		uint32_t m_lastLedsVersion = 0;
+		uint32_t m_lastLcdVersion = 0;
 	};
 }
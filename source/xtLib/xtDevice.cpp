@@ -18,6 +18,7 @@ namespace xt
 
 		auto* hw = m_xt.getHardware();
 		hw->resetMidiCounter();
+		hw->setMetrics(&getMetrics());
 	}
 
 	float Device::getSamplerate() const
@@ -50,6 +51,20 @@ namespace xt
 		return 4;
 	}
 
+	bool Device::setHeadless(const bool _headless)
+	{
+		m_xt.setHeadless(_headless);
+		return true;
+	}
+
+	bool Device::setPartOutput(const uint8_t _part, const uint32_t _outputPair)
+	{
+		// the output pairs are Main and Sub
+		if(_outputPair >= 2)
+			return false;
+		return m_state.setInstrumentOutput(_part, static_cast<uint8_t>(_outputPair));
+	}
+
 	void Device::readMidiOut(std::vector<synthLib::SMidiEvent>& _midiOut)
 	{
 		m_xt.receiveMidi(m_midiOutBuffer);
@@ -85,6 +100,10 @@ namespace xt
 		float* outputs[4] = {_outputs[0], _outputs[1], _outputs[2], _outputs[3]};
 		m_xt.process(inputs, outputs, static_cast<uint32_t>(_samples), getExtraLatencySamples());
 
+		// nobody displays the front panel until it has been requested once
+		if(!m_sysexRemote.isFrontPanelRequested())
+			return;
+
 		const auto dirty = static_cast<uint32_t>(m_xt.getDirtyFlags());
 
 		m_sysexRemote.handleDirtyFlags(m_customSysexOut, dirty);
@@ -24,6 +24,8 @@ namespace xt
 		bool setState(const std::vector<uint8_t>& _state, synthLib::StateType _type) override;
 		uint32_t getChannelCountIn() override;
 		uint32_t getChannelCountOut() override;
+		bool setHeadless(bool _headless) override;
+		bool setPartOutput(uint8_t _part, uint32_t _outputPair) override;
 
 	protected:
 		void readMidiOut(std::vector<synthLib::SMidiEvent>& _midiOut) override;
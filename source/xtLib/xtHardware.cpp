@@ -73,9 +73,10 @@ namespace xt
 		}, 0);
 	}
 
-	void Hardware::processUcCycle()
+	bool Hardware::processUcCycle()
 	{
-		syncUcToDSP();
+		if(!syncUcToDSP())
+			return false;
 
 		const auto deltaCycles = m_uc.exec();
 		if(m_esaiFrameIndex > 0)
@@ -99,6 +100,8 @@ namespace xt
 			}
 			m_uc.notifyDSPBooted();
 		}
+
+		return true;
 	}
 
 	void Hardware::processAudio(uint32_t _frames, uint32_t _latency)
@@ -194,6 +197,7 @@ namespace xt
 			{
 				// reduce thread contention by waiting for output buffer to be full enough to let us grab the data without entering the read mutex too often
 
+				const synthLib::ScopedMetricTimer timer(m_metrics, synthLib::MetricType::HostWaitForDsp);
 				std::unique_lock uLock(m_requestedFramesAvailableMutex);
 				m_requestedFrames = requiredSize;
 				m_requestedFramesAvailableCv.wait(uLock, [&]()
@@ -206,6 +210,9 @@ namespace xt
 			}
 
 			esai.processAudioOutputInterleaved(outputs, processCount);
+
+			if(m_metrics)
+				m_metrics->add(synthLib::MetricType::AudioOutputFill, esai.getAudioOutputs().size());
 			/*
 			if constexpr (g_useVoiceExpansion)
 			{
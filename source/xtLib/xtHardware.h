@@ -61,7 +61,7 @@ namespace xt
 
 	private:
 		void setupEsaiListener();
-		void processUcCycle();
+		bool processUcCycle() override;
 
 		const Rom m_rom;
 
@@ -38,7 +38,8 @@ namespace xt
 		EmuLCD = 0x60,
 		EmuLEDs = 0x61,
 		EmuButtons = 0x62,
-		EmuRotaries = 0x63
+		EmuRotaries = 0x63,
+		EmuFrontPanelClosed = 0x64
 	};
 
 	enum class LocationH : uint8_t
@@ -21,13 +21,15 @@ namespace xt
 
 			if(_index == 0)
 			{
+				const auto buttons = m_spiButtons.load(std::memory_order_relaxed);
+
 				// $30 enc 3 switches to multimode?
 				// $35 = Osc 1 Semitone
 				// $36 = Startwave1
 				// $37 = Mix Wave1
 
-				const uint8_t buttonA = m_spiButtons & 0x3f;
-				const uint8_t buttonB = (m_spiButtons>>1) & 0x20;
+				const uint8_t buttonA = buttons & 0x3f;
+				const uint8_t buttonB = (buttons>>1) & 0x20;
 
 				const uint16_t anus[] =
 				{
@@ -97,14 +99,16 @@ namespace xt
 					case 9:
 					case 10:
 					case 11:
+						if(!m_headless.load(std::memory_order_relaxed))
 						{
-							const auto oldLedState = m_ledState;
-							m_ledState &= ~(0xff << ((_index-8) * 8));
-							m_ledState |= (_data & 0xff) << ((_index-8) * 8);
-							if(oldLedState != m_ledState)
+							const auto oldLedState = m_ledState.load(std::memory_order_relaxed);
+							auto ledState = oldLedState & ~(0xff << ((_index-8) * 8));
+							ledState |= (_data & 0xff) << ((_index-8) * 8);
+							if(oldLedState != ledState)
 							{
-//								MCLOG("LEDs: " << MCHEXN(m_ledState, 4));
-								m_cbkLedsDirty();
+//								MCLOG("LEDs: " << MCHEXN(ledState, 4));
+								m_ledState.store(ledState, std::memory_order_relaxed);
+								m_ledsVersion.fetch_add(1, std::memory_order_release);
 							}
 						}
 						break;
@@ -117,13 +121,13 @@ namespace xt
 					lcdChar = static_cast<uint8_t>(_data);
 				}
 			}
-			if(lcdChar)
+			if(lcdChar && !m_headless.load(std::memory_order_relaxed))
 			{
 				const auto ch = static_cast<char>(lcdChar);
 
 				if(_lcd.writeCharacter(ch))
 				{
-					m_cbkLcdDirty();
+					m_lcdVersion.fetch_add(1, std::memory_order_release);
 					MCLOG("LCD:\n" << _lcd.toString());
 				}
 
@@ -141,9 +145,9 @@ namespace xt
 
 		// inverted on purpose, pressed buttons are 0, released ones 1
 		if(_pressed)
-			m_spiButtons &= ~buttonMask;
+			m_spiButtons.fetch_and(static_cast<uint8_t>(~buttonMask));
 		else
-			m_spiButtons |= buttonMask;
+			m_spiButtons.fetch_or(buttonMask);
 	}
 
 	bool Pic::getButton(ButtonType _button) const
@@ -154,22 +158,8 @@ namespace xt
 		return (m_spiButtons & buttonMask) == 0;
 	}
 
-	void Pic::setLcdDirtyCallback(const DirtyCallback& _cbk)
-	{
-		m_cbkLcdDirty = _cbk;
-		if(!m_cbkLcdDirty)
-			m_cbkLcdDirty = [] {};
-	}
-
-	void Pic::setLedsDirtyCallback(const DirtyCallback& _cbk)
-	{
-		m_cbkLedsDirty = _cbk;
-		if(!m_cbkLedsDirty)
-			m_cbkLedsDirty = [] {};
-	}
-
 	bool Pic::getLedState(const LedType _led) const
 	{
-		return m_ledState & (1 << _led);
+		return getLedStates() & (1 << _led);
 	}
 }
@@ -1,7 +1,7 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
-#include <functional>
 
 #include "xtButtons.h"
 #include "xtLeds.h"
@@ -18,25 +18,31 @@ namespace xt
 	class Pic
 	{
 	public:
-		using DirtyCallback = std::function<void()>;
-
 		Pic(mc68k::Mc68k& _uc, Lcd& _lcd);
 		~Pic();
 
 		void setButton(ButtonType _type, bool _pressed);
 		bool getButton(ButtonType _button) const;
 
-		void setLcdDirtyCallback(const DirtyCallback& _cbk);
-		void setLedsDirtyCallback(const DirtyCallback& _cbk);
 		bool getLedState(LedType _led) const;
+		uint32_t getLedStates() const { return m_ledState.load(std::memory_order_relaxed); }
+
+		// incremented whenever the LCD or the LEDs change, consumers poll them to find out if they need to repaint
+		uint32_t getLcdVersion() const { return m_lcdVersion.load(std::memory_order_acquire); }
+		uint32_t getLedsVersion() const { return m_ledsVersion.load(std::memory_order_acquire); }
+
+		// skips LCD and LED decoding if nobody displays them
+		void setHeadless(const bool _headless) { m_headless = _headless; }
 
 	private:
 		uint16_t m_picCommand0 = 0;
 		bool m_picHasLedUpdate = false;
 
-		uint8_t m_spiButtons = 0xff;
-		uint32_t m_ledState = 0;
-		DirtyCallback m_cbkLedsDirty = [] {};
-		DirtyCallback m_cbkLcdDirty = [] {};
+		std::atomic<uint8_t> m_spiButtons{0xff};
+		std::atomic<uint32_t> m_ledState{0};
+
+		std::atomic<uint32_t> m_lcdVersion{0};
+		std::atomic<uint32_t> m_ledsVersion{0};
+		std::atomic<bool> m_headless{false};
 	};
 }
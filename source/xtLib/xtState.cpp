@@ -306,6 +306,22 @@ namespace xt
 		return loadState(_state);
 	}
 
+	bool State::setInstrumentOutput(const uint8_t _instrument, const uint8_t _output)
+	{
+		if(_instrument >= 8)
+			return false;
+
+		// the changes are forwarded to the device in the same way as the ones of the editor
+		if(!isMultiMode())
+		{
+			Responses unused;
+			receive(unused, SysEx{0xf0, wLib::IdWaldorf, IdMw2, wLib::IdDeviceOmni, static_cast<uint8_t>(SysexCommand::ModeDump), 1, 0xf7}, Origin::External);
+		}
+
+		sendMultiParameter(_instrument, MultiParameter::Inst0Output, _output);
+		return true;
+	}
+
 	void State::process(const uint32_t _numSamples)
 	{
 		for (auto it = m_delayedCalls.begin(); it != m_delayedCalls.end();)
@@ -84,7 +84,7 @@ namespace xt
 		}
 */	}
 
-	bool SysexRemoteControl::receive(std::vector<synthLib::SMidiEvent>& _output, const std::vector<unsigned char>& _input) const
+	bool SysexRemoteControl::receive(std::vector<synthLib::SMidiEvent>& _output, const std::vector<unsigned char>& _input)
 	{
 		if(_input.size() < 5)
 			return false;
@@ -97,8 +97,12 @@ namespace xt
 		switch (static_cast<SysexCommand>(cmd))
 		{
 		case SysexCommand::EmuLCD:
+			m_frontPanelRequested = true;
 			sendSysexLCD(_output);
 			return true;
+		case SysexCommand::EmuFrontPanelClosed:
+			m_frontPanelRequested = false;
+			return true;
 		case SysexCommand::EmuButtons:
 			{
 				if(_input.size() > 6)
@@ -115,6 +119,7 @@ namespace xt
 			return true;
 		case SysexCommand::EmuLEDs:
 			{
+				m_frontPanelRequested = true;
 				sendSysexLEDs(_output);
 			}
 			return true;
@@ -216,14 +216,9 @@ namespace xt
 		m_pic.setButton(_type, _pressed);
 	}
 
-	void XtUc::setLcdDirtyCallback(const Pic::DirtyCallback& _callback)
+	void XtUc::setHeadless(const bool _headless)
 	{
-		m_pic.setLcdDirtyCallback(_callback);
-	}
-
-	void XtUc::setLedsDirtyCallback(const Pic::DirtyCallback& _callback)
-	{
-		m_pic.setLedsDirtyCallback(_callback);
+		m_pic.setHeadless(_headless);
 	}
 
 	bool XtUc::getLedState(LedType _led) const
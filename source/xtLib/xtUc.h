@@ -39,10 +39,10 @@ namespace xt
 
 		void setButton(ButtonType _type, bool _pressed);
 
-		void setLcdDirtyCallback(const Pic::DirtyCallback& _callback);
-		void setLedsDirtyCallback(const Pic::DirtyCallback& _callback);
+		void setHeadless(bool _headless);
 
 		Lcd& getLcd() { return m_lcd; }
+		const Pic& getPic() const { return m_pic; }
 		bool getLedState(LedType _led) const;
 		bool getButton(ButtonType _button) const;
 